@@ -150,10 +150,12 @@ extension IRAVPlayer {
         }
 
         avPlayer.play()
+        reloadRate()
         DispatchQueue.main.asyncAfter(deadline: .now() + 0.3) { [weak self] in
             guard let self = self else { return }
             if Self.shouldRetryPlayAfterDelay(for: self.state) {
                 self.avPlayer?.play()
+                self.reloadRate()
             }
         }
     }
@@ -195,6 +197,7 @@ extension IRAVPlayer {
             guard let avPlayer = avPlayer else { return }
             state = .playing
             avPlayer.play()
+            reloadRate()
             needPlay = false
         }
     }
@@ -274,6 +277,17 @@ extension IRAVPlayer {
         avPlayer.volume = IRPlayerVolume.normalizedFloat(from: abstractPlayer.volume)
     }
 
+    /// Applies the abstract player's rate while playing; a paused player keeps rate 0
+    /// and picks the rate up on the next play.
+    func reloadRate() {
+        guard let avPlayer = avPlayer,
+              let abstractPlayer = abstractPlayer else { return }
+        avPlayerItem?.audioTimePitchAlgorithm = .timeDomain
+        if avPlayer.rate != 0 {
+            avPlayer.rate = Float(IRPlayerRate.normalized(abstractPlayer.rate))
+        }
+    }
+
     func reloadPlayableTime() {
         guard let avPlayerItem = avPlayerItem, avPlayerItem.status == .readyToPlay,
               let range = avPlayerItem.loadedTimeRanges.first?.timeRangeValue else {
@@ -8,6 +8,7 @@
 import Foundation
 import AVFoundation
 import Accelerate
+import QuartzCore
 
 enum IRAudioManagerInterruptionType: UInt {
     case begin
@@ -23,6 +24,13 @@ enum IRAudioManagerRouteChangeReason: UInt {
     case oldDeviceUnavailable
 }
 
+/// Sample type of the output unit's stream format.
+enum IRAudioOutputSampleFormat: Equatable {
+    case float32
+    case int16
+    case unsupported
+}
+
 protocol IRAudioManagerDelegate: AnyObject {
     func audioManager(_ audioManager: IRAudioManager, outputData: UnsafeMutablePointer<Float>, numberOfFrames: UInt32, numberOfChannels: UInt32)
 }
@@ -52,6 +60,13 @@ class IRAudioManager: NSObject {
     private var _playing = false
     weak var delegate: IRAudioManagerDelegate?
 
+    /// Host time, on the `CACurrentMediaTime()` base, of the buffer being rendered.
+    /// Only meaningful inside the delegate's render call.
+    private(set) var renderHostTime: TimeInterval = 0
+    /// Time from a render callback's host time until its audio reaches the speaker.
+    /// Cached off the render thread when the unit starts and when the route changes.
+    private(set) var outputLatency: TimeInterval = 0
+
     var volume: Float {
         get {
             guard registered,
@@ -103,6 +118,8 @@ class IRAudioManager: NSObject {
     override init() {
         super.init()
         _outData = UnsafeMutablePointer<Float>.allocate(capacity: IRAudioManager.maxFrameSize * IRAudioManager.maxChan)
+        // Resolved here so the render thread never runs the lazy initializer.
+        _ = IRAudioManager.hostTimebase
 
         #if !os(macOS)
         NotificationCenter.default.addObserver(self, selector: #selector(audioSessionInterruptionHandler(_:)), name: AVAudioSession.interruptionNotification, object: nil)
@@ -145,6 +162,7 @@ class IRAudioManager: NSObject {
     }
 
     @objc private func audioSessionRouteChangeHandler(_ notification: Notification) {
+        reloadOutputLatency()
         guard let handlerTarget = handlerTarget, let routeChangeHandler = routeChangeHandler else { return }
         guard let rawReason = Self.unsignedInteger(from: notification.userInfo?[AVAudioSessionRouteChangeReasonKey]),
               let avReason = AVAudioSession.RouteChangeReason(rawValue: rawReason) else { return }
@@ -446,61 +464,70 @@ class IRAudioManager: NSObject {
         return true
     }
 
-    func renderFrames(_ numberOfFrames: UInt32, ioData: UnsafeMutablePointer<AudioBufferList>?) -> OSStatus {
+    func renderFrames(_ numberOfFrames: UInt32,
+                      ioData: UnsafeMutablePointer<AudioBufferList>?,
+                      hostTime: TimeInterval? = nil) -> OSStatus {
         guard let ioData = ioData else {
             return noErr
         }
+        renderHostTime = hostTime ?? CACurrentMediaTime()
 
         let ioBuffers = UnsafeMutableAudioBufferListPointer(ioData)
 
-        for buffer in ioBuffers {
-            guard let mData = buffer.mData else { continue }
-            memset(mData, 0, Int(buffer.mDataByteSize))
+        guard playing, let delegate = delegate,
+              let outData = _outData, let outputContext = outputContext,
+              let sampleCount = Self.renderSampleCount(numberOfFrames: numberOfFrames,
+                                                       numberOfChannels: numberOfChannels,
+                                                       maximumSampleCount: Self.maxOutputSampleCount) else {
+            Self.zero(ioBuffers)
+            return noErr
+        }
+        let outputChannelCount = numberOfChannels
+        let sampleFormat = Self.outputSampleFormat(formatFlags: outputContext.commonFormat.mFormatFlags,
+                                                   bitsPerChannel: outputContext.commonFormat.mBitsPerChannel)
+
+        // Float hardware with one interleaved buffer takes the samples as they are.
+        if ioBuffers.count == 1,
+           let mData = ioBuffers[0].mData,
+           Self.canRenderDirectly(sampleFormat: sampleFormat,
+                                  bufferChannelCount: ioBuffers[0].mNumberChannels,
+                                  bufferByteSize: ioBuffers[0].mDataByteSize,
+                                  numberOfChannels: outputChannelCount,
+                                  sampleCount: sampleCount) {
+            delegate.audioManager(self, outputData: mData.assumingMemoryBound(to: Float.self), numberOfFrames: numberOfFrames, numberOfChannels: outputChannelCount)
+            return noErr
         }
 
-        if playing, let delegate = delegate {
-            guard let outData = _outData, let outputContext = outputContext else {
-                return noErr
-            }
-
-            let outputChannelCount = numberOfChannels
-            guard let sampleCount = Self.renderSampleCount(numberOfFrames: numberOfFrames,
-                                                           numberOfChannels: outputChannelCount,
-                                                           maximumSampleCount: Self.maxOutputSampleCount) else {
-                return noErr
-            }
+        Self.zero(ioBuffers)
+        delegate.audioManager(self, outputData: outData, numberOfFrames: numberOfFrames, numberOfChannels: outputChannelCount)
 
-            delegate.audioManager(self, outputData: outData, numberOfFrames: numberOfFrames, numberOfChannels: outputChannelCount)
-
-            let numBytesPerSample = outputContext.commonFormat.mBitsPerChannel / 8
-            if numBytesPerSample == 4 {
-                var zero: Float = 0.0
-                for buffer in ioBuffers {
-                    guard let mData = buffer.mData else { continue }
-                    let numChannels = buffer.mNumberChannels
-                    for j in 0..<Int(numChannels) {
-                        vDSP_vsadd(outData + j,
-                                   vDSP_Stride(outputChannelCount),
-                                   &zero,
-                                   mData.assumingMemoryBound(to: Float.self),
-                                   vDSP_Stride(numChannels),
-                                   vDSP_Length(numberOfFrames))
-                    }
-                }
-            } else if numBytesPerSample == 2 {
-                var scale: Float = Float(INT16_MAX)
-                vDSP_vsmul(outData, 1, &scale, outData, 1, vDSP_Length(sampleCount))
-
-                for buffer in ioBuffers {
-                    guard let mData = buffer.mData else { continue }
-                    let numChannels = buffer.mNumberChannels
-                    for j in 0..<Int(numChannels) {
-                        vDSP_vfix16(outData + j,
-                                    vDSP_Stride(outputChannelCount),
-                                    mData.assumingMemoryBound(to: Int16.self) + j,
-                                    vDSP_Stride(numChannels),
-                                    vDSP_Length(numberOfFrames))
-                    }
+        if sampleFormat == .int16 {
+            var scale: Float = Float(INT16_MAX)
+            vDSP_vsmul(outData, 1, &scale, outData, 1, vDSP_Length(sampleCount))
+        }
+        // Buffers take consecutive channels: one buffer per channel when non-interleaved.
+        var channelOffset = 0
+        for buffer in ioBuffers {
+            let numChannels = Int(buffer.mNumberChannels)
+            defer { channelOffset += numChannels }
+            guard let mData = buffer.mData else { continue }
+            for j in 0..<numChannels where channelOffset + j < Int(outputChannelCount) {
+                switch sampleFormat {
+                case .float32:
+                    vDSP_mmov(outData + channelOffset + j,
+                              mData.assumingMemoryBound(to: Float.self) + j,
+                              1,
+                              vDSP_Length(numberOfFrames),
+                              vDSP_Length(outputChannelCount),
+                              vDSP_Length(numChannels))
+                case .int16:
+                    vDSP_vfix16(outData + channelOffset + j,
+                                vDSP_Stride(outputChannelCount),
+                                mData.assumingMemoryBound(to: Int16.self) + j,
+                                vDSP_Stride(numChannels),
+                                vDSP_Length(numberOfFrames))
+                case .unsupported:
+                    break
                 }
             }
         }
@@ -517,6 +544,7 @@ class IRAudioManager: NSObject {
         guard !_playing,
               let graph = outputContext?.graph else { return }
         if registerAudioSession() {
+            reloadOutputLatency()
             let result = AUGraphStart(graph)
             error = checkError(result, domain: "graph start error")
             if error != nil {
@@ -538,6 +566,14 @@ class IRAudioManager: NSObject {
         _playing = false
     }
 
+    private func reloadOutputLatency() {
+        #if os(macOS)
+        outputLatency = 0
+        #else
+        outputLatency = Self.outputLatency(audioSession.outputLatency)
+        #endif
+    }
+
     private func delegateErrorCallback() {
     }
 
@@ -570,6 +606,49 @@ class IRAudioManager: NSObject {
         )
     }
 
+    static func renderHostTime(hostTime: UInt64,
+                               flags: AudioTimeStampFlags,
+                               timebaseNumerator: UInt32,
+                               timebaseDenominator: UInt32) -> TimeInterval? {
+        return IRAudioManagerPolicy.renderHostTime(hostTime: hostTime,
+                                                   flags: flags,
+                                                   timebaseNumerator: timebaseNumerator,
+                                                   timebaseDenominator: timebaseDenominator)
+    }
+
+    static func outputLatency(_ reportedLatency: TimeInterval) -> TimeInterval {
+        return IRAudioManagerPolicy.outputLatency(reportedLatency)
+    }
+
+    static func outputSampleFormat(formatFlags: AudioFormatFlags, bitsPerChannel: UInt32) -> IRAudioOutputSampleFormat {
+        return IRAudioManagerPolicy.outputSampleFormat(formatFlags: formatFlags, bitsPerChannel: bitsPerChannel)
+    }
+
+    static func canRenderDirectly(sampleFormat: IRAudioOutputSampleFormat,
+                                  bufferChannelCount: UInt32,
+                                  bufferByteSize: UInt32,
+                                  numberOfChannels: UInt32,
+                                  sampleCount: Int) -> Bool {
+        return IRAudioManagerPolicy.canRenderDirectly(sampleFormat: sampleFormat,
+                                                      bufferChannelCount: bufferChannelCount,
+                                                      bufferByteSize: bufferByteSize,
+                                                      numberOfChannels: numberOfChannels,
+                                                      sampleCount: sampleCount)
+    }
+
+    private static func zero(_ ioBuffers: UnsafeMutableAudioBufferListPointer) {
+        for buffer in ioBuffers {
+            guard let mData = buffer.mData else { continue }
+            memset(mData, 0, Int(buffer.mDataByteSize))
+        }
+    }
+
+    fileprivate static let hostTimebase: mach_timebase_info_data_t = {
+        var timebase = mach_timebase_info_data_t()
+        mach_timebase_info(&timebase)
+        return timebase
+    }()
+
     private static var maxFrameSize = 4096
     private static let maxChan = 2
     private static var maxOutputSampleCount: Int { maxFrameSize * maxChan }
@@ -593,5 +672,9 @@ private struct IRAudioOutputContext {
 
 private func renderCallback(inRefCon: UnsafeMutableRawPointer, ioActionFlags: UnsafeMutablePointer<AudioUnitRenderActionFlags>, inTimeStamp: UnsafePointer<AudioTimeStamp>, inOutputBusNumber: UInt32, inNumberFrames: UInt32, ioData: UnsafeMutablePointer<AudioBufferList>?) -> OSStatus {
     let audioManager = Unmanaged<IRAudioManager>.fromOpaque(inRefCon).takeUnretainedValue()
-    return audioManager.renderFrames(inNumberFrames, ioData: ioData)
+    let hostTime = IRAudioManager.renderHostTime(hostTime: inTimeStamp.pointee.mHostTime,
+                                                 flags: inTimeStamp.pointee.mFlags,
+                                                 timebaseNumerator: IRAudioManager.hostTimebase.numer,
+                                                 timebaseDenominator: IRAudioManager.hostTimebase.denom)
+    return audioManager.renderFrames(inNumberFrames, ioData: ioData, hostTime: hostTime)
 }
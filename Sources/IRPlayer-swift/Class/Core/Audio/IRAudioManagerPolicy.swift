@@ -56,4 +56,48 @@ enum IRAudioManagerPolicy {
         guard sampleCount <= maximumSampleCount else { return nil }
         return sampleCount
     }
+
+    /// Converts a render timestamp's `mHostTime` to seconds on the
+    /// `CACurrentMediaTime()` base; nil when the timestamp carries no host time.
+    static func renderHostTime(hostTime: UInt64,
+                               flags: AudioTimeStampFlags,
+                               timebaseNumerator: UInt32,
+                               timebaseDenominator: UInt32) -> TimeInterval? {
+        guard flags.contains(.hostTimeValid), timebaseDenominator > 0 else { return nil }
+        return Double(hostTime) * Double(timebaseNumerator) / Double(timebaseDenominator) / 1_000_000_000
+    }
+
+    /// Output latency reported by the session; negative or non-finite values count as 0.
+    static func outputLatency(_ reportedLatency: TimeInterval) -> TimeInterval {
+        guard reportedLatency.isFinite, reportedLatency > 0 else { return 0 }
+        return reportedLatency
+    }
+
+    static func outputSampleFormat(formatFlags: AudioFormatFlags, bitsPerChannel: UInt32) -> IRAudioOutputSampleFormat {
+        switch bitsPerChannel {
+        case 32 where formatFlags & kAudioFormatFlagIsSignedInteger == 0:
+            return .float32
+        case 16 where formatFlags & kAudioFormatFlagIsFloat == 0:
+            return .int16
+        default:
+            return .unsupported
+        }
+    }
+
+    /// True when the delegate can render into the hardware buffer itself: Float32 with
+    /// the same interleaved channel count and room for every sample.
+    static func canRenderDirectly(sampleFormat: IRAudioOutputSampleFormat,
+                                  bufferChannelCount: UInt32,
+                                  bufferByteSize: UInt32,
+                                  numberOfChannels: UInt32,
+                                  sampleCount: Int) -> Bool {
+        guard sampleFormat == .float32,
+              numberOfChannels > 0,
+              bufferChannelCount == numberOfChannels,
+              sampleCount > 0 else {
+            return false
+        }
+        let (byteCount, overflow) = sampleCount.multipliedReportingOverflow(by: MemoryLayout<Float>.size)
+        return !overflow && byteCount <= Int(bufferByteSize)
+    }
 }
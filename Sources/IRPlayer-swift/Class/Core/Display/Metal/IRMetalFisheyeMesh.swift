@@ -15,12 +15,26 @@ final class IRMetalFisheyeMesh {
         let texCoord: SIMD2<Float>
     }
 
+    /// What a shared mesh was built from; meshes are shared per device.
+    private enum Source: Hashable {
+        case sphere(IRGLSphereMeshKey)
+        case vr
+    }
+
+    private struct SharedKey: Hashable {
+        let device: ObjectIdentifier
+        let source: Source
+    }
+
+    private static let cache = IRGLSharedMeshCache<SharedKey, IRMetalFisheyeMesh>()
+
     let vertexBuffer: MTLBuffer
     let indexBuffer: MTLBuffer
     let indexCount: Int
+    let indexType: MTLIndexType
 
-    init?(device: MTLDevice, positions: [SIMD3<Float>], texcoords: [SIMD2<Float>], indices: [UInt16]) {
-        guard positions.count == texcoords.count, !positions.isEmpty, !indices.isEmpty else { return nil }
+    init?(device: MTLDevice, positions: [SIMD3<Float>], texcoords: [SIMD2<Float>], indices: IRGLSphereMeshIndices) {
+        guard positions.count == texcoords.count, !positions.isEmpty, indices.count > 0 else { return nil }
 
         var vertices = [Vertex]()
         vertices.reserveCapacity(positions.count)
@@ -29,87 +43,79 @@ final class IRMetalFisheyeMesh {
         }
 
         guard let vertexLength = Self.bufferByteLength(elementCount: vertices.count, stride: MemoryLayout<Vertex>.stride),
-              let indexLength = Self.bufferByteLength(elementCount: indices.count, stride: MemoryLayout<UInt16>.stride) else { return nil }
+              let indexLength = Self.bufferByteLength(elementCount: indices.count, stride: indices.bytesPerIndex) else { return nil }
 
         guard let vBuffer = device.makeBuffer(bytes: vertices, length: vertexLength, options: .storageModeShared) else { return nil }
-        guard let iBuffer = device.makeBuffer(bytes: indices, length: indexLength, options: .storageModeShared) else { return nil }
+        guard let iBuffer = indices.withUnsafeBytes({ bytes in
+            bytes.baseAddress.flatMap { device.makeBuffer(bytes: $0, length: indexLength, options: .storageModeShared) }
+        }) else { return nil }
 
         vertexBuffer = vBuffer
         indexBuffer = iBuffer
         indexCount = indices.count
+        switch indices {
+        case .uint16: indexType = .uint16
+        case .uint32: indexType = .uint32
+        }
     }
 
-    init?(device: MTLDevice, textureWidth: Float, textureHeight: Float, centerX: Float, centerY: Float, radius: Float) {
-        let (tw, th, cx, cy, cr) = IRMetalFisheyeMesh.resolveParams(textureWidth: textureWidth, textureHeight: textureHeight, centerX: centerX, centerY: centerY, radius: radius)
-        guard tw > 0, th > 0, cr > 0 else { return nil }
-
-        let slices = 180
-        let iMax = slices + 1
-        let nVertices = iMax * iMax
-        let angleStep: Float = .pi / Float(slices)
-        let sphereRadius: Float = 800.0
-
-        var positions = [SIMD3<Float>](repeating: .zero, count: nVertices)
-        var texcoords = [SIMD2<Float>](repeating: .zero, count: nVertices)
-
-        for i in 0..<iMax {
-            let sini = sin(angleStep * Float(i))
-            let cosi = cos(angleStep * Float(i))
-            for j in 0..<iMax {
-                let sinj = sin(angleStep * Float(j))
-                let cosj = cos(angleStep * Float(j))
-                let sinisinj = sinj * sini
-                let sinicosj = cosj * sini
-
-                let vertexIndex = i * iMax + j
-                let texIndex = i * iMax + (iMax - j - 1)
-
-                let x = sphereRadius * sinisinj
-                let y = sphereRadius * sinicosj
-                let z = sphereRadius * cosi
-
-                let u = (cx - cr * sinicosj) / tw
-                let v = (cr * cosi - cy) / th
-
-                positions[vertexIndex] = SIMD3<Float>(x, y, z)
-                texcoords[texIndex] = SIMD2<Float>(u, v)
-            }
-        }
+    convenience init?(device: MTLDevice, positions: [SIMD3<Float>], texcoords: [SIMD2<Float>], indices: [UInt16]) {
+        self.init(device: device, positions: positions, texcoords: texcoords, indices: .uint16(indices))
+    }
 
-        var vertices = [Vertex]()
-        vertices.reserveCapacity(nVertices)
-        for index in 0..<nVertices {
-            vertices.append(Vertex(position: positions[index], texCoord: texcoords[index]))
-        }
+    convenience init?(device: MTLDevice, sphere: IRGLSphereMesh) {
+        self.init(device: device, positions: sphere.positions, texcoords: sphere.texcoords, indices: sphere.indices)
+    }
 
-        var indices = [UInt16]()
-        indices.reserveCapacity(slices * slices * 6)
-        for i in 0..<slices {
-            let i1 = i + 1
-            for j in 0..<slices {
-                let j1 = j + 1
-                guard let first = Self.indexValue(i * iMax + j),
-                      let second = Self.indexValue(i1 * iMax + j),
-                      let third = Self.indexValue(i1 * iMax + j1),
-                      let fourth = Self.indexValue(i * iMax + j1) else { return nil }
-                indices.append(first)
-                indices.append(second)
-                indices.append(third)
-                indices.append(first)
-                indices.append(third)
-                indices.append(fourth)
-            }
-        }
+    convenience init?(device: MTLDevice,
+                      textureWidth: Float,
+                      textureHeight: Float,
+                      centerX: Float,
+                      centerY: Float,
+                      radius: Float,
+                      slices: Int = SPHERE_SLICES) {
+        guard let key = IRGLSphereMeshKey(slices: slices,
+                                          textureWidth: textureWidth,
+                                          textureHeight: textureHeight,
+                                          centerX: centerX,
+                                          centerY: centerY,
+                                          radius: radius),
+              let sphere = IRGLSphereMesh.shared(for: key) else { return nil }
+        self.init(device: device, sphere: sphere)
+    }
 
-        guard let vertexLength = Self.bufferByteLength(elementCount: vertices.count, stride: MemoryLayout<Vertex>.stride),
-              let indexLength = Self.bufferByteLength(elementCount: indices.count, stride: MemoryLayout<UInt16>.stride) else { return nil }
+    /// The mesh shared by every view drawing `key` on `device`, or nil while it is
+    /// built in the background; `completion` runs once it is available.
+    static func shared(device: MTLDevice,
+                       key: IRGLSphereMeshKey,
+                       completion: @escaping (IRMetalFisheyeMesh?) -> Void) -> IRMetalFisheyeMesh? {
+        return cache.valueIfReady(for: SharedKey(device: ObjectIdentifier(device), source: .sphere(key)),
+                                  build: {
+                                      IRGLSphereMesh.shared(for: key).flatMap { IRMetalFisheyeMesh(device: device, sphere: $0) }
+                                  },
+                                  completion: completion)
+    }
 
-        guard let vBuffer = device.makeBuffer(bytes: vertices, length: vertexLength, options: .storageModeShared) else { return nil }
-        guard let iBuffer = device.makeBuffer(bytes: indices, length: indexLength, options: .storageModeShared) else { return nil }
+    /// Drops shared meshes no view holds any more, and the spheres they were built from.
+    static func purgeUnused() {
+        cache.purgeUnused()
+        IRGLSphereMesh.cache.purgeUnused()
+    }
 
-        vertexBuffer = vBuffer
-        indexBuffer = iBuffer
-        indexCount = indices.count
+    /// The VR sphere shared by every VR view on `device`; see `shared(device:key:completion:)`.
+    static func sharedVR(device: MTLDevice,
+                         projection: IRGLProjectionVR,
+                         completion: @escaping (IRMetalFisheyeMesh?) -> Void) -> IRMetalFisheyeMesh? {
+        return cache.valueIfReady(for: SharedKey(device: ObjectIdentifier(device), source: .vr),
+                                  build: {
+                                      projection.exportMesh().flatMap {
+                                          IRMetalFisheyeMesh(device: device,
+                                                             positions: $0.positions,
+                                                             texcoords: $0.texcoords,
+                                                             indices: $0.indices)
+                                      }
+                                  },
+                                  completion: completion)
     }
 
     static func resolveParams(textureWidth: Float, textureHeight: Float, centerX: Float, centerY: Float, radius: Float) -> (textureWidth: Float, textureHeight: Float, centerX: Float, centerY: Float, radius: Float) {
@@ -123,8 +129,4 @@ final class IRMetalFisheyeMesh {
     static func bufferByteLength(elementCount: Int, stride: Int) -> Int? {
         IRMetalFisheyeMeshPolicy.bufferByteLength(elementCount: elementCount, stride: stride)
     }
-
-    static func indexValue(_ value: Int) -> UInt16? {
-        IRMetalFisheyeMeshPolicy.indexValue(value)
-    }
 }
@@ -38,9 +38,4 @@ enum IRMetalFisheyeMeshPolicy {
 
         return byteLength
     }
-
-    static func indexValue(_ value: Int) -> UInt16? {
-        guard value >= 0, value <= Int(UInt16.max) else { return nil }
-        return UInt16(value)
-    }
 }
@@ -18,13 +18,14 @@ protocol IRMetalPixelRenderer {
                     frame: IRFFVideoFrame,
                     encoder: MTLRenderCommandEncoder,
                     indexCount: Int,
+                    indexType: MTLIndexType,
                     indexBuffer: MTLBuffer) -> Bool
 
     func renderFish2Pano(renderer: IRMetalRenderer,
                          frame: IRFFVideoFrame,
                          encoder: MTLRenderCommandEncoder,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture]) -> Bool
+                         texUVTexture: MTLTexture?) -> Bool
 }
 
 final class IRMetalPixelRendererNV12: IRMetalPixelRenderer {
@@ -42,20 +43,21 @@ final class IRMetalPixelRendererNV12: IRMetalPixelRenderer {
                     frame: IRFFVideoFrame,
                     encoder: MTLRenderCommandEncoder,
                     indexCount: Int,
+                    indexType: MTLIndexType,
                     indexBuffer: MTLBuffer) -> Bool {
         guard let cvFrame = frame as? IRFFCVYUVVideoFrame else { return false }
-        if renderer.renderNV12Mesh(cvFrame: cvFrame, encoder: encoder, indexCount: indexCount, indexBuffer: indexBuffer) {
+        if renderer.renderNV12Mesh(cvFrame: cvFrame, encoder: encoder, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer) {
             return true
         }
-        return renderer.renderBGRAMesh(cvFrame: cvFrame, encoder: encoder, indexCount: indexCount, indexBuffer: indexBuffer)
+        return renderer.renderBGRAMesh(cvFrame: cvFrame, encoder: encoder, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer)
     }
 
     func renderFish2Pano(renderer: IRMetalRenderer,
                          frame: IRFFVideoFrame,
                          encoder: MTLRenderCommandEncoder,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture]) -> Bool {
-        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVTextureCount: texUVTextures.count) else { return false }
+                         texUVTexture: MTLTexture?) -> Bool {
+        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVSliceCount: texUVTexture?.arrayLength ?? 0) else { return false }
         guard let cvFrame = frame as? IRFFCVYUVVideoFrame else { return false }
         if let pipeline = renderer.pipelineNV12Fish2Pano, let textures = renderer.makeNV12Textures(from: cvFrame) {
             var fishParams = params
@@ -63,14 +65,7 @@ final class IRMetalPixelRendererNV12: IRMetalPixelRenderer {
             encoder.setFragmentBytes(&fishParams, length: MemoryLayout<IRMetalRenderer.Fish2PanoParams>.size, index: 0)
             encoder.setFragmentTexture(textures.y, index: 0)
             encoder.setFragmentTexture(textures.uv, index: 1)
-            for i in 0..<9 {
-                let textureIndex = i + 4
-                if i < texUVTextures.count {
-                    encoder.setFragmentTexture(texUVTextures[i], index: textureIndex)
-                } else {
-                    encoder.setFragmentTexture(nil, index: textureIndex)
-                }
-            }
+            encoder.setFragmentTexture(texUVTexture, index: 4)
             encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
             return true
         }
@@ -80,14 +75,7 @@ final class IRMetalPixelRendererNV12: IRMetalPixelRenderer {
             encoder.setRenderPipelineState(pipeline)
             encoder.setFragmentBytes(&fishParams, length: MemoryLayout<IRMetalRenderer.Fish2PanoParams>.size, index: 0)
             encoder.setFragmentTexture(texture, index: 0)
-            for i in 0..<9 {
-                let textureIndex = i + 4
-                if i < texUVTextures.count {
-                    encoder.setFragmentTexture(texUVTextures[i], index: textureIndex)
-                } else {
-                    encoder.setFragmentTexture(nil, index: textureIndex)
-                }
-            }
+            encoder.setFragmentTexture(texUVTexture, index: 4)
             encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
             return true
         }
@@ -108,17 +96,18 @@ final class IRMetalPixelRendererI420: IRMetalPixelRenderer {
                     frame: IRFFVideoFrame,
                     encoder: MTLRenderCommandEncoder,
                     indexCount: Int,
+                    indexType: MTLIndexType,
                     indexBuffer: MTLBuffer) -> Bool {
         guard let yuvFrame = frame as? IRFFAVYUVVideoFrame else { return false }
-        return renderer.renderI420Mesh(yuvFrame: yuvFrame, encoder: encoder, indexCount: indexCount, indexBuffer: indexBuffer)
+        return renderer.renderI420Mesh(yuvFrame: yuvFrame, encoder: encoder, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer)
     }
 
     func renderFish2Pano(renderer: IRMetalRenderer,
                          frame: IRFFVideoFrame,
                          encoder: MTLRenderCommandEncoder,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture]) -> Bool {
-        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVTextureCount: texUVTextures.count) else { return false }
+                         texUVTexture: MTLTexture?) -> Bool {
+        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVSliceCount: texUVTexture?.arrayLength ?? 0) else { return false }
         guard let yuvFrame = frame as? IRFFAVYUVVideoFrame else { return false }
         if let pipeline = renderer.pipelineI420Fish2Pano, let textures = renderer.makeI420Textures(from: yuvFrame) {
             var fishParams = params
@@ -127,14 +116,7 @@ final class IRMetalPixelRendererI420: IRMetalPixelRenderer {
             encoder.setFragmentTexture(textures.y, index: 0)
             encoder.setFragmentTexture(textures.u, index: 1)
             encoder.setFragmentTexture(textures.v, index: 2)
-            for i in 0..<9 {
-                let textureIndex = i + 4
-                if i < texUVTextures.count {
-                    encoder.setFragmentTexture(texUVTextures[i], index: textureIndex)
-                } else {
-                    encoder.setFragmentTexture(nil, index: textureIndex)
-                }
-            }
+            encoder.setFragmentTexture(texUVTexture, index: 4)
             encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
             return true
         }
@@ -154,6 +136,7 @@ final class IRMetalPixelRendererRGB: IRMetalPixelRenderer {
                     frame: IRFFVideoFrame,
                     encoder: MTLRenderCommandEncoder,
                     indexCount: Int,
+                    indexType: MTLIndexType,
                     indexBuffer: MTLBuffer) -> Bool {
         // RGB mesh rendering is unsupported.
         return false
@@ -163,22 +146,15 @@ final class IRMetalPixelRendererRGB: IRMetalPixelRenderer {
                          frame: IRFFVideoFrame,
                          encoder: MTLRenderCommandEncoder,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture]) -> Bool {
-        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVTextureCount: texUVTextures.count) else { return false }
+                         texUVTexture: MTLTexture?) -> Bool {
+        guard IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVSliceCount: texUVTexture?.arrayLength ?? 0) else { return false }
         guard let rgbFrame = frame as? IRVideoFrameRGB else { return false }
         if let pipeline = renderer.pipelineRGBFish2Pano, let texture = renderer.makeRGBTexture(from: rgbFrame) {
             var fishParams = params
             encoder.setRenderPipelineState(pipeline)
             encoder.setFragmentBytes(&fishParams, length: MemoryLayout<IRMetalRenderer.Fish2PanoParams>.size, index: 0)
             encoder.setFragmentTexture(texture, index: 0)
-            for i in 0..<9 {
-                let textureIndex = i + 4
-                if i < texUVTextures.count {
-                    encoder.setFragmentTexture(texUVTextures[i], index: textureIndex)
-                } else {
-                    encoder.setFragmentTexture(nil, index: textureIndex)
-                }
-            }
+            encoder.setFragmentTexture(texUVTexture, index: 4)
             encoder.drawPrimitives(type: .triangleStrip, vertexStart: 0, vertexCount: 4)
             return true
         }
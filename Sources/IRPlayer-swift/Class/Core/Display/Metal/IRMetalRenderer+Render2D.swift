@@ -19,7 +19,7 @@ extension IRMetalRenderer {
                 drawableSize: CGSize,
                 zoomScale: Float,
                 translation: SIMD2<Float>) -> Bool {
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return false }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return false }
 
@@ -38,7 +38,7 @@ extension IRMetalRenderer {
             if pixelRenderer.render2D(renderer: self, frame: frame, encoder: encoder) {
                 encoder.endEncoding()
                 commandBuffer.present(drawable)
-                commandBuffer.commit()
+                commitFrame(commandBuffer)
                 return true
             }
         }
@@ -55,7 +55,7 @@ extension IRMetalRenderer {
                      zoomScales: [Float],
                      translations: [SIMD2<Float>]) -> Bool {
         guard !viewports.isEmpty, viewports.count == contentModes.count else { return false }
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return false }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return false }
 
@@ -86,18 +86,18 @@ extension IRMetalRenderer {
         encoder.endEncoding()
         if didRender {
             commandBuffer.present(drawable)
-            commandBuffer.commit()
+            commitFrame(commandBuffer)
         }
         return didRender
     }
 
     func renderClear(to drawable: CAMetalDrawable) {
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return }
         encoder.endEncoding()
         commandBuffer.present(drawable)
-        commandBuffer.commit()
+        commitFrame(commandBuffer)
     }
 
 }
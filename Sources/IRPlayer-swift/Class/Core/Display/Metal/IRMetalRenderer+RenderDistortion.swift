@@ -19,7 +19,7 @@ extension IRMetalRenderer {
                           to drawable: CAMetalDrawable,
                           drawableSize: CGSize,
                           contentMode: IRGLRenderContentMode) -> Bool {
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let offscreen = makeDistortionOffscreenTexture(size: drawableSize) else { return false }
 
         let offscreenPass = MTLRenderPassDescriptor()
@@ -94,7 +94,7 @@ extension IRMetalRenderer {
 
         encoder.endEncoding()
         commandBuffer.present(drawable)
-        commandBuffer.commit()
+        commitFrame(commandBuffer)
         return true
     }
 
@@ -15,7 +15,7 @@ extension IRMetalRenderer {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -23,8 +23,8 @@ extension IRMetalRenderer {
                          outputSize: CGSize,
                          zoomScale: Float,
                          translation: SIMD2<Float>) -> Bool {
-        guard Self.fish2PanoInputsAreValid(params: params, texUVTextureCount: texUVTextures.count) else { return false }
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard Self.fish2PanoInputsAreValid(params: params, texUVSliceCount: texUVTexture?.arrayLength ?? 0) else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return false }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return false }
 
@@ -44,14 +44,7 @@ extension IRMetalRenderer {
         var fishParams = params
         encoder.setFragmentBytes(&fishParams, length: MemoryLayout<Fish2PanoParams>.size, index: 0)
 
-        for i in 0..<9 {
-            let textureIndex = i + 4
-            if i < texUVTextures.count {
-                encoder.setFragmentTexture(texUVTextures[i], index: textureIndex)
-            } else {
-                encoder.setFragmentTexture(nil as MTLTexture?, index: textureIndex)
-            }
-        }
+        encoder.setFragmentTexture(texUVTexture, index: 4)
 
         var didRender = false
         if let pixelRenderer = pixelRenderer(for: frame) {
@@ -59,13 +52,13 @@ extension IRMetalRenderer {
                                                       frame: frame,
                                                       encoder: encoder,
                                                       params: fishParams,
-                                                      texUVTextures: texUVTextures)
+                                                      texUVTexture: texUVTexture)
         }
 
         encoder.endEncoding()
         if didRender {
             commandBuffer.present(drawable)
-            commandBuffer.commit()
+            commitFrame(commandBuffer)
         }
         return didRender
     }
@@ -20,7 +20,7 @@ extension IRMetalRenderer {
                        to drawable: CAMetalDrawable,
                        drawableSize: CGSize,
                        viewport: CGRect) -> Bool {
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return false }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return false }
 
@@ -39,13 +39,14 @@ extension IRMetalRenderer {
                                                  frame: frame,
                                                  encoder: encoder,
                                                  indexCount: mesh.indexCount,
+                                                 indexType: mesh.indexType,
                                                  indexBuffer: mesh.indexBuffer)
         }
 
         encoder.endEncoding()
         if didRender {
             commandBuffer.present(drawable)
-            commandBuffer.commit()
+            commitFrame(commandBuffer)
         }
         return didRender
     }
@@ -58,7 +59,7 @@ extension IRMetalRenderer {
                             drawableSize: CGSize,
                             viewports: [CGRect]) -> Bool {
         guard !viewports.isEmpty, viewports.count == mvpList.count else { return false }
-        guard let commandBuffer = commandQueue.makeCommandBuffer() else { return false }
+        guard let commandBuffer = makeFrameCommandBuffer() else { return false }
         guard let renderPass = currentRenderPassDescriptor(drawable: drawable) else { return false }
         guard let encoder = commandBuffer.makeRenderCommandEncoder(descriptor: renderPass) else { return false }
 
@@ -79,6 +80,7 @@ extension IRMetalRenderer {
                                              frame: frame,
                                              encoder: encoder,
                                              indexCount: mesh.indexCount,
+                                             indexType: mesh.indexType,
                                              indexBuffer: mesh.indexBuffer) {
                     encoder.endEncoding()
                     return false
@@ -90,7 +92,7 @@ extension IRMetalRenderer {
         encoder.endEncoding()
         if didRender {
             commandBuffer.present(drawable)
-            commandBuffer.commit()
+            commitFrame(commandBuffer)
         }
         return didRender
     }
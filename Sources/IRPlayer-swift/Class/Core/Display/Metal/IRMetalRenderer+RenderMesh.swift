@@ -16,31 +16,34 @@ extension IRMetalRenderer {
     func renderNV12Mesh(cvFrame: IRFFCVYUVVideoFrame,
                                 encoder: MTLRenderCommandEncoder,
                                 indexCount: Int,
+                                indexType: MTLIndexType,
                                 indexBuffer: MTLBuffer) -> Bool {
         guard let pipeline = pipelineNV12Mesh else { return false }
         guard let textures = makeNV12Textures(from: cvFrame) else { return false }
         encoder.setRenderPipelineState(pipeline)
         encoder.setFragmentTexture(textures.y, index: 0)
         encoder.setFragmentTexture(textures.uv, index: 1)
-        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: .uint16, indexBuffer: indexBuffer, indexBufferOffset: 0)
+        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer, indexBufferOffset: 0)
         return true
     }
 
     func renderBGRAMesh(cvFrame: IRFFCVYUVVideoFrame,
                                 encoder: MTLRenderCommandEncoder,
                                 indexCount: Int,
+                                indexType: MTLIndexType,
                                 indexBuffer: MTLBuffer) -> Bool {
         guard let pipeline = pipelineRGBMesh else { return false }
         guard let texture = makeBGRATexture(from: cvFrame) else { return false }
         encoder.setRenderPipelineState(pipeline)
         encoder.setFragmentTexture(texture, index: 0)
-        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: .uint16, indexBuffer: indexBuffer, indexBufferOffset: 0)
+        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer, indexBufferOffset: 0)
         return true
     }
 
     func renderI420Mesh(yuvFrame: IRFFAVYUVVideoFrame,
                                 encoder: MTLRenderCommandEncoder,
                                 indexCount: Int,
+                                indexType: MTLIndexType,
                                 indexBuffer: MTLBuffer) -> Bool {
         guard let pipeline = pipelineI420Mesh else { return false }
         guard let textures = makeI420Textures(from: yuvFrame) else { return false }
@@ -48,7 +51,7 @@ extension IRMetalRenderer {
         encoder.setFragmentTexture(textures.y, index: 0)
         encoder.setFragmentTexture(textures.u, index: 1)
         encoder.setFragmentTexture(textures.v, index: 2)
-        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: .uint16, indexBuffer: indexBuffer, indexBufferOffset: 0)
+        encoder.drawIndexedPrimitives(type: .triangle, indexCount: indexCount, indexType: indexType, indexBuffer: indexBuffer, indexBufferOffset: 0)
         return true
     }
 
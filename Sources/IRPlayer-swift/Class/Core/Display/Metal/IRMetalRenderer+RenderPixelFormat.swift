@@ -63,9 +63,9 @@ extension IRMetalRenderer {
         let height = yuvFrame.height
         guard width > 0, height > 0 else { return false }
 
-        let yTexture = makeTexture(width: width, height: height, pixelFormat: .r8Unorm, bytes: yPtr)
-        let uTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: uPtr)
-        let vTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: vPtr)
+        let yTexture = makeTexture(width: width, height: height, pixelFormat: .r8Unorm, bytes: yPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .luma))
+        let uTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: uPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .chromaB))
+        let vTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: vPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .chromaR))
         guard let yTexture, let uTexture, let vTexture else { return false }
 
         encoder.setRenderPipelineState(pipeline)
@@ -125,9 +125,9 @@ extension IRMetalRenderer {
         let height = yuvFrame.height
         guard width > 0, height > 0 else { return nil }
 
-        guard let yTexture = makeTexture(width: width, height: height, pixelFormat: .r8Unorm, bytes: yPtr) else { return nil }
-        guard let uTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: uPtr) else { return nil }
-        guard let vTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: vPtr) else { return nil }
+        guard let yTexture = makeTexture(width: width, height: height, pixelFormat: .r8Unorm, bytes: yPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .luma)) else { return nil }
+        guard let uTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: uPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .chromaB)) else { return nil }
+        guard let vTexture = makeTexture(width: width / 2, height: height / 2, pixelFormat: .r8Unorm, bytes: vPtr, bytesPerRow: yuvFrame.bytesPerRow(for: .chromaR)) else { return nil }
         return (y: yTexture, u: uTexture, v: vTexture)
     }
 
@@ -142,9 +142,7 @@ extension IRMetalRenderer {
             byteCount: rgbFrame.rgb.count
         ) else { return nil }
 
-        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .bgra8Unorm, width: width, height: height, mipmapped: false)
-        descriptor.usage = .shaderRead
-        guard let texture = device.makeTexture(descriptor: descriptor) else { return nil }
+        guard let texture = texturePool.texture(width: width, height: height, pixelFormat: .bgra8Unorm) else { return nil }
 
         rgbFrame.rgb.withUnsafeBytes { rawBuffer in
             if let base = rawBuffer.baseAddress {
@@ -162,12 +160,15 @@ extension IRMetalRenderer {
                                                           byteCount: byteCount)
     }
 
-    func makeTexture(width: Int, height: Int, pixelFormat: MTLPixelFormat, bytes: UnsafeRawPointer) -> MTLTexture? {
-        guard width > 0, height > 0 else { return nil }
-        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: pixelFormat, width: width, height: height, mipmapped: false)
-        descriptor.usage = .shaderRead
-        guard let texture = device.makeTexture(descriptor: descriptor) else { return nil }
-        let bytesPerRow = width
+    static func planeBytesPerRow(width: Int, height: Int, stride: Int?) -> Int? {
+        IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: width, height: height, stride: stride)
+    }
+
+    /// Uploads a single-byte plane into a pooled texture. `bytesPerRow` is the source
+    /// stride; nil means the rows are packed.
+    func makeTexture(width: Int, height: Int, pixelFormat: MTLPixelFormat, bytes: UnsafeRawPointer, bytesPerRow stride: Int? = nil) -> MTLTexture? {
+        guard let bytesPerRow = Self.planeBytesPerRow(width: width, height: height, stride: stride) else { return nil }
+        guard let texture = texturePool.texture(width: width, height: height, pixelFormat: pixelFormat) else { return nil }
         texture.replace(region: MTLRegionMake2D(0, 0, width, height), mipmapLevel: 0, withBytes: bytes, bytesPerRow: bytesPerRow)
         return texture
     }
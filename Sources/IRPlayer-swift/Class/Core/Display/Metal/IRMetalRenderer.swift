@@ -49,14 +49,15 @@ final class IRMetalRenderer {
         var _padding: SIMD2<Float> = .zero
     }
 
-    static func fish2PanoInputsAreValid(params: Fish2PanoParams, texUVTextureCount: Int) -> Bool {
+    static func fish2PanoInputsAreValid(params: Fish2PanoParams, texUVSliceCount: Int) -> Bool {
         return IRMetalRendererFish2PanoPolicy.inputsAreValid(params: params,
-                                                             texUVTextureCount: texUVTextureCount)
+                                                             texUVSliceCount: texUVSliceCount)
     }
 
     let device: MTLDevice
     let commandQueue: MTLCommandQueue
     var textureCache: CVMetalTextureCache?
+    let texturePool: IRMetalTexturePool
     var pipelineNV12: MTLRenderPipelineState?
     var pipelineI420: MTLRenderPipelineState?
     var pipelineRGB: MTLRenderPipelineState?
@@ -130,6 +131,7 @@ final class IRMetalRenderer {
             return nil
         }
         self.commandQueue = queue
+        self.texturePool = IRMetalTexturePool(device: device)
         if CVMetalTextureCacheCreate(kCFAllocatorDefault, nil, device, nil, &textureCache) != kCVReturnSuccess {
             textureCache = nil
         }
@@ -292,6 +294,17 @@ final class IRMetalRenderer {
         vertexBufferRight = device.makeBuffer(bytes: rightVertices, length: MemoryLayout<QuadVertex>.stride * rightVertices.count, options: .storageModeShared)
     }
 
+    /// Starts a frame whose upload textures come from `texturePool`; pair with
+    /// `commitFrame(_:)` so they are recycled when the GPU finishes.
+    func makeFrameCommandBuffer() -> MTLCommandBuffer? {
+        texturePool.beginFrame()
+        return commandQueue.makeCommandBuffer()
+    }
+
+    func commitFrame(_ commandBuffer: MTLCommandBuffer) {
+        texturePool.commit(commandBuffer)
+    }
+
     func currentRenderPassDescriptor(drawable: CAMetalDrawable) -> MTLRenderPassDescriptor? {
         let descriptor = MTLRenderPassDescriptor()
         descriptor.colorAttachments[0].texture = drawable.texture
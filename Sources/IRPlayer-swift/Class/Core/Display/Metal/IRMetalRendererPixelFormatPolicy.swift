@@ -17,28 +17,38 @@ enum IRMetalRendererPixelFormatPolicy {
 
         return (bytesPerRow: expectedBytesPerRow, totalByteCount: totalByteCount)
     }
+
+    /// Row pitch for a single-byte plane upload. A nil stride means a packed plane;
+    /// a padded stride is uploaded as-is so the plane never has to be repacked.
+    static func planeBytesPerRow(width: Int, height: Int, stride: Int?) -> Int? {
+        guard width > 0, height > 0 else { return nil }
+        let bytesPerRow = stride ?? width
+        guard bytesPerRow >= width else { return nil }
+        let (_, overflow) = bytesPerRow.multipliedReportingOverflow(by: height)
+        return overflow ? nil : bytesPerRow
+    }
 }
 
 enum IRMetalRendererFish2PanoPolicy {
-    static func inputsAreValid(params: IRMetalRenderer.Fish2PanoParams, texUVTextureCount: Int) -> Bool {
+    static func inputsAreValid(params: IRMetalRenderer.Fish2PanoParams, texUVSliceCount: Int) -> Bool {
         guard params.fishwidth > 0,
               params.fishheight > 0,
               params.panowidth > 0,
               params.panoheight > 0,
               params.antialias > 0,
               params.offsetX.isFinite,
-              texUVTextureCount > 0 else {
+              texUVSliceCount > 0 else {
             return false
         }
 
         let antialias = Int(params.antialias)
-        let (requiredTextureCount, overflow) = antialias.multipliedReportingOverflow(by: antialias)
+        let (requiredSliceCount, overflow) = antialias.multipliedReportingOverflow(by: antialias)
         guard !overflow,
-              requiredTextureCount > 0,
-              requiredTextureCount <= 9 else {
+              requiredSliceCount > 0,
+              requiredSliceCount <= 9 else {
             return false
         }
 
-        return texUVTextureCount == requiredTextureCount
+        return texUVSliceCount == requiredSliceCount
     }
 }
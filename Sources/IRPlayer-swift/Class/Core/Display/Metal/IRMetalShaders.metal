@@ -80,20 +80,24 @@ vertex VertexOut irVertex3D(VertexIn3D in [[stage_in]],
     return out;
 }
 
-inline float2 sampleTexUV(int idx,
-                          float2 uv,
-                          array<texture2d<float, access::sample>, 9> texUV,
-                          sampler s) {
-    idx = clamp(idx, 0, 8);
-    float2 uvPixel = texUV[idx].sample(s, uv).rg;
-    return uvPixel;
+// texUV holds one rg16Unorm slice per antialias sample: the fisheye coordinate
+// normalised to the fisheye texture, or 1.0 for samples outside the fisheye.
+// Sampled nearest so an outside sample never blends into its neighbours.
+inline bool sampleTexUV(int idx,
+                        float2 uv,
+                        texture2d_array<float, access::sample> texUV,
+                        thread float2 &fishUV) {
+    constexpr sampler nearest(address::clamp_to_edge, filter::nearest);
+    idx = clamp(idx, 0, int(texUV.get_array_size()) - 1);
+    fishUV = texUV.sample(nearest, uv, uint(idx)).rg;
+    return fishUV.x < 1.0 && fishUV.y < 1.0;
 }
 
 fragment float4 irFragmentFish2PanoNV12(VertexOut in [[stage_in]],
                                         constant Fish2PanoParams &params [[buffer(0)]],
                                         texture2d<float, access::sample> yTex [[texture(0)]],
                                         texture2d<float, access::sample> uvTex [[texture(1)]],
-                                        array<texture2d<float, access::sample>, 9> texUV [[texture(4)]]) {
+                                        texture2d_array<float, access::sample> texUV [[texture(4)]]) {
     constexpr sampler s(address::clamp_to_edge, filter::linear);
     if (params.antialias <= 0 || params.panowidth <= 0 || params.panoheight <= 0) {
         return float4(0.0, 0.0, 0.0, 1.0);
@@ -109,13 +113,10 @@ fragment float4 irFragmentFish2PanoNV12(VertexOut in [[stage_in]],
     for (int ai = 0; ai < params.antialias; ai++) {
         for (int aj = 0; aj < params.antialias; aj++) {
             int aa = ai * params.antialias + aj;
-            float2 uvPixel = sampleTexUV(aa, baseUV, texUV, s);
-            float u = uvPixel.x;
-            float v = uvPixel.y;
-            if (u < 0.0 || u > float(params.fishwidth) || v < 0.0 || v > float(params.fishheight)) {
+            float2 fishUV;
+            if (!sampleTexUV(aa, baseUV, texUV, fishUV)) {
                 continue;
             }
-            float2 fishUV = float2(u / float(params.fishwidth), v / float(params.fishheight));
             float y = yTex.sample(s, fishUV).r - (16.0 / 255.0);
             float2 uv = uvTex.sample(s, fishUV).rg - float2(0.5, 0.5);
             float r = y + 1.402 * uv.y;
@@ -137,7 +138,7 @@ fragment float4 irFragmentFish2PanoI420(VertexOut in [[stage_in]],
                                         texture2d<float, access::sample> yTex [[texture(0)]],
                                         texture2d<float, access::sample> uTex [[texture(1)]],
                                         texture2d<float, access::sample> vTex [[texture(2)]],
-                                        array<texture2d<float, access::sample>, 9> texUV [[texture(4)]]) {
+                                        texture2d_array<float, access::sample> texUV [[texture(4)]]) {
     constexpr sampler s(address::clamp_to_edge, filter::linear);
     if (params.antialias <= 0 || params.panowidth <= 0 || params.panoheight <= 0) {
         return float4(0.0, 0.0, 0.0, 1.0);
@@ -153,13 +154,10 @@ fragment float4 irFragmentFish2PanoI420(VertexOut in [[stage_in]],
     for (int ai = 0; ai < params.antialias; ai++) {
         for (int aj = 0; aj < params.antialias; aj++) {
             int aa = ai * params.antialias + aj;
-            float2 uvPixel = sampleTexUV(aa, baseUV, texUV, s);
-            float u = uvPixel.x;
-            float v = uvPixel.y;
-            if (u < 0.0 || u > float(params.fishwidth) || v < 0.0 || v > float(params.fishheight)) {
+            float2 fishUV;
+            if (!sampleTexUV(aa, baseUV, texUV, fishUV)) {
                 continue;
             }
-            float2 fishUV = float2(u / float(params.fishwidth), v / float(params.fishheight));
             float y = yTex.sample(s, fishUV).r - (16.0 / 255.0);
             float uVal = uTex.sample(s, fishUV).r - 0.5;
             float vVal = vTex.sample(s, fishUV).r - 0.5;
@@ -180,7 +178,7 @@ fragment float4 irFragmentFish2PanoI420(VertexOut in [[stage_in]],
 fragment float4 irFragmentFish2PanoRGB(VertexOut in [[stage_in]],
                                        constant Fish2PanoParams &params [[buffer(0)]],
                                        texture2d<float, access::sample> rgbTex [[texture(0)]],
-                                       array<texture2d<float, access::sample>, 9> texUV [[texture(4)]]) {
+                                       texture2d_array<float, access::sample> texUV [[texture(4)]]) {
     constexpr sampler s(address::clamp_to_edge, filter::linear);
     if (params.antialias <= 0 || params.panowidth <= 0 || params.panoheight <= 0) {
         return float4(0.0, 0.0, 0.0, 1.0);
@@ -196,13 +194,10 @@ fragment float4 irFragmentFish2PanoRGB(VertexOut in [[stage_in]],
     for (int ai = 0; ai < params.antialias; ai++) {
         for (int aj = 0; aj < params.antialias; aj++) {
             int aa = ai * params.antialias + aj;
-            float2 uvPixel = sampleTexUV(aa, baseUV, texUV, s);
-            float u = uvPixel.x;
-            float v = uvPixel.y;
-            if (u < 0.0 || u > float(params.fishwidth) || v < 0.0 || v > float(params.fishheight)) {
+            float2 fishUV;
+            if (!sampleTexUV(aa, baseUV, texUV, fishUV)) {
                 continue;
             }
-            float2 fishUV = float2(u / float(params.fishwidth), v / float(params.fishheight));
             float3 color = rgbTex.sample(s, fishUV).rgb;
             accum += color;
             samples += 1;
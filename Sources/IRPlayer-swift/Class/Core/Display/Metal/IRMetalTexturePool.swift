@@ -0,0 +1,118 @@
+//
+//  IRMetalTexturePool.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import Metal
+
+/// Recycles the upload textures of the I420 and RGB paths across frames.
+///
+/// Frames are bracketed by `beginFrame()` and `commit(_:)`. At most
+/// `maxFramesInFlight` committed frames may be outstanding: `beginFrame()` waits up to
+/// `frameSlotTimeout` for the GPU to retire one before encoding proceeds anyway.
+/// Completion handlers run on a Metal thread, so the policy is guarded by a lock.
+final class IRMetalTexturePool {
+    static let frameSlotTimeout: DispatchTimeInterval = .milliseconds(50)
+
+    let device: MTLDevice
+    private let lock = NSLock()
+    private var policy: IRMetalTexturePoolPolicy<IRMetalPooledTexture>
+    private let frameSlots: DispatchSemaphore
+    private var holdsFrameSlot = false
+
+    init(device: MTLDevice, configuration: IRMetalTexturePoolPolicy<IRMetalPooledTexture>.Configuration = .default) {
+        self.device = device
+        self.policy = IRMetalTexturePoolPolicy(configuration: configuration)
+        self.frameSlots = DispatchSemaphore(value: policy.configuration.maxFramesInFlight)
+    }
+
+    deinit {
+        // DispatchSemaphore traps if released below its initial value.
+        if holdsFrameSlot {
+            frameSlots.signal()
+        }
+    }
+
+    var availableCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return policy.availableCount
+    }
+
+    var inFlightCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return policy.inFlightCount
+    }
+
+    func beginFrame() {
+        lock.lock()
+        policy.beginFrame()
+        let needsSlot = !holdsFrameSlot
+        lock.unlock()
+        guard needsSlot else { return }
+        let acquired = frameSlots.wait(timeout: .now() + Self.frameSlotTimeout) == .success
+        lock.lock()
+        holdsFrameSlot = acquired
+        lock.unlock()
+    }
+
+    func texture(width: Int, height: Int, pixelFormat: MTLPixelFormat) -> MTLTexture? {
+        guard let key = IRMetalTexturePoolPolicy<IRMetalPooledTexture>.key(width: width,
+                                                                           height: height,
+                                                                           pixelFormat: pixelFormat.rawValue) else { return nil }
+        lock.lock()
+        let recycled = policy.checkout(key)
+        lock.unlock()
+        if let recycled = recycled {
+            return recycled.texture
+        }
+
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: pixelFormat, width: width, height: height, mipmapped: false)
+        descriptor.usage = .shaderRead
+        guard let texture = device.makeTexture(descriptor: descriptor) else { return nil }
+        lock.lock()
+        policy.track(IRMetalPooledTexture(texture), key: key)
+        lock.unlock()
+        return texture
+    }
+
+    /// Commits `commandBuffer` and hands this frame's textures back once the GPU is
+    /// done with them.
+    func commit(_ commandBuffer: MTLCommandBuffer) {
+        lock.lock()
+        let frameID = policy.commitFrame()
+        let releasesSlot = holdsFrameSlot
+        holdsFrameSlot = false
+        lock.unlock()
+
+        // Holds the pool until the GPU retires the frame so every slot is returned.
+        commandBuffer.addCompletedHandler { _ in
+            self.lock.lock()
+            self.policy.completeFrame(frameID)
+            self.lock.unlock()
+            if releasesSlot {
+                self.frameSlots.signal()
+            }
+        }
+        commandBuffer.commit()
+    }
+
+    func removeAvailable() {
+        lock.lock()
+        policy.removeAvailable()
+        lock.unlock()
+    }
+}
+
+/// `MTLTexture` is a protocol; the policy needs a class type to hold.
+final class IRMetalPooledTexture {
+    let texture: MTLTexture
+
+    init(_ texture: MTLTexture) {
+        self.texture = texture
+    }
+}
@@ -0,0 +1,142 @@
+//
+//  IRMetalTexturePoolPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+/// Identifies interchangeable pooled textures. `pixelFormat` is the raw
+/// `MTLPixelFormat` value so the policy stays free of Metal.
+struct IRMetalTextureKey: Hashable {
+    let width: Int
+    let height: Int
+    let pixelFormat: UInt
+}
+
+/// Bookkeeping for recycled upload textures.
+///
+/// A texture moves through three states: `pending` once it is handed out for the frame
+/// being encoded, in flight once that frame's command buffer is committed, and
+/// available again when the command buffer completes. Pending textures of a frame that
+/// was never committed go straight back to available on the next `beginFrame()`,
+/// since the GPU never saw them. Available textures unused for `maxIdleFrames`
+/// committed frames are evicted, which is how sizes from a previous stream age out.
+struct IRMetalTexturePoolPolicy<Texture: AnyObject> {
+    struct Configuration: Equatable {
+        var maxFramesInFlight: Int
+        var maxIdleFrames: Int
+        var maxAvailablePerKey: Int
+
+        static let `default` = Configuration(maxFramesInFlight: 3, maxIdleFrames: 120, maxAvailablePerKey: 8)
+    }
+
+    private struct Entry {
+        let texture: Texture
+        let key: IRMetalTextureKey
+        var releasedFrame: Int
+    }
+
+    let configuration: Configuration
+    private(set) var frameIndex = 0
+    private var available: [IRMetalTextureKey: [Entry]] = [:]
+    private var pending: [Entry] = []
+    private var inFlight: [Int: [Entry]] = [:]
+
+    init(configuration: Configuration = .default) {
+        self.configuration = Configuration(maxFramesInFlight: max(1, configuration.maxFramesInFlight),
+                                           maxIdleFrames: max(0, configuration.maxIdleFrames),
+                                           maxAvailablePerKey: max(0, configuration.maxAvailablePerKey))
+    }
+
+    static func key(width: Int, height: Int, pixelFormat: UInt) -> IRMetalTextureKey? {
+        guard width > 0, height > 0 else { return nil }
+        return IRMetalTextureKey(width: width, height: height, pixelFormat: pixelFormat)
+    }
+
+    var availableCount: Int {
+        return available.values.reduce(0) { $0 + $1.count }
+    }
+
+    var pendingCount: Int {
+        return pending.count
+    }
+
+    var inFlightCount: Int {
+        return inFlight.values.reduce(0) { $0 + $1.count }
+    }
+
+    var framesInFlight: Int {
+        return inFlight.count
+    }
+
+    func availableCount(for key: IRMetalTextureKey) -> Int {
+        return available[key]?.count ?? 0
+    }
+
+    /// Reclaims textures handed out for a frame that was abandoned before commit.
+    mutating func beginFrame() {
+        let abandoned = pending
+        pending.removeAll(keepingCapacity: true)
+        for entry in abandoned {
+            makeAvailable(entry)
+        }
+    }
+
+    /// Hands out the most recently released texture for `key` and marks it pending.
+    /// Returns nil when the caller has to allocate one and `track` it.
+    mutating func checkout(_ key: IRMetalTextureKey) -> Texture? {
+        guard var entries = available[key], let entry = entries.popLast() else { return nil }
+        available[key] = entries.isEmpty ? nil : entries
+        pending.append(entry)
+        return entry.texture
+    }
+
+    /// Marks a freshly allocated texture as pending for the current frame.
+    mutating func track(_ texture: Texture, key: IRMetalTextureKey) {
+        pending.append(Entry(texture: texture, key: key, releasedFrame: frameIndex))
+    }
+
+    /// Moves the pending textures in flight and returns the id `completeFrame` expects.
+    mutating func commitFrame() -> Int {
+        let frameID = frameIndex
+        if !pending.isEmpty {
+            inFlight[frameID] = pending
+            pending.removeAll(keepingCapacity: true)
+        }
+        frameIndex += 1
+        evictIdle()
+        return frameID
+    }
+
+    mutating func completeFrame(_ frameID: Int) {
+        guard let entries = inFlight.removeValue(forKey: frameID) else { return }
+        for entry in entries {
+            makeAvailable(entry)
+        }
+    }
+
+    mutating func evictIdle() {
+        let limit = configuration.maxIdleFrames
+        for (key, entries) in available {
+            let kept = entries.filter { frameIndex - $0.releasedFrame <= limit }
+            if kept.count != entries.count {
+                available[key] = kept.isEmpty ? nil : kept
+            }
+        }
+    }
+
+    /// Drops every available texture; pending and in-flight ones are still tracked so
+    /// completion handlers stay balanced.
+    mutating func removeAvailable() {
+        available.removeAll()
+    }
+
+    private mutating func makeAvailable(_ entry: Entry) {
+        var entries = available[entry.key] ?? []
+        guard entries.count < configuration.maxAvailablePerKey else { return }
+        var released = entry
+        released.releasedFrame = frameIndex
+        entries.append(released)
+        available[entry.key] = entries
+    }
+}
@@ -52,7 +52,7 @@ private final class IRGLRenderAdapter: IRGLRenderInternal {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -62,7 +62,7 @@ private final class IRGLRenderAdapter: IRGLRenderInternal {
                          translation: SIMD2<Float>) -> Bool {
         renderer?.renderFish2Pano(frame: frame,
                                  params: params,
-                                 texUVTextures: texUVTextures,
+                                 texUVTexture: texUVTexture,
                                  to: drawable,
                                  drawableSize: drawableSize,
                                  viewport: viewport,
@@ -151,7 +151,7 @@ extension IRGLRenderNV12: IRGLRenderInternal {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -161,7 +161,7 @@ extension IRGLRenderNV12: IRGLRenderInternal {
                          translation: SIMD2<Float>) -> Bool {
         adapter.renderFish2Pano(frame: frame,
                               params: params,
-                              texUVTextures: texUVTextures,
+                              texUVTexture: texUVTexture,
                               to: drawable,
                               drawableSize: drawableSize,
                               viewport: viewport,
@@ -250,7 +250,7 @@ extension IRGLRenderYUV: IRGLRenderInternal {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -260,7 +260,7 @@ extension IRGLRenderYUV: IRGLRenderInternal {
                          translation: SIMD2<Float>) -> Bool {
         adapter.renderFish2Pano(frame: frame,
                               params: params,
-                              texUVTextures: texUVTextures,
+                              texUVTexture: texUVTexture,
                               to: drawable,
                               drawableSize: drawableSize,
                               viewport: viewport,
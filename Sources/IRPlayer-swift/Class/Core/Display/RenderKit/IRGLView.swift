@@ -20,8 +20,23 @@ enum IRDisplayRendererType: UInt {
 }
 
 
+private final class IRGLViewDisplayLinkProxy {
+    weak var view: IRGLView?
 
-public class IRGLView: UIView, IRFFDecoderVideoOutput {
+    init(view: IRGLView) {
+        self.view = view
+    }
+
+    @objc func tick(_ sender: CADisplayLink) {
+        guard let view else {
+            sender.invalidate()
+            return
+        }
+        view.displayLinkDidFire(sender)
+    }
+}
+
+public class IRGLView: UIView, IRFFDecoderPacedVideoOutput {
 
     var abstractPlayer: IRPlayerImp?
     private var metalLayer: CAMetalLayer? {
@@ -34,13 +49,18 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     private var commandQueue: MTLCommandQueue?
     private var ciContext: CIContext?
     private var metalRenderer: IRMetalRenderer?
-    private var metalFisheyeMesh: IRMetalFisheyeMesh?
+    /// Levels of detail of the current fisheye geometry this view holds, by slice count;
+    /// see `IRGLSphereMeshLODPolicy.retainedLevels(for:available:)`.
+    private var metalFisheyeMeshes: [Int: IRMetalFisheyeMesh] = [:]
     private var metalVRMesh: IRMetalFisheyeMesh?
+    /// Shared mesh builds this view already waits on, so each notifies it once.
+    private var pendingFisheyeMeshKeys: Set<IRGLSphereMeshKey> = []
+    private var metalVRMeshPending = false
     private var metalFisheyeController: IRGLTransformController3DFisheye?
     private var metalFisheyeParameter: IRFisheyeParameter?
-    private var metalFisheyeLastSize: CGSize = .zero
+    private var metalFisheyeMeshKey: IRGLSphereMeshKey?
     private var metalFish2PanoParams: IRGLFish2PanoShaderParams?
-    private var metalFish2PanoTexUV: [MTLTexture] = []
+    private var metalFish2PanoTexUV: MTLTexture?
     private var metalFish2PanoLastOutputSize: CGSize = .zero
     private var metalFish2PanoLastAntialias: Int = 0
     private var metalDistortionLeftMesh: IRMetalDistortionMesh?
@@ -51,6 +71,8 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     private var currentImage: CIImage?
     private var currentFrame: IRFFVideoFrame?
     private let queue: DispatchQueue = DispatchQueue(label: "render.queue")
+    let presentationScheduler = IRFFPresentationScheduler()
+    private var displayLink: CADisplayLink?
     var irPixelFormat: IRPixelFormat = .YUV_IRPixelFormat {
         didSet {
             initGL(with: irPixelFormat)
@@ -152,6 +174,7 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     }
 
     func close() {
+        presentationScheduler.removeAll()
         queue.sync {
             reset()
         }
@@ -161,12 +184,13 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
         currentImage = nil
         currentFrame = nil
         metalRenderer = nil
-        metalFisheyeMesh = nil
+        metalFisheyeMeshes = [:]
+        metalFisheyeMeshKey = nil
         metalVRMesh = nil
         metalFisheyeController = nil
         metalFisheyeParameter = nil
         metalFish2PanoParams = nil
-        metalFish2PanoTexUV = []
+        metalFish2PanoTexUV = nil
         metalFish2PanoLastOutputSize = .zero
         metalFish2PanoLastAntialias = 0
         metalDistortionLeftMesh = nil
@@ -177,9 +201,59 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     }
 
     deinit {
+        displayLink?.invalidate()
         reset()
     }
 
+    public override func didMoveToWindow() {
+        super.didMoveToWindow()
+        if window != nil {
+            startDisplayLink()
+        } else {
+            stopDisplayLink()
+        }
+    }
+
+    private func startDisplayLink() {
+        guard displayLink == nil else { return }
+        let link = CADisplayLink(target: IRGLViewDisplayLinkProxy(view: self),
+                                 selector: #selector(IRGLViewDisplayLinkProxy.tick(_:)))
+        link.add(to: .main, forMode: .common)
+        displayLink = link
+        presentationScheduler.setVsyncDemandHandler { [weak self] in
+            DispatchQueue.main.async {
+                self?.updateDisplayLinkPaused()
+            }
+        }
+        presentationScheduler.setActive(true)
+        updateDisplayLinkPaused()
+    }
+
+    private func stopDisplayLink() {
+        presentationScheduler.setVsyncDemandHandler(nil)
+        presentationScheduler.setActive(false)
+        displayLink?.invalidate()
+        displayLink = nil
+    }
+
+    /// Main thread only. Keeps the link from firing while nothing is queued or
+    /// playback is paused; the demand handler wakes it on the next enqueue.
+    private func updateDisplayLinkPaused() {
+        displayLink?.isPaused = !presentationScheduler.needsVsync
+    }
+
+    /// Presents the scheduled frame for the upcoming vsync without blocking main on
+    /// the render queue.
+    fileprivate func displayLinkDidFire(_ link: CADisplayLink) {
+        let interval = link.targetTimestamp - link.timestamp
+        let frame = presentationScheduler.frame(forVsyncAt: link.targetTimestamp, interval: interval)
+        updateDisplayLinkPaused()
+        guard let frame else { return }
+        queue.async { [weak self] in
+            self?.present(frame)
+        }
+    }
+
     public override func layoutSubviews() {
         super.layoutSubviews()
         updateViewPort(1.0)
@@ -299,15 +373,20 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
 
     func render(_ frame: IRFFVideoFrame?) {
         queue.sync {
-            if let frame = frame {
-                self.lastFrameWidth = Int(frame.width)
-                self.lastFrameHeight = Int(frame.height)
-                self.currentFrame = frame
-                self.currentImage = nil
-            }
+            self.present(frame)
+        }
+    }
 
-            self.renderCurrentContent()
+    /// Render-queue only.
+    private func present(_ frame: IRFFVideoFrame?) {
+        if let frame = frame {
+            lastFrameWidth = Int(frame.width)
+            lastFrameHeight = Int(frame.height)
+            currentFrame = frame
+            currentImage = nil
         }
+
+        renderCurrentContent()
     }
 
     private func renderCurrentContent() {
@@ -582,7 +661,7 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     private func setupMetalFish2PanoIfNeeded(renderMode: IRGLRenderMode) {
         guard let program = renderMode.program as? IRGLProgram2DFisheye2Pano else {
             metalFish2PanoParams = nil
-            metalFish2PanoTexUV = []
+            metalFish2PanoTexUV = nil
             metalFish2PanoLastOutputSize = .zero
             metalFish2PanoLastAntialias = 0
             return
@@ -594,7 +673,8 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
     private func setupMetalFisheyeIfNeeded(renderMode: IRGLRenderMode) {
         guard renderMode is IRGLRenderMode3DFisheye else {
             metalFisheyeController = nil
-            metalFisheyeMesh = nil
+            metalFisheyeMeshes = [:]
+            metalFisheyeMeshKey = nil
             metalFisheyeParameter = nil
             return
         }
@@ -640,32 +720,16 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
         if program.programs.first is IRGLProgram3DFisheye {
             let parameter = (mode?.parameter as? IRFisheyeParameter) ??
                 IRFisheyeParameter(width: 0, height: 0, up: false, rx: 0, ry: 0, cx: 0, cy: 0, latmax: 0)
-            let textureWidth = parameter.width > 0 ? parameter.width : Float(frame.width)
-            let textureHeight = parameter.height > 0 ? parameter.height : Float(frame.height)
-            let meshSize = CGSize(width: CGFloat(textureWidth), height: CGFloat(textureHeight))
-
-            if metalFisheyeMesh == nil || metalFisheyeLastSize != meshSize {
-                let device = self.device ?? MTLCreateSystemDefaultDevice()
-                if let device = device {
-                    if let projection = program.programs.first?.mapProjection as? IRGLProjectionEquirectangular,
-                       let meshData = projection.exportMesh() {
-                        metalFisheyeMesh = IRMetalFisheyeMesh(device: device,
-                                                              positions: meshData.positions,
-                                                              texcoords: meshData.texcoords,
-                                                              indices: meshData.indices)
-                    } else {
-                        metalFisheyeMesh = IRMetalFisheyeMesh(device: device,
-                                                              textureWidth: textureWidth,
-                                                              textureHeight: textureHeight,
-                                                              centerX: parameter.cx,
-                                                              centerY: parameter.cy,
-                                                              radius: parameter.ry)
-                    }
-                    metalFisheyeLastSize = meshSize
-                }
+            let projection = program.programs.first?.mapProjection as? IRGLProjectionEquirectangular
+            guard let meshKey = fisheyeMeshKey(projection: projection, parameter: parameter, frame: frame) else { return false }
+            // One mesh serves every panel, so the most demanding one picks it.
+            let slices = program.programs
+                .compactMap { ($0.tramsformController as? IRGLTransformController3DFisheye)?.sphereMeshSlices() }
+                .max() ?? SPHERE_SLICES
+            guard let mesh = sharedFisheyeMesh(for: meshKey, slices: slices) else {
+                renderer.renderClear(to: drawable)
+                return true
             }
-
-            guard let mesh = metalFisheyeMesh else { return false }
             let texMatrix = IRMatrix4.makeScale(1, -1, 1)
             let viewports = program.programs.map { $0.viewprotRange }
             var mvps: [simd_float4x4] = []
@@ -713,31 +777,20 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
 
         let outputSize = CGSize(width: outputWidth, height: outputHeight)
         if outputSize != metalFish2PanoLastOutputSize || antialias != metalFish2PanoLastAntialias {
-            metalFish2PanoTexUV = []
+            metalFish2PanoTexUV = nil
             metalFish2PanoLastOutputSize = outputSize
             metalFish2PanoLastAntialias = antialias
         }
 
-        if let pixUV = params.consumePixUVIfReady() {
-            defer { params.releaseConsumedPixUV(pixUV) }
-
-            let texCount = min(pixUV.count, antialias * antialias)
-            var newTextures: [MTLTexture] = []
-            newTextures.reserveCapacity(texCount)
-            for i in 0..<texCount {
-                guard let texture = makeTexUVTexture(width: outputWidth,
-                                                     height: outputHeight,
-                                                     data: pixUV[i]) else {
-                    continue
-                }
-                newTextures.append(texture)
-            }
-            if !newTextures.isEmpty {
-                metalFish2PanoTexUV = newTextures
-            }
+        if let pixelMap = params.consumePixUVIfReady(),
+           pixelMap.geometry.outputWidth == outputWidth,
+           pixelMap.geometry.outputHeight == outputHeight,
+           pixelMap.geometry.antialias == antialias,
+           let texture = makeTexUVTexture(pixelMap) {
+            metalFish2PanoTexUV = texture
         }
 
-        guard metalFish2PanoTexUV.count == antialias * antialias else {
+        guard let texUVTexture = metalFish2PanoTexUV else {
             renderer.renderClear(to: drawable)
             return true
         }
@@ -764,7 +817,7 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
         let zoomScale = effectiveProgram?.getCurrentScale().x ?? 1
         return renderer.renderFish2Pano(frame: frame,
                                         params: renderParams,
-                                        texUVTextures: metalFish2PanoTexUV,
+                                        texUVTexture: texUVTexture,
                                         to: drawable,
                                         drawableSize: drawableSize,
                                         viewport: viewportRect,
@@ -798,17 +851,31 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
         IRGLViewPolicy.texUVTextureLayout(width: width, height: height)
     }
 
-    private func makeTexUVTexture(width: Int, height: Int, data: UnsafeMutablePointer<GLfloat>) -> MTLTexture? {
+    /// One `rg16Unorm` array slice per antialias sample, uploaded straight from the
+    /// packed (possibly memory-mapped) texels.
+    private func makeTexUVTexture(_ pixelMap: IRGLFish2PanoPackedPixelMap) -> MTLTexture? {
+        let width = pixelMap.geometry.outputWidth
+        let height = pixelMap.geometry.outputHeight
         guard let device = device,
-              let layout = Self.texUVTextureLayout(width: width, height: height) else { return nil }
-        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .rg32Float,
+              let layout = Self.texUVTextureLayout(width: width, height: height),
+              layout.bytesPerRow == pixelMap.bytesPerRow else { return nil }
+        let descriptor = MTLTextureDescriptor.texture2DDescriptor(pixelFormat: .rg16Unorm,
                                                                   width: width,
                                                                   height: height,
                                                                   mipmapped: false)
+        descriptor.textureType = .type2DArray
+        descriptor.arrayLength = pixelMap.sliceCount
         descriptor.usage = .shaderRead
         guard let texture = device.makeTexture(descriptor: descriptor) else { return nil }
         let region = MTLRegionMake2D(0, 0, width, height)
-        texture.replace(region: region, mipmapLevel: 0, withBytes: data, bytesPerRow: layout.bytesPerRow)
+        for slice in 0..<pixelMap.sliceCount {
+            texture.replace(region: region,
+                            mipmapLevel: 0,
+                            slice: slice,
+                            withBytes: pixelMap.slice(slice),
+                            bytesPerRow: layout.bytesPerRow,
+                            bytesPerImage: layout.totalByteCount)
+        }
         return texture
     }
 
@@ -820,31 +887,12 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
         guard let controller = metalFisheyeController else { return false }
         guard let parameter = metalFisheyeParameter else { return false }
 
-        let textureWidth = parameter.width > 0 ? parameter.width : Float(frame.width)
-        let textureHeight = parameter.height > 0 ? parameter.height : Float(frame.height)
-        let meshSize = CGSize(width: CGFloat(textureWidth), height: CGFloat(textureHeight))
-        if metalFisheyeMesh == nil || metalFisheyeLastSize != meshSize {
-            let device = self.device ?? MTLCreateSystemDefaultDevice()
-            if let device = device {
-                if let projection = mode?.program?.mapProjection as? IRGLProjectionEquirectangular,
-                   let meshData = projection.exportMesh() {
-                    metalFisheyeMesh = IRMetalFisheyeMesh(device: device,
-                                                          positions: meshData.positions,
-                                                          texcoords: meshData.texcoords,
-                                                          indices: meshData.indices)
-                } else {
-                    metalFisheyeMesh = IRMetalFisheyeMesh(device: device,
-                                                          textureWidth: textureWidth,
-                                                          textureHeight: textureHeight,
-                                                          centerX: parameter.cx,
-                                                          centerY: parameter.cy,
-                                                          radius: parameter.ry)
-                }
-                metalFisheyeLastSize = meshSize
-            }
+        let projection = mode?.program?.mapProjection as? IRGLProjectionEquirectangular
+        guard let meshKey = fisheyeMeshKey(projection: projection, parameter: parameter, frame: frame) else { return false }
+        guard let mesh = sharedFisheyeMesh(for: meshKey, slices: controller.sphereMeshSlices()) else {
+            renderer.renderClear(to: drawable)
+            return true
         }
-
-        guard let mesh = metalFisheyeMesh else { return false }
         let mvp = controller.getModelViewProjectionMatrix()
         let texMatrix = IRMatrix4.makeScale(1, -1, 1)
 
@@ -860,6 +908,71 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
                                       viewport: viewportRect)
     }
 
+    /// The projection's key when it has one, so every panel shares its mesh;
+    /// otherwise one derived from the fisheye parameter and the frame size.
+    private func fisheyeMeshKey(projection: IRGLProjectionEquirectangular?,
+                                parameter: IRFisheyeParameter,
+                                frame: IRFFVideoFrame) -> IRGLSphereMeshKey? {
+        if let meshKey = projection?.meshKey {
+            return meshKey
+        }
+        return IRGLSphereMeshKey(slices: SPHERE_SLICES,
+                                 textureWidth: parameter.width > 0 ? parameter.width : Float(frame.width),
+                                 textureHeight: parameter.height > 0 ? parameter.height : Float(frame.height),
+                                 centerX: parameter.cx,
+                                 centerY: parameter.cy,
+                                 radius: parameter.ry)
+    }
+
+    /// The process-wide mesh for the geometry of `key` at the level that covers
+    /// `slices`, or the closest one held until that is built in the background.
+    /// Levels are requested only as they are needed, and the ones this view lets go
+    /// are purged from the shared cache once no other view holds them.
+    private func sharedFisheyeMesh(for key: IRGLSphereMeshKey, slices: Int) -> IRMetalFisheyeMesh? {
+        if key != metalFisheyeMeshKey {
+            metalFisheyeMeshKey = key
+            metalFisheyeMeshes = [:]
+        }
+        let level = IRGLSphereMeshLODPolicy.level(for: slices)
+        if metalFisheyeMeshes[level] == nil,
+           let levelKey = key.withSlices(level),
+           !pendingFisheyeMeshKeys.contains(levelKey),
+           let device = self.device ?? MTLCreateSystemDefaultDevice() {
+            let mesh = IRMetalFisheyeMesh.shared(device: device, key: levelKey) { [weak self] mesh in
+                self?.queue.async {
+                    self?.fisheyeMeshDidBuild(mesh, for: levelKey)
+                }
+            }
+            if let mesh {
+                metalFisheyeMeshes[level] = mesh
+            } else {
+                pendingFisheyeMeshKeys.insert(levelKey)
+            }
+        }
+        let retained = IRGLSphereMeshLODPolicy.retainedLevels(for: level, available: Set(metalFisheyeMeshes.keys))
+        if retained.count < metalFisheyeMeshes.count {
+            metalFisheyeMeshes = metalFisheyeMeshes.filter { retained.contains($0.key) }
+            IRMetalFisheyeMesh.purgeUnused()
+        }
+        return IRGLSphereMeshLODPolicy.closestLevel(to: level, available: retained).flatMap { metalFisheyeMeshes[$0] }
+    }
+
+    /// Render-queue only. Redraws once a level this view asked for is built; the
+    /// next draw picks it up from the shared cache.
+    private func fisheyeMeshDidBuild(_ mesh: IRMetalFisheyeMesh?, for levelKey: IRGLSphereMeshKey) {
+        pendingFisheyeMeshKeys.remove(levelKey)
+        guard mesh != nil, metalFisheyeMeshKey?.withSlices(levelKey.slices) == levelKey else { return }
+        renderCurrentContent()
+    }
+
+    /// Render-queue only. Redraws the current frame once the VR mesh it was
+    /// waiting for is built; the next draw picks it up from the shared cache.
+    private func vrMeshDidBuild(_ mesh: IRMetalFisheyeMesh?) {
+        metalVRMeshPending = false
+        guard mesh != nil else { return }
+        renderCurrentContent()
+    }
+
     private func renderMetalVRIfNeeded(frame: IRFFVideoFrame,
                                        renderer: IRGLRenderInternal,
                                        drawable: CAMetalDrawable,
@@ -872,19 +985,24 @@ public class IRGLView: UIView, IRFFDecoderVideoOutput {
             return false
         }
 
-        if metalVRMesh == nil {
-            if let projection = program.mapProjection as? IRGLProjectionVR,
-               let meshData = projection.exportMesh(),
-               let device = (self.device ?? MTLCreateSystemDefaultDevice()) {
-                metalVRMesh = IRMetalFisheyeMesh(device: device,
-                                                 positions: meshData.positions,
-                                                 texcoords: meshData.texcoords,
-                                                 indices: meshData.indices)
+        if metalVRMesh == nil, !metalVRMeshPending {
+            guard let projection = program.mapProjection as? IRGLProjectionVR,
+                  let device = (self.device ?? MTLCreateSystemDefaultDevice()) else {
+                return false
             }
+            metalVRMesh = IRMetalFisheyeMesh.sharedVR(device: device,
+                                                      projection: projection,
+                                                      completion: { [weak self] mesh in
+                                                          self?.queue.async {
+                                                              self?.vrMeshDidBuild(mesh)
+                                                          }
+                                                      })
+            metalVRMeshPending = metalVRMesh == nil
         }
 
         guard let mesh = metalVRMesh else {
-            return false
+            renderer.renderClear(to: drawable)
+            return true
         }
         let mvp = controller.getModelViewProjectionMatrix()
         let texMatrix = IRMatrix4.identity()
@@ -1018,7 +1136,7 @@ private class IRGLRenderStrategyBase: IRGLRenderInternal {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -1028,7 +1146,7 @@ private class IRGLRenderStrategyBase: IRGLRenderInternal {
                          translation: SIMD2<Float>) -> Bool {
         renderer.renderFish2Pano(frame: frame,
                                  params: params,
-                                 texUVTextures: texUVTextures,
+                                 texUVTexture: texUVTexture,
                                  to: drawable,
                                  drawableSize: drawableSize,
                                  viewport: viewport,
@@ -66,8 +66,7 @@ enum IRGLViewPolicy {
     static func texUVTextureLayout(width: Int, height: Int) -> (bytesPerRow: Int, totalByteCount: Int)? {
         guard width > 0, height > 0 else { return nil }
 
-        let bytesPerTexel = MemoryLayout<Float>.size * 2
-        let (bytesPerRow, rowOverflow) = width.multipliedReportingOverflow(by: bytesPerTexel)
+        let (bytesPerRow, rowOverflow) = width.multipliedReportingOverflow(by: IRGLFish2PanoPixelMapPacking.bytesPerTexel)
         guard !rowOverflow, bytesPerRow > 0 else { return nil }
 
         let (totalByteCount, totalOverflow) = bytesPerRow.multipliedReportingOverflow(by: height)
@@ -33,7 +33,7 @@ protocol IRGLRenderInternal: IRGLRender {
 
     func renderFish2Pano(frame: IRFFVideoFrame,
                          params: IRMetalRenderer.Fish2PanoParams,
-                         texUVTextures: [MTLTexture],
+                         texUVTexture: MTLTexture?,
                          to drawable: CAMetalDrawable,
                          drawableSize: CGSize,
                          viewport: CGRect,
@@ -0,0 +1,122 @@
+//
+//  IRGLFish2PanoPackedPixelMap.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Packing of the fish2pano UV maps for the GPU: every antialias sample becomes one
+/// slice of a single `rg16Unorm` texture array, each texel holding the fisheye
+/// coordinate normalised to the texture size. Half the bytes of the `rg32Float`
+/// planes, and the error stays below `maxQuantizationError`: about 0.03 px on a
+/// 2K fisheye, where `rg16Float` would already step by a whole pixel.
+enum IRGLFish2PanoPixelMapPacking {
+    /// Marks samples outside the fisheye; reads back as exactly 1.0.
+    static let outsideTexel: UInt16 = .max
+    static let maxInsideTexel: UInt16 = .max - 1
+    static let bytesPerTexel = MemoryLayout<UInt16>.size * 2
+
+    static func pack(u: Float, v: Float, textureWidth: Int, textureHeight: Int) -> (u: UInt16, v: UInt16) {
+        guard u >= 0, u < Float(textureWidth), v >= 0, v < Float(textureHeight) else {
+            return (outsideTexel, outsideTexel)
+        }
+        return (quantize(u, extent: textureWidth), quantize(v, extent: textureHeight))
+    }
+
+    /// The texel coordinate the shader reconstructs, or nil for an outside sample.
+    static func unpack(u: UInt16, v: UInt16, textureWidth: Int, textureHeight: Int) -> (u: Float, v: Float)? {
+        guard u != outsideTexel, v != outsideTexel else { return nil }
+        return (Float(u) / Float(UInt16.max) * Float(textureWidth),
+                Float(v) / Float(UInt16.max) * Float(textureHeight))
+    }
+
+    /// Largest distance, in texels, between a packed coordinate and the original:
+    /// half a step from rounding, or up to a whole step for the last step before
+    /// the sentinel.
+    static func maxQuantizationError(extent: Int) -> Float {
+        return Float(extent) / Float(UInt16.max)
+    }
+
+    static func layout(for geometry: IRGLFish2PanoPixelMapGeometry) -> (bytesPerRow: Int, bytesPerImage: Int, byteCount: Int)? {
+        guard geometry.isValid else { return nil }
+        let (bytesPerRow, rowOverflow) = geometry.outputWidth.multipliedReportingOverflow(by: bytesPerTexel)
+        let (bytesPerImage, imageOverflow) = bytesPerRow.multipliedReportingOverflow(by: geometry.outputHeight)
+        let (slices, slicesOverflow) = geometry.antialias.multipliedReportingOverflow(by: geometry.antialias)
+        let (byteCount, countOverflow) = bytesPerImage.multipliedReportingOverflow(by: slices)
+        guard !rowOverflow, !imageOverflow, !slicesOverflow, !countOverflow else { return nil }
+        return (bytesPerRow, bytesPerImage, byteCount)
+    }
+
+    /// Packs `maps` slice after slice into `texels`, which must hold
+    /// `layout(for:).byteCount` bytes.
+    static func pack(_ maps: [UnsafeMutablePointer<Float>],
+                     geometry: IRGLFish2PanoPixelMapGeometry,
+                     into texels: UnsafeMutablePointer<UInt16>) {
+        let count = geometry.outputWidth * geometry.outputHeight
+        for (slice, map) in maps.enumerated() {
+            let output = texels + slice * count * 2
+            for texel in 0..<count {
+                let packed = pack(u: map[texel * 2],
+                                  v: map[texel * 2 + 1],
+                                  textureWidth: geometry.textureWidth,
+                                  textureHeight: geometry.textureHeight)
+                output[texel * 2] = packed.u
+                output[texel * 2 + 1] = packed.v
+            }
+        }
+    }
+
+    private static func quantize(_ coordinate: Float, extent: Int) -> UInt16 {
+        let scaled = (coordinate / Float(extent) * Float(UInt16.max)).rounded()
+        return UInt16(min(scaled, Float(maxInsideTexel)))
+    }
+}
+
+/// A packed pixel map ready for upload. The texels are either owned or mapped from
+/// `IRGLFish2PanoPixelMapCache`, and stay valid while this object is alive.
+final class IRGLFish2PanoPackedPixelMap {
+    let geometry: IRGLFish2PanoPixelMapGeometry
+    let texels: UnsafePointer<UInt16>
+    let bytesPerRow: Int
+    let bytesPerImage: Int
+    let byteCount: Int
+    private let release: () -> Void
+
+    var sliceCount: Int {
+        return geometry.mapCount
+    }
+
+    init?(geometry: IRGLFish2PanoPixelMapGeometry, texels: UnsafePointer<UInt16>, release: @escaping () -> Void) {
+        guard let layout = IRGLFish2PanoPixelMapPacking.layout(for: geometry) else { return nil }
+        self.geometry = geometry
+        self.texels = texels
+        self.bytesPerRow = layout.bytesPerRow
+        self.bytesPerImage = layout.bytesPerImage
+        self.byteCount = layout.byteCount
+        self.release = release
+    }
+
+    /// Generates the UV maps for `geometry` and packs them.
+    convenience init?(building geometry: IRGLFish2PanoPixelMapGeometry) {
+        guard let layout = IRGLFish2PanoPixelMapPacking.layout(for: geometry) else { return nil }
+        let maps = (0..<geometry.mapCount).map { _ in
+            UnsafeMutablePointer<Float>.allocate(capacity: geometry.mapCapacity)
+        }
+        defer { maps.forEach { $0.deallocate() } }
+        IRGLFish2PanoPixelMap.fill(geometry, into: maps)
+
+        let texels = UnsafeMutablePointer<UInt16>.allocate(capacity: layout.byteCount / MemoryLayout<UInt16>.stride)
+        IRGLFish2PanoPixelMapPacking.pack(maps, geometry: geometry, into: texels)
+        self.init(geometry: geometry, texels: texels, release: { texels.deallocate() })
+    }
+
+    func slice(_ index: Int) -> UnsafePointer<UInt16> {
+        return texels + index * bytesPerImage / MemoryLayout<UInt16>.stride
+    }
+
+    deinit {
+        release()
+    }
+}
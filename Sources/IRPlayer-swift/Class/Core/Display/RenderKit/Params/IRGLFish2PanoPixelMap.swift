@@ -0,0 +1,298 @@
+//
+//  IRGLFish2PanoPixelMap.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Everything the fish2pano UV lookup depends on, captured so a map can be built
+/// away from the params object.
+struct IRGLFish2PanoPixelMapGeometry: Hashable {
+    var outputWidth: Int
+    var outputHeight: Int
+    var antialias: Int
+    var textureWidth: Int
+    var textureHeight: Int
+    var fishCenterX: Int
+    var fishCenterY: Int
+    var fishRadiusH: Int
+    var fishAperture: Float
+    var lat1: Float
+    var lat2: Float
+    var long1: Float
+    var long2: Float
+    var transformX: Float
+    var transformY: Float
+    var transformZ: Float
+
+    var isValid: Bool {
+        return outputWidth > 0 && outputHeight > 0 && antialias > 0
+    }
+
+    var mapCount: Int {
+        return antialias * antialias
+    }
+
+    /// Floats in each map: an interleaved (u, v) pair per output pixel.
+    var mapCapacity: Int {
+        return outputWidth * outputHeight * 2
+    }
+}
+
+/// Builds the fish2pano UV maps: map `antialias * i + j` holds, for every output
+/// pixel, the fisheye texel seen by sub-sample (i, j), or (-1, -1) outside the
+/// fisheye.
+///
+/// `fill` splits the work into rows run with `concurrentPerform` and evaluates each
+/// row eight pixels at a time. It is bit-compatible with `fillScalar`, the original
+/// per-pixel loop: every expression keeps the scalar version's operands and
+/// association, and the transcendental calls are the same scalar functions applied
+/// per lane. What it saves is repeated work: latitude trigonometry once per row,
+/// longitude trigonometry once per column and rotation trigonometry once per row.
+enum IRGLFish2PanoPixelMap {
+    static let laneCount = 8
+    typealias Lanes = SIMD8<Float>
+
+    private static let degreesToRadians: Float = Float.pi / 180.0
+
+    /// Per-map constants shared by both implementations.
+    private struct Constants {
+        let transX: Float
+        let transY: Float
+        let transZ: Float
+        let tlat1: Float
+        let tlat2: Float
+        let lng1: Float
+        let dlng: Float
+        let raperture: Float
+        let y0: Float
+
+        init(_ geometry: IRGLFish2PanoPixelMapGeometry) {
+            let dtor = IRGLFish2PanoPixelMap.degreesToRadians
+            transX = geometry.transformX * dtor
+            transY = geometry.transformY * dtor
+            transZ = geometry.transformZ * dtor
+            tlat1 = tan(geometry.lat1 * dtor)
+            tlat2 = tan(geometry.lat2 * dtor)
+            lng1 = geometry.long1 * dtor
+            dlng = geometry.long2 * dtor - lng1
+            raperture = 2.0 / (geometry.fishAperture * dtor)
+            y0 = (tlat1 + tlat2) / (tlat1 - tlat2)
+        }
+    }
+
+    // MARK: - Reference
+
+    /// The original scalar generator, kept as the reference `fill` must match.
+    static func fillScalar(_ geometry: IRGLFish2PanoPixelMapGeometry, into maps: [UnsafeMutablePointer<Float>]) {
+        guard geometry.isValid, maps.count == geometry.mapCount else { return }
+        let constants = Constants(geometry)
+        let antialias = geometry.antialias
+
+        for y in 0..<geometry.outputHeight {
+            for x in 0..<geometry.outputWidth {
+                for i in 0..<antialias {
+                    let longitude = sampleLongitude(x: x, sample: i, geometry: geometry, constants: constants)
+                    for j in 0..<antialias {
+                        let latitude = sampleLatitude(y: y, sample: j, geometry: geometry, constants: constants)
+                        setPixelFactors(latitude, longitude, maps[antialias * i + j], x, y, geometry, constants)
+                    }
+                }
+            }
+        }
+    }
+
+    private static func setPixelFactors(_ latitude: Float,
+                                        _ longitude: Float,
+                                        _ map: UnsafeMutablePointer<Float>,
+                                        _ x: Int,
+                                        _ y: Int,
+                                        _ geometry: IRGLFish2PanoPixelMapGeometry,
+                                        _ constants: Constants) {
+        let uvOffset = (geometry.outputWidth * y + x) * 2
+        var p = XYZ(x: cos(latitude) * cos(longitude), y: cos(latitude) * sin(longitude), z: sin(latitude))
+
+        if constants.transX != 0 { p = PRotateX(p, constants.transX) }
+        if constants.transY != 0 { p = PRotateY(p, constants.transY) }
+        if constants.transZ != 0 { p = PRotateZ(p, constants.transZ) }
+
+        let theta = atan2(p.y, p.x)
+        let phi = atan2(sqrt(p.x * p.x + p.y * p.y), p.z)
+        let r = phi * constants.raperture
+
+        let u = Float(geometry.fishCenterX) + Float(geometry.fishRadiusH) * r * cos(theta)
+        if u < 0 || u >= Float(geometry.textureWidth) {
+            map[uvOffset] = -1
+            map[uvOffset + 1] = -1
+            return
+        }
+
+        let v = Float(geometry.textureHeight) - Float(geometry.fishCenterY) + Float(geometry.fishRadiusH) * r * sin(theta)
+        if v < 0 || v >= Float(geometry.textureHeight) {
+            map[uvOffset] = -1
+            map[uvOffset + 1] = -1
+            return
+        }
+
+        map[uvOffset] = u
+        map[uvOffset + 1] = v
+    }
+
+    // MARK: - Vectorised
+
+    static func fill(_ geometry: IRGLFish2PanoPixelMapGeometry,
+                     into maps: [UnsafeMutablePointer<Float>],
+                     concurrent: Bool = true) {
+        guard geometry.isValid, maps.count == geometry.mapCount else { return }
+        let constants = Constants(geometry)
+        let columns = ColumnTables(geometry: geometry, constants: constants)
+
+        if concurrent {
+            DispatchQueue.concurrentPerform(iterations: geometry.outputHeight) { y in
+                fillRow(y, geometry: geometry, constants: constants, columns: columns, maps: maps)
+            }
+        } else {
+            for y in 0..<geometry.outputHeight {
+                fillRow(y, geometry: geometry, constants: constants, columns: columns, maps: maps)
+            }
+        }
+    }
+
+    /// cos and sin of every column's longitude, per horizontal sub-sample, padded to
+    /// a whole number of lanes.
+    private struct ColumnTables {
+        let paddedWidth: Int
+        let cosLongitude: [[Float]]
+        let sinLongitude: [[Float]]
+
+        init(geometry: IRGLFish2PanoPixelMapGeometry, constants: Constants) {
+            let laneCount = IRGLFish2PanoPixelMap.laneCount
+            paddedWidth = (geometry.outputWidth + laneCount - 1) / laneCount * laneCount
+            var cosLongitude: [[Float]] = []
+            var sinLongitude: [[Float]] = []
+            for i in 0..<geometry.antialias {
+                var cosRow = [Float](repeating: 1, count: paddedWidth)
+                var sinRow = [Float](repeating: 0, count: paddedWidth)
+                for x in 0..<geometry.outputWidth {
+                    let longitude = IRGLFish2PanoPixelMap.sampleLongitude(x: x, sample: i, geometry: geometry, constants: constants)
+                    cosRow[x] = cos(longitude)
+                    sinRow[x] = sin(longitude)
+                }
+                cosLongitude.append(cosRow)
+                sinLongitude.append(sinRow)
+            }
+            self.cosLongitude = cosLongitude
+            self.sinLongitude = sinLongitude
+        }
+    }
+
+    private static func fillRow(_ y: Int,
+                                geometry: IRGLFish2PanoPixelMapGeometry,
+                                constants: Constants,
+                                columns: ColumnTables,
+                                maps: [UnsafeMutablePointer<Float>]) {
+        let antialias = geometry.antialias
+        let rotateX = rotation(constants.transX)
+        let rotateY = rotation(constants.transY)
+        let rotateZ = rotation(constants.transZ)
+        let centerX = Lanes(repeating: Float(geometry.fishCenterX))
+        let radius = Lanes(repeating: Float(geometry.fishRadiusH))
+        let vOrigin = Lanes(repeating: Float(geometry.textureHeight) - Float(geometry.fishCenterY))
+        let textureWidth = Lanes(repeating: Float(geometry.textureWidth))
+        let textureHeight = Lanes(repeating: Float(geometry.textureHeight))
+        let raperture = Lanes(repeating: constants.raperture)
+        let rowOffset = geometry.outputWidth * y * 2
+
+        for j in 0..<antialias {
+            let latitude = sampleLatitude(y: y, sample: j, geometry: geometry, constants: constants)
+            let cosLatitude = Lanes(repeating: cos(latitude))
+            let sinLatitude = Lanes(repeating: sin(latitude))
+
+            for i in 0..<antialias {
+                let map = maps[antialias * i + j] + rowOffset
+                columns.cosLongitude[i].withUnsafeBufferPointer { cosLongitude in
+                    columns.sinLongitude[i].withUnsafeBufferPointer { sinLongitude in
+                        var x = 0
+                        while x < geometry.outputWidth {
+                            var px = cosLatitude * Lanes(cosLongitude[x..<(x + laneCount)])
+                            var py = cosLatitude * Lanes(sinLongitude[x..<(x + laneCount)])
+                            var pz = sinLatitude
+
+                            if let rotation = rotateX {
+                                let c = Lanes(repeating: rotation.cos), s = Lanes(repeating: rotation.sin)
+                                (py, pz) = (py * c + pz * s, -py * s + pz * c)
+                            }
+                            if let rotation = rotateY {
+                                let c = Lanes(repeating: rotation.cos), s = Lanes(repeating: rotation.sin)
+                                (px, pz) = (px * c - pz * s, px * s + pz * c)
+                            }
+                            if let rotation = rotateZ {
+                                let c = Lanes(repeating: rotation.cos), s = Lanes(repeating: rotation.sin)
+                                (px, py) = (px * c + py * s, -px * s + py * c)
+                            }
+
+                            let planar = (px * px + py * py).squareRoot()
+                            var cosTheta = Lanes()
+                            var sinTheta = Lanes()
+                            var phi = Lanes()
+                            for lane in 0..<laneCount {
+                                let theta = atan2(py[lane], px[lane])
+                                cosTheta[lane] = cos(theta)
+                                sinTheta[lane] = sin(theta)
+                                phi[lane] = atan2(planar[lane], pz[lane])
+                            }
+                            let r = phi * raperture
+
+                            let u = centerX + radius * r * cosTheta
+                            let v = vOrigin + radius * r * sinTheta
+                            let outside = (u .< 0) .| (u .>= textureWidth) .| (v .< 0) .| (v .>= textureHeight)
+                            let mappedU = u.replacing(with: -1, where: outside)
+                            let mappedV = v.replacing(with: -1, where: outside)
+
+                            for lane in 0..<min(laneCount, geometry.outputWidth - x) {
+                                map[(x + lane) * 2] = mappedU[lane]
+                                map[(x + lane) * 2 + 1] = mappedV[lane]
+                            }
+                            x += laneCount
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /// The cos and sin `PRotateX/Y/Z` would compute, or nil when the scalar path
+    /// skips the rotation.
+    private static func rotation(_ angle: Float) -> (cos: Float, sin: Float)? {
+        guard angle != 0 else { return nil }
+        return (cos: cos(angle), sin: sin(angle))
+    }
+
+    // MARK: - Shared terms
+
+    private static func sampleLongitude(x: Int,
+                                  sample i: Int,
+                                  geometry: IRGLFish2PanoPixelMapGeometry,
+                                  constants: Constants) -> Float {
+        let fractionX = Float(x) + Float(i) / Float(geometry.antialias)
+        let xx = fractionX / Float(geometry.outputWidth)
+        return constants.lng1 + xx * constants.dlng
+    }
+
+    private static func sampleLatitude(y: Int,
+                                 sample j: Int,
+                                 geometry: IRGLFish2PanoPixelMapGeometry,
+                                 constants: Constants) -> Float {
+        let fractionY = Float(y) + Float(j) / Float(geometry.antialias)
+        let normalizedY = 2.0 * fractionY / Float(geometry.outputHeight)
+        let yy = normalizedY - 1.0
+        let y0 = constants.y0
+        if yy > y0 {
+            return (1.0 - y0) == 0 ? 0 : atan((yy - y0) * constants.tlat2 / (1.0 - y0))
+        } else {
+            return (-1.0 - y0) == 0 ? 0 : atan((yy - y0) * constants.tlat1 / (-1.0 - y0))
+        }
+    }
+}
@@ -0,0 +1,111 @@
+//
+//  IRGLFish2PanoPixelMapCache.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Content-addressed store of packed fish2pano pixel maps. A geometry seen before is
+/// memory-mapped from disk instead of being generated again; the slices are
+/// uploaded from the mapping without an intermediate copy.
+final class IRGLFish2PanoPixelMapCache {
+    static let shared = IRGLFish2PanoPixelMapCache(directory: defaultDirectory)
+
+    static var defaultDirectory: URL {
+        let caches = FileManager.default.urls(for: .cachesDirectory, in: .userDomainMask).first
+            ?? FileManager.default.temporaryDirectory
+        return caches.appendingPathComponent("IRPlayer/Fish2PanoPixelMaps", isDirectory: true)
+    }
+
+    let directory: URL
+    let maxFileCount: Int
+    private let lock = NSLock()
+
+    init(directory: URL, maxFileCount: Int = 32) {
+        self.directory = directory
+        self.maxFileCount = max(1, maxFileCount)
+    }
+
+    func fileURL(for geometry: IRGLFish2PanoPixelMapGeometry) -> URL {
+        return directory.appendingPathComponent(IRGLFish2PanoPixelMapCachePolicy.fileName(for: geometry))
+    }
+
+    /// The cached map for `geometry`, or nil when it is missing, truncated or was
+    /// written for another geometry.
+    func load(_ geometry: IRGLFish2PanoPixelMapGeometry) -> IRGLFish2PanoPackedPixelMap? {
+        guard let fileByteCount = IRGLFish2PanoPixelMapCachePolicy.fileByteCount(for: geometry) else {
+            return nil
+        }
+        let url = fileURL(for: geometry)
+        let fd = open(url.path, O_RDONLY)
+        guard fd >= 0 else { return nil }
+        defer { close(fd) }
+
+        var info = stat()
+        guard fstat(fd, &info) == 0, Int(info.st_size) == fileByteCount else { return nil }
+        guard let base = mmap(nil, fileByteCount, PROT_READ, MAP_PRIVATE, fd, 0),
+              base != UnsafeMutableRawPointer(bitPattern: -1) else {
+            return nil
+        }
+        let header = IRGLFish2PanoPixelMapCachePolicy.header(for: geometry)
+        guard memcmp(base, header, header.count) == 0 else {
+            munmap(base, fileByteCount)
+            return nil
+        }
+        try? FileManager.default.setAttributes([.modificationDate: Date()], ofItemAtPath: url.path)
+        let texels = (base + IRGLFish2PanoPixelMapCachePolicy.headerByteCount).assumingMemoryBound(to: UInt16.self)
+        return IRGLFish2PanoPackedPixelMap(geometry: geometry, texels: texels, release: { munmap(base, fileByteCount) })
+    }
+
+    /// Writes `pixelMap`. The file appears atomically, so a concurrent `load` sees
+    /// either nothing or the complete map.
+    @discardableResult
+    func store(_ pixelMap: IRGLFish2PanoPackedPixelMap) -> Bool {
+        let fileManager = FileManager.default
+        let geometry = pixelMap.geometry
+        let url = fileURL(for: geometry)
+        let temporaryURL = directory.appendingPathComponent(UUID().uuidString + ".tmp")
+        do {
+            try fileManager.createDirectory(at: directory, withIntermediateDirectories: true)
+            guard fileManager.createFile(atPath: temporaryURL.path, contents: nil) else { return false }
+            let handle = try FileHandle(forWritingTo: temporaryURL)
+            defer { try? handle.close() }
+            try handle.write(contentsOf: IRGLFish2PanoPixelMapCachePolicy.header(for: geometry))
+            try handle.write(contentsOf: UnsafeRawBufferPointer(start: pixelMap.texels, count: pixelMap.byteCount))
+        } catch {
+            try? fileManager.removeItem(at: temporaryURL)
+            return false
+        }
+        guard rename(temporaryURL.path, url.path) == 0 else {
+            try? fileManager.removeItem(at: temporaryURL)
+            return false
+        }
+        evictIfNeeded()
+        return true
+    }
+
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    private func evictIfNeeded() {
+        lock.lock()
+        defer { lock.unlock() }
+        let fileManager = FileManager.default
+        guard let names = try? fileManager.contentsOfDirectory(atPath: directory.path) else { return }
+        let files: [(name: String, lastUsed: Date)] = names
+            .filter { $0.hasSuffix("." + IRGLFish2PanoPixelMapCachePolicy.fileExtension) }
+            .map { name in
+                let path = directory.appendingPathComponent(name).path
+                let date = (try? fileManager.attributesOfItem(atPath: path)[.modificationDate] as? Date) ?? .distantPast
+                return (name, date)
+            }
+        for name in IRGLFish2PanoPixelMapCachePolicy.evictionCandidates(files, maxFileCount: maxFileCount) {
+            try? fileManager.removeItem(at: directory.appendingPathComponent(name))
+        }
+    }
+}
@@ -0,0 +1,74 @@
+//
+//  IRGLFish2PanoPixelMapCachePolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// File layout of a cached fish2pano pixel map: a fixed-size header describing the
+/// geometry, then the packed texture-array slices exactly as they are uploaded.
+/// The file is named after a hash of the header, so the same geometry always
+/// resolves to the same file, across launches too.
+enum IRGLFish2PanoPixelMapCachePolicy {
+    /// "IRUV", little-endian.
+    static let magic: UInt32 = 0x5655_5249
+    /// Bump when the layout or the generator's output changes.
+    static let formatVersion: UInt32 = 2
+    /// Keeps the slices 64-byte aligned within the page-aligned mapping.
+    static let headerByteCount = 128
+    static let fileExtension = "uvmap"
+
+    static func header(for geometry: IRGLFish2PanoPixelMapGeometry) -> [UInt8] {
+        var bytes: [UInt8] = []
+        bytes.reserveCapacity(headerByteCount)
+        func append<T: FixedWidthInteger>(_ value: T) {
+            withUnsafeBytes(of: value.littleEndian) { bytes.append(contentsOf: $0) }
+        }
+
+        append(magic)
+        append(formatVersion)
+        for value in [geometry.outputWidth, geometry.outputHeight, geometry.antialias,
+                      geometry.textureWidth, geometry.textureHeight,
+                      geometry.fishCenterX, geometry.fishCenterY, geometry.fishRadiusH] {
+            append(Int64(value))
+        }
+        for value in [geometry.fishAperture, geometry.lat1, geometry.lat2, geometry.long1, geometry.long2,
+                      geometry.transformX, geometry.transformY, geometry.transformZ] {
+            append(value.bitPattern)
+        }
+        bytes.append(contentsOf: [UInt8](repeating: 0, count: headerByteCount - bytes.count))
+        return bytes
+    }
+
+    static func fileName(for geometry: IRGLFish2PanoPixelMapGeometry) -> String {
+        let hash = fnv1a64(header(for: geometry))
+        let hex = String(hash, radix: 16)
+        return "fish2pano-" + String(repeating: "0", count: 16 - hex.count) + hex + "." + fileExtension
+    }
+
+    static func fileByteCount(for geometry: IRGLFish2PanoPixelMapGeometry) -> Int? {
+        guard let layout = IRGLFish2PanoPixelMapPacking.layout(for: geometry) else { return nil }
+        let (total, overflow) = layout.byteCount.addingReportingOverflow(headerByteCount)
+        return overflow ? nil : total
+    }
+
+    static func fnv1a64(_ bytes: [UInt8]) -> UInt64 {
+        var hash: UInt64 = 0xcbf2_9ce4_8422_2325
+        for byte in bytes {
+            hash ^= UInt64(byte)
+            hash = hash &* 0x0000_0100_0000_01b3
+        }
+        return hash
+    }
+
+    /// Names to delete so at most `maxFileCount` remain, least recently used first.
+    static func evictionCandidates(_ files: [(name: String, lastUsed: Date)], maxFileCount: Int) -> [String] {
+        guard files.count > maxFileCount else { return [] }
+        return files
+            .sorted { $0.lastUsed < $1.lastUsed }
+            .prefix(files.count - max(0, maxFileCount))
+            .map(\.name)
+    }
+}
@@ -7,8 +7,6 @@
 
 import Foundation
 
-private let DTOR: GLfloat = Float.pi / 180.0
-
 class IRGLFish2PanoShaderParams: IRGLShaderParams {
 
     var preferredRotation: GLfloat = 0.0
@@ -31,58 +29,28 @@ class IRGLFish2PanoShaderParams: IRGLShaderParams {
     var transformZ: GLfloat = -90.0
     var offsetX: GLfloat = 0.0
 
-    private var pixUV: UnsafeMutablePointer<UnsafeMutablePointer<GLfloat>?>?
-    private var pixUVTextureCount = 0
-    private var useTexUVs = false
-    private var metalPixUVReady = false
     private let pixelMapQueue = DispatchQueue(label: "irplayer.fish2pano.pixelmap")
     private let pixelMapGenerationLock = NSLock()
     private var pixelMapGeneration = 0
+    private let readyPixelMapLock = NSLock()
+    private var readyPixelMap: IRGLFish2PanoPackedPixelMap?
+    /// Where built maps are kept for the next time the same geometry opens; nil,
+    /// the default, always builds. The pano program opts into the shared cache.
+    var pixelMapCache: IRGLFish2PanoPixelMapCache?
 
-    func consumePixUVIfReady() -> [UnsafeMutablePointer<GLfloat>]? {
-        guard metalPixUVReady else { return nil }
-        guard pixUVTextureCount > 0 else { return nil }
-        guard let pixUV = pixUV else { return nil }
-
-        var result: [UnsafeMutablePointer<GLfloat>] = []
-        result.reserveCapacity(pixUVTextureCount)
-        for i in 0..<pixUVTextureCount {
-            guard let ptr = pixUV[i] else { return nil }
-            result.append(ptr)
-        }
-
-        metalPixUVReady = false
-        return result
-    }
-
-    func releaseConsumedPixUV(_ consumed: [UnsafeMutablePointer<GLfloat>]) {
-        guard let pixUV = pixUV, pixUVTextureCount == consumed.count else { return }
-
-        for i in 0..<pixUVTextureCount {
-            guard pixUV[i] == consumed[i] else { return }
-        }
-
-        releaseCurrentPixUV()
+    /// Hands over the most recently built map, once.
+    func consumePixUVIfReady() -> IRGLFish2PanoPackedPixelMap? {
+        readyPixelMapLock.lock()
+        defer { readyPixelMapLock.unlock() }
+        let pixelMap = readyPixelMap
+        readyPixelMap = nil
+        return pixelMap
     }
 
-    private func releaseCurrentPixUV() {
-        guard let pixUV = pixUV else {
-            pixUVTextureCount = 0
-            useTexUVs = false
-            metalPixUVReady = false
-            return
-        }
-
-        for i in 0..<pixUVTextureCount {
-            pixUV[i]?.deallocate()
-            pixUV[i] = nil
-        }
-        pixUV.deallocate()
-
-        self.pixUV = nil
-        pixUVTextureCount = 0
-        useTexUVs = false
-        metalPixUVReady = false
+    private func publish(_ pixelMap: IRGLFish2PanoPackedPixelMap) {
+        readyPixelMapLock.lock()
+        defer { readyPixelMapLock.unlock() }
+        readyPixelMap = pixelMap
     }
 
     private func nextPixelMapGeneration() -> Int {
@@ -103,10 +71,6 @@ class IRGLFish2PanoShaderParams: IRGLShaderParams {
         setDefaultValues()
     }
 
-    deinit {
-        releaseCurrentPixUV()
-    }
-
     static func outputSize(forTextureWidth textureWidth: Int, height textureHeight: Int) -> (width: Int, height: Int)? {
         return IRGLFish2PanoShaderParamsPolicy.outputSize(forTextureWidth: textureWidth, height: textureHeight)
     }
@@ -126,70 +90,23 @@ class IRGLFish2PanoShaderParams: IRGLShaderParams {
                                                                y: y)
     }
 
-    func initPixelMaps() {
-        let transX = transformX * DTOR
-        let transY = transformY * DTOR
-        let transZ = transformZ * DTOR
-        let tlat1 = tan(lat1 * DTOR)
-        let tlat2 = tan(lat2 * DTOR)
-        let lng1 = long1 * DTOR
-        let dlng = long2 * DTOR - lng1
-        let raperture = 2.0 / (fishaperture * DTOR)
-        let y0 = (tlat1 + tlat2) / (tlat1 - tlat2)
-
-        for y in 0..<outputHeight {
-            for x in 0..<outputWidth {
-                for i in 0..<antialias {
-                    let fractionX = Float(x) + Float(i) / Float(antialias)
-                    let xx = fractionX / Float(outputWidth)
-                    let longitude = lng1 + xx * dlng
-                    for j in 0..<antialias {
-                        let fractionY = Float(y) + Float(j) / Float(antialias)
-                        let normalizedY = 2.0 * fractionY / Float(outputHeight)
-                        let yy = normalizedY - 1.0
-                        let latitude: Float
-                        if yy > y0 {
-                            latitude = (1.0 - y0) == 0 ? 0 : atan((yy - y0) * tlat2 / (1.0 - y0))
-                        } else {
-                            latitude = (-1.0 - y0) == 0 ? 0 : atan((yy - y0) * tlat1 / (-1.0 - y0))
-                        }
-                        setPixelFactors(latitude, longitude, Int(antialias * i + j), Int(x), Int(y), transX, transY, transZ, raperture)
-                    }
-                }
-            }
-        }
-    }
-
-    func setPixelFactors(_ latitude: Float, _ longitude: Float, _ index: Int, _ x: Int, _ y: Int, _ transX: Float, _ transY: Float, _ transZ: Float, _ raperture: Float) {
-        guard let uvOffset = Self.pixelMapUVOffset(outputWidth: outputWidth, outputHeight: outputHeight, x: x, y: y) else {
-            return
-        }
-        var p = XYZ(x: cos(latitude) * cos(longitude), y: cos(latitude) * sin(longitude), z: sin(latitude))
-
-        if transX != 0 { p = PRotateX(p, transX) }
-        if transY != 0 { p = PRotateY(p, transY) }
-        if transZ != 0 { p = PRotateZ(p, transZ) }
-
-        let theta = atan2(p.y, p.x)
-        let phi = atan2(sqrt(p.x * p.x + p.y * p.y), p.z)
-        let r = phi * raperture
-
-        let u = Float(fishcenterx) + Float(fishradiush) * r * cos(theta)
-        if u < 0 || u >= Float(textureWidth) {
-            pixUV?[index]?[uvOffset] = -1
-            pixUV?[index]?[uvOffset + 1] = -1
-            return
-        }
-
-        let v = Float(textureHeight) - Float(fishcentery) + Float(fishradiush) * r * sin(theta)
-        if v < 0 || v >= Float(textureHeight) {
-            pixUV?[index]?[uvOffset] = -1
-            pixUV?[index]?[uvOffset + 1] = -1
-            return
-        }
-
-        pixUV?[index]?[uvOffset] = GLfloat(u)
-        pixUV?[index]?[uvOffset + 1] = GLfloat(v)
+    var pixelMapGeometry: IRGLFish2PanoPixelMapGeometry {
+        return IRGLFish2PanoPixelMapGeometry(outputWidth: Int(outputWidth),
+                                             outputHeight: Int(outputHeight),
+                                             antialias: Int(antialias),
+                                             textureWidth: Int(textureWidth),
+                                             textureHeight: Int(textureHeight),
+                                             fishCenterX: Int(fishcenterx),
+                                             fishCenterY: Int(fishcentery),
+                                             fishRadiusH: Int(fishradiush),
+                                             fishAperture: fishaperture,
+                                             lat1: lat1,
+                                             lat2: lat2,
+                                             long1: long1,
+                                             long2: long2,
+                                             transformX: transformX,
+                                             transformY: transformY,
+                                             transformZ: transformZ)
     }
 
     func setDefaultValues() {
@@ -251,28 +168,23 @@ class IRGLFish2PanoShaderParams: IRGLShaderParams {
         transformZ = -90.0
 
         pixelMapQueue.async {
-            guard let texnum = Self.pixelMapTextureCount(antialias: self.antialias),
-                  let pixelMapCapacity = Self.pixelMapCapacity(outputWidth: self.outputWidth, outputHeight: self.outputHeight) else {
+            guard Self.pixelMapTextureCount(antialias: self.antialias) != nil,
+                  Self.pixelMapCapacity(outputWidth: self.outputWidth, outputHeight: self.outputHeight) != nil else {
                 return
             }
-            if self.metalPixUVReady {
-                self.releaseCurrentPixUV()
-            }
-            self.pixUV = .allocate(capacity: texnum)
-            self.pixUVTextureCount = texnum
-            for i in 0..<texnum {
-                self.pixUV?[i] = .allocate(capacity: pixelMapCapacity)
-            }
-            self.initPixelMaps()
-            guard IRGLFish2PanoShaderParamsPolicy.shouldPublishPixelMap(
-                jobGeneration: jobGeneration,
-                currentGeneration: self.currentPixelMapGeneration()
-            ) else {
-                self.releaseCurrentPixUV()
+            let geometry = self.pixelMapGeometry
+            let cached = self.pixelMapCache?.load(geometry)
+            guard let pixelMap = cached ?? IRGLFish2PanoPackedPixelMap(building: geometry),
+                  IRGLFish2PanoShaderParamsPolicy.shouldPublishPixelMap(
+                      jobGeneration: jobGeneration,
+                      currentGeneration: self.currentPixelMapGeneration()
+                  ) else {
                 return
             }
-            self.useTexUVs = true
-            self.metalPixUVReady = true
+            if cached == nil {
+                self.pixelMapCache?.store(pixelMap)
+            }
+            self.publish(pixelMap)
         }
     }
 }
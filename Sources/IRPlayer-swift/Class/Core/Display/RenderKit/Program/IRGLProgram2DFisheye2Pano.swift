@@ -28,6 +28,7 @@ import Foundation
 
     override func initShaderParams() {
         fish2Pano = IRGLFish2PanoShaderParams()
+        fish2Pano?.pixelMapCache = .shared
         fish2Pano?.delegate = self
     }
 
@@ -27,19 +27,6 @@ enum IRGLProjectionEquirectangularPolicy {
         return true
     }
 
-    static func maxItem(in array: UnsafeMutablePointer<Int>?, size: Int) -> Int? {
-        guard let array, size > 0 else { return nil }
-
-        var max = array[0]
-        for i in 1..<size {
-            if array[i] > max {
-                max = array[i]
-            }
-        }
-
-        return max
-    }
-
     static func bufferPlan(slices: Int,
                            indicesPerVertex: Int) -> IRGLProjectionEquirectangular.BufferPlan? {
         guard slices > 0, indicesPerVertex > 0 else { return nil }
@@ -70,18 +57,4 @@ enum IRGLProjectionEquirectangularPolicy {
 
         return count
     }
-
-    static func byteCount(elementCount: Int, stride: Int) -> Int? {
-        guard elementCount > 0, stride > 0 else { return nil }
-
-        let (count, overflow) = elementCount.multipliedReportingOverflow(by: stride)
-        guard !overflow, count > 0 else { return nil }
-
-        return count
-    }
-
-    static func indexValue(_ value: Int) -> Int16? {
-        guard value >= Int(Int16.min), value <= Int(Int16.max) else { return nil }
-        return Int16(value)
-    }
 }
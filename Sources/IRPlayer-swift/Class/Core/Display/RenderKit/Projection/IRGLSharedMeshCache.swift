@@ -0,0 +1,139 @@
+//
+//  IRGLSharedMeshCache.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Process-wide store for immutable meshes shared between views. Each key is built
+/// once; concurrent requests wait on, or are notified by, the build in flight.
+/// Entries are reference counted through their holders: once a handed-out value is
+/// referenced by the cache alone it is dropped at the next insertion or purge.
+final class IRGLSharedMeshCache<Key: Hashable, Value: AnyObject> {
+    private final class Slot {
+        var value: Value?
+        var build: DispatchGroup?
+        var completions: [(Value?) -> Void] = []
+        var claimed = false
+    }
+
+    private let lock = NSLock()
+    private let buildQueue: DispatchQueue
+    private var slots: [Key: Slot] = [:]
+
+    init(buildQueue: DispatchQueue = DispatchQueue(label: "irplayer.mesh.build", qos: .userInitiated, attributes: .concurrent)) {
+        self.buildQueue = buildQueue
+    }
+
+    /// Keys with a built value still held by the cache.
+    var keys: [Key] {
+        lock.lock()
+        defer { lock.unlock() }
+        return slots.filter { $0.value.value != nil }.map(\.key)
+    }
+
+    /// Returns the value for `key`, building it on this thread unless another
+    /// build is already in flight, in which case this waits for that one.
+    func value(for key: Key, build: () -> Value?) -> Value? {
+        lock.lock()
+        if let slot = slots[key] {
+            if let value = slot.value {
+                slot.claimed = true
+                lock.unlock()
+                return value
+            }
+            if let pending = slot.build {
+                lock.unlock()
+                pending.wait()
+                return self.value(for: key, build: build)
+            }
+        }
+        let slot = beginBuild(for: key)
+        lock.unlock()
+
+        let value = build()
+        finishBuild(slot, key: key, value: value, claimed: true)
+        return value
+    }
+
+    /// Returns the value for `key` if it is built. Otherwise starts a single
+    /// background build, if none is running, and returns nil; `completion` runs
+    /// on the build queue once the value is available.
+    func valueIfReady(for key: Key,
+                      build: @escaping () -> Value?,
+                      completion: @escaping (Value?) -> Void) -> Value? {
+        lock.lock()
+        defer { lock.unlock() }
+        if let slot = slots[key] {
+            if let value = slot.value {
+                slot.claimed = true
+                return value
+            }
+            if slot.build != nil {
+                slot.completions.append(completion)
+                return nil
+            }
+        }
+
+        let slot = beginBuild(for: key)
+        slot.completions.append(completion)
+        buildQueue.async {
+            self.finishBuild(slot, key: key, value: build(), claimed: false)
+        }
+        return nil
+    }
+
+    /// Drops values that were handed out and are no longer held by anyone else.
+    func purgeUnused() {
+        lock.lock()
+        defer { lock.unlock() }
+        purgeUnusedLocked()
+    }
+
+    func removeAll() {
+        lock.lock()
+        defer { lock.unlock() }
+        slots = slots.filter { $0.value.build != nil }
+    }
+
+    private func beginBuild(for key: Key) -> Slot {
+        let slot = Slot()
+        let group = DispatchGroup()
+        group.enter()
+        slot.build = group
+        slots[key] = slot
+        return slot
+    }
+
+    private func finishBuild(_ slot: Slot, key: Key, value: Value?, claimed: Bool) {
+        lock.lock()
+        if value != nil {
+            purgeUnusedLocked()
+        }
+        let group = slot.build
+        let completions = slot.completions
+        slot.build = nil
+        slot.completions = []
+        slot.value = value
+        slot.claimed = claimed
+        if value == nil, slots[key] === slot {
+            slots[key] = nil
+        }
+        lock.unlock()
+
+        group?.leave()
+        completions.forEach { $0(value) }
+    }
+
+    /// Values are only retained on behalf of callers while the lock is held, so a
+    /// uniquely referenced value cannot be picked up concurrently.
+    private func purgeUnusedLocked() {
+        for (key, slot) in slots where slot.claimed && slot.build == nil {
+            if isKnownUniquelyReferenced(&slot.value) {
+                slots[key] = nil
+            }
+        }
+    }
+}
@@ -0,0 +1,171 @@
+//
+//  IRGLSphereMesh.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import simd
+
+/// Identifies a fisheye sphere mesh: its tessellation and the fisheye circle it
+/// samples. The failable init applies the projection's centred fallback first, so
+/// parameters that render the same mesh always produce the same key.
+struct IRGLSphereMeshKey: Hashable {
+    let slices: Int
+    let textureWidth: Float
+    let textureHeight: Float
+    let centerX: Float
+    let centerY: Float
+    let radius: Float
+
+    init?(slices: Int, textureWidth: Float, textureHeight: Float, centerX: Float, centerY: Float, radius: Float) {
+        let resolved = IRMetalFisheyeMeshPolicy.resolveParams(textureWidth: textureWidth,
+                                                              textureHeight: textureHeight,
+                                                              centerX: centerX,
+                                                              centerY: centerY,
+                                                              radius: radius)
+        guard slices > 0,
+              IRGLProjectionEquirectangularPolicy.isValidGeometry(tw: resolved.textureWidth,
+                                                                  th: resolved.textureHeight,
+                                                                  cr: resolved.radius,
+                                                                  cx: resolved.centerX,
+                                                                  cy: resolved.centerY) else {
+            return nil
+        }
+        self.slices = slices
+        self.textureWidth = resolved.textureWidth
+        self.textureHeight = resolved.textureHeight
+        self.centerX = resolved.centerX
+        self.centerY = resolved.centerY
+        self.radius = resolved.radius
+    }
+
+    /// The same fisheye geometry at another tessellation.
+    func withSlices(_ slices: Int) -> IRGLSphereMeshKey? {
+        return IRGLSphereMeshKey(slices: slices,
+                                 textureWidth: textureWidth,
+                                 textureHeight: textureHeight,
+                                 centerX: centerX,
+                                 centerY: centerY,
+                                 radius: radius)
+    }
+}
+
+/// Triangle-list indices, 16-bit while every vertex fits and 32-bit beyond that.
+enum IRGLSphereMeshIndices {
+    case uint16([UInt16])
+    case uint32([UInt32])
+
+    var count: Int {
+        switch self {
+        case .uint16(let indices): return indices.count
+        case .uint32(let indices): return indices.count
+        }
+    }
+
+    var bytesPerIndex: Int {
+        switch self {
+        case .uint16: return MemoryLayout<UInt16>.stride
+        case .uint32: return MemoryLayout<UInt32>.stride
+        }
+    }
+
+    subscript(index: Int) -> Int {
+        switch self {
+        case .uint16(let indices): return Int(indices[index])
+        case .uint32(let indices): return Int(indices[index])
+        }
+    }
+
+    func withUnsafeBytes<Result>(_ body: (UnsafeRawBufferPointer) throws -> Result) rethrows -> Result {
+        switch self {
+        case .uint16(let indices): return try indices.withUnsafeBytes(body)
+        case .uint32(let indices): return try indices.withUnsafeBytes(body)
+        }
+    }
+}
+
+/// Immutable vertex and index data of a fisheye sphere, shared by every projection
+/// and Metal mesh built for the same key through `shared(for:)`.
+final class IRGLSphereMesh {
+    static let cache = IRGLSharedMeshCache<IRGLSphereMeshKey, IRGLSphereMesh>()
+
+    let key: IRGLSphereMeshKey
+    let positions: [SIMD3<Float>]
+    let texcoords: [SIMD2<Float>]
+    let indices: IRGLSphereMeshIndices
+
+    /// The shared mesh for `key`, built on this thread or awaited from a build
+    /// already in flight.
+    static func shared(for key: IRGLSphereMeshKey) -> IRGLSphereMesh? {
+        return cache.value(for: key) { IRGLSphereMesh(key: key) }
+    }
+
+    static func usesUInt32Indices(vertexCount: Int) -> Bool {
+        return vertexCount > Int(UInt16.max) + 1
+    }
+
+    init?(key: IRGLSphereMeshKey) {
+        guard let plan = IRGLProjectionEquirectangularPolicy.bufferPlan(slices: key.slices, indicesPerVertex: 1),
+              plan.vertexCount <= Int(UInt32.max) + 1 else {
+            return nil
+        }
+
+        let slices = key.slices
+        let iMax = plan.iMax
+        let angleStep: Float = .pi / Float(slices)
+        // One sin/cos per ring and per meridian instead of per vertex.
+        let sines = (0..<iMax).map { sin(angleStep * Float($0)) }
+        let cosines = (0..<iMax).map { cos(angleStep * Float($0)) }
+
+        var positions = [SIMD3<Float>](repeating: .zero, count: plan.vertexCount)
+        var texcoords = [SIMD2<Float>](repeating: .zero, count: plan.vertexCount)
+        for i in 0..<iMax {
+            let sini = sines[i]
+            let cosi = cosines[i]
+            for j in 0..<iMax {
+                let sinisinj = sines[j] * sini
+                let sinicosj = cosines[j] * sini
+
+                positions[i * iMax + j] = SIMD3<Float>(SPHERE_RADIUS * sinisinj,
+                                                       SPHERE_RADIUS * sinicosj,
+                                                       SPHERE_RADIUS * cosi)
+                texcoords[i * iMax + (iMax - j - 1)] = SIMD2<Float>((key.centerX - key.radius * sinicosj) / key.textureWidth,
+                                                                    (key.radius * cosi - key.centerY) / key.textureHeight)
+            }
+        }
+
+        self.key = key
+        self.positions = positions
+        self.texcoords = texcoords
+        if Self.usesUInt32Indices(vertexCount: plan.vertexCount) {
+            indices = .uint32(Self.triangleIndices(slices: slices, count: plan.totalIndices))
+        } else {
+            indices = .uint16(Self.triangleIndices(slices: slices, count: plan.totalIndices))
+        }
+    }
+
+    private static func triangleIndices<Index: FixedWidthInteger>(slices: Int, count: Int) -> [Index] {
+        let iMax = slices + 1
+        var indices = [Index]()
+        indices.reserveCapacity(count)
+        for i in 0..<slices {
+            let i1 = i + 1
+            for j in 0..<slices {
+                let j1 = j + 1
+                let first = Index(truncatingIfNeeded: i * iMax + j)
+                let second = Index(truncatingIfNeeded: i1 * iMax + j)
+                let third = Index(truncatingIfNeeded: i1 * iMax + j1)
+                let fourth = Index(truncatingIfNeeded: i * iMax + j1)
+                indices.append(first)
+                indices.append(second)
+                indices.append(third)
+                indices.append(first)
+                indices.append(third)
+                indices.append(fourth)
+            }
+        }
+        return indices
+    }
+}
@@ -0,0 +1,87 @@
+//
+//  IRGLSphereMeshLODPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Picks the fisheye sphere tessellation from what the viewport can resolve. A
+/// flat triangle spanning `π / slices` sits `R (1 - cos(step / 2))` inside the
+/// sphere; projected from the nearest possible surface, that chord error in pixels
+/// grows with the viewport height and shrinks with the field of view, which is
+/// where the scope's zoom shows up.
+enum IRGLSphereMeshLODPolicy {
+    /// Tessellations a fisheye geometry can be drawn at, coarsest first. Each is
+    /// built only once a view asks for it.
+    static let sliceLevels = [32, 64, 128, 256]
+    static let maxErrorPixels: Float = 0.5
+
+    /// Pixels per radian at the edge of a perspective view, where they are densest.
+    static func pixelsPerRadian(viewportHeight: Float, fovDegrees: Float) -> Float? {
+        guard viewportHeight.isFinite, viewportHeight > 0,
+              fovDegrees.isFinite, fovDegrees > 0, fovDegrees < 180 else {
+            return nil
+        }
+        let halfFov = fovDegrees * .pi / 360
+        let centre = viewportHeight / 2 / tan(halfFov)
+        return centre / (cos(halfFov) * cos(halfFov))
+    }
+
+    static func chordErrorPixels(slices: Int,
+                                 pixelsPerRadian: Float,
+                                 sphereRadius: Float = SPHERE_RADIUS,
+                                 cameraOffset: Float = 0) -> Float {
+        let step = Float.pi / Float(slices)
+        // 1 - cos(step / 2), without the cancellation at small steps.
+        let sagitta = sphereRadius * 2 * sin(step / 4) * sin(step / 4)
+        return sagitta * pixelsPerRadian / max(sphereRadius - cameraOffset, 1)
+    }
+
+    /// The coarsest level whose chord error stays under `maxErrorPixels`, the
+    /// finest when none does, and the coarsest when nothing can be seen.
+    static func slices(viewportHeight: Float,
+                       fovDegrees: Float,
+                       cameraOffset: Float = 0,
+                       maxErrorPixels: Float = maxErrorPixels) -> Int {
+        guard let pixelsPerRadian = pixelsPerRadian(viewportHeight: viewportHeight, fovDegrees: fovDegrees) else {
+            return sliceLevels[0]
+        }
+        return sliceLevels.first {
+            chordErrorPixels(slices: $0, pixelsPerRadian: pixelsPerRadian, cameraOffset: cameraOffset) <= maxErrorPixels
+        } ?? sliceLevels[sliceLevels.count - 1]
+    }
+
+    /// The level that covers `slices`: the coarsest at least as fine, else the finest.
+    static func level(for slices: Int) -> Int {
+        return sliceLevels.first { $0 >= slices } ?? sliceLevels[sliceLevels.count - 1]
+    }
+
+    /// Levels a view keeps while it wants `level`: that one and at most one other.
+    /// Until `level` is built the other is the one drawn in its place; after that it
+    /// is an already built neighbour, so zooming back across the boundary does not
+    /// rebuild it.
+    static func retainedLevels(for level: Int, available: Set<Int>) -> Set<Int> {
+        let others = available.subtracting([level])
+        guard available.contains(level) else {
+            return closestLevel(to: level, available: others).map { [$0] } ?? []
+        }
+        guard let index = sliceLevels.firstIndex(of: level) else { return [level] }
+        let neighbour = [index - 1, index + 1]
+            .filter { sliceLevels.indices.contains($0) && others.contains(sliceLevels[$0]) }
+            .first
+            .map { sliceLevels[$0] }
+        return neighbour.map { [level, $0] } ?? [level]
+    }
+
+    /// The level to draw while others are still being built: the requested one,
+    /// else the next finer, else the finest coarser one.
+    static func closestLevel(to slices: Int, available: Set<Int>) -> Int? {
+        return available.filter { $0 >= slices }.min() ?? available.max()
+    }
+
+    static func triangleCount(slices: Int) -> Int {
+        return slices * slices * 2
+    }
+}
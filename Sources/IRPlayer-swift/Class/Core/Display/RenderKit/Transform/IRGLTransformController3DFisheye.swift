@@ -66,6 +66,11 @@ class IRGLTransformController3DFisheye: IRGLTransformController {
         return scope
     }
 
+    /// Sphere tessellation the current viewport height and zoom can resolve.
+    func sphereMeshSlices() -> Int {
+        return IRGLSphereMeshLODPolicy.slices(viewportHeight: Float(scope.h), fovDegrees: fov, cameraOffset: rc)
+    }
+
     class func getScopeRange(of type: IRGLScope3D.TiltType) -> IRGLScopeRange {
         return IRGLFisheyeTransformPolicy.scopeRange(for: type)
     }
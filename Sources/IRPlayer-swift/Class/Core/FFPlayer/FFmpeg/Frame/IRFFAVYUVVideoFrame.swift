@@ -8,6 +8,7 @@
 import Foundation
 import CoreVideo
 import IRFFMpeg
+import IRPlayerObjc
 
 @objcMembers public class IRFFAVYUVVideoFrame: IRFFVideoFrame {
     var channelPixels = [UnsafeMutablePointer<UInt8>?](repeating: nil, count: IRYUVChannel.count.rawValue)
@@ -15,6 +16,11 @@ import IRFFMpeg
     private var channelPixelsBufferSize = [Int](repeating: 0, count: IRYUVChannel.count.rawValue)
     private var channelLengths = [Int](repeating: 0, count: IRYUVChannel.count.rawValue)
     private var channelLinesize = [Int32](repeating: 0, count: IRYUVChannel.count.rawValue)
+    private var channelBytesPerRow = [Int](repeating: 0, count: IRYUVChannel.count.rawValue)
+    // Holds a reference on the decoder's buffers while the frame is queued, so the
+    // planes are read in place instead of being copied into `channelPixels`.
+    private var referencedFrame: UnsafeMutablePointer<AVFrame>?
+    private var isReferencingFrame = false
     private let lock = NSLock()
     private var cachedImage: IRPLFImage?
     private var isImageDirty = true
@@ -47,6 +53,35 @@ import IRFFMpeg
         return IRFFAVYUVVideoFramePolicy.channelBufferSize(for: channel, capacities: capacities)
     }
 
+    /// Set to false to always copy decoded planes, e.g. when a decoder's buffer pool
+    /// must not be held by queued frames.
+    static var referencesDecodedFrames = true
+
+    private static let copiedBytes: UnsafeMutablePointer<Int> = {
+        let counter = UnsafeMutablePointer<Int>.allocate(capacity: 1)
+        counter.initialize(to: 0)
+        return counter
+    }()
+    private static let copyRateLock = NSLock()
+    private static var copyRateSample: (byteCount: Int, time: TimeInterval)?
+
+    /// Total plane bytes copied by the fallback path since launch.
+    static var copiedByteCount: Int {
+        return IRAtomicLoad(copiedBytes)
+    }
+
+    /// Plane bytes copied per second since the previous call.
+    static func copiedBytesPerSecond(now: TimeInterval = ProcessInfo.processInfo.systemUptime) -> Double {
+        copyRateLock.lock()
+        defer { copyRateLock.unlock() }
+        let byteCount = copiedByteCount
+        defer { copyRateSample = (byteCount, now) }
+        guard let previous = copyRateSample else { return 0 }
+        return IRFFAVYUVVideoFramePolicy.bytesPerSecond(byteCount: byteCount,
+                                                         previousByteCount: previous.byteCount,
+                                                         interval: now - previous.time)
+    }
+
     func setFrameData(_ frame: UnsafePointer<AVFrame>, width: Int, height: Int) {
         let linesizeY = frame.pointee.linesize.0
         let linesizeU = frame.pointee.linesize.1
@@ -71,6 +106,13 @@ import IRFFMpeg
 
         self.width = width
         self.height = height
+        cachedImage = nil
+        isImageDirty = true
+
+        if Self.referencesDecodedFrames, referenceFrameData(frame, width: width, height: height) {
+            return
+        }
+        releaseReferencedFrame()
 
         channelLinesize[IRYUVChannel.luma.rawValue] = Int32(linesizeY)
         channelLinesize[IRYUVChannel.chromaB.rawValue] = Int32(linesizeU)
@@ -83,27 +125,48 @@ import IRFFMpeg
         copyFrameData(luma, to: &channelPixels[IRYUVChannel.luma.rawValue], channel: .luma, linesize: linesizeY, width: width, height: height)
         copyFrameData(chromaB, to: &channelPixels[IRYUVChannel.chromaB.rawValue], channel: .chromaB, linesize: linesizeU, width: width / 2, height: height / 2)
         copyFrameData(chromaR, to: &channelPixels[IRYUVChannel.chromaR.rawValue], channel: .chromaR, linesize: linesizeV, width: width / 2, height: height / 2)
-        isImageDirty = true
+        channelBytesPerRow[IRYUVChannel.luma.rawValue] = IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: linesizeY, width: width)
+        channelBytesPerRow[IRYUVChannel.chromaB.rawValue] = IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: linesizeU, width: width / 2)
+        channelBytesPerRow[IRYUVChannel.chromaR.rawValue] = IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: linesizeV, width: width / 2)
+        IRAtomicFetchAdd(Self.copiedBytes, size)
     }
 
     public var luma: UnsafeMutablePointer<UInt8>? {
-        return channelPixels[IRYUVChannel.luma.rawValue]
+        return planePixels(for: .luma)
     }
 
     public var chromaB: UnsafeMutablePointer<UInt8>? {
-        return channelPixels[IRYUVChannel.chromaB.rawValue]
+        return planePixels(for: .chromaB)
     }
 
     public var chromaR: UnsafeMutablePointer<UInt8>? {
-        return channelPixels[IRYUVChannel.chromaR.rawValue]
+        return planePixels(for: .chromaR)
+    }
+
+    /// Row stride of the plane returned by `luma`, `chromaB` or `chromaR`. Referenced
+    /// frames keep the decoder's padded linesize; copied frames are packed.
+    func bytesPerRow(for channel: IRYUVChannel) -> Int {
+        guard channel != .count else { return 0 }
+        let bytesPerRow = channelBytesPerRow[channel.rawValue]
+        if bytesPerRow > 0 {
+            return bytesPerRow
+        }
+        return channel == .luma ? width : width / 2
+    }
+
+    /// True when the planes point into the decoder's reference-counted buffers.
+    var isZeroCopy: Bool {
+        return isReferencingFrame
     }
 
     func flush() {
+        releaseReferencedFrame()
         width = 0
         height = 0
         for i in 0..<IRYUVChannel.count.rawValue {
             channelLengths[i] = 0
             channelLinesize[i] = 0
+            channelBytesPerRow[i] = 0
             if let pixels = channelPixels[i], channelPixelsBufferSize[i] > 0 {
                 memset(pixels, 0, channelPixelsBufferSize[i])
             }
@@ -113,6 +176,25 @@ import IRFFMpeg
         isImageDirty = true
     }
 
+    override func prepareForReuse() {
+        super.prepareForReuse()
+        lock.lock()
+        releaseReferencedFrame()
+        // The copy buffers stay allocated for the next fill; only their layout goes.
+        pixelFormat = nil
+        width = 0
+        height = 0
+        for i in 0..<IRYUVChannel.count.rawValue {
+            channelLengths[i] = 0
+            channelLinesize[i] = 0
+            channelBytesPerRow[i] = 0
+        }
+        size = 0
+        cachedImage = nil
+        isImageDirty = true
+        lock.unlock()
+    }
+
     override func stopPlaying() {
         lock.lock()
         super.stopPlaying()
@@ -126,13 +208,19 @@ import IRFFMpeg
             return cachedImage
         }
         guard width > 0, height > 0, let pixelFormat else { return nil }
-        guard let image = IRYUVConvertToImage(srcData: channelPixels, srcLinesize: channelLinesize, width: width, height: height, pixelFormat: pixelFormat) else { return nil }
+        let channels: [IRYUVChannel] = [.luma, .chromaB, .chromaR]
+        let srcData = channels.map { planePixels(for: $0).map { UnsafePointer($0) } }
+        let srcLinesize = channels.map { Int32(clamping: bytesPerRow(for: $0)) }
+        guard let image = IRYUVConvertToImage(srcData: srcData, srcLinesize: srcLinesize, width: width, height: height, pixelFormat: pixelFormat) else { return nil }
         cachedImage = image
         isImageDirty = false
         return image
     }
 
     deinit {
+        if referencedFrame != nil {
+            av_frame_free(&referencedFrame)
+        }
         for i in 0..<IRYUVChannel.count.rawValue {
             if let pixels = channelPixels[i], channelPixelsBufferSize[i] > 0 {
                 free(pixels)
@@ -140,6 +228,59 @@ import IRFFMpeg
         }
     }
 
+    private func planePixels(for channel: IRYUVChannel) -> UnsafeMutablePointer<UInt8>? {
+        if isReferencingFrame, let frame = referencedFrame {
+            switch channel {
+            case .luma: return frame.pointee.data.0
+            case .chromaB: return frame.pointee.data.1
+            case .chromaR: return frame.pointee.data.2
+            case .count: return nil
+            }
+        }
+        guard channel != .count else { return nil }
+        return channelPixels[channel.rawValue]
+    }
+
+    private func referenceFrameData(_ frame: UnsafePointer<AVFrame>, width: Int, height: Int) -> Bool {
+        let linesizeY = frame.pointee.linesize.0
+        let linesizeU = frame.pointee.linesize.1
+        let linesizeV = frame.pointee.linesize.2
+        guard IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: frame.pointee.buf.0 != nil,
+                                                          width: width,
+                                                          height: height,
+                                                          linesizeY: linesizeY,
+                                                          linesizeU: linesizeU,
+                                                          linesizeV: linesizeV) else {
+            return false
+        }
+        if referencedFrame == nil {
+            referencedFrame = av_frame_alloc()
+        }
+        guard let referencedFrame else { return false }
+        av_frame_unref(referencedFrame)
+        isReferencingFrame = false
+        guard av_frame_ref(referencedFrame, frame) >= 0 else { return false }
+        isReferencingFrame = true
+
+        channelLinesize[IRYUVChannel.luma.rawValue] = linesizeY
+        channelLinesize[IRYUVChannel.chromaB.rawValue] = linesizeU
+        channelLinesize[IRYUVChannel.chromaR.rawValue] = linesizeV
+        channelBytesPerRow[IRYUVChannel.luma.rawValue] = Int(linesizeY)
+        channelBytesPerRow[IRYUVChannel.chromaB.rawValue] = Int(linesizeU)
+        channelBytesPerRow[IRYUVChannel.chromaR.rawValue] = Int(linesizeV)
+        channelLengths[IRYUVChannel.luma.rawValue] = Int(linesizeY) * height
+        channelLengths[IRYUVChannel.chromaB.rawValue] = Int(linesizeU) * (height / 2)
+        channelLengths[IRYUVChannel.chromaR.rawValue] = Int(linesizeV) * (height / 2)
+        size = channelLengths.reduce(0, +)
+        return true
+    }
+
+    private func releaseReferencedFrame() {
+        guard isReferencingFrame, let referencedFrame else { return }
+        av_frame_unref(referencedFrame)
+        isReferencingFrame = false
+    }
+
     private func updateChannelBuffer(for channel: IRYUVChannel, width: Int, height: Int, linesize: Int32) {
         let needSize = IRYUVChannelFilterNeedSize(linesize, width, height, 1)
         channelLengths[channel.rawValue] = needSize
@@ -33,4 +33,30 @@ enum IRFFAVYUVVideoFramePolicy {
         }
         return capacities[channel.rawValue]
     }
+
+    /// Bytes per row of a packed (copied) plane: the copy drops the row padding.
+    static func packedBytesPerRow(linesize: Int32, width: Int) -> Int {
+        guard linesize > 0, width > 0 else { return 0 }
+        return min(Int(linesize), width)
+    }
+
+    /// A decoded frame can be shown in place only when it is reference counted and
+    /// every plane's stride covers the plane's visible width.
+    static func canReferenceFrame(isReferenceCounted: Bool,
+                                  width: Int,
+                                  height: Int,
+                                  linesizeY: Int32,
+                                  linesizeU: Int32,
+                                  linesizeV: Int32) -> Bool {
+        guard isReferenceCounted, width > 0, height > 0 else { return false }
+        let chromaWidth = width / 2
+        return Int(linesizeY) >= width
+            && Int(linesizeU) >= chromaWidth
+            && Int(linesizeV) >= chromaWidth
+    }
+
+    static func bytesPerSecond(byteCount: Int, previousByteCount: Int, interval: TimeInterval) -> Double {
+        guard interval.isFinite, interval > 0, byteCount >= previousByteCount else { return 0 }
+        return Double(byteCount - previousByteCount) / interval
+    }
 }
@@ -9,7 +9,6 @@ import Foundation
 
 @objcMembers public class IRFFAudioFrame: IRFFFrame {
     var samples: UnsafeMutablePointer<Float>?
-    var outputOffset: Int = 0
     private var bufferSize: Int = 0
 
     override var type: IRFFFrameType {
@@ -20,7 +19,6 @@ import Foundation
         guard let sampleCapacity = Self.sampleCapacity(forByteLength: samplesLength) else {
             releaseSamples()
             size = 0
-            outputOffset = 0
             return
         }
 
@@ -32,7 +30,6 @@ import Foundation
             samples = UnsafeMutablePointer<Float>.allocate(capacity: sampleCapacity)
         }
         size = samplesLength
-        outputOffset = 0
     }
 
     deinit {
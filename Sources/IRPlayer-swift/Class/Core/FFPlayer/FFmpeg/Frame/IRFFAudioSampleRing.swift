@@ -0,0 +1,235 @@
+//
+//  IRFFAudioSampleRing.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRPlayerObjc
+
+/// Single-producer/single-consumer ring of interleaved Float samples feeding the
+/// audio render callback.
+///
+/// The decoder's feed thread writes, the render callback reads. Neither side takes a
+/// lock or waits: `write` stores what fits and returns, `read` copies what is there and
+/// zero-fills the rest. Every write also records a pts marker (first sample index,
+/// position, seconds per sample), so after each read the ring publishes the position
+/// of the next sample to be played, not just the pts of the last frame handed out.
+///
+/// `flush()` borrows the consumer role through `consumerToken`, like
+/// `IRFFPacketRingBuffer`. The render callback only tries the token once and outputs
+/// silence if a flush holds it, so it never spins. Call `flush()` from the producer
+/// thread, or while the producer is idle, so markers and samples stay paired.
+final class IRFFAudioSampleRing {
+    private struct Segment {
+        var start: Int
+        var position: TimeInterval
+        var secondsPerSample: TimeInterval
+    }
+
+    private enum Word: Int, CaseIterable {
+        case head
+        case tail
+        case segmentHead
+        case segmentTail
+        case consumerToken
+        case clockBits
+        case secondsPerSampleBits
+        case playbackSecondsPerSampleBits
+        case underruns
+        case primed
+        case endOfStream
+    }
+    private static let noClockBits = bits(.nan)
+
+    let capacity: Int
+    let segmentCapacity: Int
+    private let mask: Int
+    private let segmentMask: Int
+    private let samples: UnsafeMutablePointer<Float>
+    private let segments: UnsafeMutablePointer<Segment>
+    private let words = IRFFPaddedAtomicWords<Word>()
+
+    init(capacity: Int, segmentCapacity: Int = IRFFAudioSampleRingPolicy.defaultSegmentCapacity) {
+        self.capacity = IRFFPacketQueuePolicy.ringCapacity(for: capacity)
+        self.segmentCapacity = IRFFPacketQueuePolicy.ringCapacity(for: segmentCapacity)
+        self.mask = self.capacity - 1
+        self.segmentMask = self.segmentCapacity - 1
+        self.samples = UnsafeMutablePointer<Float>.allocate(capacity: self.capacity)
+        self.samples.initialize(repeating: 0, count: self.capacity)
+        self.segments = UnsafeMutablePointer<Segment>.allocate(capacity: self.segmentCapacity)
+        self.segments.initialize(repeating: Segment(start: 0, position: 0, secondsPerSample: 0), count: self.segmentCapacity)
+        word(.clockBits).pointee = Self.noClockBits
+    }
+
+    convenience init(sampleRate: Float64, channelCount: UInt32) {
+        self.init(capacity: IRFFAudioSampleRingPolicy.capacity(sampleRate: sampleRate, channelCount: channelCount))
+    }
+
+    deinit {
+        samples.deinitialize(count: capacity)
+        samples.deallocate()
+        segments.deinitialize(count: segmentCapacity)
+        segments.deallocate()
+    }
+
+    /// Interleaved samples waiting to be read.
+    var count: Int {
+        return max(0, IRAtomicLoad(word(.tail)) - IRAtomicLoad(word(.head)))
+    }
+
+    /// Seconds per interleaved sample of the latest write, 0 before the first one.
+    var secondsPerSample: TimeInterval {
+        return Self.value(fromBits: IRAtomicLoad(word(.secondsPerSampleBits)))
+    }
+
+    /// Seconds per interleaved sample of the marker the consumer is reading, 0 until a
+    /// read has seen one since the last flush.
+    var playbackSecondsPerSample: TimeInterval {
+        return Self.value(fromBits: IRAtomicLoad(word(.playbackSecondsPerSampleBits)))
+    }
+
+    var bufferedDuration: TimeInterval {
+        return Double(count) * secondsPerSample
+    }
+
+    /// Position of the next sample the consumer will read, or nil until a read has
+    /// seen a pts marker since the last flush.
+    var playbackPosition: TimeInterval? {
+        let position = Self.value(fromBits: IRAtomicLoad(word(.clockBits)))
+        return position.isFinite ? position : nil
+    }
+
+    /// Times the consumer ran dry after having had data, outside of end of stream.
+    var underrunCount: Int {
+        return IRAtomicLoad(word(.underruns))
+    }
+
+    /// Producer side. Copies as many of `sampleCount` samples as fit, tagging the first
+    /// with `position`, and returns how many were written. Samples without a usable
+    /// position or rate continue the previous marker.
+    @discardableResult
+    func write(_ source: UnsafePointer<Float>,
+               count sampleCount: Int,
+               position: TimeInterval,
+               secondsPerSample: TimeInterval) -> Int {
+        let tail = IRAtomicLoad(word(.tail))
+        let segmentTail = IRAtomicLoad(word(.segmentTail))
+        let written = IRFFAudioSampleRingPolicy.writableCount(requested: sampleCount,
+                                                              capacity: capacity,
+                                                              bufferedCount: tail - IRAtomicLoad(word(.head)),
+                                                              segmentCapacity: segmentCapacity,
+                                                              bufferedSegments: segmentTail - IRAtomicLoad(word(.segmentHead)))
+        guard written > 0 else { return 0 }
+
+        let offset = tail & mask
+        let firstPart = min(written, capacity - offset)
+        (samples + offset).update(from: source, count: firstPart)
+        if written > firstPart {
+            samples.update(from: source + firstPart, count: written - firstPart)
+        }
+        IRAtomicStore(word(.endOfStream), 0)
+        if position.isFinite, secondsPerSample.isFinite, secondsPerSample > 0 {
+            segments[segmentTail & segmentMask] = Segment(start: tail, position: position, secondsPerSample: secondsPerSample)
+            IRAtomicStore(word(.secondsPerSampleBits), Self.bits(secondsPerSample))
+            // The marker is published before the samples it describes.
+            IRAtomicStore(word(.segmentTail), segmentTail + 1)
+        }
+        IRAtomicStore(word(.tail), tail + written)
+        return written
+    }
+
+    /// Producer side: the stream has no more samples coming, so running dry is not an
+    /// underrun. Cleared by the next write or flush.
+    func markEndOfStream() {
+        IRAtomicStore(word(.endOfStream), 1)
+    }
+
+    /// Consumer side. Copies up to `sampleCount` samples into `destination`, fills the
+    /// remainder with silence and returns how many samples came from the ring.
+    @discardableResult
+    func read(into destination: UnsafeMutablePointer<Float>, count sampleCount: Int) -> Int {
+        guard sampleCount > 0 else { return 0 }
+        guard IRAtomicCompareExchange(word(.consumerToken), 0, 1) else {
+            destination.update(repeating: 0, count: sampleCount)
+            return 0
+        }
+        let head = IRAtomicLoad(word(.head))
+        let tail = IRAtomicLoad(word(.tail))
+        let readCount = max(0, min(sampleCount, tail - head))
+
+        let offset = head & mask
+        let firstPart = min(readCount, capacity - offset)
+        destination.update(from: samples + offset, count: firstPart)
+        if readCount > firstPart {
+            (destination + firstPart).update(from: samples, count: readCount - firstPart)
+        }
+        let newHead = head + readCount
+        IRAtomicStore(word(.head), newHead)
+        publishClock(at: newHead)
+
+        if readCount < sampleCount {
+            (destination + readCount).update(repeating: 0, count: sampleCount - readCount)
+            if IRAtomicLoad(word(.primed)) != 0, IRAtomicLoad(word(.endOfStream)) == 0 {
+                IRAtomicFetchAdd(word(.underruns), 1)
+            }
+            IRAtomicStore(word(.primed), 0)
+        } else {
+            IRAtomicStore(word(.primed), 1)
+        }
+        IRAtomicStore(word(.consumerToken), 0)
+        return readCount
+    }
+
+    /// Drops every buffered sample and marker and forgets the clock until new samples
+    /// are read. The underrun counter is kept.
+    func flush() {
+        while !IRAtomicCompareExchange(word(.consumerToken), 0, 1) {
+            sched_yield()
+        }
+        IRAtomicStore(word(.head), IRAtomicLoad(word(.tail)))
+        IRAtomicStore(word(.segmentHead), IRAtomicLoad(word(.segmentTail)))
+        IRAtomicStore(word(.clockBits), Self.noClockBits)
+        IRAtomicStore(word(.playbackSecondsPerSampleBits), 0)
+        IRAtomicStore(word(.primed), 0)
+        IRAtomicStore(word(.endOfStream), 0)
+        IRAtomicStore(word(.consumerToken), 0)
+    }
+
+    func resetUnderrunCount() {
+        IRAtomicStore(word(.underruns), 0)
+    }
+
+    /// Moves the current marker up to the last one starting at or before `head` and
+    /// publishes the position of sample `head`.
+    private func publishClock(at head: Int) {
+        var segmentHead = IRAtomicLoad(word(.segmentHead))
+        let segmentTail = IRAtomicLoad(word(.segmentTail))
+        guard segmentHead < segmentTail else { return }
+        while segmentHead + 1 < segmentTail, segments[(segmentHead + 1) & segmentMask].start <= head {
+            segmentHead += 1
+        }
+        IRAtomicStore(word(.segmentHead), segmentHead)
+        let segment = segments[segmentHead & segmentMask]
+        let position = IRFFAudioSampleRingPolicy.position(segmentPosition: segment.position,
+                                                          segmentStart: segment.start,
+                                                          secondsPerSample: segment.secondsPerSample,
+                                                          sampleIndex: head)
+        IRAtomicStore(word(.playbackSecondsPerSampleBits), Self.bits(segment.secondsPerSample))
+        IRAtomicStore(word(.clockBits), Self.bits(position))
+    }
+
+    // Doubles are published through the integer atomics by bit pattern.
+    private static func bits(_ value: TimeInterval) -> Int {
+        return Int(truncatingIfNeeded: value.bitPattern)
+    }
+
+    private static func value(fromBits bits: Int) -> TimeInterval {
+        return TimeInterval(bitPattern: UInt64(truncatingIfNeeded: bits))
+    }
+
+    private func word(_ word: Word) -> UnsafeMutablePointer<Int> {
+        return words[word]
+    }
+}
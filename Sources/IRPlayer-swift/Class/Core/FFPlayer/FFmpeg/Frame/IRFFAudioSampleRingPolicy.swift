@@ -0,0 +1,57 @@
+//
+//  IRFFAudioSampleRingPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+enum IRFFAudioSampleRingPolicy {
+    /// Audio kept ahead of the render callback; the decoder's frame queue holds the rest.
+    static let defaultBufferDuration: TimeInterval = 0.5
+    /// Pts markers the ring can track at once, i.e. how many writes may be queued.
+    static let defaultSegmentCapacity = 256
+    private static let minimumCapacity = 4096
+    private static let maximumCapacity = 1 << 20
+
+    /// Power-of-two sample count holding at least `duration` of interleaved audio.
+    static func capacity(sampleRate: Float64, channelCount: UInt32, duration: TimeInterval = defaultBufferDuration) -> Int {
+        let requested: Double
+        if sampleRate.isFinite, sampleRate > 0, channelCount > 0, duration.isFinite, duration > 0 {
+            requested = min(Double(maximumCapacity), (sampleRate * Double(channelCount) * duration).rounded(.up))
+        } else {
+            requested = 0
+        }
+        var capacity = minimumCapacity
+        while Double(capacity) < requested {
+            capacity <<= 1
+        }
+        return capacity
+    }
+
+    /// Playback time covered by one interleaved sample, or nil for an unusable format.
+    static func secondsPerSample(sampleRate: Float64, channelCount: UInt32) -> TimeInterval? {
+        guard sampleRate.isFinite, sampleRate > 0, channelCount > 0 else { return nil }
+        return 1 / (sampleRate * Double(channelCount))
+    }
+
+    /// Position of sample `sampleIndex` inside a write that started at `segmentStart`
+    /// with pts `segmentPosition`.
+    static func position(segmentPosition: TimeInterval,
+                         segmentStart: Int,
+                         secondsPerSample: TimeInterval,
+                         sampleIndex: Int) -> TimeInterval {
+        return segmentPosition + Double(max(0, sampleIndex - segmentStart)) * secondsPerSample
+    }
+
+    /// Samples the producer may write now: bounded by free space and by a free pts marker.
+    static func writableCount(requested: Int,
+                              capacity: Int,
+                              bufferedCount: Int,
+                              segmentCapacity: Int,
+                              bufferedSegments: Int) -> Int {
+        guard requested > 0, bufferedSegments < segmentCapacity else { return 0 }
+        return max(0, min(requested, capacity - bufferedCount))
+    }
+}
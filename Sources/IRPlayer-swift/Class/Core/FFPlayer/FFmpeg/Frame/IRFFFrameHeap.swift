@@ -0,0 +1,70 @@
+//
+//  IRFFFrameHeap.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Binary min-heap of frames ordered by `IRFFFrameOrderingKey`.
+///
+/// Replaces the sorted array in `IRFFFrameQueue` so a B-frame reordered insert and the
+/// next dequeue are both O(log n) instead of an O(n) `insert(at:)`/`removeFirst()`.
+struct IRFFFrameHeap {
+    private struct Entry {
+        let key: IRFFFrameOrderingKey
+        let frame: IRFFFrame
+    }
+
+    private var entries: [Entry] = []
+
+    var count: Int {
+        return entries.count
+    }
+
+    var isEmpty: Bool {
+        return entries.isEmpty
+    }
+
+    var first: IRFFFrame? {
+        return entries.first?.frame
+    }
+
+    mutating func insert(_ frame: IRFFFrame, key: IRFFFrameOrderingKey) {
+        entries.append(Entry(key: key, frame: frame))
+        var child = entries.count - 1
+        while child > 0 {
+            let parent = (child - 1) / 2
+            guard entries[child].key < entries[parent].key else { break }
+            entries.swapAt(child, parent)
+            child = parent
+        }
+    }
+
+    mutating func popFirst() -> IRFFFrame? {
+        guard !entries.isEmpty else { return nil }
+        entries.swapAt(0, entries.count - 1)
+        let frame = entries.removeLast().frame
+        var parent = 0
+        while true {
+            let left = parent * 2 + 1
+            let right = left + 1
+            var smallest = parent
+            if left < entries.count, entries[left].key < entries[smallest].key {
+                smallest = left
+            }
+            if right < entries.count, entries[right].key < entries[smallest].key {
+                smallest = right
+            }
+            guard smallest != parent else { break }
+            entries.swapAt(parent, smallest)
+            parent = smallest
+        }
+        return frame
+    }
+
+    mutating func removeAll() {
+        entries.removeAll(keepingCapacity: true)
+    }
+}
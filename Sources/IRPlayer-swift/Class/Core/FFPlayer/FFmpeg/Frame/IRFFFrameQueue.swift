@@ -13,10 +13,17 @@ class IRFFFrameQueue: NSObject {
     var count: Int { frames.count }
     @objc dynamic private(set) var duration: TimeInterval = 0
 
-    private var frames: [IRFFFrame] = []
+    private var frames = IRFFFrameHeap()
+    private var nextSequence = 0
     private var condition = NSCondition()
+    private let notifier = IRFFWaitNotifier()
     private var destroyToken = false
 
+    /// Times a waiting consumer woke up, whether a frame arrived or its deadline passed.
+    var wakeupCount: Int {
+        return notifier.wakeupCount
+    }
+
     static func frameQueue() -> IRFFFrameQueue {
         return IRFFFrameQueue()
     }
@@ -48,13 +55,16 @@ class IRFFFrameQueue: NSObject {
             condition.unlock()
             return
         }
-        frames.append(frame)
+        frames.insert(frame, key: IRFFFrameQueuePolicy.appendedOrderingKey(sequence: nextSequence))
+        nextSequence += 1
         duration += Self.accountedDuration(for: frame)
         size += Self.accountedSize(for: frame)
-        condition.signal()
         condition.unlock()
+        notifier.notify()
     }
 
+    /// Inserts in presentation order (see `IRFFFrameQueuePolicy.sortedOrderingKey`).
+    /// Frames added with `putFrame` always dequeue after sorted frames.
     func putSortFrame(_ frame: IRFFFrame?) {
         guard let frame = frame else { return }
         condition.lock()
@@ -62,31 +72,21 @@ class IRFFFrameQueue: NSObject {
             condition.unlock()
             return
         }
-        var added = false
-        if !frames.isEmpty {
-            for i in stride(from: frames.count - 1, through: 0, by: -1) {
-                if Self.shouldInsert(frame, after: frames[i]) {
-                    frames.insert(frame, at: i + 1)
-                    added = true
-                    break
-                }
-            }
-        }
-        if !added {
-            frames.insert(frame, at: 0)
-        }
+        frames.insert(frame, key: IRFFFrameQueuePolicy.sortedOrderingKey(for: frame, sequence: nextSequence))
+        nextSequence += 1
         duration += Self.accountedDuration(for: frame)
         size += Self.accountedSize(for: frame)
-        condition.signal()
         condition.unlock()
+        notifier.notify()
     }
 
     func getFrameSync() -> IRFFFrame? {
-        // Poll instead of blocking on condition.wait() to avoid a priority inversion
-        // warning from the Thread Performance Checker. NSCondition.wait() is an
-        // indefinite block — the checker fires whenever a high-QoS thread waits on a
-        // condition that a lower-QoS thread must signal, regardless of the queue's QoS
-        // setting. A 5 ms sleep is imperceptible at 30/60 fps.
+        return getFrame(until: .distantFuture)
+    }
+
+    /// Blocks until a frame is available, the queue is destroyed, or `deadline` passes.
+    /// Producers wake the waiter directly, so there is no polling interval to add jitter.
+    func getFrame(until deadline: DispatchTime) -> IRFFFrame? {
         while true {
             condition.lock()
             if destroyToken {
@@ -94,20 +94,15 @@ class IRFFFrameQueue: NSObject {
                 return nil
             }
             if !frames.isEmpty {
-                let frame = frames.removeFirst()
-                duration -= Self.accountedDuration(for: frame)
-                if duration < 0 || count <= 0 {
-                    duration = 0
-                }
-                size -= Self.accountedSize(for: frame)
-                if size <= 0 || count <= 0 {
-                    size = 0
-                }
+                let frame = removeFirstFrameLocked()
                 condition.unlock()
                 return frame
             }
+            notifier.prepareToWait()
             condition.unlock()
-            Thread.sleep(forTimeInterval: 0.005)
+            if !notifier.wait(until: deadline) {
+                return getFrameAsync()
+            }
         }
     }
 
@@ -117,15 +112,7 @@ class IRFFFrameQueue: NSObject {
             condition.unlock()
             return nil
         }
-        let frame = frames.removeFirst()
-        duration -= Self.accountedDuration(for: frame)
-        if duration < 0 || count <= 0 {
-            duration = 0
-        }
-        size -= Self.accountedSize(for: frame)
-        if size <= 0 || count <= 0 {
-            size = 0
-        }
+        let frame = removeFirstFrameLocked()
         condition.unlock()
         return frame
     }
@@ -140,8 +127,21 @@ class IRFFFrameQueue: NSObject {
         condition.lock()
         flushLocked()
         destroyToken = true
-        condition.broadcast()
         condition.unlock()
+        notifier.wake()
+    }
+
+    private func removeFirstFrameLocked() -> IRFFFrame? {
+        guard let frame = frames.popFirst() else { return nil }
+        duration -= Self.accountedDuration(for: frame)
+        if duration < 0 || count <= 0 {
+            duration = 0
+        }
+        size -= Self.accountedSize(for: frame)
+        if size <= 0 || count <= 0 {
+            size = 0
+        }
+        return frame
     }
 
     private func flushLocked() {
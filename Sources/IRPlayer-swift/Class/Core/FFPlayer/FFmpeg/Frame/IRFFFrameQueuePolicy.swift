@@ -7,6 +7,25 @@
 
 import Foundation
 
+/// Pop order for `IRFFFrameHeap`. Sorted inserts rank finite positions first (by
+/// position), then non-finite positions; FIFO inserts rank after both. Ties break
+/// on insertion sequence, so equal keys keep arrival order.
+struct IRFFFrameOrderingKey: Comparable {
+    let rank: Int
+    let position: TimeInterval
+    let sequence: Int
+
+    static func < (lhs: IRFFFrameOrderingKey, rhs: IRFFFrameOrderingKey) -> Bool {
+        if lhs.rank != rhs.rank {
+            return lhs.rank < rhs.rank
+        }
+        if lhs.position != rhs.position {
+            return lhs.position < rhs.position
+        }
+        return lhs.sequence < rhs.sequence
+    }
+}
+
 enum IRFFFrameQueuePolicy {
     static func sleepTimeIntervalForFull(maxVideoDuration: TimeInterval) -> TimeInterval {
         return maxVideoDuration / 2.0
@@ -34,4 +53,18 @@ enum IRFFFrameQueuePolicy {
         }
         return false
     }
+
+    /// Key matching `shouldInsert(_:after:)`: a finite frame lands after every queued
+    /// finite frame at or before its position and ahead of non-finite frames, which
+    /// keep arrival order at the back.
+    static func sortedOrderingKey(for frame: IRFFFrame, sequence: Int) -> IRFFFrameOrderingKey {
+        if frame.position.isFinite {
+            return IRFFFrameOrderingKey(rank: 0, position: frame.position, sequence: sequence)
+        }
+        return IRFFFrameOrderingKey(rank: 1, position: 0, sequence: sequence)
+    }
+
+    static func appendedOrderingKey(sequence: Int) -> IRFFFrameOrderingKey {
+        return IRFFFrameOrderingKey(rank: 2, position: 0, sequence: sequence)
+    }
 }
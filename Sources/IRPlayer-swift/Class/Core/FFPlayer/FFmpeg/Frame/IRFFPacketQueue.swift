@@ -9,19 +9,28 @@ import Foundation
 import IRFFMpeg
 
 class IRFFPacketQueue: NSObject {
-    private(set) var size: Int = 0
-    @objc dynamic private(set) var duration: TimeInterval = 0
+    static let defaultCapacity = 4096
+
+    var size: Int {
+        return ring.size
+    }
+    @objc dynamic var duration: TimeInterval {
+        return ring.duration
+    }
     private(set) var timebase: TimeInterval
-    private var condition = NSCondition()
-    private var packets = [IRFFPacketQueueEntry]()
-    private var destroyToken = false
+    private let ring: IRFFPacketRingBuffer
 
     var count: Int {
-        return packets.count
+        return ring.count
+    }
+
+    var capacity: Int {
+        return ring.capacity
     }
 
-    init(timebase: TimeInterval) {
+    init(timebase: TimeInterval, capacity: Int = IRFFPacketQueue.defaultCapacity) {
         self.timebase = timebase
+        self.ring = IRFFPacketRingBuffer(capacity: capacity)
         super.init()
     }
 
@@ -30,65 +39,31 @@ class IRFFPacketQueue: NSObject {
     }
 
     func putPacket(_ packet: AVPacket, duration: TimeInterval) {
-        condition.lock()
-        if destroyToken {
-            condition.unlock()
-            return
-        }
         let packetDuration = Self.accountedDuration(for: packet, fallbackDuration: duration, timebase: timebase)
-        packets.append(IRFFPacketQueueEntry(packet: packet, duration: packetDuration))
-        size += Self.accountedSize(for: packet)
-        self.duration += packetDuration
-        condition.signal()
-        condition.unlock()
+        ring.put(packet, size: Self.accountedSize(for: packet), duration: packetDuration)
     }
 
     func getPacket() -> AVPacket {
-        condition.lock()
+        if let packet = getPacket(timeout: nil) {
+            return packet
+        }
         var packet = AVPacket()
         packet.stream_index = -2
-        while packets.isEmpty {
-            if destroyToken {
-                condition.unlock()
-                return packet
-            }
-            condition.wait()
-        }
-        let entry = packets.removeFirst()
-        packet = entry.packet
-        size -= Self.accountedSize(for: packet)
-        if size < 0 || count <= 0 {
-            size = 0
-        }
-        duration -= entry.duration
-        if duration < 0 || count <= 0 {
-            duration = 0
-        }
-        condition.unlock()
         return packet
     }
 
-    func flush() {
-        condition.lock()
-        flushLocked()
-        condition.unlock()
+    /// Waits up to `timeout` for the next packet. Returns nil on timeout or once the
+    /// queue has been destroyed; a nil timeout waits until a packet arrives.
+    func getPacket(timeout: TimeInterval?) -> AVPacket? {
+        return ring.take(timeout: timeout)?.packet
     }
 
-    func destroy() {
-        condition.lock()
-        flushLocked()
-        destroyToken = true
-        condition.broadcast()
-        condition.unlock()
+    func flush() {
+        ring.flush()
     }
 
-    private func flushLocked() {
-        for i in packets.indices {
-            av_packet_unref(&packets[i].packet)
-        }
-        packets.removeAll()
-        size = 0
-        duration = 0
+    func destroy() {
+        ring.destroy()
     }
 
     static func accountedDuration(for packet: AVPacket,
@@ -101,8 +76,3 @@ class IRFFPacketQueue: NSObject {
         return IRFFPacketQueuePolicy.accountedSize(for: packet)
     }
 }
-
-private struct IRFFPacketQueueEntry {
-    var packet: AVPacket
-    let duration: TimeInterval
-}
@@ -9,6 +9,9 @@ import Foundation
 import IRFFMpeg
 
 enum IRFFPacketQueuePolicy {
+    static let durationTicksPerSecond: TimeInterval = 1_000_000_000
+    private static let maxAccountedDuration: TimeInterval = 1_000_000
+
     static func accountedDuration(for packet: AVPacket,
                                   fallbackDuration: TimeInterval,
                                   timebase: TimeInterval) -> TimeInterval {
@@ -28,4 +31,22 @@ enum IRFFPacketQueuePolicy {
     static func accountedSize(for packet: AVPacket) -> Int {
         return max(0, Int(packet.size))
     }
+
+    static func durationTicks(for duration: TimeInterval) -> Int {
+        guard duration.isFinite, duration > 0 else { return 0 }
+        return Int((min(duration, maxAccountedDuration) * durationTicksPerSecond).rounded())
+    }
+
+    static func duration(fromTicks ticks: Int) -> TimeInterval {
+        guard ticks > 0 else { return 0 }
+        return TimeInterval(ticks) / durationTicksPerSecond
+    }
+
+    static func ringCapacity(for requestedCapacity: Int) -> Int {
+        var capacity = 2
+        while capacity < requestedCapacity, capacity < (1 << 20) {
+            capacity <<= 1
+        }
+        return capacity
+    }
 }
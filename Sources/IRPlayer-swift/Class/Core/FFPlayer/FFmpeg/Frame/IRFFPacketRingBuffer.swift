@@ -0,0 +1,179 @@
+//
+//  IRFFPacketRingBuffer.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+import IRPlayerObjc
+
+/// Bounded single-producer/single-consumer packet ring.
+///
+/// The producer owns `tail` and the consumer owns `head`; both are published with
+/// acquire/release atomics, so enqueueing and dequeueing never take a lock. Each side
+/// parks on an `IRFFWaitNotifier` only when the ring is empty or full.
+/// `flush()` and `destroy()` may be called from any thread: they borrow the consumer
+/// role through `consumerToken`, which the consumer only holds while dequeuing and
+/// never while waiting.
+final class IRFFPacketRingBuffer {
+    struct Entry {
+        var packet: AVPacket
+        let size: Int
+        let durationTicks: Int
+    }
+
+    private enum Word: Int, CaseIterable {
+        case head
+        case tail
+        case size
+        case durationTicks
+        case consumerToken
+        case destroyed
+    }
+
+    let capacity: Int
+    private let mask: Int
+    private let slots: UnsafeMutablePointer<Entry>
+    private let words = IRFFPaddedAtomicWords<Word>()
+    private let dataAvailable = IRFFWaitNotifier()
+    private let spaceAvailable = IRFFWaitNotifier()
+
+    init(capacity: Int) {
+        self.capacity = IRFFPacketQueuePolicy.ringCapacity(for: capacity)
+        self.mask = self.capacity - 1
+        self.slots = UnsafeMutablePointer<Entry>.allocate(capacity: self.capacity)
+        self.slots.initialize(repeating: Entry(packet: AVPacket(), size: 0, durationTicks: 0), count: self.capacity)
+    }
+
+    deinit {
+        let head = IRAtomicLoad(word(.head))
+        let tail = IRAtomicLoad(word(.tail))
+        for index in head..<tail {
+            av_packet_unref(&slots[index & mask].packet)
+        }
+        slots.deinitialize(count: capacity)
+        slots.deallocate()
+    }
+
+    var count: Int {
+        return max(0, IRAtomicLoad(word(.tail)) - IRAtomicLoad(word(.head)))
+    }
+
+    var size: Int {
+        return max(0, IRAtomicLoad(word(.size)))
+    }
+
+    var duration: TimeInterval {
+        return IRFFPacketQueuePolicy.duration(fromTicks: IRAtomicLoad(word(.durationTicks)))
+    }
+
+    var destroyed: Bool {
+        return IRAtomicLoad(word(.destroyed)) != 0
+    }
+
+    /// Producer side. Blocks while the ring is full; returns false once destroyed.
+    @discardableResult
+    func put(_ packet: AVPacket, size: Int, duration: TimeInterval) -> Bool {
+        let tail = IRAtomicLoad(word(.tail))
+        while tail - IRAtomicLoad(word(.head)) >= capacity {
+            if destroyed {
+                return false
+            }
+            spaceAvailable.prepareToWait()
+            if tail - IRAtomicLoad(word(.head)) < capacity || destroyed {
+                spaceAvailable.cancelWait()
+                continue
+            }
+            _ = spaceAvailable.wait(until: .now() + .milliseconds(10))
+        }
+        if destroyed {
+            return false
+        }
+        let entry = Entry(packet: packet, size: max(0, size), durationTicks: IRFFPacketQueuePolicy.durationTicks(for: duration))
+        slots[tail & mask] = entry
+        IRAtomicFetchAdd(word(.size), entry.size)
+        IRAtomicFetchAdd(word(.durationTicks), entry.durationTicks)
+        IRAtomicStore(word(.tail), tail + 1)
+        dataAvailable.notify()
+        return true
+    }
+
+    /// Consumer side. Returns nil when the ring is destroyed or, with a timeout,
+    /// when no packet arrived in time. A nil timeout waits until a packet arrives.
+    func take(timeout: TimeInterval? = nil) -> Entry? {
+        let deadline = timeout.map { DispatchTime.now() + $0 }
+        while true {
+            if let entry = tryTake() {
+                return entry
+            }
+            if destroyed {
+                return nil
+            }
+            dataAvailable.prepareToWait()
+            if IRAtomicLoad(word(.tail)) != IRAtomicLoad(word(.head)) || destroyed {
+                dataAvailable.cancelWait()
+                continue
+            }
+            if !dataAvailable.wait(until: deadline ?? .distantFuture) {
+                return tryTake()
+            }
+        }
+    }
+
+    func tryTake() -> Entry? {
+        acquireConsumerToken()
+        let head = IRAtomicLoad(word(.head))
+        guard head != IRAtomicLoad(word(.tail)) else {
+            releaseConsumerToken()
+            return nil
+        }
+        let entry = slots[head & mask]
+        IRAtomicStore(word(.head), head + 1)
+        releaseConsumerToken()
+        IRAtomicFetchAdd(word(.size), -entry.size)
+        IRAtomicFetchAdd(word(.durationTicks), -entry.durationTicks)
+        spaceAvailable.notify()
+        return entry
+    }
+
+    func flush() {
+        acquireConsumerToken()
+        let head = IRAtomicLoad(word(.head))
+        let tail = IRAtomicLoad(word(.tail))
+        var releasedSize = 0
+        var releasedTicks = 0
+        for index in head..<tail {
+            releasedSize += slots[index & mask].size
+            releasedTicks += slots[index & mask].durationTicks
+            av_packet_unref(&slots[index & mask].packet)
+        }
+        IRAtomicStore(word(.head), tail)
+        releaseConsumerToken()
+        IRAtomicFetchAdd(word(.size), -releasedSize)
+        IRAtomicFetchAdd(word(.durationTicks), -releasedTicks)
+        spaceAvailable.notify()
+    }
+
+    func destroy() {
+        IRAtomicExchange(word(.destroyed), 1)
+        flush()
+        dataAvailable.wake()
+        spaceAvailable.wake()
+    }
+
+    private func acquireConsumerToken() {
+        while !IRAtomicCompareExchange(word(.consumerToken), 0, 1) {
+            sched_yield()
+        }
+    }
+
+    private func releaseConsumerToken() {
+        IRAtomicStore(word(.consumerToken), 0)
+    }
+
+    private func word(_ word: Word) -> UnsafeMutablePointer<Int> {
+        return words[word]
+    }
+}
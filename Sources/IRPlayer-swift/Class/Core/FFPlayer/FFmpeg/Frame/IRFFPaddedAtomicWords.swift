@@ -0,0 +1,37 @@
+//
+//  IRFFPaddedAtomicWords.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Integer words shared between threads through the `IRAtomic` functions, one per
+/// case of `Word`.
+///
+/// Each word sits on its own 128-byte line, the cache line size on Apple silicon, so
+/// a producer and a consumer publishing different words don't false-share.
+final class IRFFPaddedAtomicWords<Word: CaseIterable & RawRepresentable> where Word.RawValue == Int {
+    static var lineStride: Int {
+        return 128 / MemoryLayout<Int>.stride
+    }
+
+    private let storage: UnsafeMutablePointer<Int>
+    private let storageCount: Int
+
+    init() {
+        storageCount = Word.allCases.count * Self.lineStride
+        storage = UnsafeMutablePointer<Int>.allocate(capacity: storageCount)
+        storage.initialize(repeating: 0, count: storageCount)
+    }
+
+    deinit {
+        storage.deinitialize(count: storageCount)
+        storage.deallocate()
+    }
+
+    subscript(word: Word) -> UnsafeMutablePointer<Int> {
+        return storage + word.rawValue * Self.lineStride
+    }
+}
@@ -0,0 +1,183 @@
+//
+//  IRFFPresentationScheduler.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import QuartzCore
+
+/// Hands decoded frames from the display thread to a vsync-driven consumer.
+///
+/// The display thread stamps each frame with the host time it should appear at and
+/// parks in `waitForSpace(until:)` while the ring is full, instead of sleeping on its
+/// own estimate of the frame interval. The view's display link calls
+/// `frame(forVsyncAt:interval:)` once per vsync. Host times share the
+/// `CACurrentMediaTime()` base with `CADisplayLink.targetTimestamp`.
+///
+/// The scheduler is only used while `isActive`, i.e. while a display link is driving
+/// it; otherwise the decoder falls back to pushing frames through `send(videoFrame:)`.
+/// The link only needs to fire while `needsVsync`; the demand handler runs, on the
+/// thread that changed it, whenever that flips.
+final class IRFFPresentationScheduler {
+    private let lock = NSLock()
+    private var ring: IRFFPresentationRing<IRFFVideoFrame>
+    private var active = false
+    private var vsyncDemanded = false
+    private var vsyncDemandHandler: (() -> Void)?
+    private let spaceAvailable = IRFFWaitNotifier()
+
+    init(capacity: Int = IRFFPresentationSchedulerPolicy.defaultCapacity) {
+        ring = IRFFPresentationRing(capacity: capacity)
+    }
+
+    static func hostTime() -> TimeInterval {
+        return CACurrentMediaTime()
+    }
+
+    var isActive: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return active
+    }
+
+    /// Deactivating drops the queued frames so a later activation starts clean.
+    func setActive(_ isActive: Bool) {
+        lock.lock()
+        active = isActive
+        if !isActive {
+            ring.removeAll()
+        }
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        spaceAvailable.notify()
+        demandChanged?()
+    }
+
+    /// True while an active scheduler holds frames waiting for a vsync and is not
+    /// suspended.
+    var needsVsync: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return active && ring.needsVsync
+    }
+
+    func setVsyncDemandHandler(_ handler: (() -> Void)?) {
+        lock.lock()
+        vsyncDemandHandler = handler
+        lock.unlock()
+    }
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.count
+    }
+
+    var presentedFrameCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.presentedCount
+    }
+
+    var droppedFrameCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.droppedCount
+    }
+
+    var repeatedFrameCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.repeatedCount
+    }
+
+    /// Producer side. Returns false when the deadline passed with the ring still full.
+    func waitForSpace(until deadline: DispatchTime) -> Bool {
+        while true {
+            if !isFull {
+                return true
+            }
+            spaceAvailable.prepareToWait()
+            if !isFull {
+                spaceAvailable.cancelWait()
+                return true
+            }
+            if !spaceAvailable.wait(until: deadline) {
+                return !isFull
+            }
+        }
+    }
+
+    @discardableResult
+    func enqueue(_ frame: IRFFVideoFrame, targetHostTime: TimeInterval) -> Bool {
+        lock.lock()
+        let enqueued = ring.enqueue(frame, targetHostTime: targetHostTime, duration: frame.duration)
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        demandChanged?()
+        return enqueued
+    }
+
+    /// Consumer side: the frame to show at this vsync, or nil to keep the current one.
+    func frame(forVsyncAt vsyncHostTime: TimeInterval, interval: TimeInterval) -> IRFFVideoFrame? {
+        lock.lock()
+        let countBefore = ring.count
+        let frame = ring.frame(forVsyncAt: vsyncHostTime, interval: interval)
+        let freedSpace = ring.count < countBefore
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        if freedSpace {
+            spaceAvailable.notify()
+        }
+        demandChanged?()
+        return frame
+    }
+
+    func suspend(at hostTime: TimeInterval = IRFFPresentationScheduler.hostTime()) {
+        lock.lock()
+        ring.suspend(at: hostTime)
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        demandChanged?()
+    }
+
+    func resume(at hostTime: TimeInterval = IRFFPresentationScheduler.hostTime()) {
+        lock.lock()
+        ring.resume(at: hostTime)
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        demandChanged?()
+    }
+
+    /// Starts the counters over, e.g. when a new item opens in the same view.
+    func resetCounters() {
+        lock.lock()
+        ring.resetCounters()
+        lock.unlock()
+    }
+
+    func removeAll() {
+        lock.lock()
+        ring.removeAll()
+        let demandChanged = vsyncDemandChange()
+        lock.unlock()
+        spaceAvailable.notify()
+        demandChanged?()
+    }
+
+    /// Call with `lock` held; returns the handler to run once it is released.
+    private func vsyncDemandChange() -> (() -> Void)? {
+        let demanded = active && ring.needsVsync
+        guard demanded != vsyncDemanded else { return nil }
+        vsyncDemanded = demanded
+        return vsyncDemandHandler
+    }
+
+    private var isFull: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return ring.isFull
+    }
+}
@@ -0,0 +1,79 @@
+//
+//  IRFFSharedAudioClock.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRPlayerObjc
+
+/// Hands the latest `IRFFAudioClock` from the render callback to the display thread.
+///
+/// A sequence lock over atomic words: the single writer (the render callback) never
+/// waits, and readers retry while a store is in progress.
+final class IRFFSharedAudioClock {
+    private enum Word: Int, CaseIterable {
+        case sequence
+        case positionBits
+        case hostTimeBits
+        case pendingDurationBits
+        case rateBits
+    }
+
+    private let words: UnsafeMutablePointer<Int>
+
+    init() {
+        words = UnsafeMutablePointer<Int>.allocate(capacity: Word.allCases.count)
+        words.initialize(repeating: 0, count: Word.allCases.count)
+    }
+
+    deinit {
+        words.deinitialize(count: Word.allCases.count)
+        words.deallocate()
+    }
+
+    /// Writer side; only the render callback stores.
+    func store(_ clock: IRFFAudioClock) {
+        let sequence = IRAtomicLoad(word(.sequence))
+        IRAtomicStore(word(.sequence), sequence + 1)
+        IRAtomicStore(word(.positionBits), Self.bits(clock.position))
+        IRAtomicStore(word(.hostTimeBits), Self.bits(clock.hostTime))
+        IRAtomicStore(word(.pendingDurationBits), Self.bits(clock.pendingDuration))
+        IRAtomicStore(word(.rateBits), Self.bits(clock.rate))
+        IRAtomicStore(word(.sequence), sequence + 2)
+    }
+
+    /// The last stored clock, or nil before the first store.
+    func load() -> IRFFAudioClock? {
+        while true {
+            let before = IRAtomicLoad(word(.sequence))
+            if before == 0 {
+                return nil
+            }
+            if before & 1 != 0 {
+                sched_yield()
+                continue
+            }
+            let clock = IRFFAudioClock(position: Self.value(fromBits: IRAtomicLoad(word(.positionBits))),
+                                       hostTime: Self.value(fromBits: IRAtomicLoad(word(.hostTimeBits))),
+                                       pendingDuration: Self.value(fromBits: IRAtomicLoad(word(.pendingDurationBits))),
+                                       rate: Self.value(fromBits: IRAtomicLoad(word(.rateBits))))
+            if IRAtomicLoad(word(.sequence)) == before {
+                return clock
+            }
+        }
+    }
+
+    private func word(_ word: Word) -> UnsafeMutablePointer<Int> {
+        return words + word.rawValue
+    }
+
+    private static func bits(_ value: TimeInterval) -> Int {
+        return Int(truncatingIfNeeded: value.bitPattern)
+    }
+
+    private static func value(fromBits bits: Int) -> TimeInterval {
+        return TimeInterval(bitPattern: UInt64(truncatingIfNeeded: bits))
+    }
+}
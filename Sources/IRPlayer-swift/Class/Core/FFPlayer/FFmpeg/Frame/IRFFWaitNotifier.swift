@@ -0,0 +1,71 @@
+//
+//  IRFFWaitNotifier.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRPlayerObjc
+
+/// Single-waiter event used to park a consumer thread until a producer hands it work.
+///
+/// The waiter announces itself with `prepareToWait()`, re-checks its condition, and
+/// only then blocks in `wait(until:)`; `notify()` signals the semaphore only when a
+/// waiter is parked, so producers pay one atomic exchange on the fast path.
+///
+/// Unlike `NSCondition.wait()`, every wait is bounded by a deadline, and the decoder
+/// runs both sides on the same `.userInitiated` operation queue, so the waiter never
+/// blocks on a lower-QoS signaller.
+final class IRFFWaitNotifier {
+    private let semaphore = DispatchSemaphore(value: 0)
+    private let state = UnsafeMutablePointer<Int>.allocate(capacity: 2)
+
+    private var waiting: UnsafeMutablePointer<Int> { state }
+    private var wakeups: UnsafeMutablePointer<Int> { state + 1 }
+
+    init() {
+        state.initialize(repeating: 0, count: 2)
+    }
+
+    deinit {
+        state.deinitialize(count: 2)
+        state.deallocate()
+    }
+
+    /// Number of times a parked waiter returned from the semaphore, signalled or not.
+    var wakeupCount: Int {
+        return IRAtomicLoad(wakeups)
+    }
+
+    func prepareToWait() {
+        IRAtomicExchange(waiting, 1)
+    }
+
+    func cancelWait() {
+        IRAtomicExchange(waiting, 0)
+    }
+
+    /// Returns false when the deadline passed without a notification.
+    func wait(until deadline: DispatchTime) -> Bool {
+        let result = semaphore.wait(timeout: deadline)
+        IRAtomicFetchAdd(wakeups, 1)
+        if result == .timedOut {
+            cancelWait()
+            return false
+        }
+        return true
+    }
+
+    func notify() {
+        if IRAtomicExchange(waiting, 0) != 0 {
+            semaphore.signal()
+        }
+    }
+
+    /// Wakes a parked waiter unconditionally, e.g. on destroy.
+    func wake() {
+        IRAtomicExchange(waiting, 0)
+        semaphore.signal()
+    }
+}
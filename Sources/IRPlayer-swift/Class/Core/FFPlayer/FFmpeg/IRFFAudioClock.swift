@@ -0,0 +1,59 @@
+//
+//  IRFFAudioClock.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// What the speaker is playing, anchored at the last render callback.
+///
+/// Each callback re-anchors the clock on the sample after the last one it rendered and
+/// the host time at which that sample reaches the speaker: the callback's host time
+/// plus the rendered duration and the output latency. Between callbacks the position
+/// follows host time. It never runs past the rendered samples, so a stalled or paused
+/// output freezes the clock, and it never reaches back beyond the audio still queued
+/// between the callback and the speaker. While playing at `rate`, position moves `rate`
+/// seconds per second of host time.
+struct IRFFAudioClock: Equatable {
+    /// Position of the sample after the last one rendered.
+    let position: TimeInterval
+    /// Host time at which that sample reaches the speaker.
+    let hostTime: TimeInterval
+    /// Rendered audio not yet heard at the time of the callback.
+    let pendingDuration: TimeInterval
+    /// Media seconds played per host second.
+    let rate: Double
+
+    init(position: TimeInterval, hostTime: TimeInterval, pendingDuration: TimeInterval, rate: Double = 1) {
+        self.position = position
+        self.hostTime = hostTime
+        self.pendingDuration = pendingDuration
+        self.rate = rate
+    }
+
+    /// Anchor for a callback at `renderHostTime` that rendered `renderedDuration` of
+    /// audio ending just before `endPosition`, played at `rate`. Returns nil for
+    /// non-finite input.
+    static func rendered(endPosition: TimeInterval,
+                         renderedDuration: TimeInterval,
+                         renderHostTime: TimeInterval,
+                         outputLatency: TimeInterval,
+                         rate: Double = 1) -> IRFFAudioClock? {
+        guard endPosition.isFinite, renderHostTime.isFinite else { return nil }
+        let rendered = renderedDuration.isFinite ? max(0, renderedDuration) : 0
+        let latency = outputLatency.isFinite ? max(0, outputLatency) : 0
+        return IRFFAudioClock(position: endPosition,
+                              hostTime: renderHostTime + rendered + latency,
+                              pendingDuration: rendered + latency,
+                              rate: rate.isFinite && rate > 0 ? rate : 1)
+    }
+
+    /// Position audible at `hostTime`.
+    func position(atHostTime hostTime: TimeInterval) -> TimeInterval {
+        guard hostTime.isFinite else { return position }
+        let offset = min(0, max(-pendingDuration, hostTime - self.hostTime))
+        return position + offset * rate
+    }
+}
@@ -24,11 +24,11 @@ class IRFFAudioDecoder {
     private var samplingRate: Float64 = 0
     private var channelCount: UInt32 = 0
     private var audioSwrContext: OpaquePointer?
-    private var audioSwrBuffer: UnsafeMutableRawPointer?
-    private var audioSwrBufferSize: Int = 0
 
     private var frameQueue: IRFFFrameQueue
     private var framePool: IRFFFramePool
+    /// Set by a flush for an accurate seek; cleared by the first frame queued after it.
+    private var seekTarget: TimeInterval?
 
     static func decoder(codecContext: UnsafeMutablePointer<AVCodecContext>, timebase: TimeInterval, delegate: IRFFAudioDecoderDelegate) -> IRFFAudioDecoder {
         return IRFFAudioDecoder(codecContext: codecContext, timebase: timebase, delegate: delegate)
@@ -52,8 +52,14 @@ class IRFFAudioDecoder {
         reloadAudioOutputInfo()
         guard let outputInfo = Self.swrOutputInfo(samplingRate: samplingRate, channelCount: channelCount),
               let inputInfo = Self.swrInputInfo(from: codecContext) else { return }
+        // Interleaved Float32 at the output rate and layout is copied as decoded.
+        guard Self.requiresResampling(inputSampleFormat: inputInfo.sampleFormat,
+                                      inputSamplingRate: inputInfo.samplingRate,
+                                      inputChannelCount: inputInfo.channelCount,
+                                      outputSamplingRate: outputInfo.samplingRate,
+                                      outputChannelCount: outputInfo.channelCount) else { return }
 
-        audioSwrContext = swr_alloc_set_opts(nil, av_get_default_channel_layout(outputInfo.channelCount), AV_SAMPLE_FMT_S16, outputInfo.samplingRate, av_get_default_channel_layout(inputInfo.channelCount), inputInfo.sampleFormat, inputInfo.samplingRate, 0, nil)
+        audioSwrContext = swr_alloc_set_opts(nil, av_get_default_channel_layout(outputInfo.channelCount), Self.swrOutputSampleFormat, outputInfo.samplingRate, av_get_default_channel_layout(inputInfo.channelCount), inputInfo.sampleFormat, inputInfo.samplingRate, 0, nil)
 
         let result = swr_init(audioSwrContext)
         let error: Error? = IRFFCheckError(result)
@@ -88,6 +94,10 @@ class IRFFAudioDecoder {
         )
     }
 
+    static var swrOutputSampleFormat: AVSampleFormat {
+        return IRFFAudioDecoderPolicy.swrOutputSampleFormat
+    }
+
     static func swrOutputInfo(samplingRate: Float64, channelCount: UInt32) -> (samplingRate: Int32, channelCount: Int32)? {
         return IRFFAudioDecoderPolicy.swrOutputInfo(samplingRate: samplingRate, channelCount: channelCount)
     }
@@ -145,11 +155,26 @@ class IRFFAudioDecoder {
         return IRFFAudioDecoderPolicy.canUseDirectOutput(sampleFormat: sampleFormat)
     }
 
+    static func requiresResampling(inputSampleFormat: AVSampleFormat,
+                                   inputSamplingRate: Int32,
+                                   inputChannelCount: Int32,
+                                   outputSamplingRate: Int32,
+                                   outputChannelCount: Int32) -> Bool {
+        return IRFFAudioDecoderPolicy.requiresResampling(inputSampleFormat: inputSampleFormat,
+                                                         inputSamplingRate: inputSamplingRate,
+                                                         inputChannelCount: inputChannelCount,
+                                                         outputSamplingRate: outputSamplingRate,
+                                                         outputChannelCount: outputChannelCount)
+    }
+
     func duration() -> TimeInterval {
         return frameQueue.duration
     }
 
-    func flush() {
+    /// With `seekTarget` the samples decoded before the target are dropped, so the
+    /// audio clock starts where the seek asked for.
+    func flush(seekTarget: TimeInterval? = nil) {
+        self.seekTarget = seekTarget
         frameQueue.flush()
         framePool.flush()
         if let codecContext = codecContext {
@@ -185,7 +210,7 @@ class IRFFAudioDecoder {
             }
             autoreleasepool {
                 if let frame = decode() {
-                    frameQueue.putFrame(frame)
+                    enqueue(frame)
                 }
             }
         }
@@ -193,6 +218,17 @@ class IRFFAudioDecoder {
         return 0
     }
 
+    private func enqueue(_ frame: IRFFAudioFrame) {
+        if seekTarget != nil {
+            guard IRFFDecoder.presentsFrame(position: frame.position, duration: frame.duration, seekTarget: seekTarget) else {
+                frame.cancel()
+                return
+            }
+            seekTarget = nil
+        }
+        frameQueue.putFrame(frame)
+    }
+
     private func decode() -> IRFFAudioFrame? {
         guard Self.shouldDecodeFrame(hasFrame: tempFrame != nil, hasPrimaryData: tempFrame?.pointee.data.0 != nil),
               let tempFrame else {
@@ -201,30 +237,36 @@ class IRFFAudioDecoder {
 
         reloadAudioOutputInfo()
 
-        var numberOfFrames: Int
-        var audioDataBuffer: UnsafeMutableRawPointer
+        guard let audioFrame = framePool.getUnuseFrame() as? IRFFAudioFrame else {
+            return nil
+        }
+        // A frame that cannot be filled goes straight back to the pool rather than
+        // staying in its used set.
+        guard fill(audioFrame, from: tempFrame) else {
+            audioFrame.cancel()
+            return nil
+        }
+        return audioFrame
+    }
 
+    private func fill(_ audioFrame: IRFFAudioFrame, from tempFrame: UnsafeMutablePointer<AVFrame>) -> Bool {
+        let numberOfFrames: Int
         if let audioSwrContext = audioSwrContext {
-            guard let outputInfo = Self.swrOutputInfo(samplingRate: samplingRate, channelCount: channelCount),
-                  let ratio = Self.resampleRatio(outputSamplingRate: samplingRate,
+            guard let ratio = Self.resampleRatio(outputSamplingRate: samplingRate,
                                                  inputSamplingRate: codecContext?.pointee.sample_rate ?? 0,
                                                  outputChannelCount: channelCount,
                                                  inputChannelCount: codecContext?.pointee.channels ?? 0),
-                  let frameCapacity = Self.resampleFrameCapacity(inputFrameCount: tempFrame.pointee.nb_samples, ratio: ratio) else {
-                return nil
-            }
-            let bufferSize = av_samples_get_buffer_size(nil, outputInfo.channelCount, frameCapacity, AV_SAMPLE_FMT_S16, 1)
-            guard bufferSize > 0 else { return nil }
-
-            if audioSwrBuffer == nil || audioSwrBufferSize < bufferSize {
-                let requestedBufferSize = Int(bufferSize)
-                guard let newBuffer = realloc(audioSwrBuffer, requestedBufferSize) else { return nil }
-                audioSwrBuffer = newBuffer
-                audioSwrBufferSize = requestedBufferSize
+                  let frameCapacity = Self.resampleFrameCapacity(inputFrameCount: tempFrame.pointee.nb_samples, ratio: ratio),
+                  let elementCapacity = Self.sampleElementCount(numberOfFrames: Int(frameCapacity), channelCount: channelCount),
+                  let byteCapacity = Self.sampleByteCount(numberOfElements: elementCapacity) else {
+                return false
             }
 
-            var outputBuffer: [UnsafeMutablePointer<UInt8>?] = [audioSwrBuffer?.assumingMemoryBound(to: UInt8.self), nil]
-            guard let inputChannelCapacity = Self.inputChannelCapacity(from: codecContext) else { return nil }
+            // swresample writes interleaved Float32 straight into the frame's samples.
+            audioFrame.setSamplesLength(byteCapacity)
+            guard let samples = audioFrame.samples else { return false }
+            var outputBuffer: [UnsafeMutablePointer<UInt8>?] = [UnsafeMutableRawPointer(samples).assumingMemoryBound(to: UInt8.self), nil]
+            guard let inputChannelCapacity = Self.inputChannelCapacity(from: codecContext) else { return false }
             let inputPointer: UnsafeMutablePointer<UnsafePointer<UInt8>?> = withUnsafeMutablePointer(to: &tempFrame.pointee.data) {
                 $0.withMemoryRebound(to: UnsafePointer<UInt8>?.self, capacity: inputChannelCapacity) {
                     $0
@@ -235,43 +277,46 @@ class IRFFAudioDecoder {
             let error: Error? = IRFFCheckError(Int32(numberOfFrames))
             if error != nil {
                 IRFFErrorLog("audio codec error : \(String(describing: error))")
-                return nil
+                return false
             }
-            guard let swrBuffer = Self.audioDataBuffer(fromSwrBuffer: audioSwrBuffer) else { return nil }
-            audioDataBuffer = swrBuffer
         } else {
-            if !Self.canUseDirectOutput(sampleFormat: codecContext?.pointee.sample_fmt ?? AV_SAMPLE_FMT_NONE) {
+            let sampleFormat = codecContext?.pointee.sample_fmt ?? AV_SAMPLE_FMT_NONE
+            if !Self.canUseDirectOutput(sampleFormat: sampleFormat) ||
+                codecContext?.pointee.channels != Int32(clamping: channelCount) {
                 IRFFErrorLog("audio format error")
-                return nil
+                return false
             }
-            guard let decodedDataBuffer = Self.audioDataBuffer(fromDecodedData: tempFrame.pointee.data.0) else { return nil }
-            audioDataBuffer = decodedDataBuffer
+            guard let decodedDataBuffer = Self.audioDataBuffer(fromDecodedData: tempFrame.pointee.data.0) else { return false }
             numberOfFrames = Int(tempFrame.pointee.nb_samples)
+            guard let numberOfElements = Self.sampleElementCount(numberOfFrames: numberOfFrames, channelCount: channelCount),
+                  let sampleByteCount = Self.sampleByteCount(numberOfElements: numberOfElements) else {
+                return false
+            }
+            audioFrame.setSamplesLength(sampleByteCount)
+            guard let samples = audioFrame.samples else { return false }
+            if sampleFormat == AV_SAMPLE_FMT_FLT {
+                memcpy(samples, decodedDataBuffer, sampleByteCount)
+            } else {
+                var scale: Float32 = 1.0 / Float32(Int16.max)
+                let audioDataPointer = decodedDataBuffer.bindMemory(to: Int16.self, capacity: numberOfElements)
+                vDSP_vflt16(audioDataPointer, 1, samples, 1, vDSP_Length(numberOfElements))
+                vDSP_vsmul(samples, 1, &scale, samples, 1, vDSP_Length(numberOfElements))
+            }
         }
 
-        guard let audioFrame = framePool.getUnuseFrame() as? IRFFAudioFrame else {
-            return nil
-        }
-        
         audioFrame.position = IRFFFrameTime.position(timestamp: tempFrame.pointee.best_effort_timestamp, timebase: timebase)
 
         guard let numberOfElements = Self.sampleElementCount(numberOfFrames: numberOfFrames, channelCount: channelCount) else {
-            return nil
+            return false
         }
         guard let sampleByteCount = Self.sampleByteCount(numberOfElements: numberOfElements) else {
-            return nil
+            return false
         }
+        // Trims the size to what was produced; the buffer is not reallocated.
         audioFrame.setSamplesLength(sampleByteCount)
         let fallbackDuration = Self.fallbackDuration(sampleByteCount: sampleByteCount, channelCount: channelCount, samplingRate: samplingRate)
         audioFrame.duration = Self.decodedFrameDuration(ticks: tempFrame.pointee.duration, timebase: timebase, fallbackDuration: fallbackDuration)
-        guard let samples = audioFrame.samples else { return nil }
-
-        var scale: Float32 = 1.0 / Float32(Int16.max)
-        let audioDataPointer = audioDataBuffer.bindMemory(to: Int16.self, capacity: numberOfElements)
-        vDSP_vflt16(audioDataPointer, 1, samples, 1, vDSP_Length(numberOfElements))
-        vDSP_vsmul(samples, 1, &scale, samples, 1, vDSP_Length(numberOfElements))
-
-        return audioFrame
+        return true
     }
 
     private func reloadAudioOutputInfo() {
@@ -280,11 +325,6 @@ class IRFFAudioDecoder {
     }
 
     deinit {
-        if audioSwrBuffer != nil {
-            free(audioSwrBuffer)
-            audioSwrBuffer = nil
-            audioSwrBufferSize = 0
-        }
         if audioSwrContext != nil {
             swr_free(&audioSwrContext)
         }
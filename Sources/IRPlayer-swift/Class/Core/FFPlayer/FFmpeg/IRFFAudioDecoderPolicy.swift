@@ -3,6 +3,9 @@ import IRFFMpeg
 import IRPlayerObjc
 
 enum IRFFAudioDecoderPolicy {
+    /// Interleaved Float32, the layout of `IRFFAudioFrame.samples`, so resampled audio
+    /// needs no further conversion.
+    static let swrOutputSampleFormat = AV_SAMPLE_FMT_FLT
 
     static func sampleElementCount(numberOfFrames: Int, channelCount: UInt32) -> Int? {
         guard numberOfFrames > 0, channelCount > 0 else { return nil }
@@ -140,6 +143,18 @@ enum IRFFAudioDecoderPolicy {
     }
 
     static func canUseDirectOutput(sampleFormat: AVSampleFormat) -> Bool {
-        return sampleFormat == AV_SAMPLE_FMT_S16
+        return sampleFormat == AV_SAMPLE_FMT_FLT || sampleFormat == AV_SAMPLE_FMT_S16
+    }
+
+    /// False when decoded samples are already interleaved Float32 at the output rate
+    /// and channel count, so they can be copied into the frame without swresample.
+    static func requiresResampling(inputSampleFormat: AVSampleFormat,
+                                   inputSamplingRate: Int32,
+                                   inputChannelCount: Int32,
+                                   outputSamplingRate: Int32,
+                                   outputChannelCount: Int32) -> Bool {
+        return inputSampleFormat != swrOutputSampleFormat ||
+            inputSamplingRate != outputSamplingRate ||
+            inputChannelCount != outputChannelCount
     }
 }
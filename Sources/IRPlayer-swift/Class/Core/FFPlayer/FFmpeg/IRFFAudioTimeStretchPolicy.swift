@@ -0,0 +1,102 @@
+//
+//  IRFFAudioTimeStretchPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+enum IRFFAudioTimeStretchPolicy {
+    /// Length of one overlap-add window; consecutive windows overlap by half.
+    static let windowDuration: TimeInterval = 0.02
+    /// How far a window may move from its nominal position to line up with the previous one.
+    static let searchDuration: TimeInterval = 0.005
+    private static let minimumWindowFrameCount = 16
+
+    /// Even window length in frames for `sampleRate`.
+    static func windowFrameCount(sampleRate: Double) -> Int {
+        guard sampleRate.isFinite, sampleRate > 0 else { return minimumWindowFrameCount }
+        let frames = Int((sampleRate * windowDuration / 2).rounded()) * 2
+        return max(minimumWindowFrameCount, frames)
+    }
+
+    static func searchFrameCount(sampleRate: Double) -> Int {
+        guard sampleRate.isFinite, sampleRate > 0 else { return 1 }
+        return max(1, Int((sampleRate * searchDuration).rounded()))
+    }
+
+    /// Offset from the nominal window position tried at step `index` of the search:
+    /// 0, -1, 1, -2, 2, ... so that ties go to the candidate closest to nominal.
+    static func searchOffset(at index: Int) -> Int {
+        guard index > 0 else { return 0 }
+        return index % 2 == 1 ? -(index + 1) / 2 : index / 2
+    }
+
+    /// Frames the analysis position advances per output hop.
+    static func analysisHop(rate: Double, hopFrameCount: Int) -> Double {
+        return IRPlayerRate.normalized(rate) * Double(hopFrameCount)
+    }
+
+    /// Raised-cosine fade-in for frame `frame` of a hop; the fade-out is its complement,
+    /// so the two always sum to one.
+    static func fadeInWeight(frame: Int, hopFrameCount: Int) -> Float {
+        guard hopFrameCount > 0 else { return 1 }
+        let phase = Double.pi * (Double(frame) + 0.5) / Double(hopFrameCount)
+        return Float(0.5 - 0.5 * cos(phase))
+    }
+
+    /// How well a candidate continues the previous window: its correlation with the
+    /// previous window's tail over the candidate's own energy. Silence scores 0.
+    static func similarity(correlation: Float, energy: Float) -> Float {
+        guard energy > 0, energy.isFinite, correlation.isFinite else { return 0 }
+        return correlation / energy.squareRoot()
+    }
+
+    /// Sum of `a[i] * b[i]`, eight lanes at a time.
+    static func dot(_ a: UnsafePointer<Float>, _ b: UnsafePointer<Float>, count: Int) -> Float {
+        let rawA = UnsafeRawPointer(a)
+        let rawB = UnsafeRawPointer(b)
+        let stride = MemoryLayout<Float>.stride
+        var accumulator = SIMD8<Float>()
+        var index = 0
+        while index + 8 <= count {
+            let x = rawA.loadUnaligned(fromByteOffset: index * stride, as: SIMD8<Float>.self)
+            let y = rawB.loadUnaligned(fromByteOffset: index * stride, as: SIMD8<Float>.self)
+            accumulator += x * y
+            index += 8
+        }
+        var sum = accumulator.sum()
+        while index < count {
+            sum += a[index] * b[index]
+            index += 1
+        }
+        return sum
+    }
+
+    /// `output[i] = fadeOut[i] + (fadeIn[i] - fadeOut[i]) * weights[i]`, eight lanes at a time.
+    static func crossfade(from fadeOut: UnsafePointer<Float>,
+                          to fadeIn: UnsafePointer<Float>,
+                          weights: UnsafePointer<Float>,
+                          into output: UnsafeMutablePointer<Float>,
+                          count: Int) {
+        let rawOut = UnsafeRawPointer(fadeOut)
+        let rawIn = UnsafeRawPointer(fadeIn)
+        let rawWeights = UnsafeRawPointer(weights)
+        let rawOutput = UnsafeMutableRawPointer(output)
+        let stride = MemoryLayout<Float>.stride
+        var index = 0
+        while index + 8 <= count {
+            let offset = index * stride
+            let a = rawOut.loadUnaligned(fromByteOffset: offset, as: SIMD8<Float>.self)
+            let b = rawIn.loadUnaligned(fromByteOffset: offset, as: SIMD8<Float>.self)
+            let w = rawWeights.loadUnaligned(fromByteOffset: offset, as: SIMD8<Float>.self)
+            rawOutput.storeBytes(of: a + (b - a) * w, toByteOffset: offset, as: SIMD8<Float>.self)
+            index += 8
+        }
+        while index < count {
+            output[index] = fadeOut[index] + (fadeIn[index] - fadeOut[index]) * weights[index]
+            index += 1
+        }
+    }
+}
@@ -0,0 +1,171 @@
+//
+//  IRFFAudioTimeStretcher.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// WSOLA time stretch for interleaved Float audio: plays `rate` times faster or slower
+/// without changing pitch.
+///
+/// Windows of `windowFrameCount` input frames are taken every `rate * hopFrameCount`
+/// frames and overlap-added every `hopFrameCount` output frames. Before each window is
+/// added it may shift by up to `searchFrameCount` frames to where it best continues the
+/// previous window, which keeps the waveform phase-continuous. At rate 1 the best shift
+/// is always 0 and the output reproduces the input.
+///
+/// The kernels use Swift SIMD types only, so the stretcher behaves the same on every
+/// platform. Not thread-safe; the decoder's audio feed thread owns it.
+final class IRFFAudioTimeStretcher {
+    let sampleRate: Double
+    let channelCount: Int
+    let windowFrameCount: Int
+    let hopFrameCount: Int
+    let searchFrameCount: Int
+
+    var rate: Double {
+        didSet {
+            rate = IRPlayerRate.normalized(rate)
+        }
+    }
+
+    private var input: [Float] = []
+    /// Absolute index of the frame at `input[0]`.
+    private var inputStartFrame = 0
+    /// Absolute nominal start of the next window.
+    private var analysisFrame: Double = 0
+    /// Second half of the previous window, which the next window fades in over.
+    private var tail: [Float]
+    private var hasTail = false
+    /// Position of absolute frame 0, taken from the first append after a reset.
+    private var originPosition: TimeInterval?
+    /// Fade-in weight per interleaved sample of a hop.
+    private let fadeWeights: [Float]
+
+    init(sampleRate: Double, channelCount: Int, rate: Double = 1) {
+        self.sampleRate = sampleRate.isFinite && sampleRate > 0 ? sampleRate : 1
+        self.channelCount = max(1, channelCount)
+        self.windowFrameCount = IRFFAudioTimeStretchPolicy.windowFrameCount(sampleRate: sampleRate)
+        self.hopFrameCount = windowFrameCount / 2
+        self.searchFrameCount = IRFFAudioTimeStretchPolicy.searchFrameCount(sampleRate: sampleRate)
+        self.rate = IRPlayerRate.normalized(rate)
+        self.tail = [Float](repeating: 0, count: hopFrameCount * self.channelCount)
+        var weights = [Float](repeating: 0, count: hopFrameCount * self.channelCount)
+        for frame in 0..<hopFrameCount {
+            let weight = IRFFAudioTimeStretchPolicy.fadeInWeight(frame: frame, hopFrameCount: hopFrameCount)
+            for channel in 0..<self.channelCount {
+                weights[frame * self.channelCount + channel] = weight
+            }
+        }
+        self.fadeWeights = weights
+    }
+
+    /// Input frames held back for the next windows.
+    var bufferedFrameCount: Int {
+        return input.count / channelCount
+    }
+
+    /// Queues `frameCount` interleaved frames. Input is assumed continuous; `position`
+    /// only anchors the timeline on the first append after a reset.
+    func append(_ samples: UnsafePointer<Float>, frameCount: Int, position: TimeInterval) {
+        guard frameCount > 0 else { return }
+        if originPosition == nil, position.isFinite {
+            originPosition = position - Double(inputStartFrame + bufferedFrameCount) / sampleRate
+        }
+        input.append(contentsOf: UnsafeBufferPointer(start: samples, count: frameCount * channelCount))
+    }
+
+    /// Writes as many whole hops as fit in `frameCapacity` frames and returns how many
+    /// frames were written and the input position the first one stands for.
+    @discardableResult
+    func process(into output: UnsafeMutablePointer<Float>, frameCapacity: Int) -> (frameCount: Int, position: TimeInterval) {
+        var producedFrames = 0
+        var firstPosition = TimeInterval.nan
+        while producedFrames + hopFrameCount <= frameCapacity, let start = nextWindowStart() {
+            if producedFrames == 0 {
+                firstPosition = (originPosition ?? .nan) + analysisFrame / sampleRate
+            }
+            renderWindow(at: start, into: output + producedFrames * channelCount)
+            producedFrames += hopFrameCount
+        }
+        return (producedFrames, firstPosition)
+    }
+
+    /// Forgets all input and the timeline anchor.
+    func reset() {
+        input.removeAll(keepingCapacity: true)
+        inputStartFrame = 0
+        analysisFrame = 0
+        hasTail = false
+        originPosition = nil
+    }
+
+    /// Absolute start of the next window, or nil until enough input is buffered to
+    /// search around it.
+    private func nextWindowStart() -> Int? {
+        let nominal = Int(analysisFrame.rounded())
+        let search = hasTail ? searchFrameCount : 0
+        guard nominal + search + windowFrameCount <= inputStartFrame + bufferedFrameCount else { return nil }
+        guard hasTail else { return nominal }
+
+        let sampleCount = hopFrameCount * channelCount
+        var bestStart = nominal
+        var bestScore = -Float.infinity
+        input.withUnsafeBufferPointer { input in
+            tail.withUnsafeBufferPointer { tail in
+                guard let inputBase = input.baseAddress, let tailBase = tail.baseAddress else { return }
+                for index in 0...(2 * search) {
+                    let candidate = nominal + IRFFAudioTimeStretchPolicy.searchOffset(at: index)
+                    guard candidate >= inputStartFrame else { continue }
+                    let segment = inputBase + (candidate - inputStartFrame) * channelCount
+                    let score = IRFFAudioTimeStretchPolicy.similarity(
+                        correlation: IRFFAudioTimeStretchPolicy.dot(tailBase, segment, count: sampleCount),
+                        energy: IRFFAudioTimeStretchPolicy.dot(segment, segment, count: sampleCount)
+                    )
+                    if score > bestScore {
+                        bestScore = score
+                        bestStart = candidate
+                    }
+                }
+            }
+        }
+        return bestStart
+    }
+
+    /// Emits one hop from the window at absolute frame `start`, keeps its second half as
+    /// the next tail and drops input no later window can reach.
+    private func renderWindow(at start: Int, into output: UnsafeMutablePointer<Float>) {
+        let sampleCount = hopFrameCount * channelCount
+        let offset = (start - inputStartFrame) * channelCount
+        input.withUnsafeBufferPointer { input in
+            guard let inputBase = input.baseAddress else { return }
+            if hasTail {
+                tail.withUnsafeBufferPointer { tail in
+                    fadeWeights.withUnsafeBufferPointer { weights in
+                        IRFFAudioTimeStretchPolicy.crossfade(from: tail.baseAddress!,
+                                                             to: inputBase + offset,
+                                                             weights: weights.baseAddress!,
+                                                             into: output,
+                                                             count: sampleCount)
+                    }
+                }
+            } else {
+                output.update(from: inputBase + offset, count: sampleCount)
+            }
+            tail.withUnsafeMutableBufferPointer { tail in
+                tail.baseAddress!.update(from: inputBase + offset + sampleCount, count: sampleCount)
+            }
+        }
+        hasTail = true
+        analysisFrame += IRFFAudioTimeStretchPolicy.analysisHop(rate: rate, hopFrameCount: hopFrameCount)
+
+        let keepFrom = max(inputStartFrame, Int(analysisFrame.rounded()) - searchFrameCount)
+        let dropFrames = min(bufferedFrameCount, keepFrom - inputStartFrame)
+        if dropFrames > 0 {
+            input.removeFirst(dropFrames * channelCount)
+            inputStartFrame += dropFrames
+        }
+    }
+}
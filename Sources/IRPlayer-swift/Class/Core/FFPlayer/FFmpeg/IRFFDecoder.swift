@@ -9,6 +9,7 @@ import Foundation
 import CoreGraphics
 import AVFoundation
 import IRFFMpeg
+import IRPlayerObjc
 
 protocol IRFFDecoderDelegate: AnyObject {
     func decoderWillOpenInputStream(_ decoder: IRFFDecoder)
@@ -25,6 +26,13 @@ protocol IRFFDecoderDelegate: AnyObject {
     @objc optional func send(videoFrame frame: IRFFVideoFrame)
 }
 
+/// A video output that presents on its own vsync clock. The display thread stamps
+/// frames with target host times and queues them on `presentationScheduler` instead
+/// of sleeping between `send(videoFrame:)` calls.
+protocol IRFFDecoderPacedVideoOutput: IRFFDecoderVideoOutput {
+    var presentationScheduler: IRFFPresentationScheduler { get }
+}
+
 @objc protocol IRFFDecoderAudioOutput: AnyObject {
     var numberOfChannels: UInt32 { get }
     var samplingRate: Float64 { get }
@@ -74,6 +82,7 @@ protocol IRFFDecoderDelegate: AnyObject {
     private var readPacketOperation: Operation?
     private var decodeFrameOperation: Operation?
     private var displayOperation: Operation?
+    private var audioFeedOperation: Operation?
 
     private var formatContext: IRFFFormatContext?
     private var audioDecoder: IRFFAudioDecoder?
@@ -125,20 +134,124 @@ protocol IRFFDecoderDelegate: AnyObject {
     private(set) var closed: Bool = false
     private(set) var endOfFile: Bool = false
     private(set) var paused: Bool = false
-    private(set) var seeking: Bool = false
+    var seeking: Bool {
+        return seekRequests.isPending
+    }
     private(set) var prepareToDecode: Bool = false
 
-    private var seekToTime: TimeInterval = 0
+    /// Rapid seeks, e.g. while scrubbing, collapse into the latest one.
+    private let seekRequests = IRFFSeekRequestCoalescer()
     private var seekMinTime: TimeInterval = 0
-    private var seekCompleteHandler: ((Bool) -> Void)?
     private var selectAudioTrack = false
     private var selectAudioTrackIndex = 0
     private var currentVideoFrame: IRFFVideoFrame?
     private var currentAudioFrame: IRFFAudioFrame?
+    /// Owned by the display thread; other threads go through `resetStandaloneVideoAnchor()`.
+    private var standaloneVideoAnchor: (position: TimeInterval, hostTime: TimeInterval)?
+    private var standaloneVideoAnchorResets = 0
+    private var consecutiveLateVideoDrops = 0
+
+    /// Counters and requests the read, feed, display and main threads publish to each
+    /// other through `IRAtomic`.
+    private enum SharedWord: Int, CaseIterable {
+        case lateDroppedVideoFrames
+        /// Bumped by the read thread on a seek; the audio feed thread, the ring's
+        /// producer, flushes `audioSampleRing` when it sees a new value.
+        case audioSampleRingGeneration
+        /// Bumped by any thread that invalidates `standaloneVideoAnchor`; the display
+        /// thread drops the anchor when it sees a new value.
+        case standaloneVideoAnchorResets
+    }
+    private let sharedWords = IRFFPaddedAtomicWords<SharedWord>()
+
+    /// Filled by the audio feed thread, drained by the audio output's render callback.
+    let audioSampleRing: IRFFAudioSampleRing
+    private var seekAudioTimeClock: TimeInterval = 0
+    private let audioClock = IRFFSharedAudioClock()
+    /// Wall-clock seconds the output takes to play one interleaved sample.
+    private let audioOutputSecondsPerSample: TimeInterval?
+    /// Owned by the audio feed thread; only used while `presentationRate` is not 1.
+    private lazy var audioTimeStretcher = IRFFAudioTimeStretcher(sampleRate: audioOutput?.samplingRate ?? 0,
+                                                                 channelCount: Int(audioOutput?.numberOfChannels ?? 0))
+
+    /// Position the speaker is playing now.
+    var audioTimeClock: TimeInterval {
+        return audioTimeClock(atHostTime: IRFFPresentationScheduler.hostTime())
+    }
+
+    /// Position the speaker plays at `hostTime`, interpolated from the last render
+    /// callback; the seek target until the output has read from the ring again.
+    func audioTimeClock(atHostTime hostTime: TimeInterval) -> TimeInterval {
+        guard audioSampleRing.playbackPosition != nil, let clock = audioClock.load() else {
+            return seekAudioTimeClock
+        }
+        return clock.position(atHostTime: hostTime)
+    }
+
+    /// Times the audio output ran out of decoded samples mid-stream.
+    var audioUnderrunCount: Int {
+        return audioSampleRing.underrunCount
+    }
+
+    /// Frames the display thread skipped for being late against the audio clock.
+    var lateDroppedVideoFrameCount: Int {
+        return IRAtomicLoad(sharedWords[.lateDroppedVideoFrames])
+    }
+
+    /// Late frames skipped here plus those the output's presentation scheduler dropped.
+    var droppedVideoFrameCount: Int {
+        return lateDroppedVideoFrameCount + ((videoOutput as? IRFFDecoderPacedVideoOutput)?.presentationScheduler.droppedFrameCount ?? 0)
+    }
 
-    private(set) var audioTimeClock: TimeInterval = 0
+    var repeatedVideoFrameCount: Int {
+        return (videoOutput as? IRFFDecoderPacedVideoOutput)?.presentationScheduler.repeatedFrameCount ?? 0
+    }
+
+    /// Playback speed, clamped to 0.5...4. Audio is time-stretched to keep its pitch,
+    /// the clocks that pace video advance `rate` times faster, and video is decimated
+    /// at high rates.
+    var rate: Double = 1 {
+        didSet {
+            rate = IRPlayerRate.normalized(rate)
+            videoDecoder?.decimation = Self.videoDecimation(rate: rate)
+            resetStandaloneVideoAnchor()
+        }
+    }
+
+    /// Latency a live stream is held at; see `IRFFLiveCatchUpPolicy`.
+    var liveTargetLatency: TimeInterval = IRFFLiveCatchUpPolicy.defaultTargetLatency
+    /// Set while a live stream plays slightly fast to shed latency.
+    private var liveCatchUpSpeedingUp = false {
+        didSet {
+            if liveCatchUpSpeedingUp != oldValue {
+                resetStandaloneVideoAnchor()
+            }
+        }
+    }
+
+    /// `rate` with any live catch-up speed-up applied; what audio and video play at.
+    private var presentationRate: Double {
+        return Self.livePresentationRate(rate: rate, speedingUp: liveCatchUpSpeedingUp)
+    }
+
+    /// Media buffered ahead of what is playing. For a live stream this is how far
+    /// playback trails the newest data received.
+    var liveLatency: TimeInterval {
+        if formatContext?.audioEnable == true {
+            return (audioDecoder?.duration() ?? 0) + audioSampleRing.bufferedDuration
+        }
+        return videoDecoder?.duration() ?? 0
+    }
 
     var hardwareDecoderEnable: Bool = true
+    var videoThreading: IRDecoderThreading = .automatic
+    /// Opens only the video stream and paces it on the wall clock. Set before `open()`.
+    var videoOnly = false
+    /// Demuxer limits for opening the input. Set before `open()`.
+    var inputProfile: IRDecoderInputProfile = .standard
+    var bufferingPolicy: IRBufferingPolicy = .standard
+    /// Replaces `bufferingPolicy` while `isLiveStream` is set.
+    var liveBufferingPolicy: IRBufferingPolicy = .live
     var minBufferedDuration: TimeInterval = 0
     var reading = false
     var isLiveStream: Bool = false
@@ -181,9 +294,6 @@ protocol IRFFDecoderDelegate: AnyObject {
 
     // Buffering timeout tracking
     private var bufferingStartTime: TimeInterval = 0
-    private let bufferingMaxDuration: TimeInterval = 2.0 // Maximum time to wait for buffering before forcing play
-    private let bufferingMinimumThreshold: TimeInterval = 0.3 // Minimum buffered duration before playing on poor network
-    private let liveStreamBufferingMaxDuration: TimeInterval = 1.0 // Shorter timeout for live streams
 
     var duration: TimeInterval {
         return formatContext?.duration ?? 0
@@ -202,6 +312,10 @@ protocol IRFFDecoderDelegate: AnyObject {
         self.videoFormat = videoFormat
         self.videoOutput = videoOutput
         self.audioOutput = audioOutput
+        self.audioSampleRing = IRFFAudioSampleRing(sampleRate: audioOutput?.samplingRate ?? 0,
+                                                   channelCount: audioOutput?.numberOfChannels ?? 0)
+        self.audioOutputSecondsPerSample = IRFFAudioSampleRingPolicy.secondsPerSample(sampleRate: audioOutput?.samplingRate ?? 0,
+                                                                                      channelCount: audioOutput?.numberOfChannels ?? 0)
         super.init()
         setupFFmpeg()
     }
@@ -231,11 +345,12 @@ protocol IRFFDecoderDelegate: AnyObject {
     }
 
     private func setupOperationQueue() {
-        ffmpegOperationQueue?.maxConcurrentOperationCount = 3
+        ffmpegOperationQueue?.maxConcurrentOperationCount = 4
         // .userInitiated is appropriate for streaming video: high-priority but not
-        // user-interactive. Using .userInteractive here causes a priority inversion
-        // because the display thread blocks on NSCondition.wait() in getFrameSync(),
-        // and NSCondition does not propagate QoS to the signaling thread.
+        // user-interactive. The display thread parks on the frame queue's
+        // IRFFWaitNotifier until the decode thread hands it a frame; keeping every
+        // operation at the same QoS means that wait never blocks on a lower-QoS
+        // signaller.
         ffmpegOperationQueue?.qualityOfService = .userInitiated
         setupOpenFileOperation()
     }
@@ -267,6 +382,16 @@ protocol IRFFDecoderDelegate: AnyObject {
             readPacketOperation = operation
             Self.enqueue(operation, on: ffmpegOperationQueue)
         }
+        if formatContext?.audioEnable == true, Self.needsScheduling(audioFeedOperation) {
+            let operation = BlockOperation { [weak self] in
+                self?.audioFeedThread()
+            }
+            operation.queuePriority = .veryHigh
+            operation.qualityOfService = .userInitiated
+            Self.addDependency(openFileOperation, to: operation)
+            audioFeedOperation = operation
+            Self.enqueue(operation, on: ffmpegOperationQueue)
+        }
         if formatContext?.videoEnable == true {
             if Self.needsScheduling(decodeFrameOperation) {
                 let operation = BlockOperation { [weak self] in
@@ -354,17 +479,122 @@ protocol IRFFDecoderDelegate: AnyObject {
     static func audioSyncedVideoSleepDuration(framePosition: TimeInterval,
                                               frameDuration: TimeInterval,
                                               audioTimeClock: TimeInterval,
-                                              fps: TimeInterval) -> TimeInterval? {
+                                              fps: TimeInterval,
+                                              rate: Double = 1) -> TimeInterval? {
         return IRFFDecoderDisplayPolicy.audioSyncedVideoSleepDuration(
             framePosition: framePosition,
             frameDuration: frameDuration,
             audioTimeClock: audioTimeClock,
-            fps: fps
+            fps: fps,
+            rate: rate
+        )
+    }
+
+    static func videoLag(framePosition: TimeInterval,
+                         frameDuration: TimeInterval,
+                         audioTimeClock: TimeInterval) -> TimeInterval? {
+        return IRFFDecoderDisplayPolicy.videoLag(
+            framePosition: framePosition,
+            frameDuration: frameDuration,
+            audioTimeClock: audioTimeClock
+        )
+    }
+
+    static func shouldDropLateVideoFrame(framePosition: TimeInterval,
+                                         frameDuration: TimeInterval,
+                                         audioTimeClock: TimeInterval,
+                                         consecutiveDrops: Int) -> Bool {
+        return IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(
+            framePosition: framePosition,
+            frameDuration: frameDuration,
+            audioTimeClock: audioTimeClock,
+            consecutiveDrops: consecutiveDrops
+        )
+    }
+
+    static func skipsNonReferenceFrames(lag: TimeInterval?, currentlySkipping: Bool) -> Bool {
+        return IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: lag, currentlySkipping: currentlySkipping)
+    }
+
+    static func presentationTargetHostTime(framePosition: TimeInterval,
+                                           clockPosition: TimeInterval,
+                                           clockHostTime: TimeInterval,
+                                           rate: Double = 1) -> TimeInterval? {
+        return IRFFPresentationSchedulerPolicy.targetHostTime(
+            framePosition: framePosition,
+            clockPosition: clockPosition,
+            clockHostTime: clockHostTime,
+            rate: rate
         )
     }
 
-    static func standaloneVideoSleepDuration(frameDuration: TimeInterval, fps: TimeInterval) -> TimeInterval? {
-        return IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: frameDuration, fps: fps)
+    static func standalonePresentationAnchor(framePosition: TimeInterval,
+                                             hostTime: TimeInterval,
+                                             anchor: (position: TimeInterval, hostTime: TimeInterval)?,
+                                             rate: Double = 1,
+                                             driftCorrectionGain: Double = 0) -> (position: TimeInterval, hostTime: TimeInterval) {
+        return IRFFPresentationSchedulerPolicy.standaloneAnchor(
+            framePosition: framePosition,
+            hostTime: hostTime,
+            anchor: anchor,
+            rate: rate,
+            driftCorrectionGain: driftCorrectionGain
+        )
+    }
+
+    static var standaloneDriftCorrectionGain: Double {
+        return IRFFPresentationSchedulerPolicy.standaloneDriftCorrectionGain
+    }
+
+    static func shouldEnterBuffering(bufferedDuration: TimeInterval,
+                                     endOfFile: Bool,
+                                     policy: IRBufferingPolicy) -> Bool {
+        return IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: bufferedDuration,
+                                                               endOfFile: endOfFile,
+                                                               policy: policy)
+    }
+
+    static func shouldExitBuffering(bufferedDuration: TimeInterval,
+                                    minBufferedDuration: TimeInterval,
+                                    elapsed: TimeInterval,
+                                    endOfFile: Bool,
+                                    policy: IRBufferingPolicy) -> Bool {
+        return IRFFDecoderBufferingPolicy.shouldExitBuffering(bufferedDuration: bufferedDuration,
+                                                              minBufferedDuration: minBufferedDuration,
+                                                              elapsed: elapsed,
+                                                              endOfFile: endOfFile,
+                                                              policy: policy)
+    }
+
+    static func wallClockVideoSleepDuration(targetHostTime: TimeInterval, hostTime: TimeInterval) -> TimeInterval? {
+        return IRFFDecoderDisplayPolicy.wallClockVideoSleepDuration(targetHostTime: targetHostTime, hostTime: hostTime)
+    }
+
+    static func liveCatchUpAction(latency: TimeInterval,
+                                  targetLatency: TimeInterval,
+                                  speedingUp: Bool,
+                                  canDropPackets: Bool) -> IRFFLiveCatchUpAction {
+        return IRFFLiveCatchUpPolicy.action(latency: latency,
+                                            targetLatency: targetLatency,
+                                            speedingUp: speedingUp,
+                                            canDropPackets: canDropPackets)
+    }
+
+    static func livePresentationRate(rate: Double, speedingUp: Bool) -> Double {
+        return IRFFLiveCatchUpPolicy.presentationRate(rate: rate, speedingUp: speedingUp)
+    }
+
+    static func usesTimeStretch(rate: Double) -> Bool {
+        return IRFFPlaybackRatePolicy.usesTimeStretch(rate: rate)
+    }
+
+    static func videoDecimation(rate: Double) -> IRFFVideoDecimation {
+        return IRFFPlaybackRatePolicy.videoDecimation(rate: rate)
+    }
+
+    static func audioClockRate(playbackSecondsPerSample: TimeInterval, outputSecondsPerSample: TimeInterval) -> Double {
+        return IRFFPlaybackRatePolicy.clockRate(playbackSecondsPerSample: playbackSecondsPerSample,
+                                                outputSecondsPerSample: outputSecondsPerSample)
     }
 
     static func videoFrameOrderingPosition(_ position: TimeInterval?) -> TimeInterval? {
@@ -394,6 +624,14 @@ protocol IRFFDecoderDelegate: AnyObject {
         )
     }
 
+    static var audioFeedInterval: TimeInterval {
+        return IRFFDecoderAudioPolicy.audioFeedInterval
+    }
+
+    static func presentsFrame(position: TimeInterval, duration: TimeInterval, seekTarget: TimeInterval?) -> Bool {
+        return IRFFDecoderSeekPolicy.presentsFrame(position: position, duration: duration, seekTarget: seekTarget)
+    }
+
     static func resumeSeekTarget(playbackFinished: Bool) -> TimeInterval? {
         return IRFFDecoderSeekPolicy.resumeSeekTarget(playbackFinished: playbackFinished)
     }
@@ -440,6 +678,14 @@ protocol IRFFDecoderDelegate: AnyObject {
         )
     }
 
+    static func frameWaitInterval(fps: TimeInterval) -> TimeInterval {
+        return IRFFDecoderDisplayPolicy.frameWaitInterval(fps: fps)
+    }
+
+    static func frameWaitDuration(dueHostTime: TimeInterval?, hostTime: TimeInterval, fps: TimeInterval) -> TimeInterval {
+        return IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: dueHostTime, hostTime: hostTime, fps: fps)
+    }
+
     static func shouldFinishDisplay(endOfFile: Bool, videoDecoderEmpty: Bool) -> Bool {
         return IRFFDecoderDisplayPolicy.shouldFinishDisplay(endOfFile: endOfFile, videoDecoderEmpty: videoDecoderEmpty)
     }
@@ -452,6 +698,9 @@ protocol IRFFDecoderDelegate: AnyObject {
         delegate?.decoderWillOpenInputStream(self)
         formatContext = IRFFFormatContext(contentURL: contentURL, videoFormat: videoFormat)
         formatContext?.delegate = self
+        formatContext?.videoThreading = videoThreading
+        formatContext?.videoOnly = videoOnly
+        formatContext?.inputProfile = inputProfile
         formatContext?.setupSync()
         if let formatError = formatContext?.error {
             error = formatError
@@ -459,12 +708,15 @@ protocol IRFFDecoderDelegate: AnyObject {
             return
         }
         prepareToDecode = true
+        (videoOutput as? IRFFDecoderPacedVideoOutput)?.presentationScheduler.resetCounters()
+        audioSampleRing.resetUnderrunCount()
         delegate?.decoderDidPrepareToDecodeFrames(self)
         if let formatContext,
            let videoCodecContext = Self.videoCodecContext(from: formatContext) {
             videoDecoder = IRFFVideoDecoder(codecContext: videoCodecContext, timebase: formatContext.videoTimebase, fps: formatContext.videoFPS, delegate: self)
             videoDecoder?.source = self
             videoDecoder?.videoToolBoxEnable = hardwareDecoderEnable
+            videoDecoder?.decimation = Self.videoDecimation(rate: rate)
         }
         if let formatContext,
            let audioCodecContext = Self.audioCodecContext(from: formatContext) {
@@ -484,29 +736,33 @@ protocol IRFFDecoderDelegate: AnyObject {
                 IRFFRuntimeDebugOutput.write("read packet thread quit")
                 break
             }
-            if let transition = Self.seekCompletionTransition(seeking: seeking, progress: progress) {
+            if let request = seekRequests.pendingRequest(),
+               let transition = Self.seekCompletionTransition(seeking: true, progress: request.time) {
                 endOfFile = transition.endOfFile
                 playbackFinished = transition.playbackFinished
-                formatContext?.seekFile(withFFTimebase: seekToTime)
+                formatContext?.seekFile(withFFTimebase: request.time)
                 buffering = transition.buffering
                 if buffering {
                     bufferingStartTime = Date().timeIntervalSince1970
                 }
-                audioDecoder?.flush()
-                videoDecoder?.flush()
+                // Decoding restarts at the key frame before the target; only frames
+                // from the target on are shown.
+                audioDecoder?.flush(seekTarget: request.time)
+                videoDecoder?.flush(seekTarget: request.time)
                 videoDecoder?.paused = transition.videoPaused
                 videoDecoder?.endOfFile = transition.videoEndOfFile
-                seeking = false
-                seekToTime = transition.seekToTime
-                if let handler = seekCompleteHandler {
-                    handler(true)
-                    seekCompleteHandler = nil
-                }
-                audioTimeClock = transition.audioTimeClock
+                seekRequests.complete(request)
+                seekAudioTimeClock = transition.audioTimeClock
+                // The ring may only be flushed by its producer, so the audio feed thread
+                // flushes it, and drops its own frame, when it sees the new generation.
+                IRAtomicFetchAdd(sharedWords[.audioSampleRingGeneration], 1)
                 if transition.shouldClearFrames {
                     currentVideoFrame = nil
-                    currentAudioFrame = nil
                 }
+                presentationScheduler?.removeAll()
+                resetStandaloneVideoAnchor()
+                consecutiveLateVideoDrops = 0
+                videoDecoder?.skipsNonReferenceFrames = false
                 updateBufferedDurationByVideo()
                 updateBufferedDurationByAudio()
                 continue
@@ -534,6 +790,7 @@ protocol IRFFDecoderDelegate: AnyObject {
                 selectAudioTrackIndex = 0
                 continue
             }
+            updateLiveCatchUp()
             let size: Int = Int(audioDecoder?.size() ?? 0)
             let packetSize = (videoDecoder?.packetSize() ?? 0)
             if let interval = Self.packetBufferBackpressureSleepInterval(audioSize: size,
@@ -580,6 +837,30 @@ protocol IRFFDecoderDelegate: AnyObject {
         checkBufferingStatus()
     }
 
+    /// Runs on the read thread, ahead of backpressure so a full buffer still gets shed.
+    private func updateLiveCatchUp() {
+        guard isLiveStream, !paused, !buffering else {
+            liveCatchUpSpeedingUp = false
+            return
+        }
+        let latency = liveLatency
+        switch Self.liveCatchUpAction(latency: latency,
+                                      targetLatency: liveTargetLatency,
+                                      speedingUp: liveCatchUpSpeedingUp,
+                                      canDropPackets: formatContext?.audioEnable != true) {
+        case .none:
+            liveCatchUpSpeedingUp = false
+        case .speedUp:
+            liveCatchUpSpeedingUp = true
+        case .dropToKeyFrame:
+            IRFFRuntimeDebugOutput.write("live catch-up: drop \(latency)s up to the next key frame")
+            liveCatchUpSpeedingUp = false
+            videoDecoder?.flush(resumingAtKeyFrame: true)
+            presentationScheduler?.removeAll()
+            resetStandaloneVideoAnchor()
+        }
+    }
+
     private func displayThread() {
         while true {
             if closed || error != nil {
@@ -592,7 +873,9 @@ protocol IRFFDecoderDelegate: AnyObject {
                 paused: paused,
                 hasCurrentFrame: currentVideoFrame != nil
             ) {
-                if paused, !seeking, !buffering, let currentFrame = currentVideoFrame {
+                // A paced output keeps its on-screen frame; currentVideoFrame may be
+                // queued ahead of it.
+                if paused, !seeking, !buffering, presentationScheduler == nil, let currentFrame = currentVideoFrame {
                     videoOutput?.send?(videoFrame: currentFrame)
                 }
                 Thread.sleep(forTimeInterval: sleepTime)
@@ -602,6 +885,10 @@ protocol IRFFDecoderDelegate: AnyObject {
                 IRFFRuntimeDebugOutput.write("display finished")
                 break
             }
+            if let scheduler = presentationScheduler {
+                scheduleNextVideoFrame(on: scheduler)
+                continue
+            }
             if formatContext?.audioEnable == true {
                 let audioTimeClock = self.audioTimeClock
                 if let currentFrame = currentVideoFrame {
@@ -609,7 +896,8 @@ protocol IRFFDecoderDelegate: AnyObject {
                         framePosition: currentFrame.position,
                         frameDuration: currentFrame.duration,
                         audioTimeClock: audioTimeClock,
-                        fps: videoDecoder?.fps ?? 1
+                        fps: videoDecoder?.fps ?? 1,
+                        rate: presentationRate
                     ) {
                         IRFFRuntimeDebugOutput.write("display thread sleep: \(sleepTime)")
                         Thread.sleep(forTimeInterval: sleepTime)
@@ -619,9 +907,17 @@ protocol IRFFDecoderDelegate: AnyObject {
                 if videoDecoder?.frameEmpty() ?? true {
                     updateBufferedDurationByVideo()
                 }
-                let newFrame = videoDecoder?.getFrameSync()
+                guard let newFrame = nextVideoFrame(dueHostTime: nextVideoFrameDueHostTime()) else {
+                    if endOfFile {
+                        updateBufferedDurationByVideo()
+                    }
+                    continue
+                }
                 if !Self.shouldAcceptVideoFrame(currentPosition: currentVideoFrame?.position,
-                                                nextPosition: newFrame?.position) {
+                                                nextPosition: newFrame.position) {
+                    continue
+                }
+                if dropIfLate(newFrame) {
                     continue
                 }
                 currentVideoFrame = newFrame
@@ -631,18 +927,29 @@ protocol IRFFDecoderDelegate: AnyObject {
                     if endOfFile {
                         updateBufferedDurationByVideo()
                     }
-                } else if endOfFile {
-                    updateBufferedDurationByVideo()
                 }
             } else {
                 if videoDecoder?.frameEmpty() ?? true {
                     updateBufferedDurationByVideo()
                 }
-                let newFrame = videoDecoder?.getFrameSync()
+                guard let newFrame = nextVideoFrame(dueHostTime: nextVideoFrameDueHostTime()) else {
+                    if endOfFile {
+                        updateBufferedDurationByVideo()
+                    }
+                    continue
+                }
                 if !Self.shouldAcceptVideoFrame(currentPosition: currentVideoFrame?.position,
-                                                nextPosition: newFrame?.position) {
+                                                nextPosition: newFrame.position) {
                     continue
                 }
+                // Sleep until the frame is due on the wall-clock anchor rather than for
+                // a frame duration after sending it, so sleep overshoot and decode time
+                // do not accumulate into drift.
+                let hostTime = IRFFPresentationScheduler.hostTime()
+                if let targetHostTime = standaloneTargetHostTime(for: newFrame, hostTime: hostTime),
+                   let sleepTime = Self.wallClockVideoSleepDuration(targetHostTime: targetHostTime, hostTime: hostTime) {
+                    Thread.sleep(forTimeInterval: sleepTime)
+                }
                 currentVideoFrame = newFrame
                 if let currentFrame = currentVideoFrame {
                     videoOutput?.send?(videoFrame: currentFrame)
@@ -650,23 +957,153 @@ protocol IRFFDecoderDelegate: AnyObject {
                     if endOfFile {
                         updateBufferedDurationByVideo()
                     }
-                    if let sleepTime = Self.standaloneVideoSleepDuration(frameDuration: currentFrame.duration, fps: videoDecoder?.fps ?? 1) {
-                        Thread.sleep(forTimeInterval: sleepTime)
-                    }
-                } else if endOfFile {
-                    updateBufferedDurationByVideo()
                 }
             }
         }
         checkBufferingStatus()
     }
 
+    private var presentationScheduler: IRFFPresentationScheduler? {
+        guard let scheduler = (videoOutput as? IRFFDecoderPacedVideoOutput)?.presentationScheduler,
+              scheduler.isActive else { return nil }
+        return scheduler
+    }
+
+    /// Paced counterpart of the sleep-based loop body: waits for room in the
+    /// presentation ring, then queues the next frame at the host time its pts maps to
+    /// on the audio clock, or on a wall-clock anchor when there is no audio.
+    private func scheduleNextVideoFrame(on scheduler: IRFFPresentationScheduler) {
+        let waitInterval = Self.frameWaitInterval(fps: videoDecoder?.fps ?? 0)
+        guard scheduler.waitForSpace(until: .now() + waitInterval) else { return }
+        if videoDecoder?.frameEmpty() ?? true {
+            updateBufferedDurationByVideo()
+        }
+        guard let newFrame = nextVideoFrame() else {
+            if endOfFile {
+                updateBufferedDurationByVideo()
+            }
+            return
+        }
+        if !Self.shouldAcceptVideoFrame(currentPosition: currentVideoFrame?.position,
+                                        nextPosition: newFrame.position) {
+            return
+        }
+        if formatContext?.audioEnable == true, dropIfLate(newFrame) {
+            return
+        }
+        let hostTime = IRFFPresentationScheduler.hostTime()
+        let targetHostTime: TimeInterval?
+        if formatContext?.audioEnable == true {
+            targetHostTime = Self.presentationTargetHostTime(framePosition: newFrame.position,
+                                                             clockPosition: audioTimeClock(atHostTime: hostTime),
+                                                             clockHostTime: hostTime,
+                                                             rate: presentationRate)
+        } else {
+            targetHostTime = standaloneTargetHostTime(for: newFrame, hostTime: hostTime)
+        }
+        currentVideoFrame = newFrame
+        scheduler.enqueue(newFrame, targetHostTime: targetHostTime ?? hostTime)
+        updateProgressByVideo()
+        if endOfFile {
+            updateBufferedDurationByVideo()
+        }
+    }
+
+    /// Host time `frame` is due at on the monotonic wall-clock anchor that stands in
+    /// for the audio clock when there is no audio.
+    private func standaloneTargetHostTime(for frame: IRFFVideoFrame, hostTime: TimeInterval) -> TimeInterval? {
+        let anchor = Self.standalonePresentationAnchor(framePosition: frame.position,
+                                                       hostTime: hostTime,
+                                                       anchor: currentVideoFrame == nil ? nil : loadStandaloneVideoAnchor(),
+                                                       rate: presentationRate,
+                                                       driftCorrectionGain: Self.standaloneDriftCorrectionGain)
+        standaloneVideoAnchor = anchor
+        return Self.presentationTargetHostTime(framePosition: frame.position,
+                                               clockPosition: anchor.position,
+                                               clockHostTime: anchor.hostTime,
+                                               rate: presentationRate)
+    }
+
+    /// Asks the display thread to re-anchor the standalone clock on the next frame it paces.
+    private func resetStandaloneVideoAnchor() {
+        IRAtomicFetchAdd(sharedWords[.standaloneVideoAnchorResets], 1)
+    }
+
+    /// Display thread only: `standaloneVideoAnchor`, dropped first if another thread
+    /// asked for a reset since the last call.
+    private func loadStandaloneVideoAnchor() -> (position: TimeInterval, hostTime: TimeInterval)? {
+        let resets = IRAtomicLoad(sharedWords[.standaloneVideoAnchorResets])
+        if resets != standaloneVideoAnchorResets {
+            standaloneVideoAnchorResets = resets
+            standaloneVideoAnchor = nil
+        }
+        return standaloneVideoAnchor
+    }
+
+    /// Skips a frame that is already past its window on the audio clock, before it is
+    /// handed to the output for upload, and tells the decoder to drop non-reference
+    /// frames while the lag stays large.
+    private func dropIfLate(_ frame: IRFFVideoFrame) -> Bool {
+        let lag = Self.videoLag(framePosition: frame.position,
+                                frameDuration: frame.duration,
+                                audioTimeClock: audioTimeClock)
+        if let videoDecoder {
+            videoDecoder.skipsNonReferenceFrames = Self.skipsNonReferenceFrames(
+                lag: lag,
+                currentlySkipping: videoDecoder.skipsNonReferenceFrames
+            )
+        }
+        guard Self.shouldDropLateVideoFrame(framePosition: frame.position,
+                                            frameDuration: frame.duration,
+                                            audioTimeClock: audioTimeClock,
+                                            consecutiveDrops: consecutiveLateVideoDrops) else {
+            consecutiveLateVideoDrops = 0
+            return false
+        }
+        consecutiveLateVideoDrops += 1
+        IRAtomicFetchAdd(sharedWords[.lateDroppedVideoFrames], 1)
+        IRFFRuntimeDebugOutput.write("drop late video frame: \(frame.position)")
+        return true
+    }
+
+    /// Waits for the next decoded frame until the host time it is due, so the display
+    /// thread wakes on its arrival or its presentation time rather than on a fixed
+    /// timeout; `dueHostTime` is nil when there is nothing to pace against yet.
+    private func nextVideoFrame(dueHostTime: TimeInterval? = nil) -> IRFFVideoFrame? {
+        let waitDuration = Self.frameWaitDuration(dueHostTime: dueHostTime,
+                                                  hostTime: IRFFPresentationScheduler.hostTime(),
+                                                  fps: videoDecoder?.fps ?? 0)
+        return videoDecoder?.getFrame(until: .now() + waitDuration)
+    }
+
+    /// Host time the frame after the current one is due, on the audio clock or on the
+    /// standalone wall-clock anchor.
+    private func nextVideoFrameDueHostTime() -> TimeInterval? {
+        guard let currentFrame = currentVideoFrame else { return nil }
+        let nextPosition = currentFrame.position + currentFrame.duration
+        if formatContext?.audioEnable == true {
+            let hostTime = IRFFPresentationScheduler.hostTime()
+            return Self.presentationTargetHostTime(framePosition: nextPosition,
+                                                   clockPosition: audioTimeClock(atHostTime: hostTime),
+                                                   clockHostTime: hostTime,
+                                                   rate: presentationRate)
+        }
+        guard let anchor = loadStandaloneVideoAnchor() else { return nil }
+        return Self.presentationTargetHostTime(framePosition: nextPosition,
+                                               clockPosition: anchor.position,
+                                               clockHostTime: anchor.hostTime,
+                                               rate: presentationRate)
+    }
+
     func pause() {
         paused = true
+        presentationScheduler?.suspend()
+        resetStandaloneVideoAnchor()
     }
 
     func resume() {
         paused = false
+        presentationScheduler?.resume()
         if let seekTarget = Self.resumeSeekTarget(playbackFinished: playbackFinished) {
             seek(to: seekTarget)
         }
@@ -686,37 +1123,163 @@ protocol IRFFDecoderDelegate: AnyObject {
             return
         }
 
-        seekToTime = preparation.clampedTime
-        self.progress = seekToTime
-        self.seekCompleteHandler = completeHandler
-        self.seeking = true
+        self.progress = preparation.clampedTime
+        seekRequests.submit(time: preparation.clampedTime, completeHandler: completeHandler)
         videoDecoder?.paused = true
         if endOfFile {
             setupReadPacketOperation()
         }
     }
 
-    func fetchAudioFrame() -> IRFFAudioFrame? {
-        if !Self.shouldFetchAudioFrame(closed: closed,
-                                       seeking: seeking,
-                                       buffering: buffering,
-                                       paused: paused,
-                                       playbackFinished: playbackFinished,
-                                       audioEnabled: formatContext?.audioEnable == true) {
-            return nil
-        }
-        if audioDecoder?.isEmpty() ?? true {
-            updateBufferedDurationByAudio()
-            return nil
+    /// Render callback side: copies decoded samples into `outputData` without locking,
+    /// zero-fills whatever the ring cannot cover and re-anchors the audio clock on a
+    /// callback at `hostTime` whose audio reaches the speaker `outputLatency` later.
+    @discardableResult
+    func renderAudio(into outputData: UnsafeMutablePointer<Float>,
+                     sampleCount: Int,
+                     hostTime: TimeInterval,
+                     outputLatency: TimeInterval) -> Int {
+        let readCount = audioSampleRing.read(into: outputData, count: sampleCount)
+        let playbackSecondsPerSample = audioSampleRing.playbackSecondsPerSample
+        let outputSecondsPerSample = audioOutputSecondsPerSample ?? playbackSecondsPerSample
+        if let endPosition = audioSampleRing.playbackPosition,
+           let clock = IRFFAudioClock.rendered(endPosition: endPosition,
+                                               renderedDuration: Double(readCount) * outputSecondsPerSample,
+                                               renderHostTime: hostTime,
+                                               outputLatency: outputLatency,
+                                               rate: Self.audioClockRate(playbackSecondsPerSample: playbackSecondsPerSample,
+                                                                         outputSecondsPerSample: outputSecondsPerSample)) {
+            audioClock.store(clock)
         }
-        currentAudioFrame = audioDecoder?.getFrameSync()
-        if currentAudioFrame == nil { return nil }
-        if endOfFile {
-            updateBufferedDurationByAudio()
+        return readCount
+    }
+
+    /// Moves decoded audio frames from the audio decoder into `audioSampleRing`, keeping
+    /// the frame queue's locking and the progress callbacks off the render thread.
+    /// While `rate` is not 1 the frames go through `audioTimeStretcher` first, and the
+    /// ring's markers advance `rate` media seconds per second of output.
+    private func audioFeedThread() {
+        var generation = IRAtomicLoad(sharedWords[.audioSampleRingGeneration])
+        var writtenSampleCount = 0
+        var stretching = false
+        var stretched: [Float] = []
+        var stretchedSampleCount = 0
+        var stretchedWrittenCount = 0
+        var stretchedPosition = TimeInterval.nan
+        var stretchedSecondsPerSample = TimeInterval.nan
+        while true {
+            if closed || error != nil {
+                IRFFRuntimeDebugOutput.write("audio feed thread quit")
+                break
+            }
+            let currentGeneration = IRAtomicLoad(sharedWords[.audioSampleRingGeneration])
+            if generation != currentGeneration {
+                generation = currentGeneration
+                currentAudioFrame?.stopPlaying()
+                currentAudioFrame = nil
+                audioTimeStretcher.reset()
+                stretchedSampleCount = 0
+                stretchedWrittenCount = 0
+                audioSampleRing.flush()
+            }
+            if !Self.shouldFetchAudioFrame(closed: closed,
+                                           seeking: seeking,
+                                           buffering: buffering,
+                                           paused: paused,
+                                           playbackFinished: playbackFinished,
+                                           audioEnabled: formatContext?.audioEnable == true) {
+                Thread.sleep(forTimeInterval: Self.audioFeedInterval)
+                continue
+            }
+            let secondsPerSample = audioOutputSecondsPerSample ?? .nan
+            if stretchedWrittenCount < stretchedSampleCount {
+                let position = IRFFAudioSampleRingPolicy.position(segmentPosition: stretchedPosition,
+                                                                  segmentStart: 0,
+                                                                  secondsPerSample: stretchedSecondsPerSample,
+                                                                  sampleIndex: stretchedWrittenCount)
+                let offset = stretchedWrittenCount
+                let written = stretched.withUnsafeBufferPointer {
+                    audioSampleRing.write($0.baseAddress! + offset,
+                                          count: stretchedSampleCount - offset,
+                                          position: position,
+                                          secondsPerSample: stretchedSecondsPerSample)
+                }
+                stretchedWrittenCount += written
+                if stretchedWrittenCount < stretchedSampleCount {
+                    Thread.sleep(forTimeInterval: Self.audioFeedInterval)
+                }
+                continue
+            }
+            let playbackRate = presentationRate
+            if Self.usesTimeStretch(rate: playbackRate) != stretching {
+                // Input the stretcher still holds is dropped: less than one window.
+                stretching.toggle()
+                audioTimeStretcher.reset()
+            }
+            if stretching {
+                let stretcher = audioTimeStretcher
+                stretcher.rate = playbackRate
+                if stretched.isEmpty {
+                    stretched = [Float](repeating: 0, count: stretcher.hopFrameCount * stretcher.channelCount * 8)
+                }
+                let produced = stretched.withUnsafeMutableBufferPointer {
+                    stretcher.process(into: $0.baseAddress!, frameCapacity: $0.count / stretcher.channelCount)
+                }
+                if produced.frameCount > 0 {
+                    stretchedSampleCount = produced.frameCount * stretcher.channelCount
+                    stretchedWrittenCount = 0
+                    stretchedPosition = produced.position
+                    stretchedSecondsPerSample = secondsPerSample * stretcher.rate
+                    continue
+                }
+            }
+            if currentAudioFrame == nil {
+                if audioDecoder?.isEmpty() ?? true {
+                    if endOfFile {
+                        audioSampleRing.markEndOfStream()
+                    }
+                    updateBufferedDurationByAudio()
+                    Thread.sleep(forTimeInterval: Self.audioFeedInterval)
+                    continue
+                }
+                currentAudioFrame = audioDecoder?.getFrameSync()
+                currentAudioFrame?.startPlaying()
+                writtenSampleCount = 0
+                updateProgressByAudio()
+                if endOfFile {
+                    updateBufferedDurationByAudio()
+                }
+            }
+            guard let frame = currentAudioFrame else { continue }
+            let sampleCount = max(0, frame.size / MemoryLayout<Float>.size)
+            if let samples = frame.samples, writtenSampleCount < sampleCount {
+                let position = IRFFAudioSampleRingPolicy.position(segmentPosition: frame.position,
+                                                                  segmentStart: 0,
+                                                                  secondsPerSample: secondsPerSample,
+                                                                  sampleIndex: writtenSampleCount)
+                if stretching {
+                    let stretcher = audioTimeStretcher
+                    stretcher.append(samples + writtenSampleCount,
+                                     frameCount: (sampleCount - writtenSampleCount) / stretcher.channelCount,
+                                     position: position)
+                    writtenSampleCount = sampleCount
+                } else {
+                    let written = audioSampleRing.write(samples + writtenSampleCount,
+                                                        count: sampleCount - writtenSampleCount,
+                                                        position: position,
+                                                        secondsPerSample: secondsPerSample)
+                    writtenSampleCount += written
+                    if writtenSampleCount < sampleCount {
+                        Thread.sleep(forTimeInterval: Self.audioFeedInterval)
+                        continue
+                    }
+                }
+            }
+            frame.stopPlaying()
+            currentAudioFrame = nil
         }
-        updateProgressByAudio()
-        audioTimeClock = currentAudioFrame?.position ?? 0
-        return currentAudioFrame
+        currentAudioFrame?.stopPlaying()
+        currentAudioFrame = nil
     }
 
     func closeFile() {
@@ -728,9 +1291,12 @@ protocol IRFFDecoderDelegate: AnyObject {
         closed = true
         videoDecoder?.destroy()
         audioDecoder?.destroy()
+        presentationScheduler?.removeAll()
         let cleanup = { [self] in
             ffmpegOperationQueue?.cancelAllOperations()
             ffmpegOperationQueue?.waitUntilAllOperationsAreFinished()
+            // Only once the audio feed thread, the ring's producer, has quit.
+            audioSampleRing.flush()
             closePropertyValue()
             formatContext?.destroy()
             closeOperation()
@@ -743,7 +1309,7 @@ protocol IRFFDecoderDelegate: AnyObject {
     }
 
     private func closePropertyValue() {
-        seeking = false
+        seekRequests.cancel()
         buffering = false
         paused = false
         prepareToDecode = false
@@ -763,41 +1329,23 @@ protocol IRFFDecoderDelegate: AnyObject {
         openFileOperation = nil
         displayOperation = nil
         decodeFrameOperation = nil
+        audioFeedOperation = nil
         ffmpegOperationQueue = nil
     }
 
     private func checkBufferingStatus() {
+        let policy = isLiveStream ? liveBufferingPolicy : bufferingPolicy
         if buffering {
-            let currentTime = Date().timeIntervalSince1970
-            let bufferingElapsed = currentTime - bufferingStartTime
-
-            // For live streams, use more aggressive buffering recovery
-            let maxDuration = isLiveStream ? liveStreamBufferingMaxDuration : bufferingMaxDuration
-            let minThreshold = isLiveStream ? 0.2 : bufferingMinimumThreshold
-
-            // For live streams with no duration, use a lower minimum buffered duration requirement
-            let effectiveMinBufferedDuration: TimeInterval = isLiveStream ? 0 : minBufferedDuration
-
-            // Exit buffering if any of these conditions are met:
-            // 1. We have enough buffered duration
-            // 2. We've reached the end of file
-            // 3. Buffering timeout exceeded (prevents indefinite buffering on poor network)
-            // 4. For live streams: any data buffered after timeout (even minimal)
-            let shouldExitBuffering = (bufferedDuration >= effectiveMinBufferedDuration) ||
-                                      endOfFile ||
-                                      (bufferingElapsed > maxDuration && bufferedDuration >= minThreshold) ||
-                                      (isLiveStream && bufferingElapsed > maxDuration && bufferedDuration > 0.1)
-
-            if shouldExitBuffering {
+            let bufferingElapsed = Date().timeIntervalSince1970 - bufferingStartTime
+            if Self.shouldExitBuffering(bufferedDuration: bufferedDuration,
+                                        minBufferedDuration: minBufferedDuration,
+                                        elapsed: bufferingElapsed,
+                                        endOfFile: endOfFile,
+                                        policy: policy) {
                 buffering = false
                 bufferingStartTime = 0
             }
-        } else if bufferedDuration <= 0.2 && !endOfFile && !isLiveStream {
-            // For regular streams, enter buffering when buffer gets low
-            buffering = true
-            bufferingStartTime = Date().timeIntervalSince1970
-        } else if bufferedDuration <= 0.05 && !endOfFile && isLiveStream {
-            // Live streams only enter buffering if buffer is critically low
+        } else if Self.shouldEnterBuffering(bufferedDuration: bufferedDuration, endOfFile: endOfFile, policy: policy) {
             buffering = true
             bufferingStartTime = Date().timeIntervalSince1970
         }
@@ -811,7 +1359,7 @@ protocol IRFFDecoderDelegate: AnyObject {
 
     private func updateBufferedDurationByAudio() {
         if formatContext?.audioEnable == true {
-            bufferedDuration = audioDecoder?.duration() ?? 0.0
+            bufferedDuration = (audioDecoder?.duration() ?? 0.0) + audioSampleRing.bufferedDuration
         }
     }
 
@@ -823,7 +1371,7 @@ protocol IRFFDecoderDelegate: AnyObject {
 
     private func updateProgressByAudio() {
         if formatContext?.audioEnable == true {
-            progress = currentAudioFrame?.position ?? 0
+            progress = audioTimeClock
         }
     }
 
@@ -1,6 +1,9 @@
 import Foundation
 
 enum IRFFDecoderAudioPolicy {
+    /// How long the audio feed thread sleeps when the sample ring is full or the decoder
+    /// has nothing queued; well under the ring's `defaultBufferDuration`.
+    static let audioFeedInterval: TimeInterval = 0.005
 
     static func audioPacketError(fromPacketResult packetResult: Int) -> NSError? {
         return IRFFCheckErrorCode(Int32(packetResult), errorCode: IRFFDecoderErrorCode.codecAudioSendPacket.rawValue)
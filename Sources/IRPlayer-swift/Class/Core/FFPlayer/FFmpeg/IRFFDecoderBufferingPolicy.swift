@@ -0,0 +1,37 @@
+//
+//  IRFFDecoderBufferingPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+enum IRFFDecoderBufferingPolicy {
+
+    /// Whether playback should stop to buffer with `bufferedDuration` left.
+    static func shouldEnterBuffering(bufferedDuration: TimeInterval,
+                                     endOfFile: Bool,
+                                     policy: IRBufferingPolicy) -> Bool {
+        guard !endOfFile else { return false }
+        let bufferedDuration = bufferedDuration.isFinite ? bufferedDuration : 0
+        return bufferedDuration <= policy.enterThreshold
+    }
+
+    /// Whether buffering that started `elapsed` seconds ago can end: the playable
+    /// interval is buffered, the input ended, or the timeout passed with at least the
+    /// timeout threshold buffered, which keeps a poor network from stalling forever.
+    static func shouldExitBuffering(bufferedDuration: TimeInterval,
+                                    minBufferedDuration: TimeInterval,
+                                    elapsed: TimeInterval,
+                                    endOfFile: Bool,
+                                    policy: IRBufferingPolicy) -> Bool {
+        guard !endOfFile else { return true }
+        let bufferedDuration = bufferedDuration.isFinite ? bufferedDuration : 0
+        let requiredDuration = policy.waitsForPlayableBufferInterval && minBufferedDuration.isFinite ? minBufferedDuration : 0
+        if bufferedDuration >= requiredDuration {
+            return true
+        }
+        return elapsed > policy.timeout && bufferedDuration >= policy.timeoutResumeThreshold
+    }
+}
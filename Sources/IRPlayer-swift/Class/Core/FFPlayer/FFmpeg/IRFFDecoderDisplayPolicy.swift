@@ -1,12 +1,18 @@
 import Foundation
 
 enum IRFFDecoderDisplayPolicy {
+    static let lateFrameTolerance: TimeInterval = 0.05
+    static let maxConsecutiveLateDrops = 8
+    static let nonReferenceSkipEnterLag: TimeInterval = 0.5
+    static let nonReferenceSkipExitLag: TimeInterval = 0.1
+    static let maxFrameWaitInterval: TimeInterval = 0.1
 
     static func audioSyncedVideoSleepDuration(framePosition: TimeInterval,
                                               frameDuration: TimeInterval,
                                               audioTimeClock: TimeInterval,
-                                              fps: TimeInterval) -> TimeInterval? {
-        let sleepTime: TimeInterval
+                                              fps: TimeInterval,
+                                              rate: Double = 1) -> TimeInterval? {
+        var sleepTime: TimeInterval
         if framePosition >= audioTimeClock {
             guard let frameInterval = frameInterval(forFPS: fps) else { return nil }
             sleepTime = frameInterval / 2
@@ -16,15 +22,47 @@ enum IRFFDecoderDisplayPolicy {
         } else {
             return nil
         }
+        sleepTime = IRFFPlaybackRatePolicy.hostDuration(mediaDuration: sleepTime, rate: rate)
 
         return sleepTime < 0.015 ? 0.015 : sleepTime
     }
 
-    static func standaloneVideoSleepDuration(frameDuration: TimeInterval, fps: TimeInterval) -> TimeInterval? {
-        if frameDuration.isFinite, frameDuration >= 0.0001 {
-            return frameDuration
-        }
-        return frameInterval(forFPS: fps)
+    /// How far a frame's display window already lies behind the audio clock; positive
+    /// when the frame is late.
+    static func videoLag(framePosition: TimeInterval,
+                         frameDuration: TimeInterval,
+                         audioTimeClock: TimeInterval) -> TimeInterval? {
+        guard framePosition.isFinite, audioTimeClock.isFinite else { return nil }
+        let duration = frameDuration.isFinite && frameDuration > 0 ? frameDuration : 0
+        return audioTimeClock - (framePosition + duration)
+    }
+
+    /// Drops a frame whose window ended more than `lateFrameTolerance` ago, but never
+    /// more than `maxConsecutiveLateDrops` in a row so the picture keeps moving while the
+    /// decoder catches up.
+    static func shouldDropLateVideoFrame(framePosition: TimeInterval,
+                                         frameDuration: TimeInterval,
+                                         audioTimeClock: TimeInterval,
+                                         consecutiveDrops: Int) -> Bool {
+        guard consecutiveDrops < maxConsecutiveLateDrops,
+              let lag = videoLag(framePosition: framePosition,
+                                 frameDuration: frameDuration,
+                                 audioTimeClock: audioTimeClock) else { return false }
+        return lag > lateFrameTolerance
+    }
+
+    /// Hysteresis for decode-side skipping of non-reference frames: starts once video
+    /// lags by more than `nonReferenceSkipEnterLag` and stops when the lag is back under
+    /// `nonReferenceSkipExitLag`.
+    static func skipsNonReferenceFrames(lag: TimeInterval?, currentlySkipping: Bool) -> Bool {
+        guard let lag, lag.isFinite else { return false }
+        return lag > (currentlySkipping ? nonReferenceSkipExitLag : nonReferenceSkipEnterLag)
+    }
+
+    /// Time left until a frame paced on the wall clock is due, or nil when it is due.
+    static func wallClockVideoSleepDuration(targetHostTime: TimeInterval, hostTime: TimeInterval) -> TimeInterval? {
+        guard targetHostTime.isFinite, hostTime.isFinite, targetHostTime > hostTime else { return nil }
+        return targetHostTime - hostTime
     }
 
     static func videoFrameOrderingPosition(_ position: TimeInterval?) -> TimeInterval? {
@@ -51,6 +89,25 @@ enum IRFFDecoderDisplayPolicy {
         return nil
     }
 
+    /// How long the display thread may block waiting for the next decoded frame before it
+    /// wakes to re-check pause, seek and close state: two frame intervals, kept within
+    /// 20...100 ms.
+    static func frameWaitInterval(fps: TimeInterval) -> TimeInterval {
+        guard let frameInterval = frameInterval(forFPS: fps) else { return maxFrameWaitInterval }
+        return min(max(frameInterval * 2, 0.02), maxFrameWaitInterval)
+    }
+
+    /// How long the display thread blocks for the next decoded frame: until the host
+    /// time that frame is due while that is still ahead, otherwise `frameWaitInterval`
+    /// so a late or starved decoder still lets pause, seek and close be noticed.
+    static func frameWaitDuration(dueHostTime: TimeInterval?, hostTime: TimeInterval, fps: TimeInterval) -> TimeInterval {
+        let waitInterval = frameWaitInterval(fps: fps)
+        guard let dueHostTime, dueHostTime.isFinite, hostTime.isFinite, dueHostTime > hostTime else {
+            return waitInterval
+        }
+        return min(dueHostTime - hostTime, maxFrameWaitInterval)
+    }
+
     static func shouldFinishDisplay(endOfFile: Bool, videoDecoderEmpty: Bool) -> Bool {
         return endOfFile && videoDecoderEmpty
     }
@@ -24,6 +24,15 @@ enum IRFFDecoderSeekPolicy {
         return IRFFDecoder.SeekPreparation(clampedTime: clampedSeekTime)
     }
 
+    /// Frames before an accurate seek's target are decoded only as references for
+    /// the first one shown; the frame that covers the target is the first shown.
+    static func presentsFrame(position: TimeInterval,
+                              duration: TimeInterval,
+                              seekTarget: TimeInterval?) -> Bool {
+        guard let seekTarget else { return true }
+        return position >= seekTarget || position + max(duration, 0) > seekTarget
+    }
+
     static func resumeSeekTarget(playbackFinished: Bool) -> TimeInterval? {
         return playbackFinished ? 0 : nil
     }
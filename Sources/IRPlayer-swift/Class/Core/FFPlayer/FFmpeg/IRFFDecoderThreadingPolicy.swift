@@ -0,0 +1,46 @@
+//
+//  IRFFDecoderThreadingPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+
+enum IRFFDecoderThreadingPolicy {
+    /// Upper bound for automatic thread counts; FFmpeg's own auto mode stops at 16 too.
+    static let maximumAutomaticThreadCount = 16
+
+    static func threadCount(for threading: IRDecoderThreading, activeProcessorCount: Int) -> Int32 {
+        if threading.threadCount > 0 {
+            return Int32(clamping: threading.threadCount)
+        }
+        return Int32(min(max(activeProcessorCount, 1), maximumAutomaticThreadCount))
+    }
+
+    static func threadType(for threading: IRDecoderThreading) -> Int32 {
+        switch threading.threadType {
+        case .automatic:
+            return FF_THREAD_FRAME | FF_THREAD_SLICE
+        case .frame:
+            return FF_THREAD_FRAME
+        case .slice:
+            return FF_THREAD_SLICE
+        }
+    }
+
+    /// Frame threading delays every frame by one per thread, so a profile that must
+    /// not hold frames back keeps only the thread count.
+    static func threading(_ threading: IRDecoderThreading, for profile: IRDecoderInputProfile) -> IRDecoderThreading {
+        guard profile.sliceThreadingOnly else { return threading }
+        return IRDecoderThreading(threadCount: threading.threadCount, threadType: .slice)
+    }
+
+    static func apply(_ threading: IRDecoderThreading,
+                      to codecContext: UnsafeMutablePointer<AVCodecContext>,
+                      activeProcessorCount: Int = ProcessInfo.processInfo.activeProcessorCount) {
+        codecContext.pointee.thread_count = threadCount(for: threading, activeProcessorCount: activeProcessorCount)
+        codecContext.pointee.thread_type = threadType(for: threading)
+    }
+}
@@ -58,6 +58,16 @@ public class IRFFFormatContext {
     private(set) var videoPresentationSize: CGSize = .zero
     private(set) var videoAspect: CGFloat = 0
     private(set) var audioTimebase: TimeInterval = 0
+    /// Applied to the video codec context before it is opened.
+    var videoThreading: IRDecoderThreading = .automatic
+    /// Skips audio entirely: audio streams are discarded before probing and no audio
+    /// track is opened, so a missing audio stream is not an error.
+    var videoOnly = false
+    /// Demuxer limits applied when the input is opened.
+    var inputProfile: IRDecoderInputProfile = .standard
+    /// Key frames of the open video track, used to seek straight to the GOP that
+    /// holds the target.
+    let videoKeyFrameIndex = IRFFKeyFrameIndex()
 
     init(contentURL: URL, videoFormat: IRVideoFormat) {
         self.contentURL = contentURL
@@ -110,8 +120,8 @@ public class IRFFFormatContext {
 
         openTracks()
         let videoError = openVideoTrack()
-        let audioError = openAudioTrack()
-        self.error = Self.selectedSetupError(videoError: videoError, audioError: audioError)
+        let audioError = videoOnly ? nil : openAudioTrack()
+        self.error = Self.setupError(videoError: videoError, audioError: audioError, videoOnly: videoOnly)
     }
 
     private func openStream() -> NSError? {
@@ -129,8 +139,8 @@ public class IRFFFormatContext {
         formatContext?.pointee.interrupt_callback.opaque = Self.interruptOpaquePointer(for: self)
 
         var opts = AVDictionary(rawPointer: nil)
-        if videoFormat == .rtsp {
-            let ret = av_dict_set(&opts.rawPointer, "rtsp_transport", "tcp", 0)
+        for (key, value) in Self.openInputOptions(videoFormat: videoFormat, videoOnly: videoOnly, profile: inputProfile) {
+            let ret = av_dict_set(&opts.rawPointer, key, value, 0)
             if !Self.dictionaryOptionWasApplied(ret) {
                 // Continue opening input; FFmpeg will surface fatal stream errors.
             }
@@ -145,6 +155,7 @@ public class IRFFFormatContext {
             return error
         }
 
+        discardUnusedStreams()
         result = avformat_find_stream_info(formatContext, nil)
         error = IRFFCheckErrorCode(result, errorCode: IRFFDecoderErrorCode.formatFindStreamInfo.rawValue)
         if error != nil || formatContext == nil {
@@ -162,13 +173,23 @@ public class IRFFFormatContext {
         return error
     }
 
+    private func discardUnusedStreams() {
+        for i in 0..<Int((formatContext?.pointee.nb_streams ?? 0)) {
+            guard let stream = Self.stream(at: i, in: formatContext),
+                  let codecParameters = stream.pointee.codecpar,
+                  Self.discardsStream(codecType: codecParameters.pointee.codec_type, videoOnly: videoOnly) else { continue }
+            stream.pointee.discard = AVDISCARD_ALL
+        }
+    }
+
     private func openTracks() {
         var videoTracks: [IRFFTrack] = []
         var audioTracks: [IRFFTrack] = []
 
         for i in 0..<Int((formatContext?.pointee.nb_streams ?? 0)) {
             guard let stream = Self.stream(at: i, in: formatContext),
-                  let codecParameters = stream.pointee.codecpar else { continue }
+                  let codecParameters = stream.pointee.codecpar,
+                  !Self.discardsStream(codecType: codecParameters.pointee.codec_type, videoOnly: videoOnly) else { continue }
 
             let metadata = IRFFFoundationBrigeOfAVDictionary(stream.pointee.metadata).map(IRFFMetadata.init(dictionary:))
             guard let track = Self.track(index: i, codecType: codecParameters.pointee.codec_type, metadata: metadata) else {
@@ -203,7 +224,8 @@ public class IRFFFormatContext {
 
                 if (stream.pointee.disposition & AV_DISPOSITION_ATTACHED_PIC) == 0 {
                     var codecContext: UnsafeMutablePointer<AVCodecContext>?
-                    error = openStream(with: Int(index), codecContext: &codecContext, domain: "video")
+                    error = openStream(with: Int(index), codecContext: &codecContext, domain: "video",
+                                       threading: IRFFDecoderThreadingPolicy.threading(videoThreading, for: inputProfile))
                     if error == nil {
                         self.videoTrack = track
                         self.videoEnable = true
@@ -212,6 +234,7 @@ public class IRFFFormatContext {
                         self.videoPresentationSize = Self.presentationSize(width: codecContext?.pointee.width ?? 0, height: codecContext?.pointee.height ?? 0)
                         self.videoAspect = Self.videoAspect(width: codecContext?.pointee.width ?? 0, height: codecContext?.pointee.height ?? 0)
                         self.videoCodecContext = codecContext
+                        seedVideoKeyFrameIndex(from: stream)
                         break
                     }
                 }
@@ -223,6 +246,27 @@ public class IRFFFormatContext {
         return error
     }
 
+    /// Copies the key frames the demuxer already knows about, e.g. an MP4 sync sample
+    /// table or Matroska cues; anything else is learnt while reading. Formats on
+    /// FFmpeg's generic index only list the packets probed so far, so their index is
+    /// never treated as complete.
+    private func seedVideoKeyFrameIndex(from stream: UnsafeMutablePointer<AVStream>) {
+        videoKeyFrameIndex.removeAll()
+        let entryCount = avformat_index_get_entries_count(stream)
+        for i in 0..<entryCount {
+            guard let entry = avformat_index_get_entry(stream, i),
+                  entry.pointee.flags & AVINDEX_KEYFRAME != 0,
+                  entry.pointee.timestamp != IR_AV_NOPTS_VALUE else { continue }
+            videoKeyFrameIndex.insert(IRFFFrameTime.position(timestamp: entry.pointee.timestamp, timebase: videoTimebase))
+        }
+        let formatFlags = formatContext?.pointee.iformat?.pointee.flags ?? AVFMT_GENERIC_INDEX
+        if Self.demuxerIndexIsComplete(entryCount: Int(entryCount),
+                                       keyFrameCount: videoKeyFrameIndex.count,
+                                       formatFlags: formatFlags) {
+            videoKeyFrameIndex.markComplete()
+        }
+    }
+
     private func openAudioTrack() -> NSError? {
         var error: NSError?
 
@@ -248,7 +292,7 @@ public class IRFFFormatContext {
         return error
     }
 
-    private func openStream(with trackIndex: Int, codecContext: inout UnsafeMutablePointer<AVCodecContext>?, domain: String) -> NSError? {
+    private func openStream(with trackIndex: Int, codecContext: inout UnsafeMutablePointer<AVCodecContext>?, domain: String, threading: IRDecoderThreading? = nil) -> NSError? {
         var result: Int32 = 0
         var error: NSError?
 
@@ -282,6 +326,9 @@ public class IRFFFormatContext {
             return error
         }
         openedCodecContext.pointee.codec_id = codec.pointee.id
+        if let threading {
+            IRFFDecoderThreadingPolicy.apply(threading, to: openedCodecContext)
+        }
 
         result = avcodec_open2(codecContext, codec, nil)
         error = IRFFCheckErrorCode(result, errorCode: IRFFDecoderErrorCode.codecOpen2.rawValue)
@@ -293,19 +340,62 @@ public class IRFFFormatContext {
         return error
     }
 
+    static func setupError(videoError: NSError?, audioError: NSError?, videoOnly: Bool) -> NSError? {
+        return IRFFFormatContextPolicy.setupError(videoError: videoError, audioError: audioError, videoOnly: videoOnly)
+    }
+
+    static func openInputOptions(videoFormat: IRVideoFormat,
+                                 videoOnly: Bool,
+                                 profile: IRDecoderInputProfile = .standard) -> [String: String] {
+        return IRFFFormatContextPolicy.openInputOptions(videoFormat: videoFormat, videoOnly: videoOnly, profile: profile)
+    }
+
+    static func discardsStream(codecType: AVMediaType, videoOnly: Bool) -> Bool {
+        return IRFFFormatContextPolicy.discardsStream(codecType: codecType, videoOnly: videoOnly)
+    }
+
     static func seekTimestamp(for time: TimeInterval) -> Int64? {
         return IRFFFormatContextPolicy.seekTimestamp(for: time)
     }
 
+    static func streamTimestamp(for position: TimeInterval, timebase: TimeInterval) -> Int64? {
+        return IRFFFormatContextPolicy.streamTimestamp(for: position, timebase: timebase)
+    }
+
+    static func demuxerIndexIsComplete(entryCount: Int, keyFrameCount: Int, formatFlags: Int32) -> Bool {
+        return IRFFFormatContextPolicy.demuxerIndexIsComplete(entryCount: entryCount,
+                                                               keyFrameCount: keyFrameCount,
+                                                               formatFlags: formatFlags)
+    }
+
+    /// Seeks the video stream to the indexed key frame at or before `time` when the
+    /// index covers `time`, falling back to a container-wide backward seek when it
+    /// does not, e.g. forward past the furthest packet read from a file without an
+    /// index of its own.
     func seekFile(withFFTimebase time: TimeInterval) {
-        guard let ts = Self.seekTimestamp(for: time),
-              let formatContext else { return }
+        guard let formatContext else { return }
+        if let videoTrack,
+           let keyFrame = videoKeyFrameIndex.coveredKeyFrame(atOrBefore: time),
+           let ts = Self.streamTimestamp(for: keyFrame, timebase: videoTimebase),
+           av_seek_frame(formatContext, Int32(videoTrack.index), ts, AVSEEK_FLAG_BACKWARD) >= 0 {
+            return
+        }
+        guard let ts = Self.seekTimestamp(for: time) else { return }
         av_seek_frame(formatContext, -1, ts, AVSEEK_FLAG_BACKWARD)
     }
 
     func readFrame(_ packet: UnsafeMutablePointer<AVPacket>) -> Int32 {
         guard let formatContext else { return -1 }
-        return av_read_frame(formatContext, packet)
+        let result = av_read_frame(formatContext, packet)
+        if result >= 0,
+           let videoTrack,
+           packet.pointee.stream_index == Int32(videoTrack.index),
+           packet.pointee.flags & AV_PKT_FLAG_KEY != 0 {
+            videoKeyFrameIndex.insert(IRFFFrameTime.packetPosition(pts: packet.pointee.pts,
+                                                                   dts: packet.pointee.dts,
+                                                                   timebase: videoTimebase))
+        }
+        return result
     }
 
     func containAudioTrack(_ audioTrackIndex: Int) -> Bool {
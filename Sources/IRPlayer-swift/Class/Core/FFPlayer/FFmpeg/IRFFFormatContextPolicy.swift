@@ -40,6 +40,65 @@ enum IRFFFormatContextPolicy {
         return videoError
     }
 
+    /// A video-only context fails only on its video stream; audio is never opened.
+    static func setupError(videoError: NSError?, audioError: NSError?, videoOnly: Bool) -> NSError? {
+        guard !videoOnly else { return videoError }
+        return selectedSetupError(videoError: videoError, audioError: audioError)
+    }
+
+    /// Options for `avformat_open_input`. RTSP runs over TCP, and a video-only RTSP
+    /// session never sets up its other media, so their SDP entries are not probed.
+    /// `profile` adds its demuxer limits on top; unusable values are left out.
+    static func openInputOptions(videoFormat: IRVideoFormat,
+                                 videoOnly: Bool,
+                                 profile: IRDecoderInputProfile = .standard) -> [String: String] {
+        var options: [String: String] = [:]
+        if videoFormat == .rtsp {
+            options["rtsp_transport"] = "tcp"
+            if videoOnly {
+                options["allowed_media_types"] = "video"
+            }
+            if let reorderQueueSize = profile.reorderQueueSize, reorderQueueSize >= 0 {
+                options["reorder_queue_size"] = String(reorderQueueSize)
+            }
+        }
+        if profile.noBuffer {
+            options["fflags"] = "nobuffer"
+        }
+        if let probeSize = profile.probeSize, probeSize >= minimumProbeSize {
+            options["probesize"] = String(probeSize)
+        }
+        if let analyzeDuration = microseconds(profile.analyzeDuration) {
+            options["analyzeduration"] = String(analyzeDuration)
+        }
+        if let maxDelay = microseconds(profile.maxDelay) {
+            options["max_delay"] = String(maxDelay)
+        }
+        return options
+    }
+
+    /// Smallest `probesize` FFmpeg accepts.
+    private static let minimumProbeSize = 32
+
+    private static func microseconds(_ seconds: TimeInterval?) -> Int64? {
+        guard let seconds, seconds.isFinite, seconds >= 0 else { return nil }
+        let microseconds = (seconds * 1_000_000).rounded()
+        guard microseconds <= Double(Int32.max) else { return nil }
+        return Int64(microseconds)
+    }
+
+    /// Whether the demuxer should drop a stream before probing; video-only contexts
+    /// keep nothing but video.
+    static func discardsStream(codecType: AVMediaType, videoOnly: Bool) -> Bool {
+        return videoOnly && codecType != AVMEDIA_TYPE_VIDEO
+    }
+
+    /// A demuxer's own index (MP4 sync samples, Matroska cues) lists every key frame
+    /// up front; FFmpeg's generic index only grows as packets are read.
+    static func demuxerIndexIsComplete(entryCount: Int, keyFrameCount: Int, formatFlags: Int32) -> Bool {
+        return entryCount > 0 && keyFrameCount > 0 && formatFlags & AVFMT_GENERIC_INDEX == 0
+    }
+
     static func seekTimestamp(for time: TimeInterval) -> Int64? {
         guard time.isFinite, time >= 0 else { return nil }
         let timestamp = time * Double(AV_TIME_BASE)
@@ -51,6 +110,15 @@ enum IRFFFormatContextPolicy {
         return Int64(timestamp)
     }
 
+    /// `position` in ticks of a stream's `timebase`, rounded so a position read from
+    /// a packet maps back onto that packet's timestamp.
+    static func streamTimestamp(for position: TimeInterval, timebase: TimeInterval) -> Int64? {
+        guard position.isFinite, position >= 0, timebase.isFinite, timebase > 0 else { return nil }
+        let timestamp = (position / timebase).rounded()
+        guard timestamp.isFinite, timestamp <= Double(Int64.max) else { return nil }
+        return Int64(timestamp)
+    }
+
     static func track(index: Int, codecType: AVMediaType, metadata: IRFFMetadata?) -> IRFFTrack? {
         guard index >= 0 else { return nil }
 
@@ -0,0 +1,98 @@
+//
+//  IRFFKeyFrameIndex.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Sorted key frame positions of one stream, in seconds. Seeded from the demuxer's
+/// own index when the container has one and filled in as packets are read, so
+/// streams without an index still learn where their GOPs start.
+final class IRFFKeyFrameIndex {
+    private let lock = NSLock()
+    private var positions: [TimeInterval] = []
+    private var complete = false
+
+    /// Positions closer than this are treated as the same key frame.
+    static let tolerance: TimeInterval = 0.000_001
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return positions.count
+    }
+
+    /// True once the positions came from a demuxer index that covers the whole
+    /// stream, rather than from the packets read so far.
+    var isComplete: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return complete
+    }
+
+    func markComplete() {
+        lock.lock()
+        complete = true
+        lock.unlock()
+    }
+
+    func insert(_ position: TimeInterval) {
+        guard position.isFinite, position >= 0 else { return }
+        lock.lock()
+        defer { lock.unlock() }
+        // Packets mostly arrive in order, so appending is the common case.
+        if let last = positions.last, position > last + Self.tolerance {
+            positions.append(position)
+            return
+        }
+        let index = Self.insertionIndex(of: position, in: positions)
+        if index > 0, position - positions[index - 1] <= Self.tolerance { return }
+        if index < positions.count, positions[index] - position <= Self.tolerance { return }
+        positions.insert(position, at: index)
+    }
+
+    /// Nearest known key frame at or before `time`.
+    func keyFrame(atOrBefore time: TimeInterval) -> TimeInterval? {
+        guard time.isFinite else { return nil }
+        lock.lock()
+        defer { lock.unlock() }
+        let index = Self.insertionIndex(of: time + Self.tolerance, in: positions)
+        return index > 0 ? positions[index - 1] : nil
+    }
+
+    /// Like `keyFrame(atOrBefore:)`, but only when `time` lies inside what has been
+    /// indexed: a known key frame follows it, or the index is complete. Past the
+    /// furthest packet read there may be key frames the index has not seen yet.
+    func coveredKeyFrame(atOrBefore time: TimeInterval) -> TimeInterval? {
+        guard time.isFinite else { return nil }
+        lock.lock()
+        defer { lock.unlock() }
+        let index = Self.insertionIndex(of: time + Self.tolerance, in: positions)
+        guard index > 0, complete || index < positions.count else { return nil }
+        return positions[index - 1]
+    }
+
+    func removeAll() {
+        lock.lock()
+        positions.removeAll()
+        complete = false
+        lock.unlock()
+    }
+
+    /// First index whose position is not below `position`.
+    static func insertionIndex(of position: TimeInterval, in positions: [TimeInterval]) -> Int {
+        var low = 0
+        var high = positions.count
+        while low < high {
+            let mid = (low + high) / 2
+            if positions[mid] < position {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  IRFFLiveCatchUpPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// What a live stream does about latency that built up in the decoder's buffers.
+enum IRFFLiveCatchUpAction: Equatable {
+    case none
+    /// Plays `IRFFLiveCatchUpPolicy.speedUpRate` times faster until back at the target.
+    case speedUp
+    /// Throws away everything buffered and resumes at the next key frame.
+    case dropToKeyFrame
+}
+
+enum IRFFLiveCatchUpPolicy {
+    static let defaultTargetLatency: TimeInterval = 1.0
+    static let speedUpRate = 1.1
+    /// Latency over the target that starts a speed-up; it runs until the target is met.
+    static let speedUpExcess: TimeInterval = 0.5
+    /// Latency over the target that is too much to play off, e.g. after a network burst.
+    static let dropExcess: TimeInterval = 3.0
+
+    /// `canDropPackets` is false while audio drives the clock: its samples cannot be
+    /// cut without a gap, so audio streams only ever speed up.
+    static func action(latency: TimeInterval,
+                       targetLatency: TimeInterval,
+                       speedingUp: Bool,
+                       canDropPackets: Bool) -> IRFFLiveCatchUpAction {
+        guard latency.isFinite, targetLatency.isFinite, targetLatency > 0 else { return .none }
+        let excess = latency - targetLatency
+        if canDropPackets, excess > dropExcess {
+            return .dropToKeyFrame
+        }
+        return excess > (speedingUp ? 0 : speedUpExcess) ? .speedUp : .none
+    }
+
+    /// Rate presentation runs at for the user's `rate` while a speed-up is on.
+    static func presentationRate(rate: Double, speedingUp: Bool) -> Double {
+        return IRPlayerRate.normalized(rate * (speedingUp ? speedUpRate : 1))
+    }
+}
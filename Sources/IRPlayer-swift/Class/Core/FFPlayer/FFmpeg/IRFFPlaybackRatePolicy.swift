@@ -0,0 +1,66 @@
+//
+//  IRFFPlaybackRatePolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// How much video the decoder throws away to keep up with a fast playback rate.
+enum IRFFVideoDecimation: Equatable {
+    case none
+    /// Software decoding skips non-reference frames.
+    case nonReferenceFrames
+    /// Packets of non-key frames are dropped before decoding.
+    case keyFramesOnly
+}
+
+enum IRFFPlaybackRatePolicy {
+    static let nonReferenceDecimationRate = 1.5
+    static let keyFrameDecimationRate = 2.5
+    private static let unityTolerance = 0.001
+
+    /// Whether audio has to go through the time stretcher at `rate`.
+    static func usesTimeStretch(rate: Double) -> Bool {
+        return abs(IRPlayerRate.normalized(rate) - 1) > unityTolerance
+    }
+
+    static func videoDecimation(rate: Double) -> IRFFVideoDecimation {
+        let rate = IRPlayerRate.normalized(rate)
+        if rate >= keyFrameDecimationRate {
+            return .keyFramesOnly
+        }
+        if rate >= nonReferenceDecimationRate {
+            return .nonReferenceFrames
+        }
+        return .none
+    }
+
+    /// Whether to decode a packet, and whether the next one must be a key frame. After
+    /// non-key packets were dropped, the frames that follow reference pictures that
+    /// were never decoded, so decoding only resumes at the next key frame.
+    static func packetDecision(isKeyFrame: Bool,
+                               decimation: IRFFVideoDecimation,
+                               awaitingKeyFrame: Bool) -> (decodes: Bool, awaitingKeyFrame: Bool) {
+        if decimation == .keyFramesOnly || awaitingKeyFrame {
+            return (isKeyFrame, !isKeyFrame)
+        }
+        return (true, false)
+    }
+
+    /// Rate the audio clock runs at while the output plays samples written with
+    /// `playbackSecondsPerSample` media seconds each; 1 when either is unknown.
+    static func clockRate(playbackSecondsPerSample: TimeInterval, outputSecondsPerSample: TimeInterval) -> Double {
+        guard playbackSecondsPerSample.isFinite, playbackSecondsPerSample > 0,
+              outputSecondsPerSample.isFinite, outputSecondsPerSample > 0 else {
+            return 1
+        }
+        return playbackSecondsPerSample / outputSecondsPerSample
+    }
+
+    /// Host time it takes to play `mediaDuration` at `rate`.
+    static func hostDuration(mediaDuration: TimeInterval, rate: Double) -> TimeInterval {
+        return mediaDuration / IRPlayerRate.normalized(rate)
+    }
+}
@@ -0,0 +1,233 @@
+//
+//  IRFFPresentationSchedulerPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+enum IRFFPresentationSchedulerPolicy {
+    struct Selection: Equatable {
+        /// Index of the frame to put on screen at this vsync, or nil to keep the
+        /// previous one.
+        let index: Int?
+        /// Frames ahead of `index` that became due before they could be shown.
+        let droppedCount: Int
+    }
+
+    /// Ready frames queued per scheduler. The frame on screen has already left the ring,
+    /// so this is the frame for the next vsync plus two of headroom for a display
+    /// thread that wakes late.
+    static let defaultCapacity = 3
+
+    /// Picks the frame for the vsync at `vsyncHostTime` from targets sorted ascending.
+    ///
+    /// A frame is due when its target falls before the midpoint between this vsync
+    /// and the next one, so the last due frame is the one whose target is closest to
+    /// the vsync; any due frames before it are dropped.
+    static func selection(targetHostTimes: [TimeInterval],
+                          vsyncHostTime: TimeInterval,
+                          vsyncInterval: TimeInterval) -> Selection {
+        let deadline = vsyncHostTime + halfInterval(vsyncInterval)
+        var dueCount = 0
+        for target in targetHostTimes {
+            guard target < deadline else { break }
+            dueCount += 1
+        }
+        guard dueCount > 0 else { return Selection(index: nil, droppedCount: 0) }
+        return Selection(index: dueCount - 1, droppedCount: dueCount - 1)
+    }
+
+    /// True when the frame on screen has outlived its duration at this vsync and
+    /// nothing replaced it, i.e. the vsync shows a repeat rather than normal cadence.
+    static func isRepeat(presentedTargetHostTime: TimeInterval?,
+                         presentedDuration: TimeInterval,
+                         vsyncHostTime: TimeInterval,
+                         vsyncInterval: TimeInterval) -> Bool {
+        guard let presentedTargetHostTime, presentedTargetHostTime.isFinite else { return false }
+        let duration = presentedDuration.isFinite && presentedDuration > 0 ? presentedDuration : 0
+        return vsyncHostTime - halfInterval(vsyncInterval) >= presentedTargetHostTime + duration
+    }
+
+    /// Vsyncs between `previousVsyncHostTime` and `vsyncHostTime` that a paused display
+    /// link never delivered and that would each have repeated the frame on screen.
+    static func skippedRepeatCount(presentedTargetHostTime: TimeInterval?,
+                                   presentedDuration: TimeInterval,
+                                   previousVsyncHostTime: TimeInterval?,
+                                   vsyncHostTime: TimeInterval,
+                                   vsyncInterval: TimeInterval) -> Int {
+        guard let presentedTargetHostTime, presentedTargetHostTime.isFinite,
+              let previousVsyncHostTime, previousVsyncHostTime.isFinite,
+              vsyncHostTime.isFinite, vsyncInterval.isFinite, vsyncInterval > 0 else {
+            return 0
+        }
+        let skipped = Int(((vsyncHostTime - previousVsyncHostTime) / vsyncInterval).rounded()) - 1
+        guard skipped > 0 else { return 0 }
+        let duration = presentedDuration.isFinite && presentedDuration > 0 ? presentedDuration : 0
+        // `isRepeat` holds for every vsync from here on.
+        let repeatsFrom = presentedTargetHostTime + duration + halfInterval(vsyncInterval)
+        let firstRepeat = max(1, Int(((repeatsFrom - previousVsyncHostTime) / vsyncInterval).rounded(.up)))
+        return max(0, skipped - firstRepeat + 1)
+    }
+
+    /// Host time at which a frame at `framePosition` should be on screen, given a clock
+    /// that read `clockPosition` at `clockHostTime` and advances at `rate`.
+    static func targetHostTime(framePosition: TimeInterval,
+                               clockPosition: TimeInterval,
+                               clockHostTime: TimeInterval,
+                               rate: Double = 1) -> TimeInterval? {
+        guard framePosition.isFinite, clockPosition.isFinite, clockHostTime.isFinite else { return nil }
+        return clockHostTime + IRFFPlaybackRatePolicy.hostDuration(mediaDuration: framePosition - clockPosition, rate: rate)
+    }
+
+    /// Share of a late frame's lateness the standalone anchor gives way by, so video
+    /// that keeps arriving late settles at a steady delay instead of bursting to catch up.
+    static let standaloneDriftCorrectionGain = 0.1
+
+    /// Anchor for video without audio: the first frame, or the first after a jump of
+    /// more than `maxDrift`, is pinned to `hostTime` and later frames follow their pts.
+    /// A frame that is late on the anchor moves it later by `driftCorrectionGain` of
+    /// its lateness.
+    static func standaloneAnchor(framePosition: TimeInterval,
+                                 hostTime: TimeInterval,
+                                 anchor: (position: TimeInterval, hostTime: TimeInterval)?,
+                                 rate: Double = 1,
+                                 maxDrift: TimeInterval = 1.0,
+                                 driftCorrectionGain: Double = 0) -> (position: TimeInterval, hostTime: TimeInterval) {
+        if let anchor,
+           let target = targetHostTime(framePosition: framePosition,
+                                       clockPosition: anchor.position,
+                                       clockHostTime: anchor.hostTime,
+                                       rate: rate),
+           abs(target - hostTime) <= maxDrift {
+            let lateness = hostTime - target
+            guard lateness > 0, driftCorrectionGain.isFinite, driftCorrectionGain > 0 else { return anchor }
+            return (position: anchor.position, hostTime: anchor.hostTime + lateness * min(driftCorrectionGain, 1))
+        }
+        return (position: framePosition, hostTime: hostTime)
+    }
+
+    private static func halfInterval(_ vsyncInterval: TimeInterval) -> TimeInterval {
+        guard vsyncInterval.isFinite, vsyncInterval > 0 else { return 0 }
+        return vsyncInterval / 2
+    }
+}
+
+/// Bounded ring of decoded frames waiting for their vsync.
+///
+/// Frames are enqueued in presentation order by the display thread and consumed once
+/// per vsync by `frame(forVsyncAt:interval:)`, which counts frames dropped for being
+/// late and vsyncs that had to repeat the previous frame. While suspended nothing is
+/// consumed or counted, and `resume(at:)` shifts the queued targets by the time spent
+/// suspended so a pause does not turn every queued frame into a late one. The display
+/// link may pause while `needsVsync` is false; vsyncs it skipped past the end of the
+/// frame on screen still count as repeats.
+struct IRFFPresentationRing<Frame> {
+    private struct Entry {
+        let frame: Frame
+        var targetHostTime: TimeInterval
+        let duration: TimeInterval
+    }
+
+    let capacity: Int
+    private var entries: [Entry] = []
+    private var presentedTargetHostTime: TimeInterval?
+    private var presentedDuration: TimeInterval = 0
+    private var suspendedHostTime: TimeInterval?
+    private var previousVsyncHostTime: TimeInterval?
+    private(set) var presentedCount = 0
+    private(set) var droppedCount = 0
+    private(set) var repeatedCount = 0
+
+    init(capacity: Int = IRFFPresentationSchedulerPolicy.defaultCapacity) {
+        self.capacity = max(1, capacity)
+        entries.reserveCapacity(self.capacity)
+    }
+
+    var count: Int {
+        return entries.count
+    }
+
+    var isFull: Bool {
+        return entries.count >= capacity
+    }
+
+    var isSuspended: Bool {
+        return suspendedHostTime != nil
+    }
+
+    /// False while nothing is queued or presentation is suspended.
+    var needsVsync: Bool {
+        return suspendedHostTime == nil && !entries.isEmpty
+    }
+
+    /// Returns false when the ring is full. A target earlier than the last queued one
+    /// is raised to it so the ring stays sorted.
+    @discardableResult
+    mutating func enqueue(_ frame: Frame, targetHostTime: TimeInterval, duration: TimeInterval) -> Bool {
+        guard !isFull, targetHostTime.isFinite else { return false }
+        let target = max(targetHostTime, entries.last?.targetHostTime ?? -.infinity)
+        entries.append(Entry(frame: frame, targetHostTime: target, duration: duration))
+        return true
+    }
+
+    mutating func frame(forVsyncAt vsyncHostTime: TimeInterval, interval vsyncInterval: TimeInterval) -> Frame? {
+        guard suspendedHostTime == nil else { return nil }
+        repeatedCount += IRFFPresentationSchedulerPolicy.skippedRepeatCount(presentedTargetHostTime: presentedTargetHostTime,
+                                                                           presentedDuration: presentedDuration,
+                                                                           previousVsyncHostTime: previousVsyncHostTime,
+                                                                           vsyncHostTime: vsyncHostTime,
+                                                                           vsyncInterval: vsyncInterval)
+        previousVsyncHostTime = vsyncHostTime
+        let selection = IRFFPresentationSchedulerPolicy.selection(targetHostTimes: entries.map(\.targetHostTime),
+                                                                 vsyncHostTime: vsyncHostTime,
+                                                                 vsyncInterval: vsyncInterval)
+        guard let index = selection.index else {
+            if IRFFPresentationSchedulerPolicy.isRepeat(presentedTargetHostTime: presentedTargetHostTime,
+                                                        presentedDuration: presentedDuration,
+                                                        vsyncHostTime: vsyncHostTime,
+                                                        vsyncInterval: vsyncInterval) {
+                repeatedCount += 1
+            }
+            return nil
+        }
+        let entry = entries[index]
+        entries.removeFirst(index + 1)
+        droppedCount += selection.droppedCount
+        presentedCount += 1
+        presentedTargetHostTime = entry.targetHostTime
+        presentedDuration = entry.duration
+        return entry.frame
+    }
+
+    mutating func suspend(at hostTime: TimeInterval) {
+        guard suspendedHostTime == nil else { return }
+        suspendedHostTime = hostTime
+    }
+
+    mutating func resume(at hostTime: TimeInterval) {
+        guard let suspendedHostTime else { return }
+        self.suspendedHostTime = nil
+        let shift = max(0, hostTime - suspendedHostTime)
+        for index in entries.indices {
+            entries[index].targetHostTime += shift
+        }
+        presentedTargetHostTime = presentedTargetHostTime.map { $0 + shift }
+        previousVsyncHostTime = previousVsyncHostTime.map { $0 + shift }
+    }
+
+    mutating func resetCounters() {
+        presentedCount = 0
+        droppedCount = 0
+        repeatedCount = 0
+    }
+
+    /// Drops queued frames, e.g. after a seek. Counters are kept.
+    mutating func removeAll() {
+        entries.removeAll(keepingCapacity: true)
+        presentedTargetHostTime = nil
+        presentedDuration = 0
+        previousVsyncHostTime = nil
+    }
+}
@@ -0,0 +1,72 @@
+//
+//  IRFFSeekRequestCoalescer.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Holds the one seek the read thread has yet to honour. A newer request replaces a
+/// pending one, whose handler is told it did not complete, so scrubbing only ever
+/// costs the read thread the latest position.
+final class IRFFSeekRequestCoalescer {
+    struct Request: Equatable {
+        let time: TimeInterval
+        let generation: Int
+    }
+
+    private let lock = NSLock()
+    private var pending: Request?
+    private var pendingHandler: ((Bool) -> Void)?
+    private var generation = 0
+
+    var isPending: Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return pending != nil
+    }
+
+    /// Handlers run on the calling thread, outside the lock.
+    func submit(time: TimeInterval, completeHandler: ((Bool) -> Void)?) {
+        lock.lock()
+        let superseded = pendingHandler
+        generation += 1
+        pending = Request(time: time, generation: generation)
+        pendingHandler = completeHandler
+        lock.unlock()
+        superseded?(false)
+    }
+
+    func pendingRequest() -> Request? {
+        lock.lock()
+        defer { lock.unlock() }
+        return pending
+    }
+
+    /// Finishes `request` unless a newer one arrived while it was being applied; that
+    /// one stays pending and false is returned.
+    @discardableResult
+    func complete(_ request: Request) -> Bool {
+        lock.lock()
+        guard pending == request else {
+            lock.unlock()
+            return false
+        }
+        let handler = pendingHandler
+        pending = nil
+        pendingHandler = nil
+        lock.unlock()
+        handler?(true)
+        return true
+    }
+
+    func cancel() {
+        lock.lock()
+        let handler = pendingHandler
+        pending = nil
+        pendingHandler = nil
+        lock.unlock()
+        handler?(false)
+    }
+}
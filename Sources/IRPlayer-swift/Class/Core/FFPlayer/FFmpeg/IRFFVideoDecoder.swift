@@ -34,7 +34,6 @@ class IRFFVideoDecoder {
     private var tempFrame: UnsafeMutablePointer<AVFrame>?
     private var packetQueue: IRFFPacketQueue
     private var frameQueue: IRFFFrameQueue
-    private var framePool: IRFFFramePool?
     private lazy var videoToolBox: IRFFVideoToolBox = {
         return IRFFVideoToolBox(codecContext: codecContext)
     }()
@@ -45,11 +44,33 @@ class IRFFVideoDecoder {
     weak var delegate: IRFFVideoDecoderDelegate?
     weak var source: IRFFVideoDecoderDataSource?
     var videoToolBoxEnable = true
+    /// Keeps several VideoToolbox frames in flight and reorders their output by pts.
+    var videoToolBoxAsynchronous = true
     var maxDecodeDuration: TimeInterval = 2.0
     var timebase: TimeInterval
     var fps: TimeInterval
     var paused = false
     var endOfFile = false
+    /// Set by the display thread while video lags the audio clock; applied to the
+    /// codec's `skip_frame` before the next software decode on the decode thread.
+    var skipsNonReferenceFrames: Bool {
+        get { IRAtomicLoad(sharedWords[.skipsNonReferenceFrames]) != 0 }
+        set { IRAtomicStore(sharedWords[.skipsNonReferenceFrames], newValue ? 1 : 0) }
+    }
+    private enum SharedWord: Int, CaseIterable {
+        case skipsNonReferenceFrames
+    }
+    private let sharedWords = IRFFPaddedAtomicWords<SharedWord>()
+    /// Set by the decoder from the playback rate. Non-key packets are dropped while it
+    /// is `.keyFramesOnly`, and decoding resumes at a key frame after it is lifted.
+    var decimation: IRFFVideoDecimation = .none
+    private var awaitingKeyFrame = false
+    /// Read by the decode thread when it reaches the flush packet.
+    private var resumesAtKeyFrame = false
+    private var pendingSeekTarget: TimeInterval?
+    /// Frames ending before this are decoded but never queued; cleared by the first
+    /// frame that is.
+    private var seekTarget: TimeInterval?
 
     static var flushPacket: AVPacket = makeFlushPacket()
 
@@ -119,6 +140,20 @@ class IRFFVideoDecoder {
         )
     }
 
+    static func skipFrameDiscard(skippingNonReferenceFrames: Bool) -> AVDiscard {
+        return IRFFVideoDecoderPolicy.skipFrameDiscard(skippingNonReferenceFrames: skippingNonReferenceFrames)
+    }
+
+    static func packetDecision(isKeyFrame: Bool,
+                               decimation: IRFFVideoDecimation,
+                               awaitingKeyFrame: Bool) -> (decodes: Bool, awaitingKeyFrame: Bool) {
+        return IRFFPlaybackRatePolicy.packetDecision(
+            isKeyFrame: isKeyFrame,
+            decimation: decimation,
+            awaitingKeyFrame: awaitingKeyFrame
+        )
+    }
+
     static func packetDecodeResultIsFailure(_ result: Int32) -> Bool {
         return IRFFVideoDecoderPolicy.packetDecodeResultIsFailure(result)
     }
@@ -147,6 +182,10 @@ class IRFFVideoDecoder {
         return frameQueue.getFrameSync() as? IRFFVideoFrame
     }
 
+    func getFrame(until deadline: DispatchTime) -> IRFFVideoFrame? {
+        return frameQueue.getFrame(until: deadline) as? IRFFVideoFrame
+    }
+
     func getFrameAsync() -> IRFFVideoFrame? {
         return frameQueue.getFrameAsync() as? IRFFVideoFrame
     }
@@ -159,10 +198,15 @@ class IRFFVideoDecoder {
         packetQueue.putPacket(packet, duration: duration)
     }
 
-    func flush() {
+    /// Drops every queued packet and frame. With `resumingAtKeyFrame` packets are
+    /// also dropped after the flush until the next key frame, for when the stream is
+    /// cut mid-GOP rather than at a seek point. With `seekTarget` the frames decoded
+    /// on the way from the key frame to the target are not shown.
+    func flush(resumingAtKeyFrame: Bool = false, seekTarget: TimeInterval? = nil) {
         packetQueue.flush()
         frameQueue.flush()
-        framePool?.flush()
+        resumesAtKeyFrame = resumingAtKeyFrame
+        pendingSeekTarget = seekTarget
         putPacket(IRFFVideoDecoder.flushPacket)
     }
 
@@ -170,7 +214,6 @@ class IRFFVideoDecoder {
         canceled = true
         frameQueue.destroy()
         packetQueue.destroy()
-        framePool?.flush()
     }
 
     func decodeFrameThread() {
@@ -186,6 +229,8 @@ class IRFFVideoDecoder {
             }
             if Self.shouldFinishDecode(endOfFile: endOfFile, packetEmpty: packetEmpty()) {
                 IRFFRuntimeDebugOutput.write("decode video finished")
+                enqueueVideoToolBoxFrames(draining: true)
+                drainFFmpegFrames()
                 break
             }
             if let interval = Self.decodeBackpressureSleepInterval(frameDuration: frameDuration(),
@@ -204,12 +249,23 @@ class IRFFVideoDecoder {
                 IRFFRuntimeDebugOutput.write("video codec flush")
                 avcodec_flush_buffers(codecContext)
                 videoToolBox.flush()
+                awaitingKeyFrame = resumesAtKeyFrame
+                seekTarget = pendingSeekTarget
                 continue
             }
             if packet.stream_index < 0 || packet.data == nil { continue }
 
-            if let videoFrame = decodeFrame(packet: packet) {
-                frameQueue.putSortFrame(videoFrame)
+            let decision = Self.packetDecision(isKeyFrame: packet.flags & AV_PKT_FLAG_KEY != 0,
+                                               decimation: decimation,
+                                               awaitingKeyFrame: awaitingKeyFrame)
+            awaitingKeyFrame = decision.awaitingKeyFrame
+            guard decision.decodes else {
+                av_packet_unref(&packet)
+                continue
+            }
+
+            for videoFrame in decodeFrames(packet: packet) {
+                enqueue(videoFrame)
             }
             av_packet_unref(&packet)
         }
@@ -217,46 +273,95 @@ class IRFFVideoDecoder {
         delegate?.videoDecoderNeedCheckBufferingStatus(self)
     }
 
-    private func decodeFrame(packet: AVPacket) -> IRFFVideoFrame? {
+    private func enqueue(_ videoFrame: IRFFVideoFrame) {
+        if seekTarget != nil {
+            guard IRFFDecoder.presentsFrame(position: videoFrame.position,
+                                            duration: videoFrame.duration,
+                                            seekTarget: seekTarget) else {
+                videoFrame.cancel()
+                return
+            }
+            seekTarget = nil
+        }
+        frameQueue.putSortFrame(videoFrame)
+    }
+
+    private func decodeFrames(packet: AVPacket) -> [IRFFVideoFrame] {
         let info = IRFFVideoDecoderInfo(codecContext: codecContext, videoToolBoxEnable: videoToolBoxEnable, maxDecodeDuration: maxDecodeDuration, timebase: timebase, fps: fps)
         if self.source?.shouldHandle(info, decodeFrame: packet) == true {
             if let videoFrame = self.source?.videoDecoder(info, decodeFrame: packet) {
-                return videoFrame
+                return [videoFrame]
             }
-            return nil
+            return []
         }
 
-        if videoToolBoxEnable && codecContext.pointee.codec_id == AV_CODEC_ID_H264 {
+        if videoToolBoxEnable && IRFFVideoToolBox.supportsCodec(codecContext.pointee.codec_id) {
             if videoToolBox.trySetupVTSession() {
-                if videoToolBox.sendPacket(packet) {
-                     return videoFrameFromVideoToolBox(packet: packet)
+                if videoToolBoxAsynchronous {
+                    let position = IRFFFrameTime.packetPosition(pts: packet.pts, dts: packet.dts, timebase: timebase)
+                    let duration = Self.frameDuration(ticks: packet.duration, repeatPicture: 0, timebase: timebase, fps: fps)
+                    if videoToolBox.sendPacketAsynchronously(packet, position: position, duration: duration) {
+                        enqueueVideoToolBoxFrames(draining: false)
+                        return []
+                    }
+                } else if videoToolBox.sendPacket(packet) {
+                    return videoFrameFromVideoToolBox(packet: packet).map { [$0] } ?? []
                 }
             }
         }
 
-        return decodeFrameWithFFmpeg(packet: packet)
+        return decodeFramesWithFFmpeg(packet: packet)
     }
 
-    private func decodeFrameWithFFmpeg(packet: AVPacket) -> IRFFVideoFrame? {
+    private func decodeFramesWithFFmpeg(packet: AVPacket) -> [IRFFVideoFrame] {
         var packet = packet
-        var result = avcodec_send_packet(codecContext, &packet)
+        // Nothing refers to a non-reference frame, so one that ends before the seek
+        // target need not be decoded at all.
+        let beforeSeekTarget = seekTarget != nil && !IRFFDecoder.presentsFrame(
+            position: IRFFFrameTime.packetPosition(pts: packet.pts, dts: packet.dts, timebase: timebase),
+            duration: Self.frameDuration(ticks: packet.duration, repeatPicture: 0, timebase: timebase, fps: fps),
+            seekTarget: seekTarget
+        )
+        let discard = Self.skipFrameDiscard(skippingNonReferenceFrames: skipsNonReferenceFrames || decimation != .none || beforeSeekTarget)
+        if codecContext.pointee.skip_frame != discard {
+            codecContext.pointee.skip_frame = discard
+        }
+        let result = avcodec_send_packet(codecContext, &packet)
         if Self.packetDecodeResultIsFailure(result) {
             handleDecodingError(IRFFCheckError(result))
             delegateErrorCallback()
-            return nil
+            return []
         }
-        while result >= 0 {
-            result = avcodec_receive_frame(codecContext, tempFrame)
+        return receiveFFmpegFrames()
+    }
+
+    /// Takes every frame the codec has ready. A frame-threaded codec can release
+    /// several after one packet, or none until it has a frame per thread in flight.
+    private func receiveFFmpegFrames() -> [IRFFVideoFrame] {
+        var videoFrames: [IRFFVideoFrame] = []
+        while true {
+            let result = avcodec_receive_frame(codecContext, tempFrame)
             if result < 0 {
                 if Self.packetDecodeResultIsFailure(result) {
                     handleDecodingError(IRFFCheckError(result))
-                    return nil
                 }
                 break
             }
-            return videoFrameFromTempFrame()
+            if let videoFrame = videoFrameFromTempFrame() {
+                videoFrames.append(videoFrame)
+            }
+        }
+        return videoFrames
+    }
+
+    /// Sends the end-of-stream packet and queues the pictures the codec still holds,
+    /// up to one per frame thread.
+    private func drainFFmpegFrames() {
+        let result = avcodec_send_packet(codecContext, nil)
+        guard result >= 0 else { return }
+        for videoFrame in receiveFFmpegFrames() {
+            enqueue(videoFrame)
         }
-        return nil
     }
 
     private func videoFrameFromTempFrame() -> IRFFAVYUVVideoFrame? {
@@ -269,7 +374,10 @@ class IRFFVideoDecoder {
             return nil
         }
 
-        let videoFrame = framePool?.getUnuseFrame() as? IRFFAVYUVVideoFrame ?? IRFFAVYUVVideoFrame()
+        // Not pooled: video frames never report when the output is done drawing them,
+        // so a pool would keep every decoded picture referenced. The last release
+        // drops the AVFrame reference in deinit.
+        let videoFrame = IRFFAVYUVVideoFrame()
         videoFrame.setFrameData(frame, width: Int(codecContext.pointee.width), height: Int(codecContext.pointee.height))
         videoFrame.position = IRFFFrameTime.position(timestamp: frame.pointee.best_effort_timestamp, timebase: timebase)
 
@@ -280,6 +388,17 @@ class IRFFVideoDecoder {
         return videoFrame
     }
 
+    /// Moves pictures the asynchronous session has released into the frame queue.
+    private func enqueueVideoToolBoxFrames(draining: Bool) {
+        guard videoToolBoxEnable, videoToolBoxAsynchronous, videoToolBox.vtSessionToken else { return }
+        for image in videoToolBox.dequeueDecodedImages(draining: draining) {
+            let videoFrame = IRFFCVYUVVideoFrame(pixelBuffer: image.imageBuffer)
+            videoFrame.position = image.position
+            videoFrame.duration = image.duration > 0 ? image.duration : Self.frameDuration(ticks: 0, repeatPicture: 0, timebase: timebase, fps: fps)
+            enqueue(videoFrame)
+        }
+    }
+
     private func videoFrameFromVideoToolBox(packet: AVPacket) -> IRFFVideoFrame? {
         guard let imageBuffer = videoToolBox.imageBuffer() else {
             return nil
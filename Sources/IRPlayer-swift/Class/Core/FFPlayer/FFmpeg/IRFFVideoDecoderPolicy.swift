@@ -36,6 +36,12 @@ enum IRFFVideoDecoderPolicy {
         return paused ? maxVideoFrameSleepFullAndPauseTimeInterval : maxVideoFrameSleepFullTimeInterval
     }
 
+    /// `skip_frame` setting for the software decoder: non-reference frames are dropped
+    /// inside the codec while the display thread reports that video is lagging.
+    static func skipFrameDiscard(skippingNonReferenceFrames: Bool) -> AVDiscard {
+        return skippingNonReferenceFrames ? AVDISCARD_NONREF : AVDISCARD_DEFAULT
+    }
+
     static func packetDecodeResultIsFailure(_ result: Int32) -> Bool {
         guard result < 0 else { return false }
         return result != AVERROR(EAGAIN) && result != IR_AVERROR_EOF
@@ -44,6 +44,21 @@ class IRFFVideoToolBox {
         let shouldConvertThreeByteNALUnits: Bool
     }
 
+    struct DecodedImage {
+        let imageBuffer: CVImageBuffer
+        let position: TimeInterval
+        let duration: TimeInterval
+    }
+
+    /// Timing of a submitted packet, kept under its frame token for pictures that come
+    /// back without a usable presentation time.
+    private struct SubmittedFrame {
+        let position: TimeInterval
+        let duration: TimeInterval
+    }
+
+    private static let inFlightWaitTimeout: TimeInterval = 0.1
+
     private var codecContext: UnsafeMutablePointer<AVCodecContext>
     private var vtSession: VTDecompressionSession?
     private var formatDescription: CMFormatDescription?
@@ -52,6 +67,15 @@ class IRFFVideoToolBox {
 
     var vtSessionToken: Bool = false
     var needConvertNALSize3To4: Bool = false
+    /// Set once session creation fails; the stream then stays on the software decoder.
+    private(set) var sessionUnavailable = false
+    /// Upper bound on frames submitted with `sendPacketAsynchronously` but not yet output.
+    var maxFramesInFlight = 4
+
+    private let outputCondition = NSCondition()
+    private var framesInFlight: [Int: SubmittedFrame] = [:]
+    private var nextFrameToken = 1
+    private var reorderBuffer = IRFFVideoToolBoxReorderBuffer<DecodedImage>(depth: 0)
 
     init(codecContext: UnsafeMutablePointer<AVCodecContext>) {
         self.codecContext = codecContext
@@ -73,12 +97,19 @@ class IRFFVideoToolBox {
         )
     }
 
+    static func supportsCodec(_ codecID: AVCodecID) -> Bool {
+        return IRFFVideoToolBoxPolicy.codec(for: codecID) != nil
+    }
+
     func trySetupVTSession() -> Bool {
         if !self.vtSessionToken {
+            guard !self.sessionUnavailable else { return false }
             do {
                 try self.setupVTSession()
                 self.vtSessionToken = true
             } catch {
+                self.sessionUnavailable = true
+                self.cleanVTSession()
                 return false
             }
         }
@@ -99,14 +130,24 @@ class IRFFVideoToolBox {
             throw validationError
         }
 
-        guard let extradata else {
+        guard let extradata, let codec = IRFFVideoToolBoxPolicy.codec(for: codecID) else {
             throw IRFFVideoToolBoxErrorCode.extradataSize
         }
+        let codecType = IRFFVideoToolBoxPolicy.codecType(for: codec)
+        if codec == .hevc && !VTIsHardwareDecodeSupported(codecType) {
+            throw IRFFVideoToolBoxErrorCode.createSession
+        }
 
-        let nalPolicy = Self.nalLengthSizePolicy(for: extradata[4])
-        extradata[4] = nalPolicy.normalizedMarker
-        self.needConvertNALSize3To4 = nalPolicy.shouldConvertThreeByteNALUnits
-        self.formatDescription = createFormatDescription(codecType: kCMVideoCodecType_H264, width: codecContext.pointee.width, height: codecContext.pointee.height, extradata: extradata, extradataSize: extradataSize)
+        // Work on a copy: the software decoder keeps reading the codec context's extradata.
+        let extradataBytes = [UInt8](UnsafeBufferPointer(start: extradata, count: Int(extradataSize)))
+        guard let record = IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: codec, extradata: extradataBytes) else {
+            throw IRFFVideoToolBoxErrorCode.extradataData
+        }
+        self.needConvertNALSize3To4 = record.needsNALLengthConversion
+        self.formatDescription = record.bytes.withUnsafeBufferPointer { buffer -> CMFormatDescription? in
+            guard let baseAddress = buffer.baseAddress else { return nil }
+            return createFormatDescription(codec: codec, codecType: codecType, width: codecContext.pointee.width, height: codecContext.pointee.height, extradata: baseAddress, extradataSize: Int32(buffer.count))
+        }
         if self.formatDescription == nil {
             throw IRFFVideoToolBoxErrorCode.createFormatDescription
         }
@@ -138,6 +179,10 @@ class IRFFVideoToolBox {
         if status != noErr {
             throw IRFFVideoToolBoxErrorCode.createSession
         }
+
+        outputCondition.lock()
+        reorderBuffer = IRFFVideoToolBoxReorderBuffer(depth: IRFFVideoToolBoxPolicy.reorderDepth(hasBFrames: codecContext.pointee.has_b_frames))
+        outputCondition.unlock()
     }
 
     func cleanVTSession() {
@@ -158,46 +203,123 @@ class IRFFVideoToolBox {
 
     func sendPacket(_ packet: AVPacket) -> Bool {
         guard self.trySetupVTSession() else { return false }
-        guard let packetPayload = Self.packetPayload(for: packet) else { return false }
         self.cleanDecodeInfo()
+        guard let sampleBuffer = makeSampleBuffer(for: packet, timing: nil, copiesData: false),
+              let decodePayload = Self.decodeFramePayload(session: self.vtSession, sampleBuffer: sampleBuffer) else {
+            return false
+        }
+        let status = VTDecompressionSessionDecodeFrame(
+            decodePayload.session,
+            sampleBuffer: decodePayload.sampleBuffer,
+            flags: [],
+            frameRefcon: nil,
+            infoFlagsOut: nil
+        )
+        return Self.decodeFrameSucceeded(status: status, callbackStatus: self.decodeStatus, hasOutput: self.decodeOutput != nil)
+    }
+
+    /// Submits `packet` without waiting for its picture. Pictures come back through
+    /// `dequeueDecodedImages(draining:)` in presentation order, stamped with the
+    /// presentation time VideoToolbox reports for them, or with `position` and
+    /// `duration` when it reports none.
+    func sendPacketAsynchronously(_ packet: AVPacket, position: TimeInterval, duration: TimeInterval) -> Bool {
+        guard self.trySetupVTSession() else { return false }
+        // The packet is released as soon as this returns, so the sample owns a copy.
+        guard let sampleBuffer = makeSampleBuffer(for: packet,
+                                                  timing: IRFFVideoToolBoxPolicy.sampleTiming(position: position, duration: duration),
+                                                  copiesData: true),
+              let decodePayload = Self.decodeFramePayload(session: self.vtSession, sampleBuffer: sampleBuffer) else {
+            return false
+        }
+
+        outputCondition.lock()
+        let deadline = Date(timeIntervalSinceNow: Self.inFlightWaitTimeout)
+        while framesInFlight.count >= maxFramesInFlight {
+            if !outputCondition.wait(until: deadline) {
+                break
+            }
+        }
+        let token = nextFrameToken
+        nextFrameToken += 1
+        framesInFlight[token] = SubmittedFrame(position: position, duration: duration)
+        outputCondition.unlock()
+
+        let status = VTDecompressionSessionDecodeFrame(
+            decodePayload.session,
+            sampleBuffer: decodePayload.sampleBuffer,
+            flags: [._EnableAsynchronousDecompression],
+            frameRefcon: UnsafeMutableRawPointer(bitPattern: token),
+            infoFlagsOut: nil
+        )
+        if status != noErr {
+            outputCondition.lock()
+            framesInFlight[token] = nil
+            outputCondition.broadcast()
+            outputCondition.unlock()
+            return false
+        }
+        return true
+    }
+
+    /// Pictures that can no longer be overtaken by a later one. With `draining`, waits
+    /// for every submitted frame and returns all of them, e.g. at end of stream.
+    func dequeueDecodedImages(draining: Bool = false) -> [DecodedImage] {
+        if draining, let vtSession = self.vtSession {
+            VTDecompressionSessionFinishDelayedFrames(vtSession)
+            VTDecompressionSessionWaitForAsynchronousFrames(vtSession)
+        }
+        outputCondition.lock()
+        defer { outputCondition.unlock() }
+        if draining {
+            return reorderBuffer.drain()
+        }
+        var images: [DecodedImage] = []
+        while let image = reorderBuffer.popReady() {
+            images.append(image)
+        }
+        return images
+    }
+
+    private func makeSampleBuffer(for packet: AVPacket, timing: CMSampleTimingInfo?, copiesData: Bool) -> CMSampleBuffer? {
+        guard let packetPayload = Self.packetPayload(for: packet) else { return nil }
 
-        var result = false
         var blockBuffer: CMBlockBuffer?
         var status: OSStatus = noErr
 
-        if self.needConvertNALSize3To4 {
-            guard Self.threeByteNALUnitsAreBounded(in: packetPayload) else { return false }
-
-            var ioContext: UnsafeMutablePointer<AVIOContext>?
-            if avio_open_dyn_buf(&ioContext) < 0 {
-                status = -1900
-            } else {
-                var nalSize: UInt32 = 0
-                let end = packetPayload.end
-                var nalStart = packetPayload.data
-                while nalStart < end {
-                    nalSize = (UInt32(nalStart[0]) << 16) | (UInt32(nalStart[1]) << 8) | UInt32(nalStart[2])
-                    avio_wb32(ioContext, nalSize)
-                    nalStart += 3
-                    avio_write(ioContext, nalStart, Int32(nalSize))
-                    nalStart += UnsafeMutablePointer<UInt8>.Stride(nalSize)
+        if self.needConvertNALSize3To4 || copiesData {
+            let source = UnsafeRawBufferPointer(start: packetPayload.data, count: Int(packetPayload.size))
+            let sourceNALLengthSize = self.needConvertNALSize3To4 ? 3 : IRFFVideoToolBoxBitstreamPolicy.outputNALLengthSize
+            let convertedSize = self.needConvertNALSize3To4
+                ? IRFFVideoToolBoxBitstreamPolicy.convertedPacketSize(source, sourceNALLengthSize: sourceNALLengthSize)
+                : source.count
+            guard let convertedSize, convertedSize <= Int(Int32.max) else { return nil }
+
+            guard let demuxBuffer = av_malloc(convertedSize)?.assumingMemoryBound(to: UInt8.self) else { return nil }
+            let destination = UnsafeMutableRawBufferPointer(start: demuxBuffer, count: convertedSize)
+            if self.needConvertNALSize3To4 {
+                guard IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes(source, sourceNALLengthSize: sourceNALLengthSize, into: destination) == convertedSize else {
+                    av_free(demuxBuffer)
+                    return nil
                 }
-                var demuxBuffer: UnsafeMutablePointer<UInt8>?
-                let demuxSize = avio_close_dyn_buf(ioContext, &demuxBuffer)
-                guard let convertedPayload = Self.convertedNALBlockPayload(memoryBlock: demuxBuffer, demuxSize: demuxSize, packetSize: packetPayload.size) else { return false }
-                var customBlockSource = convertedPayload.customBlockSource
-                status = CMBlockBufferCreateWithMemoryBlock(
-                    allocator: nil,
-                    memoryBlock: convertedPayload.memoryBlock,
-                    blockLength: convertedPayload.blockLength,
-                    blockAllocator: kCFAllocatorNull,
-                    customBlockSource: &customBlockSource,
-                    offsetToData: 0,
-                    dataLength: convertedPayload.dataLength,
-                    flags: 0,
-                    blockBufferOut: &blockBuffer
-                )
+            } else {
+                destination.copyMemory(from: source)
             }
+            guard let convertedPayload = Self.convertedNALBlockPayload(memoryBlock: demuxBuffer, demuxSize: Int32(convertedSize), packetSize: packetPayload.size) else {
+                av_free(demuxBuffer)
+                return nil
+            }
+            var customBlockSource = convertedPayload.customBlockSource
+            status = CMBlockBufferCreateWithMemoryBlock(
+                allocator: nil,
+                memoryBlock: convertedPayload.memoryBlock,
+                blockLength: convertedPayload.blockLength,
+                blockAllocator: kCFAllocatorNull,
+                customBlockSource: &customBlockSource,
+                offsetToData: 0,
+                dataLength: convertedPayload.dataLength,
+                flags: 0,
+                blockBufferOut: &blockBuffer
+            )
         } else {
             status = CMBlockBufferCreateWithMemoryBlock(
                 allocator: nil,
@@ -211,10 +333,26 @@ class IRFFVideoToolBox {
                 blockBufferOut: &blockBuffer
             )
         }
+        guard status == noErr,
+              let formatDescription = Self.requiredFormatDescription(self.formatDescription) else { return nil }
 
-        if status == noErr {
-            guard let formatDescription = Self.requiredFormatDescription(self.formatDescription) else { return false }
-            var sampleBuffer: CMSampleBuffer?
+        var sampleBuffer: CMSampleBuffer?
+        if var timing {
+            status = CMSampleBufferCreate(
+                allocator: nil,
+                dataBuffer: blockBuffer,
+                dataReady: true,
+                makeDataReadyCallback: nil,
+                refcon: nil,
+                formatDescription: formatDescription,
+                sampleCount: 1,
+                sampleTimingEntryCount: 1,
+                sampleTimingArray: &timing,
+                sampleSizeEntryCount: 0,
+                sampleSizeArray: nil,
+                sampleBufferOut: &sampleBuffer
+            )
+        } else {
             status = CMSampleBufferCreate(
                 allocator: nil,
                 dataBuffer: blockBuffer,
@@ -229,23 +367,8 @@ class IRFFVideoToolBox {
                 sampleSizeArray: nil,
                 sampleBufferOut: &sampleBuffer
             )
-
-            if status == noErr {
-                guard let decodePayload = Self.decodeFramePayload(session: self.vtSession, sampleBuffer: sampleBuffer) else { return false }
-                status = VTDecompressionSessionDecodeFrame(
-                    decodePayload.session,
-                    sampleBuffer: decodePayload.sampleBuffer,
-                    flags: [],
-                    frameRefcon: nil,
-                    infoFlagsOut: nil
-                )
-
-                if Self.decodeFrameSucceeded(status: status, callbackStatus: self.decodeStatus, hasOutput: self.decodeOutput != nil) {
-                    result = true
-                }
-            }
         }
-        return result
+        return status == noErr ? sampleBuffer : nil
     }
 
     static func packetPayload(for packet: AVPacket) -> PacketPayload? {
@@ -301,23 +424,55 @@ class IRFFVideoToolBox {
     func flush() {
         self.cleanVTSession()
         self.cleanDecodeInfo()
+        outputCondition.lock()
+        reorderBuffer.removeAll()
+        framesInFlight.removeAll()
+        outputCondition.broadcast()
+        outputCondition.unlock()
     }
 
     deinit {
         self.flush()
     }
 
-    static func handleOutputCallback(refCon: UnsafeMutableRawPointer?, status: OSStatus, imageBuffer: CVImageBuffer?) {
+    static func handleOutputCallback(refCon: UnsafeMutableRawPointer?,
+                                     status: OSStatus,
+                                     imageBuffer: CVImageBuffer?,
+                                     frameRefCon: UnsafeMutableRawPointer? = nil,
+                                     presentationTimeStamp: CMTime = .invalid,
+                                     presentationDuration: CMTime = .invalid) {
         guard let refCon else { return }
         let videoToolBox = Unmanaged<IRFFVideoToolBox>.fromOpaque(refCon).takeUnretainedValue()
-        videoToolBox.decodeStatus = status
-        videoToolBox.decodeOutput = imageBuffer
+        guard let frameRefCon else {
+            videoToolBox.decodeStatus = status
+            videoToolBox.decodeOutput = imageBuffer
+            return
+        }
+        videoToolBox.outputCondition.lock()
+        // A token missing here was flushed; its picture belongs to the previous position.
+        if let submitted = videoToolBox.framesInFlight.removeValue(forKey: Int(bitPattern: frameRefCon)),
+           status == noErr,
+           let imageBuffer {
+            let timing = IRFFVideoToolBoxPolicy.outputTiming(presentationTimeStamp: presentationTimeStamp,
+                                                             presentationDuration: presentationDuration,
+                                                             submittedPosition: submitted.position,
+                                                             submittedDuration: submitted.duration)
+            let image = DecodedImage(imageBuffer: imageBuffer,
+                                     position: timing.position,
+                                     duration: timing.duration)
+            videoToolBox.reorderBuffer.insert(image, pts: image.position)
+        }
+        videoToolBox.outputCondition.broadcast()
+        videoToolBox.outputCondition.unlock()
     }
 
-    static func makeFormatDescriptionExtensions(extradata: UnsafePointer<UInt8>, extradataSize: Int32) -> CFDictionary {
+    static func makeFormatDescriptionExtensions(extradata: UnsafePointer<UInt8>,
+                                                extradataSize: Int32,
+                                                codec: IRFFVideoToolBoxCodec = .h264) -> CFDictionary {
         return IRFFVideoToolBoxPolicy.makeFormatDescriptionExtensions(
             extradata: extradata,
-            extradataSize: extradataSize
+            extradataSize: extradataSize,
+            codec: codec
         )
     }
 
@@ -330,14 +485,19 @@ class IRFFVideoToolBox {
         presentationTimeStamp: CMTime,
         presentationDuration: CMTime
     ) in
-            IRFFVideoToolBox.handleOutputCallback(refCon: decompressionOutputRefCon, status: status, imageBuffer: imageBuffer)
+            IRFFVideoToolBox.handleOutputCallback(refCon: decompressionOutputRefCon,
+                                                  status: status,
+                                                  imageBuffer: imageBuffer,
+                                                  frameRefCon: sourceFrameRefCon,
+                                                  presentationTimeStamp: presentationTimeStamp,
+                                                  presentationDuration: presentationDuration)
     }
 
-    private func createFormatDescription(codecType: CMVideoCodecType, width: Int32, height: Int32, extradata: UnsafePointer<UInt8>, extradataSize: Int32) -> CMFormatDescription? {
+    private func createFormatDescription(codec: IRFFVideoToolBoxCodec, codecType: CMVideoCodecType, width: Int32, height: Int32, extradata: UnsafePointer<UInt8>, extradataSize: Int32) -> CMFormatDescription? {
         var formatDescription: CMFormatDescription?
         var status: OSStatus
 
-        let extensions = Self.makeFormatDescriptionExtensions(extradata: extradata, extradataSize: extradataSize)
+        let extensions = Self.makeFormatDescriptionExtensions(extradata: extradata, extradataSize: extradataSize, codec: codec)
 
         status = CMVideoFormatDescriptionCreate(
             allocator: nil,
@@ -0,0 +1,147 @@
+//
+//  IRFFVideoToolBoxBitstreamPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Codecs IRFFVideoToolBox can hand to a VTDecompressionSession.
+enum IRFFVideoToolBoxCodec: Equatable {
+    case h264
+    case hevc
+
+    /// Sample description atom VideoToolbox reads the decoder configuration from.
+    var configurationAtomKey: String {
+        switch self {
+        case .h264: return "avcC"
+        case .hevc: return "hvcC"
+        }
+    }
+
+    /// Smallest record that still contains the NAL length field.
+    var minimumConfigurationRecordSize: Int {
+        switch self {
+        case .h264: return 7
+        case .hevc: return 23
+        }
+    }
+
+    /// Byte holding `lengthSizeMinusOne` in its two low bits.
+    var nalLengthSizeByteOffset: Int {
+        switch self {
+        case .h264: return 4
+        case .hevc: return 21
+        }
+    }
+}
+
+/// An avcC/hvcC record rewritten for VideoToolbox, plus the NAL length prefix size
+/// the demuxed packets still carry.
+struct IRFFVideoToolBoxConfigurationRecord: Equatable {
+    let codec: IRFFVideoToolBoxCodec
+    let bytes: [UInt8]
+    let sourceNALLengthSize: Int
+
+    /// VideoToolbox accepts 1, 2 and 4 byte prefixes; 3 byte prefixes are rewritten.
+    var needsNALLengthConversion: Bool {
+        return sourceNALLengthSize == 3
+    }
+}
+
+/// Extradata parsing and NAL length rewriting, free of CoreMedia so it can be tested
+/// against raw bitstream bytes.
+enum IRFFVideoToolBoxBitstreamPolicy {
+    static let outputNALLengthSize = 4
+
+    /// Annex B extradata (start-code delimited parameter sets) is not an avcC/hvcC
+    /// record and is left to the software decoder.
+    static func isAnnexB(_ extradata: [UInt8]) -> Bool {
+        if extradata.starts(with: [0, 0, 1]) {
+            return true
+        }
+        return extradata.starts(with: [0, 0, 0, 1])
+    }
+
+    static func configurationRecord(codec: IRFFVideoToolBoxCodec, extradata: [UInt8]) -> IRFFVideoToolBoxConfigurationRecord? {
+        guard extradata.count >= codec.minimumConfigurationRecordSize,
+              !isAnnexB(extradata),
+              extradata[0] == 1 else {
+            return nil
+        }
+
+        var bytes = extradata
+        let offset = codec.nalLengthSizeByteOffset
+        let sourceNALLengthSize = Int(bytes[offset] & 0x03) + 1
+        if sourceNALLengthSize == 3 {
+            bytes[offset] = (bytes[offset] & ~0x03) | UInt8(outputNALLengthSize - 1)
+        }
+        return IRFFVideoToolBoxConfigurationRecord(codec: codec, bytes: bytes, sourceNALLengthSize: sourceNALLengthSize)
+    }
+
+    /// Size of `payload` once every length prefix is widened to four bytes, or nil when
+    /// a prefix or NAL unit runs past the end of the packet.
+    static func convertedPacketSize(_ payload: UnsafeRawBufferPointer, sourceNALLengthSize: Int) -> Int? {
+        guard (1...outputNALLengthSize).contains(sourceNALLengthSize) else { return nil }
+        var cursor = 0
+        var nalCount = 0
+        while cursor < payload.count {
+            guard let nalSize = readNALLength(payload, at: cursor, lengthSize: sourceNALLengthSize) else { return nil }
+            cursor += sourceNALLengthSize
+            guard nalSize <= payload.count - cursor else { return nil }
+            cursor += nalSize
+            nalCount += 1
+        }
+        return payload.count + nalCount * (outputNALLengthSize - sourceNALLengthSize)
+    }
+
+    /// Writes `payload` into `destination` with four-byte big-endian length prefixes and
+    /// returns the number of bytes written.
+    static func convertNALLengthPrefixes(_ payload: UnsafeRawBufferPointer,
+                                         sourceNALLengthSize: Int,
+                                         into destination: UnsafeMutableRawBufferPointer) -> Int? {
+        guard let convertedSize = convertedPacketSize(payload, sourceNALLengthSize: sourceNALLengthSize),
+              destination.count >= convertedSize else {
+            return nil
+        }
+        var readCursor = 0
+        var writeCursor = 0
+        while readCursor < payload.count {
+            guard let nalSize = readNALLength(payload, at: readCursor, lengthSize: sourceNALLengthSize) else { return nil }
+            readCursor += sourceNALLengthSize
+            let length = UInt32(nalSize)
+            destination[writeCursor] = UInt8(truncatingIfNeeded: length >> 24)
+            destination[writeCursor + 1] = UInt8(truncatingIfNeeded: length >> 16)
+            destination[writeCursor + 2] = UInt8(truncatingIfNeeded: length >> 8)
+            destination[writeCursor + 3] = UInt8(truncatingIfNeeded: length)
+            writeCursor += outputNALLengthSize
+            if nalSize > 0, let source = payload.baseAddress, let target = destination.baseAddress {
+                memcpy(target + writeCursor, source + readCursor, nalSize)
+            }
+            readCursor += nalSize
+            writeCursor += nalSize
+        }
+        return writeCursor
+    }
+
+    static func convertNALLengthPrefixes(_ payload: [UInt8], sourceNALLengthSize: Int) -> [UInt8]? {
+        return payload.withUnsafeBytes { source -> [UInt8]? in
+            guard let convertedSize = convertedPacketSize(source, sourceNALLengthSize: sourceNALLengthSize) else { return nil }
+            var converted = [UInt8](repeating: 0, count: convertedSize)
+            let written = converted.withUnsafeMutableBytes { destination in
+                convertNALLengthPrefixes(source, sourceNALLengthSize: sourceNALLengthSize, into: destination)
+            }
+            return written == convertedSize ? converted : nil
+        }
+    }
+
+    private static func readNALLength(_ payload: UnsafeRawBufferPointer, at offset: Int, lengthSize: Int) -> Int? {
+        guard offset >= 0, lengthSize <= payload.count - offset else { return nil }
+        var length = 0
+        for index in 0..<lengthSize {
+            length = (length << 8) | Int(payload[offset + index])
+        }
+        return length
+    }
+}
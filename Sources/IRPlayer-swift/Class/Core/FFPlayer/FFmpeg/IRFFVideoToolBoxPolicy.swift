@@ -5,12 +5,60 @@ import VideoToolbox
 
 enum IRFFVideoToolBoxPolicy {
 
+    static func codec(for codecID: AVCodecID) -> IRFFVideoToolBoxCodec? {
+        switch codecID {
+        case AV_CODEC_ID_H264: return .h264
+        case AV_CODEC_ID_HEVC: return .hevc
+        default: return nil
+        }
+    }
+
+    static func codecType(for codec: IRFFVideoToolBoxCodec) -> CMVideoCodecType {
+        switch codec {
+        case .h264: return kCMVideoCodecType_H264
+        case .hevc: return kCMVideoCodecType_HEVC
+        }
+    }
+
+    /// Pictures VideoToolbox may emit ahead of an earlier-presented one; the codec
+    /// context's `has_b_frames` is FFmpeg's reorder delay for the stream.
+    static func reorderDepth(hasBFrames: Int32) -> Int {
+        return min(max(Int(hasBFrames), 0), 16)
+    }
+
+    static func sampleTiming(position: TimeInterval, duration: TimeInterval) -> CMSampleTimingInfo {
+        let timescale: CMTimeScale = 1_000_000
+        return CMSampleTimingInfo(
+            duration: duration.isFinite && duration > 0 ? CMTime(seconds: duration, preferredTimescale: timescale) : .invalid,
+            presentationTimeStamp: position.isFinite ? CMTime(seconds: position, preferredTimescale: timescale) : .invalid,
+            decodeTimeStamp: .invalid
+        )
+    }
+
+    static func seconds(from time: CMTime) -> TimeInterval? {
+        guard time.isValid, time.isNumeric else { return nil }
+        let seconds = CMTimeGetSeconds(time)
+        return seconds.isFinite ? seconds : nil
+    }
+
+    /// Timing of an output picture. VideoToolbox can hand a picture back without a
+    /// usable timestamp; it then keeps the timing of the packet it was decoded from,
+    /// so it is not ordered as if it were the start of the stream.
+    static func outputTiming(presentationTimeStamp: CMTime,
+                             presentationDuration: CMTime,
+                             submittedPosition: TimeInterval,
+                             submittedDuration: TimeInterval) -> (position: TimeInterval, duration: TimeInterval) {
+        let position = seconds(from: presentationTimeStamp) ?? (submittedPosition.isFinite ? submittedPosition : 0)
+        let duration = seconds(from: presentationDuration) ?? (submittedDuration.isFinite && submittedDuration > 0 ? submittedDuration : 0)
+        return (position, duration)
+    }
+
     static func setupValidationError(codecID: AVCodecID,
                                      extradata: UnsafeMutablePointer<UInt8>?,
                                      extradataSize: Int32,
                                      firstExtradataByte: UInt8?) -> IRFFVideoToolBoxErrorCode? {
-        guard codecID == AV_CODEC_ID_H264 else { return .notH264 }
-        guard extradata != nil, extradataSize >= 7 else { return .extradataSize }
+        guard let codec = codec(for: codecID) else { return .notH264 }
+        guard extradata != nil, Int(extradataSize) >= codec.minimumConfigurationRecordSize else { return .extradataSize }
         guard firstExtradataByte == 1 else { return .extradataData }
         return nil
     }
@@ -77,27 +125,13 @@ enum IRFFVideoToolBoxPolicy {
     }
 
     static func threeByteNALUnitsAreBounded(in payload: IRFFVideoToolBox.PacketPayload) -> Bool {
-        var cursor = payload.data
-        let end = payload.end
-
-        while cursor < end {
-            let nalSizeEnd = cursor.advanced(by: 3)
-            guard nalSizeEnd <= end else { return false }
-
-            let nalSize = (UInt32(cursor[0]) << 16) | (UInt32(cursor[1]) << 8) | UInt32(cursor[2])
-            cursor = nalSizeEnd
-
-            guard nalPayloadCanAdvance(nalSize: nalSize, remainingByteCount: cursor.distance(to: end)) else {
-                return false
-            }
-            let nalEnd = cursor.advanced(by: Int(nalSize))
-            cursor = nalEnd
-        }
-
-        return true
+        let buffer = UnsafeRawBufferPointer(start: payload.data, count: Int(payload.size))
+        return IRFFVideoToolBoxBitstreamPolicy.convertedPacketSize(buffer, sourceNALLengthSize: 3) != nil
     }
 
-    static func makeFormatDescriptionExtensions(extradata: UnsafePointer<UInt8>, extradataSize: Int32) -> CFDictionary {
+    static func makeFormatDescriptionExtensions(extradata: UnsafePointer<UInt8>,
+                                                extradataSize: Int32,
+                                                codec: IRFFVideoToolBoxCodec = .h264) -> CFDictionary {
         let safeExtradataSize = max(0, CFIndex(extradataSize))
         let pixelAspectRatio: [String: Any] = [
             "HorizontalSpacing": 0,
@@ -105,7 +139,7 @@ enum IRFFVideoToolBoxPolicy {
         ]
 
         let atoms: [String: Any] = [
-            "avcC": CFDataCreate(nil, extradata, safeExtradataSize) as Data
+            codec.configurationAtomKey: CFDataCreate(nil, extradata, safeExtradataSize) as Data
         ]
 
         let extensions: [String: Any] = [
@@ -0,0 +1,68 @@
+//
+//  IRFFVideoToolBoxReorderBuffer.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Holds asynchronously decoded pictures until they can leave in presentation order.
+///
+/// VideoToolbox reports pictures in decode order; with B-frames a picture may only be
+/// emitted once `depth` later pictures have arrived, because none of them can precede
+/// it any more. Equal timestamps keep their arrival order.
+struct IRFFVideoToolBoxReorderBuffer<Element> {
+    private struct Entry {
+        let pts: TimeInterval
+        let element: Element
+    }
+
+    let depth: Int
+    private var entries: [Entry] = []
+
+    init(depth: Int) {
+        self.depth = max(0, depth)
+    }
+
+    var count: Int {
+        return entries.count
+    }
+
+    var isEmpty: Bool {
+        return entries.isEmpty
+    }
+
+    /// Timestamps that are not finite sort after every finite one.
+    mutating func insert(_ element: Element, pts: TimeInterval) {
+        let key = pts.isFinite ? pts : .infinity
+        var low = 0
+        var high = entries.count
+        while low < high {
+            let mid = (low + high) / 2
+            if entries[mid].pts <= key {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        entries.insert(Entry(pts: key, element: element), at: low)
+    }
+
+    /// The earliest picture, once more than `depth` pictures are buffered.
+    mutating func popReady() -> Element? {
+        guard entries.count > depth else { return nil }
+        return entries.removeFirst().element
+    }
+
+    /// Every buffered picture in presentation order, e.g. at end of stream.
+    mutating func drain() -> [Element] {
+        let drained = entries.map(\.element)
+        entries.removeAll()
+        return drained
+    }
+
+    mutating func removeAll() {
+        entries.removeAll()
+    }
+}
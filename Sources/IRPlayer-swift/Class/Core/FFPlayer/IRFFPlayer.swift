@@ -9,12 +9,6 @@ import UIKit // For CGSize
 import AVFoundation // For NSTimeInterval
 
 class IRFFPlayer: NSObject {
-    struct AudioCopyPlan: Equatable, Hashable, Sendable {
-        let bytesToCopy: Int
-        let framesToCopy: Int
-        let hasRemainingFrameBytes: Bool
-    }
-
     struct PlayTransition: Equatable {
         let nextState: IRPlayerState
         let shouldSeekToStart: Bool
@@ -35,6 +29,9 @@ class IRFFPlayer: NSObject {
     weak var abstractPlayer: IRPlayerImp?
     var decoder: IRFFDecoder?
     var audioManager: IRAudioManager?
+    /// Set once this player registered the audio session, which only happens when it
+    /// opens media with audio.
+    private(set) var audioSessionRegistered = false
     private(set) var seeking: Bool = false
 
     var state: IRPlayerState = .none {
@@ -46,7 +43,7 @@ class IRFFPlayer: NSObject {
                 if state != .failed {
                     abstractPlayer?.error = nil
                 }
-                if state == .playing {
+                if state == .playing, decoder?.videoOnly != true {
                     audioManager?.play(withDelegate: self)
                 } else {
                     audioManager?.pause()
@@ -104,19 +101,18 @@ class IRFFPlayer: NSObject {
     var lastPostProgressTime: TimeInterval = 0.0
     var lastPostPlayableTime: TimeInterval = 0.0
 
-    var currentAudioFrame: IRFFAudioFrame?
-
     var playing = false
 
     init(abstractPlayer: IRPlayerImp) {
         self.abstractPlayer = abstractPlayer
         self.audioManager = abstractPlayer.manager
-        _ = audioManager?.registerAudioSession()
     }
 
     deinit {
         clean()
-        audioManager?.unregisterAudioSession()
+        if audioSessionRegistered {
+            audioManager?.unregisterAudioSession()
+        }
     }
 
     static func player(with abstractPlayer: IRPlayerImp) -> IRFFPlayer {
@@ -154,15 +150,6 @@ class IRFFPlayer: NSObject {
         )
     }
 
-    static func audioCopyPlan(frameSize: Int, outputOffset: Int, remainingFrames: UInt32, numberOfChannels: UInt32) -> AudioCopyPlan? {
-        return IRFFPlayerPlaybackPolicy.audioCopyPlan(
-            frameSize: frameSize,
-            outputOffset: outputOffset,
-            remainingFrames: remainingFrames,
-            numberOfChannels: numberOfChannels
-        )
-    }
-
     func play() {
         playing = true
         decoder?.resume()
@@ -201,7 +188,6 @@ extension IRFFPlayer {
 
     private func clean() {
         cleanDecoder()
-        cleanFrame()
         cleanPlayer()
     }
 
@@ -216,10 +202,6 @@ extension IRFFPlayer {
         abstractPlayer?.displayView?.cleanEmptyBuffer()
     }
 
-    private func cleanFrame() {
-        currentAudioFrame?.stopPlaying()
-        currentAudioFrame = nil
-    }
 
     private func cleanDecoder() {
         if let decoder = decoder {
@@ -292,14 +274,49 @@ extension IRFFPlayer {
         return decoder?.prepareToDecode == true ? decoder?.bitrate ?? 0 : 0
     }
 
+    var droppedVideoFrameCount: Int {
+        return decoder?.droppedVideoFrameCount ?? 0
+    }
+
+    var repeatedVideoFrameCount: Int {
+        return decoder?.repeatedVideoFrameCount ?? 0
+    }
+
+    var audioUnderrunCount: Int {
+        return decoder?.audioUnderrunCount ?? 0
+    }
+
+    var liveLatency: TimeInterval {
+        return decoder?.liveLatency ?? 0
+    }
+
     func reloadVolume() {
         audioManager?.volume = IRPlayerVolume.normalizedFloat(from: abstractPlayer?.volume)
     }
 
+    func reloadRate() {
+        decoder?.rate = IRPlayerRate.normalized(abstractPlayer?.rate)
+    }
+
+    func reloadLiveTargetLatency() {
+        decoder?.liveTargetLatency = abstractPlayer?.liveTargetLatency ?? IRFFLiveCatchUpPolicy.defaultTargetLatency
+    }
+
+    /// Registers the audio session the first time media that may carry audio is
+    /// opened; video-only playback never touches it.
+    func reloadAudioSession() {
+        guard !audioSessionRegistered, abstractPlayer?.decoder.ffmpegVideoOnly != true else { return }
+        audioSessionRegistered = audioManager?.registerAudioSession() ?? false
+    }
+
     func reloadPlayableBufferInterval() {
         guard let decoder = decoder else { return }
         var bufferInterval = abstractPlayer?.playableBufferInterval ?? 0
         decoder.isLiveStream = abstractPlayer?.isLiveStream ?? false
+        if let playerDecoder = abstractPlayer?.decoder {
+            decoder.bufferingPolicy = playerDecoder.ffmpegBufferingPolicy
+            decoder.liveBufferingPolicy = playerDecoder.ffmpegLiveBufferingPolicy
+        }
 
         // For live streams (RTSP, no duration), use much lower buffer threshold
         // to prevent stuck buffering state
@@ -339,15 +356,22 @@ extension IRFFPlayer {
               let contentURL = abstractPlayer.contentURL,
               let displayView = abstractPlayer.displayView else { return }
 
+        let videoOnly = abstractPlayer.decoder.ffmpegVideoOnly
+        reloadAudioSession()
         decoder = IRFFDecoder(contentURL: contentURL as URL,
                               videoFormat: abstractPlayer.decoder.formatForContentURL(contentURL: contentURL),
                               videoOutput: displayView,
-                              audioOutput: self)
+                              audioOutput: videoOnly ? nil : self)
+        decoder?.videoOnly = videoOnly
+        decoder?.inputProfile = abstractPlayer.decoder.ffmpegInputProfile
         decoder?.source = abstractPlayer.videoInput
         decoder?.delegate = self
         decoder?.hardwareDecoderEnable = abstractPlayer.decoder.ffmpegHardwareDecoderEnable
+        decoder?.videoThreading = abstractPlayer.decoder.ffmpegVideoThreading
         decoder?.open()
         reloadVolume()
+        reloadRate()
+        reloadLiveTargetLatency()
         reloadPlayableBufferInterval()
 
         let pixelFormat: IRPixelFormat = decoder?.hardwareDecoderEnable == true ? .NV12_IRPixelFormat : .YUV_IRPixelFormat
@@ -376,69 +400,20 @@ extension IRFFPlayer: IRFFDecoderAudioOutput {
 
 extension IRFFPlayer: IRAudioManagerDelegate {
 
+    /// Runs on the audio render thread: reads straight from the decoder's sample ring,
+    /// which never locks or allocates.
     func audioManager(_ audioManager: IRAudioManager, outputData: UnsafeMutablePointer<Float>, numberOfFrames: UInt32, numberOfChannels: UInt32) {
-        guard self.playing else {
-            if let byteCount = Self.audioSilenceByteCount(numberOfFrames: numberOfFrames, numberOfChannels: numberOfChannels) {
-                memset(outputData, 0, byteCount)
-            }
+        guard let byteCount = Self.audioSilenceByteCount(numberOfFrames: numberOfFrames, numberOfChannels: numberOfChannels) else {
             return
         }
-
-//        autoreleasepool {
-            var remainingFrames = numberOfFrames
-            var currentOutputData = outputData
-
-            while remainingFrames > 0 {
-                if self.currentAudioFrame == nil {
-                    self.currentAudioFrame = self.decoder?.fetchAudioFrame()
-                    self.currentAudioFrame?.startPlaying()
-                }
-
-                guard let currentAudioFrame = self.currentAudioFrame else {
-                    if let byteCount = Self.audioSilenceByteCount(numberOfFrames: remainingFrames, numberOfChannels: numberOfChannels) {
-                        memset(currentOutputData, 0, byteCount)
-                    }
-                    return
-                }
-
-                guard let samples = currentAudioFrame.samples else {
-                    currentAudioFrame.stopPlaying()
-                    self.currentAudioFrame = nil
-                    if let byteCount = Self.audioSilenceByteCount(numberOfFrames: remainingFrames, numberOfChannels: numberOfChannels) {
-                        memset(currentOutputData, 0, byteCount)
-                    }
-                    return
-                }
-
-                guard let copyPlan = Self.audioCopyPlan(
-                    frameSize: currentAudioFrame.size,
-                    outputOffset: currentAudioFrame.outputOffset,
-                    remainingFrames: remainingFrames,
-                    numberOfChannels: numberOfChannels
-                ) else {
-                    currentAudioFrame.stopPlaying()
-                    self.currentAudioFrame = nil
-                    if let byteCount = Self.audioSilenceByteCount(numberOfFrames: remainingFrames, numberOfChannels: numberOfChannels) {
-                        memset(currentOutputData, 0, byteCount)
-                    }
-                    return
-                }
-
-                let bytes = UnsafeRawPointer(samples).advanced(by: Int(currentAudioFrame.outputOffset)).assumingMemoryBound(to: UInt8.self)
-                let bytesToCopy = copyPlan.bytesToCopy
-                let framesToCopy = copyPlan.framesToCopy
-                memcpy(currentOutputData, bytes, bytesToCopy)
-                remainingFrames -= UInt32(framesToCopy)
-                currentOutputData = currentOutputData.advanced(by: framesToCopy * Int(numberOfChannels))
-
-                if copyPlan.hasRemainingFrameBytes {
-                    currentAudioFrame.outputOffset += bytesToCopy
-                } else {
-                    currentAudioFrame.stopPlaying()
-                    self.currentAudioFrame = nil
-                }
-            }
-//        }
+        guard self.playing, let decoder = self.decoder else {
+            memset(outputData, 0, byteCount)
+            return
+        }
+        decoder.renderAudio(into: outputData,
+                            sampleCount: byteCount / MemoryLayout<Float>.size,
+                            hostTime: audioManager.renderHostTime,
+                            outputLatency: audioManager.outputLatency)
     }
 
 }
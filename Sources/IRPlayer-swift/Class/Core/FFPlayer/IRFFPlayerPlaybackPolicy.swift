@@ -58,38 +58,4 @@ enum IRFFPlayerPlaybackPolicy {
         guard !byteCountOverflow else { return nil }
         return byteCount
     }
-
-    static func audioCopyPlan(frameSize: Int,
-                              outputOffset: Int,
-                              remainingFrames: UInt32,
-                              numberOfChannels: UInt32) -> IRFFPlayer.AudioCopyPlan? {
-        guard frameSize > 0,
-              outputOffset >= 0,
-              outputOffset <= frameSize,
-              remainingFrames > 0,
-              numberOfChannels > 0 else {
-            return nil
-        }
-
-        let (frameSizeOf, frameSizeOverflow) = Int(numberOfChannels).multipliedReportingOverflow(by: MemoryLayout<Float>.size)
-        guard !frameSizeOverflow, frameSizeOf > 0 else { return nil }
-        guard outputOffset % frameSizeOf == 0 else { return nil }
-
-        let bytesLeft = frameSize - outputOffset
-        guard bytesLeft > 0 else { return nil }
-
-        let (requestedBytes, requestedBytesOverflow) = Int(remainingFrames).multipliedReportingOverflow(by: frameSizeOf)
-        guard !requestedBytesOverflow else { return nil }
-
-        let boundedBytesToCopy = min(requestedBytes, bytesLeft)
-        let bytesToCopy = boundedBytesToCopy - (boundedBytesToCopy % frameSizeOf)
-        let framesToCopy = bytesToCopy / frameSizeOf
-        guard bytesToCopy > 0, framesToCopy > 0 else { return nil }
-
-        return IRFFPlayer.AudioCopyPlan(
-            bytesToCopy: bytesToCopy,
-            framesToCopy: framesToCopy,
-            hasRemainingFrameBytes: bytesToCopy < bytesLeft
-        )
-    }
 }
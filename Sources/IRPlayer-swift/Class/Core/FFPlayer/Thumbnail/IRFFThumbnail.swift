@@ -0,0 +1,28 @@
+//
+//  IRFFThumbnail.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// A downscaled key frame as packed RGB24 rows.
+public struct IRFFThumbnail {
+    /// Time of the request that decoded it; later requests in the same time bucket
+    /// get this thumbnail back from the cache.
+    public let requestedTime: TimeInterval
+    /// Position of the key frame it shows.
+    public let position: TimeInterval
+    public let width: Int
+    public let height: Int
+    public let bytesPerRow: Int
+    public let pixels: Data
+}
+
+struct IRFFThumbnailKey: Hashable {
+    let url: URL
+    let bucket: Int64
+    let maxWidth: Int
+    let maxHeight: Int
+}
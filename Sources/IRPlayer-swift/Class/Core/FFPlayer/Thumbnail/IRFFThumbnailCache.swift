@@ -0,0 +1,135 @@
+//
+//  IRFFThumbnailCache.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+/// Least-recently-used thumbnails, shared by every generator by default. Bounded by
+/// both entry count and total pixel bytes; a thumbnail larger than the whole byte
+/// budget is not kept.
+final class IRFFThumbnailCache {
+    private final class Node {
+        let key: IRFFThumbnailKey
+        var thumbnail: IRFFThumbnail
+        var previous: Node?
+        var next: Node?
+
+        init(key: IRFFThumbnailKey, thumbnail: IRFFThumbnail) {
+            self.key = key
+            self.thumbnail = thumbnail
+        }
+    }
+
+    static let shared = IRFFThumbnailCache(capacity: IRFFThumbnailPolicy.defaultCacheCapacity,
+                                           byteCapacity: IRFFThumbnailPolicy.defaultCacheByteCapacity)
+
+    let capacity: Int
+    let byteCapacity: Int
+    /// Pixel bytes of every cached thumbnail.
+    private var pixelByteCount = 0
+    private let lock = NSLock()
+    private var nodes: [IRFFThumbnailKey: Node] = [:]
+    /// Most recently used.
+    private var head: Node?
+    /// Next to be evicted.
+    private var tail: Node?
+
+    init(capacity: Int, byteCapacity: Int = IRFFThumbnailPolicy.defaultCacheByteCapacity) {
+        self.capacity = max(1, capacity)
+        self.byteCapacity = max(0, byteCapacity)
+    }
+
+    var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return nodes.count
+    }
+
+    var byteCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return pixelByteCount
+    }
+
+    func thumbnail(for key: IRFFThumbnailKey) -> IRFFThumbnail? {
+        lock.lock()
+        defer { lock.unlock() }
+        guard let node = nodes[key] else { return nil }
+        moveToFront(node)
+        return node.thumbnail
+    }
+
+    func insert(_ thumbnail: IRFFThumbnail, for key: IRFFThumbnailKey) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard thumbnail.pixels.count <= byteCapacity else {
+            if let stale = nodes.removeValue(forKey: key) {
+                unlink(stale)
+                pixelByteCount -= stale.thumbnail.pixels.count
+            }
+            return
+        }
+        if let node = nodes[key] {
+            pixelByteCount -= node.thumbnail.pixels.count
+            node.thumbnail = thumbnail
+            moveToFront(node)
+        } else {
+            let node = Node(key: key, thumbnail: thumbnail)
+            nodes[key] = node
+            moveToFront(node)
+        }
+        pixelByteCount += thumbnail.pixels.count
+        while IRFFThumbnailPolicy.cacheIsOverLimit(count: nodes.count,
+                                                   byteCount: pixelByteCount,
+                                                   capacity: capacity,
+                                                   byteCapacity: byteCapacity),
+              let evicted = tail {
+            unlink(evicted)
+            nodes[evicted.key] = nil
+            pixelByteCount -= evicted.thumbnail.pixels.count
+        }
+    }
+
+    func removeAll() {
+        lock.lock()
+        // Break the links so the nodes are not kept alive by each other.
+        var node = head
+        while let current = node {
+            node = current.next
+            current.previous = nil
+            current.next = nil
+        }
+        nodes.removeAll()
+        pixelByteCount = 0
+        head = nil
+        tail = nil
+        lock.unlock()
+    }
+
+    private func moveToFront(_ node: Node) {
+        guard head !== node else { return }
+        unlink(node)
+        node.next = head
+        head?.previous = node
+        head = node
+        if tail == nil {
+            tail = node
+        }
+    }
+
+    private func unlink(_ node: Node) {
+        node.previous?.next = node.next
+        node.next?.previous = node.previous
+        if head === node {
+            head = node.next
+        }
+        if tail === node {
+            tail = node.previous
+        }
+        node.previous = nil
+        node.next = nil
+    }
+}
@@ -0,0 +1,175 @@
+//
+//  IRFFThumbnailGenerator.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+
+/// Scrub-preview thumbnails for a local file or VOD URL. Opens its own format
+/// context on a background queue, decodes only the key frame at or before each
+/// requested time and downscales it in software, so nothing here needs a display.
+/// Turning a thumbnail into an image is left to the platform layer.
+public final class IRFFThumbnailGenerator {
+    public static let defaultBucketDuration: TimeInterval = IRFFThumbnailPolicy.defaultBucketDuration
+
+    public let contentURL: URL
+    public let bucketDuration: TimeInterval
+
+    private let videoFormat: IRVideoFormat
+    private let cache: IRFFThumbnailCache
+    private let queue = DispatchQueue(label: "IRFFThumbnailGenerator", qos: .utility)
+    /// Everything below is owned by `queue`.
+    private var formatContext: IRFFFormatContext?
+    private var frame: UnsafeMutablePointer<AVFrame>?
+    private let scaler = IRFFThumbnailScaler()
+    private(set) var decodedKeyFrameCount = 0
+
+    public convenience init(contentURL: URL, bucketDuration: TimeInterval = IRFFThumbnailGenerator.defaultBucketDuration) {
+        self.init(contentURL: contentURL, videoFormat: .unknown, bucketDuration: bucketDuration, cache: .shared)
+    }
+
+    init(contentURL: URL, videoFormat: IRVideoFormat, bucketDuration: TimeInterval, cache: IRFFThumbnailCache) {
+        self.contentURL = contentURL
+        self.videoFormat = videoFormat
+        self.bucketDuration = bucketDuration
+        self.cache = cache
+    }
+
+    /// Calls `completion` on `callbackQueue` with the thumbnail for `time`, fitted
+    /// into `maxWidth` x `maxHeight` pixels, or nil when the file has no decodable
+    /// video there.
+    public func thumbnail(at time: TimeInterval,
+                          maxWidth: Int,
+                          maxHeight: Int,
+                          callbackQueue: DispatchQueue = .main,
+                          completion: @escaping (IRFFThumbnail?) -> Void) {
+        queue.async {
+            let thumbnail = self.thumbnailSync(at: time, maxWidth: maxWidth, maxHeight: maxHeight)
+            callbackQueue.async {
+                completion(thumbnail)
+            }
+        }
+    }
+
+    /// `count` thumbnails spread evenly across the duration, in time order. Times
+    /// without a decodable key frame are left out.
+    public func thumbnails(count: Int,
+                           maxWidth: Int,
+                           maxHeight: Int,
+                           callbackQueue: DispatchQueue = .main,
+                           completion: @escaping ([IRFFThumbnail]) -> Void) {
+        queue.async {
+            let thumbnails = self.thumbnailsSync(count: count, maxWidth: maxWidth, maxHeight: maxHeight)
+            callbackQueue.async {
+                completion(thumbnails)
+            }
+        }
+    }
+
+    /// Releases the format context; a later request opens it again.
+    public func close() {
+        queue.async {
+            self.closeFormatContext()
+        }
+    }
+
+    func thumbnailsSync(count: Int, maxWidth: Int, maxHeight: Int) -> [IRFFThumbnail] {
+        guard let duration = openedFormatContext()?.duration else { return [] }
+        return IRFFThumbnailPolicy.batchTimes(count: count, duration: duration).compactMap {
+            thumbnailSync(at: $0, maxWidth: maxWidth, maxHeight: maxHeight)
+        }
+    }
+
+    func thumbnailSync(at time: TimeInterval, maxWidth: Int, maxHeight: Int) -> IRFFThumbnail? {
+        guard maxWidth > 0, maxHeight > 0,
+              let bucket = IRFFThumbnailPolicy.timeBucket(for: time, bucketDuration: bucketDuration) else {
+            return nil
+        }
+        let key = IRFFThumbnailKey(url: contentURL, bucket: bucket, maxWidth: maxWidth, maxHeight: maxHeight)
+        if let thumbnail = cache.thumbnail(for: key) {
+            return thumbnail
+        }
+        guard let thumbnail = decodeKeyFrame(at: time, maxWidth: maxWidth, maxHeight: maxHeight) else {
+            return nil
+        }
+        cache.insert(thumbnail, for: key)
+        return thumbnail
+    }
+
+    private func openedFormatContext() -> IRFFFormatContext? {
+        if let formatContext {
+            return formatContext
+        }
+        let context = IRFFFormatContext(contentURL: contentURL, videoFormat: videoFormat)
+        context.videoOnly = true
+        context.setupSync()
+        guard context.error == nil, context.videoEnable else {
+            context.destroy()
+            return nil
+        }
+        formatContext = context
+        frame = av_frame_alloc()
+        return context
+    }
+
+    private func closeFormatContext() {
+        formatContext?.destroy()
+        formatContext = nil
+        if frame != nil {
+            av_frame_free(&frame)
+        }
+    }
+
+    private func decodeKeyFrame(at time: TimeInterval, maxWidth: Int, maxHeight: Int) -> IRFFThumbnail? {
+        guard let formatContext = openedFormatContext(),
+              let codecContext = formatContext.videoCodecContext,
+              let videoTrack = formatContext.videoTrack,
+              let frame else {
+            return nil
+        }
+        formatContext.seekFile(withFFTimebase: time)
+        avcodec_flush_buffers(codecContext)
+
+        var packet = AVPacket()
+        for _ in 0..<IRFFThumbnailPolicy.maxPacketsPerSeek {
+            guard formatContext.readFrame(&packet) >= 0 else { return nil }
+            defer { av_packet_unref(&packet) }
+            guard packet.stream_index == Int32(videoTrack.index),
+                  packet.flags & AV_PKT_FLAG_KEY != 0 else {
+                continue
+            }
+
+            // Draining hands the key frame back without feeding the packets after it;
+            // the flush re-arms the codec for the next request, even if the send fails.
+            defer { avcodec_flush_buffers(codecContext) }
+            guard avcodec_send_packet(codecContext, &packet) >= 0 else { return nil }
+            _ = avcodec_send_packet(codecContext, nil)
+            guard avcodec_receive_frame(codecContext, frame) >= 0 else { return nil }
+            defer { av_frame_unref(frame) }
+            decodedKeyFrameCount += 1
+
+            guard let size = IRFFThumbnailPolicy.fittedSize(sourceWidth: Int(frame.pointee.width),
+                                                             sourceHeight: Int(frame.pointee.height),
+                                                             maxWidth: maxWidth,
+                                                             maxHeight: maxHeight),
+                  let scaled = scaler.scale(frame, width: size.width, height: size.height) else {
+                return nil
+            }
+            return IRFFThumbnail(requestedTime: time,
+                                 position: IRFFFrameTime.position(timestamp: frame.pointee.best_effort_timestamp,
+                                                                  timebase: formatContext.videoTimebase),
+                                 width: size.width,
+                                 height: size.height,
+                                 bytesPerRow: scaled.bytesPerRow,
+                                 pixels: scaled.pixels)
+        }
+        return nil
+    }
+
+    deinit {
+        closeFormatContext()
+    }
+}
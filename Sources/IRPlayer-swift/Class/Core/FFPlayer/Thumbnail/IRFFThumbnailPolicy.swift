@@ -0,0 +1,58 @@
+//
+//  IRFFThumbnailPolicy.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+
+enum IRFFThumbnailPolicy {
+    /// Requests this close together share one cached thumbnail.
+    static let defaultBucketDuration: TimeInterval = 1.0
+    static let defaultCacheCapacity = 256
+    /// Pixel bytes the shared cache holds at most, so large `maxWidth`/`maxHeight`
+    /// requests can't pin `defaultCacheCapacity` full-size frames.
+    static let defaultCacheByteCapacity = 32 * 1024 * 1024
+    /// Packets read after a seek before giving up on finding a key frame.
+    static let maxPacketsPerSeek = 2_048
+    /// Row alignment of the RGB output, matching what swscale's SIMD paths expect.
+    static let rowAlignment = 32
+
+    /// Whether a cache holding `count` thumbnails of `byteCount` pixel bytes in total
+    /// is over either of its limits and should drop its least recently used entry.
+    static func cacheIsOverLimit(count: Int, byteCount: Int, capacity: Int, byteCapacity: Int) -> Bool {
+        return count > capacity || (count > 0 && byteCount > byteCapacity)
+    }
+
+    static func timeBucket(for time: TimeInterval, bucketDuration: TimeInterval) -> Int64? {
+        guard time.isFinite, time >= 0, bucketDuration.isFinite, bucketDuration > 0 else { return nil }
+        let bucket = (time / bucketDuration).rounded(.down)
+        guard bucket <= Double(Int64.max) else { return nil }
+        return Int64(bucket)
+    }
+
+    /// `count` times spread evenly across `duration`, each in the middle of its slot.
+    /// Streams without a known duration report `MAXFLOAT` and get none.
+    static func batchTimes(count: Int, duration: TimeInterval) -> [TimeInterval] {
+        guard count > 0, duration.isFinite, duration > 0, duration < TimeInterval(Float.greatestFiniteMagnitude) else { return [] }
+        let slot = duration / Double(count)
+        return (0..<count).map { (Double($0) + 0.5) * slot }
+    }
+
+    /// Largest size with the source's aspect ratio that fits in `maxWidth`×`maxHeight`,
+    /// never upscaling.
+    static func fittedSize(sourceWidth: Int, sourceHeight: Int, maxWidth: Int, maxHeight: Int) -> (width: Int, height: Int)? {
+        guard sourceWidth > 0, sourceHeight > 0, maxWidth > 0, maxHeight > 0 else { return nil }
+        let scale = min(1, min(Double(maxWidth) / Double(sourceWidth), Double(maxHeight) / Double(sourceHeight)))
+        let width = max(1, Int((Double(sourceWidth) * scale).rounded()))
+        let height = max(1, Int((Double(sourceHeight) * scale).rounded()))
+        return (width, height)
+    }
+
+    static func bytesPerRow(width: Int) -> Int? {
+        let (rowBytes, overflow) = width.multipliedReportingOverflow(by: 3)
+        guard width > 0, !overflow, rowBytes <= Int(Int32.max) - rowAlignment else { return nil }
+        return (rowBytes + rowAlignment - 1) / rowAlignment * rowAlignment
+    }
+}
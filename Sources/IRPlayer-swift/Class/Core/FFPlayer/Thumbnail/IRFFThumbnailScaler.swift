@@ -0,0 +1,51 @@
+//
+//  IRFFThumbnailScaler.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+
+/// Downscales decoded frames to RGB24, keeping one `SwsContext` for as long as the
+/// source and output geometry stay the same.
+final class IRFFThumbnailScaler {
+    private var swsContext: OpaquePointer?
+
+    func scale(_ frame: UnsafePointer<AVFrame>, width: Int, height: Int) -> (pixels: Data, bytesPerRow: Int)? {
+        let sourceFormat = AVPixelFormat(rawValue: frame.pointee.format)
+        guard frame.pointee.width > 0,
+              frame.pointee.height > 0,
+              let dimensions = IRYUVImageDimensions32(width: width, height: height),
+              let bytesPerRow = IRFFThumbnailPolicy.bytesPerRow(width: width) else {
+            return nil
+        }
+        swsContext = sws_getCachedContext(swsContext,
+                                          frame.pointee.width, frame.pointee.height, sourceFormat,
+                                          dimensions.width, dimensions.height, AV_PIX_FMT_RGB24,
+                                          SWS_AREA, nil, nil, nil)
+        guard let swsContext else { return nil }
+
+        let srcData: [UnsafePointer<UInt8>?] = [
+            UnsafePointer(frame.pointee.data.0), UnsafePointer(frame.pointee.data.1),
+            UnsafePointer(frame.pointee.data.2), UnsafePointer(frame.pointee.data.3)
+        ]
+        let srcLinesize: [Int32] = [
+            frame.pointee.linesize.0, frame.pointee.linesize.1,
+            frame.pointee.linesize.2, frame.pointee.linesize.3
+        ]
+        var pixels = Data(count: bytesPerRow * height)
+        let scaled = pixels.withUnsafeMutableBytes { buffer -> Int32 in
+            var dstData: [UnsafeMutablePointer<UInt8>?] = [buffer.bindMemory(to: UInt8.self).baseAddress, nil, nil, nil]
+            var dstLinesize: [Int32] = [Int32(bytesPerRow), 0, 0, 0]
+            return sws_scale(swsContext, srcData, srcLinesize, 0, frame.pointee.height, &dstData, &dstLinesize)
+        }
+        guard scaled > 0 else { return nil }
+        return (pixels, bytesPerRow)
+    }
+
+    deinit {
+        sws_freeContext(swsContext)
+    }
+}
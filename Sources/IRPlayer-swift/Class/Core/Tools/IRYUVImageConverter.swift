@@ -0,0 +1,180 @@
+//
+//  IRYUVImageConverter.swift
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+
+enum IRYUVImageOutputFormat {
+    case rgb24
+    /// Byte order Core Graphics draws without converting.
+    case bgra
+
+    var pixelFormat: AVPixelFormat {
+        switch self {
+        case .rgb24: return AV_PIX_FMT_RGB24
+        case .bgra: return AV_PIX_FMT_BGRA
+        }
+    }
+}
+
+/// Converts decoded planes to packed RGB. The swscale contexts and output buffer of
+/// each (size, source format, output format) are kept for the next call instead of
+/// being rebuilt per image; the few most recently used geometries are retained.
+/// Calls are serialised, so one converter can be shared across threads.
+final class IRYUVImageConverter {
+    struct Key: Hashable {
+        let width: Int32
+        let height: Int32
+        let sourceFormat: Int32
+        let outputFormat: Int32
+    }
+
+    private final class Entry {
+        /// One context per row band; a single band when not converting in parallel.
+        let contexts: [OpaquePointer]
+        let bands: [Range<Int>]
+        /// Vertical chroma subsampling of the source, as a shift.
+        let chromaShift: Int
+        var buffer: [UnsafeMutablePointer<UInt8>?]
+        var linesize: [Int32]
+
+        init?(key: Key, bands: [Range<Int>], chromaShift: Int) {
+            var buffer = [UnsafeMutablePointer<UInt8>?](repeating: nil, count: 4)
+            var linesize = [Int32](repeating: 0, count: 4)
+            // 64-byte rows keep every band's first pixel aligned for swscale's SIMD paths.
+            guard av_image_alloc(&buffer, &linesize, key.width, key.height, AVPixelFormat(rawValue: key.outputFormat), 64) >= 0 else {
+                return nil
+            }
+            var contexts: [OpaquePointer] = []
+            for band in bands {
+                guard let context = sws_getContext(key.width, Int32(band.count), AVPixelFormat(rawValue: key.sourceFormat),
+                                                   key.width, Int32(band.count), AVPixelFormat(rawValue: key.outputFormat),
+                                                   SWS_FAST_BILINEAR, nil, nil, nil) else {
+                    contexts.forEach { sws_freeContext($0) }
+                    av_freep(&buffer[0])
+                    return nil
+                }
+                contexts.append(context)
+            }
+            self.contexts = contexts
+            self.bands = bands
+            self.chromaShift = chromaShift
+            self.buffer = buffer
+            self.linesize = linesize
+        }
+
+        deinit {
+            contexts.forEach { sws_freeContext($0) }
+            av_freep(&buffer[0])
+        }
+    }
+
+    static let shared = IRYUVImageConverter()
+
+    let capacity: Int
+    /// Splits each image into row bands converted concurrently.
+    let rowParallel: Bool
+    private let lock = NSLock()
+    private var entries: [Key: Entry] = [:]
+    /// Least recently used first.
+    private var recentKeys: [Key] = []
+    private(set) var createdEntryCount = 0
+
+    init(capacity: Int = 4, rowParallel: Bool = false) {
+        self.capacity = max(1, capacity)
+        self.rowParallel = rowParallel
+    }
+
+    var cachedEntryCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return entries.count
+    }
+
+    /// Converts the planes and hands the packed pixels to `body`. They live in the
+    /// converter's reused buffer, so `body` must copy whatever it keeps.
+    func convert<T>(srcData: [UnsafePointer<UInt8>?],
+                    srcLinesize: [Int32],
+                    width: Int,
+                    height: Int,
+                    pixelFormat: AVPixelFormat,
+                    outputFormat: IRYUVImageOutputFormat,
+                    body: (_ pixels: UnsafePointer<UInt8>, _ linesize: Int) -> T?) -> T? {
+        guard IRYUVSourcePlaneInputsAreValid(srcData: srcData, srcLinesize: srcLinesize),
+              let dimensions = IRYUVImageDimensions32(width: width, height: height) else {
+            return nil
+        }
+        let key = Key(width: dimensions.width,
+                      height: dimensions.height,
+                      sourceFormat: pixelFormat.rawValue,
+                      outputFormat: outputFormat.pixelFormat.rawValue)
+
+        lock.lock()
+        defer { lock.unlock() }
+        guard let entry = entry(for: key) else { return nil }
+
+        let sources = Array((srcData + [nil, nil, nil, nil]).prefix(4))
+        let sourceLinesizes = Array((srcLinesize + [0, 0, 0, 0]).prefix(4))
+        var failed = false
+        if entry.contexts.count == 1 {
+            failed = sws_scale(entry.contexts[0], sources, sourceLinesizes, 0, dimensions.height, &entry.buffer, &entry.linesize) < 0
+        } else {
+            let failures = UnsafeMutableBufferPointer<Bool>.allocate(capacity: entry.bands.count)
+            failures.initialize(repeating: false)
+            defer { failures.deallocate() }
+            DispatchQueue.concurrentPerform(iterations: entry.bands.count) { index in
+                failures[index] = !Self.scale(band: index, of: entry, sources: sources, sourceLinesizes: sourceLinesizes)
+            }
+            failed = failures.contains(true)
+        }
+        guard !failed, let pixels = entry.buffer[0] else { return nil }
+        return body(UnsafePointer(pixels), Int(entry.linesize[0]))
+    }
+
+    private static func scale(band index: Int,
+                              of entry: Entry,
+                              sources: [UnsafePointer<UInt8>?],
+                              sourceLinesizes: [Int32]) -> Bool {
+        let band = entry.bands[index]
+        var bandSources = sources
+        for plane in bandSources.indices {
+            // Planes 1 and 2 carry the chroma, subsampled vertically by `chromaShift`.
+            let row = plane == 1 || plane == 2 ? band.lowerBound >> entry.chromaShift : band.lowerBound
+            bandSources[plane] = sources[plane].map { $0 + row * Int(sourceLinesizes[plane]) }
+        }
+        var bandOutput: [UnsafeMutablePointer<UInt8>?] = [
+            entry.buffer[0].map { $0 + band.lowerBound * Int(entry.linesize[0]) }, nil, nil, nil
+        ]
+        var outputLinesize = entry.linesize
+        return sws_scale(entry.contexts[index], bandSources, sourceLinesizes, 0, Int32(band.count), &bandOutput, &outputLinesize) >= 0
+    }
+
+    private func entry(for key: Key) -> Entry? {
+        if let entry = entries[key] {
+            if let index = recentKeys.firstIndex(of: key) {
+                recentKeys.remove(at: index)
+            }
+            recentKeys.append(key)
+            return entry
+        }
+
+        let chromaShift = Int(av_pix_fmt_desc_get(AVPixelFormat(rawValue: key.sourceFormat))?.pointee.log2_chroma_h ?? 0)
+        let bands = rowParallel
+            ? IRYUVToolsPolicy.rowBands(height: Int(key.height),
+                                        maxBands: ProcessInfo.processInfo.activeProcessorCount,
+                                        rowAlignment: 1 << chromaShift)
+            : [0..<Int(key.height)]
+        guard let entry = Entry(key: key, bands: bands, chromaShift: chromaShift) else { return nil }
+        createdEntryCount += 1
+        entries[key] = entry
+        recentKeys.append(key)
+        if recentKeys.count > capacity {
+            entries[recentKeys.removeFirst()] = nil
+        }
+        return entry
+    }
+}
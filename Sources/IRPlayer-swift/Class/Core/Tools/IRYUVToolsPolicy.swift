@@ -61,4 +61,27 @@ enum IRYUVToolsPolicy {
             src += linesize
         }
     }
+
+    /// Fewest rows worth handing to a thread of their own.
+    static let minimumRowsPerBand = 64
+
+    /// Splits `height` rows into up to `maxBands` contiguous bands for converting in
+    /// parallel. Every band but the last starts and ends on a multiple of
+    /// `rowAlignment`, so subsampled chroma rows are never split between two bands.
+    static func rowBands(height: Int, maxBands: Int, rowAlignment: Int) -> [Range<Int>] {
+        guard height > 0 else { return [] }
+        let alignment = max(1, rowAlignment)
+        let bandCount = max(1, min(maxBands, height / minimumRowsPerBand))
+        guard bandCount > 1 else { return [0..<height] }
+
+        let alignedRows = (height / bandCount + alignment - 1) / alignment * alignment
+        var bands: [Range<Int>] = []
+        var start = 0
+        while start < height {
+            let end = min(height, start + alignedRows)
+            bands.append(start..<end)
+            start = end
+        }
+        return bands
+    }
 }
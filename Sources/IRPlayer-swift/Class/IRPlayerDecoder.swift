@@ -54,10 +54,117 @@ enum IRVideoFormatResolver {
     }
 }
 
+/// Threading applied to FFmpeg's software video decoder.
+public struct IRDecoderThreading: Hashable, Sendable {
+    public enum ThreadType: String, Hashable, Sendable {
+        /// Frame threading where the codec supports it, slice threading otherwise.
+        case automatic
+        /// Decodes several frames at once; adds one frame of latency per thread.
+        case frame
+        /// Splits a single frame across threads; no extra latency.
+        case slice
+    }
+
+    /// Number of decode threads, or 0 to derive it from the active core count.
+    public var threadCount: Int
+    public var threadType: ThreadType
+
+    public init(threadCount: Int = 0, threadType: ThreadType = .automatic) {
+        self.threadCount = threadCount
+        self.threadType = threadType
+    }
+
+    public static let automatic = IRDecoderThreading()
+    public static let singleThreaded = IRDecoderThreading(threadCount: 1, threadType: .slice)
+}
+
+/// Demuxer options FFmpeg opens a source with. nil leaves FFmpeg's default in place.
+public struct IRDecoderInputProfile: Hashable, Sendable {
+    /// Hands packets on without the demuxer's own buffering (`fflags=nobuffer`).
+    public var noBuffer: Bool
+    /// Bytes read to detect the streams; FFmpeg reads up to 5 MB by default.
+    public var probeSize: Int?
+    /// Media time analysed to detect stream parameters; FFmpeg takes up to 5 s by default.
+    public var analyzeDuration: TimeInterval?
+    /// Longest the demuxer may hold packets back to reorder or interleave them.
+    public var maxDelay: TimeInterval?
+    /// RTP packets RTSP buffers to undo network reordering; 0 passes them on as they
+    /// arrive, which is safe over the TCP transport used here.
+    public var reorderQueueSize: Int?
+    /// Restricts software video decode to slice threading, whatever
+    /// `IRPlayerDecoder.ffmpegVideoThreading` asks for, so no thread holds a frame back.
+    public var sliceThreadingOnly: Bool
+
+    public init(noBuffer: Bool = false,
+                probeSize: Int? = nil,
+                analyzeDuration: TimeInterval? = nil,
+                maxDelay: TimeInterval? = nil,
+                reorderQueueSize: Int? = nil,
+                sliceThreadingOnly: Bool = false) {
+        self.noBuffer = noBuffer
+        self.probeSize = probeSize
+        self.analyzeDuration = analyzeDuration
+        self.maxDelay = maxDelay
+        self.reorderQueueSize = reorderQueueSize
+        self.sliceThreadingOnly = sliceThreadingOnly
+    }
+
+    public static let standard = IRDecoderInputProfile()
+    /// For live cameras: opens after a short probe and never holds packets or frames back.
+    public static let lowLatencyLive = IRDecoderInputProfile(noBuffer: true,
+                                                             probeSize: 65_536,
+                                                             analyzeDuration: 0.5,
+                                                             maxDelay: 0.5,
+                                                             reorderQueueSize: 0,
+                                                             sliceThreadingOnly: true)
+}
+
+/// When FFmpeg playback stops to buffer and when it resumes.
+public struct IRBufferingPolicy: Hashable, Sendable {
+    /// Playback stops to buffer once no more than this is buffered.
+    public var enterThreshold: TimeInterval
+    /// Whether buffering waits for the player's `playableBufferInterval` to be
+    /// buffered; without it playback resumes on the next check.
+    public var waitsForPlayableBufferInterval: Bool
+    /// How long buffering waits before resuming with less than the playable interval.
+    public var timeout: TimeInterval
+    /// Buffered duration needed to resume once `timeout` has passed.
+    public var timeoutResumeThreshold: TimeInterval
+
+    public init(enterThreshold: TimeInterval,
+                waitsForPlayableBufferInterval: Bool,
+                timeout: TimeInterval,
+                timeoutResumeThreshold: TimeInterval) {
+        self.enterThreshold = enterThreshold
+        self.waitsForPlayableBufferInterval = waitsForPlayableBufferInterval
+        self.timeout = timeout
+        self.timeoutResumeThreshold = timeoutResumeThreshold
+    }
+
+    public static let standard = IRBufferingPolicy(enterThreshold: 0.2,
+                                                   waitsForPlayableBufferInterval: true,
+                                                   timeout: 2.0,
+                                                   timeoutResumeThreshold: 0.3)
+    /// Live streams only stop when the buffer is nearly dry and resume right away.
+    public static let live = IRBufferingPolicy(enterThreshold: 0.05,
+                                               waitsForPlayableBufferInterval: false,
+                                               timeout: 1.0,
+                                               timeoutResumeThreshold: 0.1)
+}
+
 @objcMembers
 public class IRPlayerDecoder: NSObject {
 
     public var ffmpegHardwareDecoderEnable: Bool = true
+    public var ffmpegVideoThreading: IRDecoderThreading = .automatic
+    /// Plays FFmpeg sources as video only, e.g. cameras without an audio track: audio
+    /// streams are neither probed nor opened, the audio session is never registered
+    /// and frames are paced on the wall clock.
+    public var ffmpegVideoOnly: Bool = false
+    public var ffmpegInputProfile: IRDecoderInputProfile = .standard
+    public var ffmpegBufferingPolicy: IRBufferingPolicy = .standard
+    /// Used instead of `ffmpegBufferingPolicy` while the player is a live stream.
+    public var ffmpegLiveBufferingPolicy: IRBufferingPolicy = .live
     var unkonwnFormat: IRDecoderType = .ffmpeg
     public var mpeg4Format: IRDecoderType = .avPlayer
     var flvFormat: IRDecoderType = .ffmpeg
@@ -57,6 +57,16 @@ enum IRPlayerVolume {
     }
 }
 
+enum IRPlayerRate {
+    static let range: ClosedRange<Double> = 0.5...4.0
+
+    /// Playback rate clamped to `range`; 1 for anything unusable.
+    static func normalized(_ rate: Double?) -> Double {
+        guard let rate = rate, rate.isFinite, rate > 0 else { return 1 }
+        return min(max(rate, range.lowerBound), range.upperBound)
+    }
+}
+
 // MARK: - IRPlayerImp
 @objcMembers
 public class IRPlayerImp: NSObject {
@@ -157,6 +167,46 @@ public class IRPlayerImp: NSObject {
             return 0
         }
     }
+    /// Video frames skipped because they were already late, counted since the current
+    /// item was opened. Always 0 for AVPlayer playback.
+    public var droppedVideoFrameCount: Int {
+        switch self.decoderType {
+        case .ffmpeg:
+            return self.ffPlayer.droppedVideoFrameCount
+        case .avPlayer, .error, .none:
+            return 0
+        }
+    }
+    /// Vsyncs that had to show the previous frame again because the next one was not
+    /// ready in time. Always 0 for AVPlayer playback.
+    public var repeatedVideoFrameCount: Int {
+        switch self.decoderType {
+        case .ffmpeg:
+            return self.ffPlayer.repeatedVideoFrameCount
+        case .avPlayer, .error, .none:
+            return 0
+        }
+    }
+    /// Times the audio output ran out of decoded samples mid-stream, counted since the
+    /// current item was opened. Always 0 for AVPlayer playback.
+    public var audioUnderrunCount: Int {
+        switch self.decoderType {
+        case .ffmpeg:
+            return self.ffPlayer.audioUnderrunCount
+        case .avPlayer, .error, .none:
+            return 0
+        }
+    }
+    /// How far live FFmpeg playback trails the newest data received, measured as the
+    /// media buffered ahead of what is playing. Always 0 for AVPlayer playback.
+    public var liveLatency: TimeInterval {
+        switch self.decoderType {
+        case .ffmpeg:
+            return self.ffPlayer.liveLatency
+        case .avPlayer, .error, .none:
+            return 0
+        }
+    }
     var playableTime: TimeInterval {
         switch self.decoderType {
         case .avPlayer:
@@ -176,6 +226,16 @@ public class IRPlayerImp: NSObject {
             }
         }
     }
+    /// Latency live FFmpeg playback is held at while `isLiveStream` is set. Above it
+    /// playback runs slightly fast; far above it, video-only streams drop to the next
+    /// key frame. 0 turns catch-up off.
+    public var liveTargetLatency: TimeInterval = IRFFLiveCatchUpPolicy.defaultTargetLatency {
+        didSet {
+            if self._ffPlayer != nil {
+                self.ffPlayer.reloadLiveTargetLatency()
+            }
+        }
+    }
     var seeking: Bool {
         switch self.decoderType {
         case .avPlayer:
@@ -199,6 +259,20 @@ public class IRPlayerImp: NSObject {
         }
     }
 
+    /// Playback speed, clamped to 0.5...4. FFmpeg playback time-stretches the audio so
+    /// its pitch is kept; AVPlayer playback applies it to the player's rate.
+    public var rate: Double = 1 {
+        didSet {
+            rate = IRPlayerRate.normalized(rate)
+            if self._avPlayer != nil {
+                self.avPlayer.reloadRate()
+            }
+            if self._ffPlayer != nil {
+                self.ffPlayer.reloadRate()
+            }
+        }
+    }
+
     var displayView: IRGLView?
     private var decoderType: IRDecoderType?
     private var _avPlayer: IRAVPlayer?
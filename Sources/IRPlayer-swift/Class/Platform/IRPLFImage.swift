@@ -58,3 +58,49 @@ func IRPLFImageCGImageWithRGBData(_ rgbData: UnsafePointer<UInt8>, linesize: Int
 
     return imageRef
 }
+
+// Function to create UIImage from BGRA data buffer
+func IRPLFImageWithBGRAData(_ bgraData: UnsafePointer<UInt8>, linesize: Int, width: Int, height: Int) -> IRPLFImage? {
+    guard let imageRef = IRPLFImageCGImageWithBGRAData(bgraData, linesize: linesize, width: width, height: height) else {
+        return nil
+    }
+    return IRPLFImageWithCGImage(imageRef)
+}
+
+func IRPLFImageBGRADataByteCount(linesize: Int, width: Int, height: Int) -> Int? {
+    return IRPLFImagePolicy.bgraDataByteCount(linesize: linesize, width: width, height: height)
+}
+
+// Function to create CGImage from BGRA data buffer, the layout Core Graphics draws
+// without converting
+func IRPLFImageCGImageWithBGRAData(_ bgraData: UnsafePointer<UInt8>, linesize: Int, width: Int, height: Int) -> CGImage? {
+    guard let byteCount = IRPLFImageBGRADataByteCount(linesize: linesize, width: width, height: height),
+          let data = CFDataCreate(kCFAllocatorDefault, bgraData, byteCount),
+          let provider = CGDataProvider(data: data),
+          let colorSpace = CGColorSpace(name: CGColorSpace.sRGB) else {
+        return nil
+    }
+
+    return CGImage(
+        width: width,
+        height: height,
+        bitsPerComponent: 8,
+        bitsPerPixel: 32,
+        bytesPerRow: linesize,
+        space: colorSpace,
+        bitmapInfo: CGBitmapInfo(rawValue: CGBitmapInfo.byteOrder32Little.rawValue | CGImageAlphaInfo.noneSkipFirst.rawValue),
+        provider: provider,
+        decode: nil,
+        shouldInterpolate: false,
+        intent: .defaultIntent
+    )
+}
+
+extension IRFFThumbnail {
+    func image() -> IRPLFImage? {
+        return pixels.withUnsafeBytes { buffer -> IRPLFImage? in
+            guard let baseAddress = buffer.bindMemory(to: UInt8.self).baseAddress else { return nil }
+            return IRPLFImageWithRGBData(baseAddress, linesize: bytesPerRow, width: width, height: height)
+        }
+    }
+}
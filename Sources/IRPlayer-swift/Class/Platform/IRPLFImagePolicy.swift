@@ -9,9 +9,17 @@ import Foundation
 
 enum IRPLFImagePolicy {
     static func rgbDataByteCount(linesize: Int, width: Int, height: Int) -> Int? {
+        return dataByteCount(linesize: linesize, width: width, height: height, bytesPerPixel: 3)
+    }
+
+    static func bgraDataByteCount(linesize: Int, width: Int, height: Int) -> Int? {
+        return dataByteCount(linesize: linesize, width: width, height: height, bytesPerPixel: 4)
+    }
+
+    static func dataByteCount(linesize: Int, width: Int, height: Int, bytesPerPixel: Int) -> Int? {
         guard linesize > 0, width > 0, height > 0 else { return nil }
 
-        let (minimumLineSize, minimumLineSizeOverflow) = width.multipliedReportingOverflow(by: 3)
+        let (minimumLineSize, minimumLineSizeOverflow) = width.multipliedReportingOverflow(by: bytesPerPixel)
         guard !minimumLineSizeOverflow, linesize >= minimumLineSize else { return nil }
 
         let (byteCount, byteCountOverflow) = linesize.multipliedReportingOverflow(by: height)
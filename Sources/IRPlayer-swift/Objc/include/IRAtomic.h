@@ -0,0 +1,37 @@
+//
+//  IRAtomic.h
+//  IRPlayer-swift
+//
+//  Created by irons on 2026/10/17.
+//
+
+#ifndef IRAtomic_h
+#define IRAtomic_h
+
+#include <stdbool.h>
+
+// Thin wrappers over the compiler atomic builtins so Swift code can publish
+// indices and counters between threads without taking a lock. All values are
+// plain `long` storage owned by the caller (imported into Swift as `Int`).
+
+static inline long IRAtomicLoad(const long *value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline void IRAtomicStore(long *value, long newValue) {
+    __atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+static inline long IRAtomicFetchAdd(long *value, long delta) {
+    return __atomic_fetch_add(value, delta, __ATOMIC_ACQ_REL);
+}
+
+static inline long IRAtomicExchange(long *value, long newValue) {
+    return __atomic_exchange_n(value, newValue, __ATOMIC_SEQ_CST);
+}
+
+static inline bool IRAtomicCompareExchange(long *value, long expected, long desired) {
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+#endif /* IRAtomic_h */
@@ -146,6 +146,32 @@ final class IRAudioManagerRenderTests: XCTestCase {
         XCTAssertNil(IRAudioManagerPolicy.renderSampleCount(numberOfFrames: 0, numberOfChannels: 2))
     }
 
+    func testOutputSampleFormatFollowsFormatFlagsAndBitDepth() {
+        XCTAssertEqual(IRAudioManagerPolicy.outputSampleFormat(formatFlags: kAudioFormatFlagsNativeFloatPacked, bitsPerChannel: 32), .float32)
+        XCTAssertEqual(IRAudioManagerPolicy.outputSampleFormat(formatFlags: kAudioFormatFlagsNativeFloatPacked | kAudioFormatFlagIsNonInterleaved,
+                                                               bitsPerChannel: 32), .float32)
+        XCTAssertEqual(IRAudioManagerPolicy.outputSampleFormat(formatFlags: kAudioFormatFlagIsSignedInteger | kAudioFormatFlagIsPacked,
+                                                               bitsPerChannel: 16), .int16)
+        XCTAssertEqual(IRAudioManagerPolicy.outputSampleFormat(formatFlags: kAudioFormatFlagIsSignedInteger, bitsPerChannel: 32), .unsupported)
+        XCTAssertEqual(IRAudioManagerPolicy.outputSampleFormat(formatFlags: kAudioFormatFlagIsFloat, bitsPerChannel: 64), .unsupported)
+        XCTAssertEqual(IRAudioManager.outputSampleFormat(formatFlags: kAudioFormatFlagsNativeFloatPacked, bitsPerChannel: 32), .float32)
+    }
+
+    func testDirectRenderRequiresMatchingFloatBufferWithRoom() {
+        XCTAssertTrue(IRAudioManagerPolicy.canRenderDirectly(sampleFormat: .float32, bufferChannelCount: 2,
+                                                             bufferByteSize: 4096, numberOfChannels: 2, sampleCount: 1024))
+        XCTAssertFalse(IRAudioManagerPolicy.canRenderDirectly(sampleFormat: .int16, bufferChannelCount: 2,
+                                                              bufferByteSize: 4096, numberOfChannels: 2, sampleCount: 1024))
+        XCTAssertFalse(IRAudioManagerPolicy.canRenderDirectly(sampleFormat: .float32, bufferChannelCount: 1,
+                                                              bufferByteSize: 4096, numberOfChannels: 2, sampleCount: 1024))
+        XCTAssertFalse(IRAudioManagerPolicy.canRenderDirectly(sampleFormat: .float32, bufferChannelCount: 2,
+                                                              bufferByteSize: 4092, numberOfChannels: 2, sampleCount: 1024))
+        XCTAssertFalse(IRAudioManagerPolicy.canRenderDirectly(sampleFormat: .float32, bufferChannelCount: 2,
+                                                              bufferByteSize: .max, numberOfChannels: 2, sampleCount: .max))
+        XCTAssertEqual(IRAudioManager.canRenderDirectly(sampleFormat: .float32, bufferChannelCount: 2,
+                                                        bufferByteSize: 4096, numberOfChannels: 2, sampleCount: 1024), true)
+    }
+
     func testRequiredAudioResourceWrappersMatchPolicyFailures() {
         switch (IRAudioManager.requiredAudioGraph(nil, domain: "missing graph"),
                 IRAudioManagerPolicy.requiredAudioGraph(nil, domain: "missing graph")) {
@@ -84,6 +84,120 @@ final class IRFFAVYUVVideoFrameTests: XCTestCase {
         XCTAssertNil(frame.image())
     }
 
+    private func makeReferenceCountedFrame(width: Int32, height: Int32, align: Int32 = 64) throws -> UnsafeMutablePointer<AVFrame> {
+        guard let frame = av_frame_alloc() else { throw XCTSkip("AVFrame allocation unavailable") }
+        frame.pointee.width = width
+        frame.pointee.height = height
+        frame.pointee.format = AV_PIX_FMT_YUV420P.rawValue
+        guard av_frame_get_buffer(frame, align) >= 0 else {
+            var unused: UnsafeMutablePointer<AVFrame>? = frame
+            av_frame_free(&unused)
+            throw XCTSkip("AVFrame buffer allocation unavailable")
+        }
+        for row in 0..<Int(height) {
+            memset(frame.pointee.data.0! + row * Int(frame.pointee.linesize.0), Int32(row + 1), Int(width))
+        }
+        return frame
+    }
+
+    func testSetFrameDataReferencesRefCountedFrameWithoutCopying() throws {
+        var source: UnsafeMutablePointer<AVFrame>? = try makeReferenceCountedFrame(width: 6, height: 4)
+        let frame = IRFFAVYUVVideoFrame()
+        let copiedBefore = IRFFAVYUVVideoFrame.copiedByteCount
+        let linesizeY = Int(source!.pointee.linesize.0)
+        let linesizeU = Int(source!.pointee.linesize.1)
+
+        frame.setFrameData(source!, width: 6, height: 4)
+        av_frame_free(&source)
+
+        XCTAssertTrue(frame.isZeroCopy)
+        XCTAssertGreaterThan(linesizeY, 6)
+        XCTAssertEqual(frame.bytesPerRow(for: .luma), linesizeY)
+        XCTAssertEqual(frame.bytesPerRow(for: .chromaB), linesizeU)
+        XCTAssertEqual(IRFFAVYUVVideoFrame.copiedByteCount, copiedBefore)
+        let luma = try XCTUnwrap(frame.luma)
+        for row in 0..<4 {
+            XCTAssertEqual(luma[row * linesizeY], UInt8(row + 1))
+            XCTAssertEqual(luma[row * linesizeY + 5], UInt8(row + 1))
+        }
+
+        frame.prepareForReuse()
+
+        XCTAssertFalse(frame.isZeroCopy)
+        XCTAssertNil(frame.luma)
+        XCTAssertEqual(frame.size, 0)
+        XCTAssertEqual(frame.bytesPerRow(for: .luma), 0)
+        XCTAssertEqual(frame.bytesPerRow(for: .chromaB), 0)
+    }
+
+    func testSetFrameDataCopiesWhenReferencingIsDisabled() throws {
+        var source: UnsafeMutablePointer<AVFrame>? = try makeReferenceCountedFrame(width: 6, height: 4)
+        defer { av_frame_free(&source) }
+        IRFFAVYUVVideoFrame.referencesDecodedFrames = false
+        defer { IRFFAVYUVVideoFrame.referencesDecodedFrames = true }
+        let frame = IRFFAVYUVVideoFrame()
+        let copiedBefore = IRFFAVYUVVideoFrame.copiedByteCount
+
+        frame.setFrameData(source!, width: 6, height: 4)
+
+        XCTAssertFalse(frame.isZeroCopy)
+        XCTAssertEqual(frame.bytesPerRow(for: .luma), 6)
+        XCTAssertEqual(frame.bytesPerRow(for: .chromaR), 3)
+        XCTAssertGreaterThanOrEqual(IRFFAVYUVVideoFrame.copiedByteCount - copiedBefore, 6 * 4 + 2 * 3 * 2)
+        let luma = try XCTUnwrap(frame.luma)
+        XCTAssertEqual(luma[6 * 3], 4)
+    }
+
+    func testSetFrameDataFallsBackToCopyForFramesWithoutBuffers() throws {
+        var y: [UInt8] = [1, 2, 3, 4, 0, 0, 5, 6, 7, 8, 0, 0]
+        var u: [UInt8] = [9, 0]
+        var v: [UInt8] = [10, 0]
+        var avFrame = AVFrame()
+        avFrame.format = AV_PIX_FMT_YUV420P.rawValue
+        avFrame.linesize.0 = 6
+        avFrame.linesize.1 = 2
+        avFrame.linesize.2 = 2
+        let frame = IRFFAVYUVVideoFrame()
+
+        y.withUnsafeMutableBufferPointer { yBuffer in
+            u.withUnsafeMutableBufferPointer { uBuffer in
+                v.withUnsafeMutableBufferPointer { vBuffer in
+                    avFrame.data.0 = yBuffer.baseAddress
+                    avFrame.data.1 = uBuffer.baseAddress
+                    avFrame.data.2 = vBuffer.baseAddress
+                    withUnsafePointer(to: &avFrame) { pointer in
+                        frame.setFrameData(pointer, width: 4, height: 2)
+                    }
+                }
+            }
+        }
+
+        XCTAssertFalse(frame.isZeroCopy)
+        XCTAssertEqual(frame.bytesPerRow(for: .luma), 4)
+        let luma = try XCTUnwrap(frame.luma)
+        XCTAssertEqual(Array(UnsafeBufferPointer(start: luma, count: 8)), [1, 2, 3, 4, 5, 6, 7, 8])
+    }
+
+    func testReferencePolicyRequiresRefCountedBuffersAndCoveringStrides() {
+        XCTAssertTrue(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: true, width: 6, height: 4, linesizeY: 64, linesizeU: 32, linesizeV: 32))
+        XCTAssertTrue(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: true, width: 6, height: 4, linesizeY: 6, linesizeU: 3, linesizeV: 3))
+        XCTAssertFalse(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: false, width: 6, height: 4, linesizeY: 64, linesizeU: 32, linesizeV: 32))
+        XCTAssertFalse(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: true, width: 6, height: 4, linesizeY: 4, linesizeU: 32, linesizeV: 32))
+        XCTAssertFalse(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: true, width: 6, height: 4, linesizeY: 64, linesizeU: 32, linesizeV: -32))
+        XCTAssertFalse(IRFFAVYUVVideoFramePolicy.canReferenceFrame(isReferenceCounted: true, width: 0, height: 4, linesizeY: 64, linesizeU: 32, linesizeV: 32))
+    }
+
+    func testPackedBytesPerRowAndCopyRate() {
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: 64, width: 6), 6)
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: 4, width: 6), 4)
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.packedBytesPerRow(linesize: -4, width: 6), 0)
+
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.bytesPerSecond(byteCount: 3_000, previousByteCount: 1_000, interval: 0.5), 4_000)
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.bytesPerSecond(byteCount: 3_000, previousByteCount: 1_000, interval: 0), 0)
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.bytesPerSecond(byteCount: 1_000, previousByteCount: 3_000, interval: 1), 0)
+        XCTAssertEqual(IRFFAVYUVVideoFramePolicy.bytesPerSecond(byteCount: 3_000, previousByteCount: 1_000, interval: .nan), 0)
+    }
+
     func testShouldAcceptFrameDataRequiresDimensionsPlanesAndLinesizes() {
         XCTAssertFalse(
             IRFFAVYUVVideoFrame.shouldAcceptFrameData(
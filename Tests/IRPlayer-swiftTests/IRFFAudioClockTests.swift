@@ -0,0 +1,145 @@
+//
+//  IRFFAudioClockTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import AVFoundation
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFAudioClockTests: XCTestCase {
+
+    func testRenderedAnchorAddsBufferAndOutputLatency() {
+        let clock = IRFFAudioClock.rendered(endPosition: 10.02, renderedDuration: 0.02, renderHostTime: 100, outputLatency: 0.005)!
+
+        XCTAssertEqual(clock.position, 10.02)
+        XCTAssertEqual(clock.hostTime, 100.025, accuracy: 1e-12)
+        XCTAssertEqual(clock.pendingDuration, 0.025, accuracy: 1e-12)
+        XCTAssertEqual(IRFFAudioClock.rendered(endPosition: 1, renderedDuration: -1, renderHostTime: 5, outputLatency: .nan),
+                       IRFFAudioClock(position: 1, hostTime: 5, pendingDuration: 0))
+        XCTAssertNil(IRFFAudioClock.rendered(endPosition: .nan, renderedDuration: 0.02, renderHostTime: 100, outputLatency: 0))
+        XCTAssertNil(IRFFAudioClock.rendered(endPosition: 1, renderedDuration: 0.02, renderHostTime: .infinity, outputLatency: 0))
+    }
+
+    func testPositionSubtractsOutputLatencyAndInterpolatesBetweenCallbacks() {
+        let clock = IRFFAudioClock.rendered(endPosition: 10.02, renderedDuration: 0.02, renderHostTime: 100, outputLatency: 0.005)!
+
+        // At the callback the speaker still plays audio rendered 25 ms earlier.
+        XCTAssertEqual(clock.position(atHostTime: 100), 9.995, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 100.005), 10.0, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 100.015), 10.01, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: .nan), 10.02)
+    }
+
+    func testPositionFreezesAtRenderedEndAndIsBoundedBehind() {
+        let clock = IRFFAudioClock.rendered(endPosition: 10.02, renderedDuration: 0.02, renderHostTime: 100, outputLatency: 0.005)!
+
+        XCTAssertEqual(clock.position(atHostTime: 100.025), 10.02, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 105), 10.02, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 99), 9.995, accuracy: 1e-9)
+    }
+
+    func testSteadyCallbacksGiveAContinuousMonotonicClock() {
+        let sampleRate = 48_000.0
+        let framesPerCallback = 512.0
+        let callbackDuration = framesPerCallback / sampleRate
+        let latency = 0.012
+        var renderedEnd = 3.0
+        var previous = -Double.infinity
+
+        for callback in 0..<50 {
+            let renderHostTime = 200 + Double(callback) * callbackDuration
+            renderedEnd += callbackDuration
+            let clock = IRFFAudioClock.rendered(endPosition: renderedEnd,
+                                                renderedDuration: callbackDuration,
+                                                renderHostTime: renderHostTime,
+                                                outputLatency: latency)!
+            for step in 0..<4 {
+                let hostTime = renderHostTime + Double(step) * callbackDuration / 4
+                let position = clock.position(atHostTime: hostTime)
+                XCTAssertGreaterThanOrEqual(position, previous - 1e-9)
+                // Speaker position is the rendered end minus everything still queued.
+                XCTAssertEqual(position, renderedEnd - callbackDuration - latency + (hostTime - renderHostTime), accuracy: 1e-9)
+                previous = position
+            }
+        }
+    }
+
+    func testSharedClockReturnsNilUntilStoredThenLatestValue() {
+        let shared = IRFFSharedAudioClock()
+        XCTAssertNil(shared.load())
+
+        let first = IRFFAudioClock(position: 1, hostTime: 2, pendingDuration: 0.1)
+        let second = IRFFAudioClock(position: 3, hostTime: 4, pendingDuration: 0.2)
+        shared.store(first)
+        XCTAssertEqual(shared.load(), first)
+        shared.store(second)
+        XCTAssertEqual(shared.load(), second)
+    }
+
+    func testSharedClockNeverReturnsATornValue() {
+        let shared = IRFFSharedAudioClock()
+        shared.store(IRFFAudioClock(position: 0, hostTime: 0, pendingDuration: 0))
+        let writerDone = expectation(description: "writer finished")
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            for index in 1...100_000 {
+                let value = Double(index)
+                shared.store(IRFFAudioClock(position: value, hostTime: value, pendingDuration: value))
+            }
+            writerDone.fulfill()
+        }
+        for _ in 0..<100_000 {
+            let clock = shared.load()!
+            XCTAssertEqual(clock.position, clock.hostTime)
+            XCTAssertEqual(clock.position, clock.pendingDuration)
+        }
+        wait(for: [writerDone], timeout: 10)
+    }
+
+    func testRenderHostTimeConversionAndLatencySanitizing() {
+        XCTAssertEqual(IRAudioManagerPolicy.renderHostTime(hostTime: 3_000_000_000,
+                                                           flags: .hostTimeValid,
+                                                           timebaseNumerator: 1,
+                                                           timebaseDenominator: 1)!,
+                       3, accuracy: 1e-12)
+        XCTAssertEqual(IRAudioManagerPolicy.renderHostTime(hostTime: 72_000_000,
+                                                           flags: [.sampleTimeValid, .hostTimeValid],
+                                                           timebaseNumerator: 125,
+                                                           timebaseDenominator: 3)!,
+                       3, accuracy: 1e-12)
+        XCTAssertNil(IRAudioManagerPolicy.renderHostTime(hostTime: 1, flags: .sampleTimeValid, timebaseNumerator: 1, timebaseDenominator: 1))
+        XCTAssertNil(IRAudioManagerPolicy.renderHostTime(hostTime: 1, flags: .hostTimeValid, timebaseNumerator: 1, timebaseDenominator: 0))
+
+        XCTAssertEqual(IRAudioManager.outputLatency(0.008), 0.008)
+        XCTAssertEqual(IRAudioManager.outputLatency(-1), 0)
+        XCTAssertEqual(IRAudioManager.outputLatency(.nan), 0)
+    }
+
+    func testDecoderClockFollowsRenderedSamplesAndFallsBackAfterFlush() {
+        let decoder = IRFFDecoder(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
+                                  videoFormat: .mpeg4,
+                                  videoOutput: nil,
+                                  audioOutput: nil)
+        XCTAssertEqual(decoder.audioTimeClock(atHostTime: 50), 0)
+
+        let samples = [Float](repeating: 0.25, count: 960)
+        samples.withUnsafeBufferPointer {
+            _ = decoder.audioSampleRing.write($0.baseAddress!, count: 960, position: 4, secondsPerSample: 1.0 / 96_000)
+        }
+        var output = [Float](repeating: 0, count: 480)
+        let readCount = output.withUnsafeMutableBufferPointer {
+            decoder.renderAudio(into: $0.baseAddress!, sampleCount: 480, hostTime: 50, outputLatency: 0.01)
+        }
+
+        XCTAssertEqual(readCount, 480)
+        XCTAssertEqual(decoder.audioTimeClock(atHostTime: 50), 3.99, accuracy: 1e-9)
+        XCTAssertEqual(decoder.audioTimeClock(atHostTime: 50.012), 4.002, accuracy: 1e-9)
+        XCTAssertEqual(decoder.audioTimeClock(atHostTime: 60), 4.005, accuracy: 1e-9)
+
+        decoder.audioSampleRing.flush()
+        XCTAssertEqual(decoder.audioTimeClock(atHostTime: 60), 0)
+    }
+}
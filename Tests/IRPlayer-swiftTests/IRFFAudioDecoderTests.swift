@@ -257,9 +257,33 @@ final class IRFFAudioDecoderTests: XCTestCase {
         XCTAssertTrue(IRFFAudioDecoder.shouldDecodeFrame(hasFrame: true, hasPrimaryData: true))
     }
 
-    func testDirectOutputSampleFormatRequiresS16() {
+    func testDirectOutputSampleFormatAcceptsInterleavedFloatAndS16() {
         XCTAssertTrue(IRFFAudioDecoder.canUseDirectOutput(sampleFormat: AV_SAMPLE_FMT_S16))
-        XCTAssertFalse(IRFFAudioDecoder.canUseDirectOutput(sampleFormat: AV_SAMPLE_FMT_FLT))
+        XCTAssertTrue(IRFFAudioDecoder.canUseDirectOutput(sampleFormat: AV_SAMPLE_FMT_FLT))
+        XCTAssertFalse(IRFFAudioDecoder.canUseDirectOutput(sampleFormat: AV_SAMPLE_FMT_FLTP))
         XCTAssertFalse(IRFFAudioDecoder.canUseDirectOutput(sampleFormat: AV_SAMPLE_FMT_NONE))
     }
+
+    func testOnlyMatchingInterleavedFloatSkipsTheResampler() {
+        XCTAssertFalse(IRFFAudioDecoder.requiresResampling(inputSampleFormat: AV_SAMPLE_FMT_FLT,
+                                                           inputSamplingRate: 48_000, inputChannelCount: 2,
+                                                           outputSamplingRate: 48_000, outputChannelCount: 2))
+        XCTAssertTrue(IRFFAudioDecoder.requiresResampling(inputSampleFormat: AV_SAMPLE_FMT_FLTP,
+                                                          inputSamplingRate: 48_000, inputChannelCount: 2,
+                                                          outputSamplingRate: 48_000, outputChannelCount: 2))
+        XCTAssertTrue(IRFFAudioDecoder.requiresResampling(inputSampleFormat: AV_SAMPLE_FMT_FLT,
+                                                          inputSamplingRate: 44_100, inputChannelCount: 2,
+                                                          outputSamplingRate: 48_000, outputChannelCount: 2))
+        XCTAssertTrue(IRFFAudioDecoder.requiresResampling(inputSampleFormat: AV_SAMPLE_FMT_FLT,
+                                                          inputSamplingRate: 48_000, inputChannelCount: 1,
+                                                          outputSamplingRate: 48_000, outputChannelCount: 2))
+        XCTAssertTrue(IRFFAudioDecoder.requiresResampling(inputSampleFormat: AV_SAMPLE_FMT_S16,
+                                                          inputSamplingRate: 48_000, inputChannelCount: 2,
+                                                          outputSamplingRate: 48_000, outputChannelCount: 2))
+    }
+
+    func testResamplerOutputsFloatSamples() {
+        XCTAssertEqual(IRFFAudioDecoder.swrOutputSampleFormat, AV_SAMPLE_FMT_FLT)
+        XCTAssertEqual(IRFFAudioDecoderPolicy.swrOutputSampleFormat, AV_SAMPLE_FMT_FLT)
+    }
 }
@@ -30,14 +30,12 @@ final class IRFFAudioFrameTests: XCTestCase {
         XCTAssertTrue(IRFFAudioFrame.shouldAllocateSampleBuffer(currentCapacity: 3, requiredCapacity: 4))
     }
 
-    func testSetSamplesLengthAllocatesStorageAndResetsOutputOffset() throws {
+    func testSetSamplesLengthAllocatesStorage() throws {
         let frame = IRFFAudioFrame()
-        frame.outputOffset = 8
 
         frame.setSamplesLength(MemoryLayout<Float>.size * 2)
 
         XCTAssertEqual(frame.size, MemoryLayout<Float>.size * 2)
-        XCTAssertEqual(frame.outputOffset, 0)
         let samples = try XCTUnwrap(frame.samples)
         samples[0] = 1.25
         samples[1] = -2.5
@@ -49,24 +47,20 @@ final class IRFFAudioFrameTests: XCTestCase {
         let frame = IRFFAudioFrame()
         frame.setSamplesLength(MemoryLayout<Float>.size * 4)
         let initialSamples = try XCTUnwrap(frame.samples)
-        frame.outputOffset = 2
 
         frame.setSamplesLength(MemoryLayout<Float>.size * 2)
 
         XCTAssertEqual(frame.size, MemoryLayout<Float>.size * 2)
-        XCTAssertEqual(frame.outputOffset, 0)
         XCTAssertTrue(frame.samples == initialSamples)
     }
 
     func testSetSamplesLengthReallocatesStorageWhenCapacityIsTooSmall() throws {
         let frame = IRFFAudioFrame()
         frame.setSamplesLength(MemoryLayout<Float>.size)
-        frame.outputOffset = 2
 
         frame.setSamplesLength(MemoryLayout<Float>.size * 3)
 
         XCTAssertEqual(frame.size, MemoryLayout<Float>.size * 3)
-        XCTAssertEqual(frame.outputOffset, 0)
         let samples = try XCTUnwrap(frame.samples)
         samples[2] = 3.5
         XCTAssertEqual(samples[2], 3.5, accuracy: 0.0001)
@@ -74,24 +68,20 @@ final class IRFFAudioFrameTests: XCTestCase {
 
     func testSetSamplesLengthRejectsInvalidLengthsWithoutAllocatingStorage() {
         let frame = IRFFAudioFrame()
-        frame.outputOffset = 4
 
         frame.setSamplesLength(0)
 
         XCTAssertEqual(frame.size, 0)
-        XCTAssertEqual(frame.outputOffset, 0)
         XCTAssertNil(frame.samples)
     }
 
     func testSetSamplesLengthRejectsInvalidLengthsAndClearsExistingStorage() {
         let frame = IRFFAudioFrame()
         frame.setSamplesLength(MemoryLayout<Float>.size * 2)
-        frame.outputOffset = 4
 
         frame.setSamplesLength(0)
 
         XCTAssertEqual(frame.size, 0)
-        XCTAssertEqual(frame.outputOffset, 0)
         XCTAssertNil(frame.samples)
     }
 
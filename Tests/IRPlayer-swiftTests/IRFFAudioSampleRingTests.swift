@@ -0,0 +1,212 @@
+//
+//  IRFFAudioSampleRingTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFAudioSampleRingTests: XCTestCase {
+
+    func testCapacityCoversRequestedDurationAsPowerOfTwo() {
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.capacity(sampleRate: 48_000, channelCount: 2), 65_536)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.capacity(sampleRate: 44_100, channelCount: 1, duration: 0.05), 4096)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.capacity(sampleRate: 0, channelCount: 2), 4096)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.capacity(sampleRate: .nan, channelCount: 2), 4096)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.capacity(sampleRate: 48_000, channelCount: 2, duration: 1_000), 1 << 20)
+    }
+
+    func testSecondsPerSampleAndMarkerPositions() {
+        let secondsPerSample = IRFFAudioSampleRingPolicy.secondsPerSample(sampleRate: 48_000, channelCount: 2)!
+        XCTAssertEqual(secondsPerSample, 1.0 / 96_000, accuracy: 1e-12)
+        XCTAssertNil(IRFFAudioSampleRingPolicy.secondsPerSample(sampleRate: 48_000, channelCount: 0))
+        XCTAssertNil(IRFFAudioSampleRingPolicy.secondsPerSample(sampleRate: -1, channelCount: 2))
+
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.position(segmentPosition: 2,
+                                                          segmentStart: 100,
+                                                          secondsPerSample: secondsPerSample,
+                                                          sampleIndex: 100 + 9_600),
+                       2.1, accuracy: 1e-9)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.position(segmentPosition: 2,
+                                                          segmentStart: 100,
+                                                          secondsPerSample: secondsPerSample,
+                                                          sampleIndex: 50),
+                       2)
+    }
+
+    func testWritableCountIsBoundedBySpaceAndMarkers() {
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.writableCount(requested: 100, capacity: 64, bufferedCount: 0,
+                                                               segmentCapacity: 4, bufferedSegments: 0), 64)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.writableCount(requested: 10, capacity: 64, bufferedCount: 60,
+                                                               segmentCapacity: 4, bufferedSegments: 1), 4)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.writableCount(requested: 10, capacity: 64, bufferedCount: 0,
+                                                               segmentCapacity: 4, bufferedSegments: 4), 0)
+        XCTAssertEqual(IRFFAudioSampleRingPolicy.writableCount(requested: 0, capacity: 64, bufferedCount: 0,
+                                                               segmentCapacity: 4, bufferedSegments: 0), 0)
+    }
+
+    func testSamplesComeOutInOrderAcrossWrapAround() {
+        let ring = IRFFAudioSampleRing(capacity: 8)
+        var next: Float = 0
+        var expected: Float = 0
+
+        for _ in 0..<5 {
+            let input: [Float] = (0..<6).map { _ in defer { next += 1 }; return next }
+            XCTAssertEqual(input.withUnsafeBufferPointer { ring.write($0.baseAddress!, count: 6, position: 0, secondsPerSample: 0.001) }, 6)
+            var output = [Float](repeating: -1, count: 6)
+            XCTAssertEqual(output.withUnsafeMutableBufferPointer { ring.read(into: $0.baseAddress!, count: 6) }, 6)
+            for sample in output {
+                XCTAssertEqual(sample, expected)
+                expected += 1
+            }
+        }
+        XCTAssertEqual(ring.count, 0)
+    }
+
+    func testWriteStoresOnlyWhatFits() {
+        let ring = IRFFAudioSampleRing(capacity: 8)
+        let input = [Float](repeating: 1, count: 12)
+
+        XCTAssertEqual(input.withUnsafeBufferPointer { ring.write($0.baseAddress!, count: 12, position: 0, secondsPerSample: 0.001) }, 8)
+        XCTAssertEqual(input.withUnsafeBufferPointer { ring.write($0.baseAddress!, count: 4, position: 0.008, secondsPerSample: 0.001) }, 0)
+        XCTAssertEqual(ring.count, 8)
+        XCTAssertEqual(ring.bufferedDuration, 0.008, accuracy: 1e-9)
+    }
+
+    func testPlaybackPositionIsSampleAccurateAcrossMarkers() {
+        let ring = IRFFAudioSampleRing(capacity: 64)
+        let frame = [Float](repeating: 0.5, count: 10)
+        XCTAssertNil(ring.playbackPosition)
+
+        frame.withUnsafeBufferPointer {
+            ring.write($0.baseAddress!, count: 10, position: 1.0, secondsPerSample: 0.01)
+            // A pts jump between frames must show up exactly at the frame boundary.
+            ring.write($0.baseAddress!, count: 10, position: 5.0, secondsPerSample: 0.01)
+        }
+        var output = [Float](repeating: 0, count: 20)
+        output.withUnsafeMutableBufferPointer { buffer in
+            ring.read(into: buffer.baseAddress!, count: 3)
+            XCTAssertEqual(ring.playbackPosition!, 1.03, accuracy: 1e-9)
+            ring.read(into: buffer.baseAddress!, count: 7)
+            XCTAssertEqual(ring.playbackPosition!, 5.0, accuracy: 1e-9)
+            ring.read(into: buffer.baseAddress!, count: 4)
+            XCTAssertEqual(ring.playbackPosition!, 5.04, accuracy: 1e-9)
+        }
+    }
+
+    func testWriteWithoutUsablePositionContinuesPreviousMarker() {
+        let ring = IRFFAudioSampleRing(capacity: 64)
+        let frame = [Float](repeating: 0, count: 10)
+        frame.withUnsafeBufferPointer {
+            ring.write($0.baseAddress!, count: 10, position: 2.0, secondsPerSample: 0.01)
+            ring.write($0.baseAddress!, count: 10, position: .nan, secondsPerSample: 0.01)
+        }
+        var output = [Float](repeating: 0, count: 15)
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 15) }
+
+        XCTAssertEqual(ring.playbackPosition!, 2.15, accuracy: 1e-9)
+    }
+
+    func testShortReadZeroFillsAndCountsOneUnderrunPerDrySpell() {
+        let ring = IRFFAudioSampleRing(capacity: 16)
+        let frame = [Float](repeating: 1, count: 4)
+        var output = [Float](repeating: 7, count: 8)
+
+        // Nothing written yet: silence, but not an underrun.
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 8) }
+        XCTAssertEqual(output, [Float](repeating: 0, count: 8))
+        XCTAssertEqual(ring.underrunCount, 0)
+
+        frame.withUnsafeBufferPointer { _ = ring.write($0.baseAddress!, count: 4, position: 0, secondsPerSample: 0.001) }
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 2) }
+        output = [Float](repeating: 7, count: 8)
+        XCTAssertEqual(output.withUnsafeMutableBufferPointer { ring.read(into: $0.baseAddress!, count: 8) }, 2)
+        XCTAssertEqual(output, [1, 1, 0, 0, 0, 0, 0, 0])
+        XCTAssertEqual(ring.underrunCount, 1)
+
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 8) }
+        XCTAssertEqual(ring.underrunCount, 1)
+    }
+
+    func testRunningDryAtEndOfStreamIsNotAnUnderrun() {
+        let ring = IRFFAudioSampleRing(capacity: 16)
+        let frame = [Float](repeating: 1, count: 4)
+        var output = [Float](repeating: 0, count: 8)
+        frame.withUnsafeBufferPointer { _ = ring.write($0.baseAddress!, count: 4, position: 0, secondsPerSample: 0.001) }
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 2) }
+
+        ring.markEndOfStream()
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 8) }
+
+        XCTAssertEqual(ring.underrunCount, 0)
+    }
+
+    func testFlushDropsSamplesAndClockButKeepsUnderrunCount() {
+        let ring = IRFFAudioSampleRing(capacity: 16)
+        let frame = [Float](repeating: 1, count: 4)
+        var output = [Float](repeating: 0, count: 8)
+        frame.withUnsafeBufferPointer { _ = ring.write($0.baseAddress!, count: 4, position: 3, secondsPerSample: 0.001) }
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 2) }
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 8) }
+        frame.withUnsafeBufferPointer { _ = ring.write($0.baseAddress!, count: 4, position: 4, secondsPerSample: 0.001) }
+        XCTAssertEqual(ring.underrunCount, 1)
+
+        ring.flush()
+
+        XCTAssertEqual(ring.count, 0)
+        XCTAssertNil(ring.playbackPosition)
+        XCTAssertEqual(ring.underrunCount, 1)
+        frame.withUnsafeBufferPointer { _ = ring.write($0.baseAddress!, count: 4, position: 10, secondsPerSample: 0.001) }
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 1) }
+        XCTAssertEqual(ring.playbackPosition!, 10.001, accuracy: 1e-9)
+
+        ring.resetUnderrunCount()
+        XCTAssertEqual(ring.underrunCount, 0)
+    }
+
+    func testConcurrentProducerAndConsumerSeeEverySampleInOrder() {
+        let ring = IRFFAudioSampleRing(capacity: 256, segmentCapacity: 8)
+        let total = 200_000
+        let producerDone = expectation(description: "producer wrote every sample")
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            var next = 0
+            var chunk = [Float](repeating: 0, count: 37)
+            while next < total {
+                let count = min(chunk.count, total - next)
+                for index in 0..<count {
+                    chunk[index] = Float(next + index)
+                }
+                let position = Double(next)
+                next += chunk.withUnsafeBufferPointer {
+                    ring.write($0.baseAddress!, count: count, position: position, secondsPerSample: 1)
+                }
+            }
+            producerDone.fulfill()
+        }
+
+        var expected = 0
+        var output = [Float](repeating: 0, count: 64)
+        let deadline = Date().addingTimeInterval(10)
+        while expected < total, Date() < deadline {
+            let read = output.withUnsafeMutableBufferPointer { ring.read(into: $0.baseAddress!, count: 64) }
+            for index in 0..<read {
+                XCTAssertEqual(output[index], Float(expected))
+                expected += 1
+            }
+            if read > 0 {
+                XCTAssertEqual(ring.playbackPosition!, Double(expected), accuracy: 1e-9)
+            }
+        }
+
+        wait(for: [producerDone], timeout: 10)
+        XCTAssertEqual(expected, total)
+    }
+
+    func testDecoderWrappersRemainSourceCompatible() {
+        XCTAssertEqual(IRFFDecoder.audioFeedInterval, IRFFDecoderAudioPolicy.audioFeedInterval)
+        XCTAssertLessThan(IRFFDecoder.audioFeedInterval, IRFFAudioSampleRingPolicy.defaultBufferDuration)
+    }
+}
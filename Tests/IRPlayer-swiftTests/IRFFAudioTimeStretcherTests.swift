@@ -0,0 +1,199 @@
+//
+//  IRFFAudioTimeStretcherTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFAudioTimeStretcherTests: XCTestCase {
+    private let sampleRate = 8_000.0
+
+    func testWindowSearchAndHopFollowSampleRate() {
+        let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 2)
+
+        XCTAssertEqual(stretcher.windowFrameCount, 160)
+        XCTAssertEqual(stretcher.hopFrameCount, 80)
+        XCTAssertEqual(stretcher.searchFrameCount, 40)
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.windowFrameCount(sampleRate: 48_000), 960)
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.windowFrameCount(sampleRate: .nan), 16)
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.searchFrameCount(sampleRate: 0), 1)
+    }
+
+    func testSearchStartsAtNominalAndAlternatesOutward() {
+        XCTAssertEqual((0..<7).map(IRFFAudioTimeStretchPolicy.searchOffset(at:)), [0, -1, 1, -2, 2, -3, 3])
+    }
+
+    func testFadeWeightsAreSymmetricAndComplementary() {
+        let hop = 80
+        for frame in 0..<hop {
+            let fadeIn = IRFFAudioTimeStretchPolicy.fadeInWeight(frame: frame, hopFrameCount: hop)
+            let mirrored = IRFFAudioTimeStretchPolicy.fadeInWeight(frame: hop - 1 - frame, hopFrameCount: hop)
+            XCTAssertEqual(fadeIn + mirrored, 1, accuracy: 1e-6)
+        }
+        XCTAssertLessThan(IRFFAudioTimeStretchPolicy.fadeInWeight(frame: 0, hopFrameCount: hop), 0.001)
+        XCTAssertGreaterThan(IRFFAudioTimeStretchPolicy.fadeInWeight(frame: hop - 1, hopFrameCount: hop), 0.999)
+    }
+
+    func testVectorKernelsMatchScalarReference() {
+        let count = 37
+        let a = (0..<count).map { Float($0) * 0.25 - 3 }
+        let b = (0..<count).map { Float(count - $0) * 0.125 }
+        let weights = (0..<count).map { Float($0) / Float(count) }
+        var expectedDot: Float = 0
+        for index in 0..<count {
+            expectedDot += a[index] * b[index]
+        }
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.dot(a, b, count: count), expectedDot, accuracy: 1e-3)
+
+        var output = [Float](repeating: 0, count: count)
+        output.withUnsafeMutableBufferPointer {
+            IRFFAudioTimeStretchPolicy.crossfade(from: a, to: b, weights: weights, into: $0.baseAddress!, count: count)
+        }
+        for index in 0..<count {
+            XCTAssertEqual(output[index], a[index] + (b[index] - a[index]) * weights[index], accuracy: 1e-6)
+        }
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.similarity(correlation: 3, energy: 0), 0)
+        XCTAssertEqual(IRFFAudioTimeStretchPolicy.similarity(correlation: 3, energy: 4), 1.5)
+    }
+
+    func testUnityRateReproducesInput() {
+        let input = stereoTestSignal(frameCount: 4_000)
+        let (output, frameCount, position) = stretch(input, rate: 1)
+
+        XCTAssertEqual(frameCount, 3_840)
+        XCTAssertEqual(position, 10)
+        for index in 0..<(frameCount * 2) {
+            XCTAssertEqual(output[index], input[index], accuracy: 1e-6)
+        }
+    }
+
+    func testDoubleRateMatchesGoldenOutput() {
+        let (output, frameCount, position) = stretch(stereoTestSignal(frameCount: 4_000), rate: 2)
+
+        XCTAssertEqual(frameCount, 1_920)
+        XCTAssertEqual(position, 10)
+        XCTAssertEqual(energy(output), 439.2315, accuracy: 0.01)
+        let golden: [Float] = [-0.507588, 0.055767, -0.694979, -0.147633, -0.645169, -0.31212, -0.426867, -0.394725]
+        for (offset, expected) in golden.enumerated() {
+            XCTAssertEqual(output[1_600 + offset], expected, accuracy: 1e-4)
+        }
+        XCTAssertEqual(output[161], -0.320235, accuracy: 1e-4)
+        XCTAssertEqual(output[1_001], -0.038415, accuracy: 1e-4)
+        XCTAssertEqual(output[3_839], -0.299623, accuracy: 1e-4)
+    }
+
+    func testHalfAndOneAndAHalfRatesMatchGoldenOutput() {
+        let slow = stretch(stereoTestSignal(frameCount: 4_000), rate: 0.5)
+        XCTAssertEqual(slow.frameCount, 7_680)
+        XCTAssertEqual(energy(slow.output), 1_797.632, accuracy: 0.02)
+        XCTAssertEqual(slow.output[1_001], 0.117743, accuracy: 1e-4)
+        XCTAssertEqual(slow.output[15_359], -0.390499, accuracy: 1e-4)
+
+        let fast = stretch(stereoTestSignal(frameCount: 4_000), rate: 1.5)
+        XCTAssertEqual(fast.frameCount, 2_560)
+        XCTAssertEqual(energy(fast.output), 599.1772, accuracy: 0.01)
+        XCTAssertEqual(fast.output[1_001], 0.312483, accuracy: 1e-4)
+        XCTAssertEqual(fast.output[5_119], 0.316445, accuracy: 1e-4)
+    }
+
+    func testStretchKeepsPitch() {
+        for (rate, expectedFrames) in [(2.0, 3_920), (0.5, 15_680), (4.0, 2_000)] {
+            let input = (0..<8_000).map { Float(0.5 * sin(2 * Double.pi * 440 * Double($0) / sampleRate)) }
+            let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 1, rate: rate)
+            var output = [Float](repeating: 0, count: 20_000)
+            input.withUnsafeBufferPointer { stretcher.append($0.baseAddress!, frameCount: input.count, position: 0) }
+            let frameCount = output.withUnsafeMutableBufferPointer {
+                stretcher.process(into: $0.baseAddress!, frameCapacity: $0.count).frameCount
+            }
+
+            XCTAssertEqual(frameCount, expectedFrames)
+            var crossings = 0
+            for index in 1..<frameCount where output[index - 1] < 0 && output[index] >= 0 {
+                crossings += 1
+            }
+            XCTAssertEqual(Double(crossings) / (Double(frameCount) / sampleRate), 440, accuracy: 6)
+        }
+    }
+
+    func testChunkedInputGivesTheSameOutputAndAdvancingPositions() {
+        let input = stereoTestSignal(frameCount: 4_000)
+        let whole = stretch(input, rate: 1.5)
+        let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 2, rate: 1.5)
+        var chunked: [Float] = []
+        var buffer = [Float](repeating: 0, count: 2 * 160)
+
+        input.withUnsafeBufferPointer { input in
+            for start in stride(from: 0, to: 4_000, by: 333) {
+                let frames = min(333, 4_000 - start)
+                stretcher.append(input.baseAddress! + start * 2, frameCount: frames, position: 10 + Double(start) / sampleRate)
+                while true {
+                    let produced = buffer.withUnsafeMutableBufferPointer {
+                        stretcher.process(into: $0.baseAddress!, frameCapacity: 160)
+                    }
+                    guard produced.frameCount > 0 else { break }
+                    // Each output frame stands for 1.5 input frames.
+                    XCTAssertEqual(produced.position, 10 + Double(chunked.count / 2) * 1.5 / sampleRate, accuracy: 1e-9)
+                    chunked.append(contentsOf: buffer[0..<(produced.frameCount * 2)])
+                }
+            }
+        }
+
+        XCTAssertEqual(chunked.count, whole.frameCount * 2)
+        for index in 0..<chunked.count {
+            XCTAssertEqual(chunked[index], whole.output[index], accuracy: 1e-6)
+        }
+    }
+
+    func testResetDropsInputAndReanchorsPosition() {
+        let input = stereoTestSignal(frameCount: 1_000)
+        let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 2, rate: 2)
+        var output = [Float](repeating: 0, count: 4_000)
+        input.withUnsafeBufferPointer { stretcher.append($0.baseAddress!, frameCount: 1_000, position: 3) }
+        XCTAssertEqual(stretcher.bufferedFrameCount, 1_000)
+
+        stretcher.reset()
+        XCTAssertEqual(stretcher.bufferedFrameCount, 0)
+        XCTAssertEqual(output.withUnsafeMutableBufferPointer { stretcher.process(into: $0.baseAddress!, frameCapacity: 2_000).frameCount }, 0)
+
+        input.withUnsafeBufferPointer { stretcher.append($0.baseAddress!, frameCount: 1_000, position: 7) }
+        let produced = output.withUnsafeMutableBufferPointer { stretcher.process(into: $0.baseAddress!, frameCapacity: 2_000) }
+        XCTAssertGreaterThan(produced.frameCount, 0)
+        XCTAssertEqual(produced.position, 7)
+    }
+
+    func testRateIsClampedToSupportedRange() {
+        let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 1, rate: 10)
+        XCTAssertEqual(stretcher.rate, 4)
+        stretcher.rate = 0.1
+        XCTAssertEqual(stretcher.rate, 0.5)
+        stretcher.rate = .nan
+        XCTAssertEqual(stretcher.rate, 1)
+    }
+
+    private func stereoTestSignal(frameCount: Int) -> [Float] {
+        var samples = [Float](repeating: 0, count: frameCount * 2)
+        for frame in 0..<frameCount {
+            let time = Double(frame) / sampleRate
+            samples[frame * 2] = Float(0.5 * sin(2 * Double.pi * 440 * time) + 0.25 * sin(2 * Double.pi * 1_130 * time))
+            samples[frame * 2 + 1] = Float(0.4 * sin(2 * Double.pi * 660 * time + 0.3))
+        }
+        return samples
+    }
+
+    private func stretch(_ input: [Float], rate: Double) -> (output: [Float], frameCount: Int, position: TimeInterval) {
+        let stretcher = IRFFAudioTimeStretcher(sampleRate: sampleRate, channelCount: 2, rate: rate)
+        var output = [Float](repeating: 0, count: input.count * 3)
+        input.withUnsafeBufferPointer { stretcher.append($0.baseAddress!, frameCount: input.count / 2, position: 10) }
+        let produced = output.withUnsafeMutableBufferPointer {
+            stretcher.process(into: $0.baseAddress!, frameCapacity: $0.count / 2)
+        }
+        return (output, produced.frameCount, produced.position)
+    }
+
+    private func energy(_ samples: [Float]) -> Double {
+        return samples.reduce(0) { $0 + Double($1) * Double($1) }
+    }
+}
@@ -0,0 +1,67 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFDecoderBufferingPolicyTests: XCTestCase {
+
+    func testPresetsKeepTheFormerDecoderThresholds() {
+        XCTAssertEqual(IRBufferingPolicy.standard.enterThreshold, 0.2)
+        XCTAssertTrue(IRBufferingPolicy.standard.waitsForPlayableBufferInterval)
+        XCTAssertEqual(IRBufferingPolicy.standard.timeout, 2.0)
+        XCTAssertEqual(IRBufferingPolicy.standard.timeoutResumeThreshold, 0.3)
+
+        XCTAssertEqual(IRBufferingPolicy.live.enterThreshold, 0.05)
+        XCTAssertFalse(IRBufferingPolicy.live.waitsForPlayableBufferInterval)
+        XCTAssertEqual(IRBufferingPolicy.live.timeout, 1.0)
+        XCTAssertEqual(IRBufferingPolicy.live.timeoutResumeThreshold, 0.1)
+
+        let decoder = IRPlayerDecoder()
+        XCTAssertEqual(decoder.ffmpegBufferingPolicy, .standard)
+        XCTAssertEqual(decoder.ffmpegLiveBufferingPolicy, .live)
+        XCTAssertEqual(decoder.ffmpegInputProfile, .standard)
+    }
+
+    func testBufferingStartsAtTheEnterThresholdUnlessInputEnded() {
+        XCTAssertTrue(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0.2, endOfFile: false, policy: .standard))
+        XCTAssertFalse(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0.21, endOfFile: false, policy: .standard))
+        XCTAssertFalse(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0, endOfFile: true, policy: .standard))
+        XCTAssertFalse(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0.1, endOfFile: false, policy: .live))
+        XCTAssertTrue(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0.05, endOfFile: false, policy: .live))
+        XCTAssertTrue(IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: .nan, endOfFile: false, policy: .live))
+    }
+
+    func testBufferingEndsOnPlayableIntervalEndOfFileOrTimeout() {
+        func exits(_ buffered: TimeInterval, elapsed: TimeInterval, endOfFile: Bool = false,
+                   policy: IRBufferingPolicy = .standard) -> Bool {
+            return IRFFDecoderBufferingPolicy.shouldExitBuffering(bufferedDuration: buffered,
+                                                                  minBufferedDuration: 2,
+                                                                  elapsed: elapsed,
+                                                                  endOfFile: endOfFile,
+                                                                  policy: policy)
+        }
+
+        XCTAssertTrue(exits(2, elapsed: 0))
+        XCTAssertFalse(exits(1.9, elapsed: 1))
+        XCTAssertTrue(exits(0, elapsed: 0, endOfFile: true))
+        XCTAssertFalse(exits(0.29, elapsed: 2.5))
+        XCTAssertTrue(exits(0.3, elapsed: 2.5))
+        XCTAssertFalse(exits(0.3, elapsed: 2))
+        // Live streams do not wait for the playable interval.
+        XCTAssertTrue(exits(0, elapsed: 0, policy: .live))
+
+        let patient = IRBufferingPolicy(enterThreshold: 0.5, waitsForPlayableBufferInterval: true,
+                                        timeout: 10, timeoutResumeThreshold: 1)
+        XCTAssertFalse(exits(1, elapsed: 5, policy: patient))
+        XCTAssertTrue(exits(1, elapsed: 11, policy: patient))
+    }
+
+    func testDecoderWrappersRemainSourceCompatible() {
+        XCTAssertEqual(
+            IRFFDecoder.shouldEnterBuffering(bufferedDuration: 0.1, endOfFile: false, policy: .standard),
+            IRFFDecoderBufferingPolicy.shouldEnterBuffering(bufferedDuration: 0.1, endOfFile: false, policy: .standard)
+        )
+        XCTAssertEqual(
+            IRFFDecoder.shouldExitBuffering(bufferedDuration: 0.3, minBufferedDuration: 2, elapsed: 3, endOfFile: false, policy: .standard),
+            IRFFDecoderBufferingPolicy.shouldExitBuffering(bufferedDuration: 0.3, minBufferedDuration: 2, elapsed: 3, endOfFile: false, policy: .standard)
+        )
+    }
+}
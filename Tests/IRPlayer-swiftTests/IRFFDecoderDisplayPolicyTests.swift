@@ -32,9 +32,13 @@ final class IRFFDecoderDisplayPolicyTests: XCTestCase {
         )
     }
 
-    func testStandaloneVideoSleepDurationUsesFrameDurationOrFPSFallback() {
-        XCTAssertEqual(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: 0.04, fps: 25), 0.04)
-        XCTAssertEqual(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: 0, fps: 25), 0.04)
+    func testWallClockVideoSleepDurationWaitsOnlyForFramesNotYetDue() {
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.wallClockVideoSleepDuration(targetHostTime: 100.04, hostTime: 100.01)!,
+                       0.03, accuracy: 1e-9)
+        XCTAssertNil(IRFFDecoderDisplayPolicy.wallClockVideoSleepDuration(targetHostTime: 100, hostTime: 100))
+        XCTAssertNil(IRFFDecoderDisplayPolicy.wallClockVideoSleepDuration(targetHostTime: 99.9, hostTime: 100))
+        XCTAssertNil(IRFFDecoderDisplayPolicy.wallClockVideoSleepDuration(targetHostTime: .infinity, hostTime: 100))
+        XCTAssertEqual(IRFFDecoder.wallClockVideoSleepDuration(targetHostTime: 5, hostTime: 4), 1)
     }
 
     func testVideoSleepDurationRejectsInvalidTimingFallbacks() {
@@ -46,10 +50,6 @@ final class IRFFDecoderDisplayPolicyTests: XCTestCase {
                 fps: 0
             )
         )
-        XCTAssertNil(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: 0, fps: 0))
-        XCTAssertEqual(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: .nan, fps: 25), 0.04)
-        XCTAssertEqual(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: .infinity, fps: 25), 0.04)
-        XCTAssertEqual(IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: 0.04, fps: 0), 0.04)
     }
 
     func testShouldAcceptVideoFramePreservesForwardProgressOrdering() {
@@ -118,4 +118,80 @@ final class IRFFDecoderDisplayPolicyTests: XCTestCase {
         XCTAssertFalse(IRFFDecoderDisplayPolicy.shouldFinishDisplay(endOfFile: true, videoDecoderEmpty: false))
         XCTAssertTrue(IRFFDecoderDisplayPolicy.shouldFinishDisplay(endOfFile: true, videoDecoderEmpty: true))
     }
+
+    func testFrameWaitIntervalCoversTwoFramesWithinBounds() {
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitInterval(fps: 30), 2.0 / 30.0, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitInterval(fps: 240), 0.02, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitInterval(fps: 5), 0.1, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitInterval(fps: 0), 0.1, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitInterval(fps: .nan), 0.1, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoder.frameWaitInterval(fps: 30), IRFFDecoderDisplayPolicy.frameWaitInterval(fps: 30))
+    }
+
+    func testFrameWaitBlocksUntilTheNextFrameIsDue() {
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: 100.03, hostTime: 100, fps: 30),
+                       0.03, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: 105, hostTime: 100, fps: 30),
+                       IRFFDecoderDisplayPolicy.maxFrameWaitInterval, accuracy: 0.0001)
+        // Already due, or nothing to pace against: fall back to the starvation wait.
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: 99.9, hostTime: 100, fps: 30),
+                       2.0 / 30.0, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: nil, hostTime: 100, fps: 30),
+                       2.0 / 30.0, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.frameWaitDuration(dueHostTime: .nan, hostTime: 100, fps: 30),
+                       2.0 / 30.0, accuracy: 0.0001)
+    }
+
+    func testVideoLagMeasuresFromTheEndOfTheFrameWindow() {
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.videoLag(framePosition: 10, frameDuration: 0.04, audioTimeClock: 10.5)!,
+                       0.46, accuracy: 0.0001)
+        XCTAssertEqual(IRFFDecoderDisplayPolicy.videoLag(framePosition: 10, frameDuration: .nan, audioTimeClock: 9.5)!,
+                       -0.5, accuracy: 0.0001)
+        XCTAssertNil(IRFFDecoderDisplayPolicy.videoLag(framePosition: .nan, frameDuration: 0.04, audioTimeClock: 10))
+        XCTAssertNil(IRFFDecoderDisplayPolicy.videoLag(framePosition: 10, frameDuration: 0.04, audioTimeClock: .infinity))
+    }
+
+    func testLateFramesAreDroppedOnlyPastToleranceAndUpToTheConsecutiveCap() {
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(framePosition: 10,
+                                                                         frameDuration: 0.04,
+                                                                         audioTimeClock: 10.06,
+                                                                         consecutiveDrops: 0))
+        XCTAssertTrue(IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(framePosition: 10,
+                                                                        frameDuration: 0.04,
+                                                                        audioTimeClock: 10.2,
+                                                                        consecutiveDrops: 0))
+        XCTAssertTrue(IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(
+            framePosition: 10,
+            frameDuration: 0.04,
+            audioTimeClock: 12,
+            consecutiveDrops: IRFFDecoderDisplayPolicy.maxConsecutiveLateDrops - 1
+        ))
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(
+            framePosition: 10,
+            frameDuration: 0.04,
+            audioTimeClock: 12,
+            consecutiveDrops: IRFFDecoderDisplayPolicy.maxConsecutiveLateDrops
+        ))
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(framePosition: .nan,
+                                                                         frameDuration: 0.04,
+                                                                         audioTimeClock: 12,
+                                                                         consecutiveDrops: 0))
+    }
+
+    func testNonReferenceSkippingUsesHysteresis() {
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: 0.3, currentlySkipping: false))
+        XCTAssertTrue(IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: 0.6, currentlySkipping: false))
+        XCTAssertTrue(IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: 0.3, currentlySkipping: true))
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: 0.05, currentlySkipping: true))
+        XCTAssertFalse(IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: nil, currentlySkipping: true))
+    }
+
+    func testLateFrameWrappersRemainSourceCompatible() {
+        XCTAssertEqual(IRFFDecoder.videoLag(framePosition: 1, frameDuration: 0.04, audioTimeClock: 2),
+                       IRFFDecoderDisplayPolicy.videoLag(framePosition: 1, frameDuration: 0.04, audioTimeClock: 2))
+        XCTAssertEqual(IRFFDecoder.shouldDropLateVideoFrame(framePosition: 1, frameDuration: 0.04, audioTimeClock: 2, consecutiveDrops: 0),
+                       IRFFDecoderDisplayPolicy.shouldDropLateVideoFrame(framePosition: 1, frameDuration: 0.04, audioTimeClock: 2, consecutiveDrops: 0))
+        XCTAssertEqual(IRFFDecoder.skipsNonReferenceFrames(lag: 1, currentlySkipping: false),
+                       IRFFDecoderDisplayPolicy.skipsNonReferenceFrames(lag: 1, currentlySkipping: false))
+    }
 }
@@ -65,10 +65,6 @@ final class IRFFDecoderOperationTests: XCTestCase {
                 fps: 25
             )
         )
-        XCTAssertEqual(
-            IRFFDecoder.standaloneVideoSleepDuration(frameDuration: 0.04, fps: 25),
-            IRFFDecoderDisplayPolicy.standaloneVideoSleepDuration(frameDuration: 0.04, fps: 25)
-        )
         XCTAssertEqual(
             IRFFDecoder.videoFrameOrderingPosition(1.25),
             IRFFDecoderDisplayPolicy.videoFrameOrderingPosition(1.25)
@@ -78,6 +78,17 @@ final class IRFFDecoderSeekPolicyTests: XCTestCase {
         )
     }
 
+    func testAccurateSeekShowsTheFrameCoveringTheTargetAndEverythingAfter() {
+        XCTAssertTrue(IRFFDecoderSeekPolicy.presentsFrame(position: 1, duration: 0.04, seekTarget: nil))
+        XCTAssertFalse(IRFFDecoderSeekPolicy.presentsFrame(position: 4.96, duration: 0.04, seekTarget: 5))
+        XCTAssertTrue(IRFFDecoderSeekPolicy.presentsFrame(position: 4.98, duration: 0.04, seekTarget: 5))
+        XCTAssertTrue(IRFFDecoderSeekPolicy.presentsFrame(position: 5, duration: 0.04, seekTarget: 5))
+        XCTAssertTrue(IRFFDecoderSeekPolicy.presentsFrame(position: 5, duration: 0, seekTarget: 5))
+        XCTAssertFalse(IRFFDecoderSeekPolicy.presentsFrame(position: 4.99, duration: -1, seekTarget: 5))
+        XCTAssertEqual(IRFFDecoder.presentsFrame(position: 4.98, duration: 0.04, seekTarget: 5),
+                       IRFFDecoderSeekPolicy.presentsFrame(position: 4.98, duration: 0.04, seekTarget: 5))
+    }
+
     func testResumeSeekTargetRestartsOnlyFinishedPlayback() {
         XCTAssertNil(IRFFDecoderSeekPolicy.resumeSeekTarget(playbackFinished: false))
         XCTAssertEqual(IRFFDecoderSeekPolicy.resumeSeekTarget(playbackFinished: true), 0)
@@ -0,0 +1,59 @@
+//
+//  IRFFDecoderThreadingPolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFDecoderThreadingPolicyTests: XCTestCase {
+
+    func testAutomaticThreadCountFollowsActiveCoresWithinBounds() {
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: .automatic, activeProcessorCount: 6), 6)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: .automatic, activeProcessorCount: 0), 1)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: .automatic, activeProcessorCount: 64), 16)
+    }
+
+    func testExplicitThreadCountOverridesCoreCount() {
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: IRDecoderThreading(threadCount: 3), activeProcessorCount: 8), 3)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: .singleThreaded, activeProcessorCount: 8), 1)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadCount(for: IRDecoderThreading(threadCount: -2), activeProcessorCount: 4), 4)
+    }
+
+    func testThreadTypeMapsToFFmpegFlags() {
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadType(for: .automatic), FF_THREAD_FRAME | FF_THREAD_SLICE)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadType(for: IRDecoderThreading(threadType: .frame)), FF_THREAD_FRAME)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadType(for: IRDecoderThreading(threadType: .slice)), FF_THREAD_SLICE)
+    }
+
+    func testLowLatencyLiveProfileMapsToSliceThreading() {
+        let live = IRFFDecoderThreadingPolicy.threading(.automatic, for: .lowLatencyLive)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threadType(for: live), FF_THREAD_SLICE)
+        XCTAssertEqual(live.threadCount, 0)
+
+        let frame = IRDecoderThreading(threadCount: 3, threadType: .frame)
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threading(frame, for: .lowLatencyLive),
+                       IRDecoderThreading(threadCount: 3, threadType: .slice))
+        XCTAssertEqual(IRFFDecoderThreadingPolicy.threading(frame, for: .standard), frame)
+    }
+
+    func testApplyWritesThreadSettingsToCodecContext() throws {
+        var codecContext = avcodec_alloc_context3(nil)
+        defer { avcodec_free_context(&codecContext) }
+        let context = try XCTUnwrap(codecContext)
+
+        IRFFDecoderThreadingPolicy.apply(IRDecoderThreading(threadCount: 0, threadType: .slice), to: context, activeProcessorCount: 4)
+
+        XCTAssertEqual(context.pointee.thread_count, 4)
+        XCTAssertEqual(context.pointee.thread_type, FF_THREAD_SLICE)
+    }
+
+    func testPlayerDecoderDefaultsToAutomaticThreading() {
+        XCTAssertEqual(IRPlayerDecoder.defaultDecoder().ffmpegVideoThreading, .automatic)
+        XCTAssertEqual(IRPlayerDecoder.FFmpegDecoder().ffmpegVideoThreading, .automatic)
+    }
+}
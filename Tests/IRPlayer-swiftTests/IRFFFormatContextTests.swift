@@ -155,6 +155,74 @@ final class IRFFFormatContextTests: XCTestCase {
         XCTAssertEqual(selected, videoOpen)
     }
 
+    func testVideoOnlySetupFailsOnlyOnVideoError() {
+        let streamNotFound = NSError(
+            domain: "video stream not found",
+            code: Int(IRFFDecoderErrorCode.streamNotFound.rawValue)
+        )
+        let audioOpen = NSError(
+            domain: "audio",
+            code: Int(IRFFDecoderErrorCode.codecOpen2.rawValue)
+        )
+
+        XCTAssertNil(IRFFFormatContext.setupError(videoError: nil, audioError: nil, videoOnly: true))
+        XCTAssertEqual(IRFFFormatContext.setupError(videoError: streamNotFound, audioError: nil, videoOnly: true), streamNotFound)
+        XCTAssertEqual(IRFFFormatContext.setupError(videoError: streamNotFound, audioError: audioOpen, videoOnly: false), audioOpen)
+        XCTAssertNil(IRFFFormatContext.setupError(videoError: streamNotFound, audioError: nil, videoOnly: false))
+    }
+
+    func testOpenInputOptionsRestrictVideoOnlyRTSPToVideoMedia() {
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .rtsp, videoOnly: false), ["rtsp_transport": "tcp"])
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .rtsp, videoOnly: true),
+                       ["rtsp_transport": "tcp", "allowed_media_types": "video"])
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .flv, videoOnly: true), [:])
+    }
+
+    func testLowLatencyProfileAddsDemuxerLimits() {
+        XCTAssertEqual(
+            IRFFFormatContext.openInputOptions(videoFormat: .rtsp, videoOnly: false, profile: .lowLatencyLive),
+            [
+                "rtsp_transport": "tcp",
+                "fflags": "nobuffer",
+                "probesize": "65536",
+                "analyzeduration": "500000",
+                "max_delay": "500000",
+                "reorder_queue_size": "0"
+            ]
+        )
+        // reorder_queue_size is an RTSP option; the rest applies to any demuxer.
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .flv, videoOnly: false, profile: .lowLatencyLive).count, 4)
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .rtsp, videoOnly: false, profile: .standard), ["rtsp_transport": "tcp"])
+
+        let invalid = IRDecoderInputProfile(probeSize: 16, analyzeDuration: -1, maxDelay: .infinity, reorderQueueSize: -1)
+        XCTAssertEqual(IRFFFormatContext.openInputOptions(videoFormat: .rtsp, videoOnly: false, profile: invalid), ["rtsp_transport": "tcp"])
+    }
+
+    func testLowLatencyProfileOpensVideoStandIn() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+        context.inputProfile = .lowLatencyLive
+        context.videoOnly = true
+
+        context.setupSync()
+
+        XCTAssertNil(context.error)
+        XCTAssertTrue(context.videoEnable)
+        XCTAssertEqual(context.videoPresentationSize, CGSize(width: videoStandInWidth, height: videoStandInHeight))
+        XCTAssertEqual(context.videoFPS, 25, accuracy: 0.01)
+        context.destroy()
+    }
+
+    func testVideoOnlyDiscardsEverythingButVideoStreams() {
+        XCTAssertFalse(IRFFFormatContext.discardsStream(codecType: AVMEDIA_TYPE_AUDIO, videoOnly: false))
+        XCTAssertFalse(IRFFFormatContext.discardsStream(codecType: AVMEDIA_TYPE_VIDEO, videoOnly: true))
+        XCTAssertTrue(IRFFFormatContext.discardsStream(codecType: AVMEDIA_TYPE_AUDIO, videoOnly: true))
+        XCTAssertTrue(IRFFFormatContext.discardsStream(codecType: AVMEDIA_TYPE_SUBTITLE, videoOnly: true))
+    }
+
     func testVideoAspectUsesFiniteRatioAndFallsBackForInvalidDimensions() {
         XCTAssertEqual(IRFFFormatContext.videoAspect(width: 1920, height: 1080), 16.0 / 9.0, accuracy: 0.0001)
         XCTAssertEqual(IRFFFormatContext.videoAspect(width: 0, height: 1080), 0)
@@ -213,6 +281,73 @@ final class IRFFFormatContextTests: XCTestCase {
         context.seekFile(withFFTimebase: 1)
     }
 
+    func testStreamTimestampRoundsPositionsBackOntoStreamTicks() {
+        XCTAssertEqual(IRFFFormatContext.streamTimestamp(for: 5, timebase: 0.04), 125)
+        XCTAssertEqual(IRFFFormatContext.streamTimestamp(for: 3 * (1.0 / 30_000), timebase: 1.0 / 30_000), 3)
+        XCTAssertNil(IRFFFormatContext.streamTimestamp(for: -1, timebase: 0.04))
+        XCTAssertNil(IRFFFormatContext.streamTimestamp(for: .nan, timebase: 0.04))
+        XCTAssertNil(IRFFFormatContext.streamTimestamp(for: 1, timebase: 0))
+    }
+
+    func testReadingIndexesKeyFramesAndSeekLandsOnTheOneBeforeTheTarget() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+        context.setupSync()
+        XCTAssertNil(context.error)
+
+        var packet = AVPacket()
+        while context.readFrame(&packet) >= 0 {
+            av_packet_unref(&packet)
+        }
+        // Every YUV4MPEG frame is a key frame.
+        XCTAssertEqual(context.videoKeyFrameIndex.count, 250)
+        XCTAssertEqual(context.videoKeyFrameIndex.keyFrame(atOrBefore: 5.03) ?? -1, 5, accuracy: 0.0001)
+
+        context.seekFile(withFFTimebase: 5.03)
+        XCTAssertGreaterThanOrEqual(context.readFrame(&packet), 0)
+        XCTAssertEqual(IRFFFrameTime.packetPosition(pts: packet.pts, dts: packet.dts, timebase: context.videoTimebase),
+                       5, accuracy: 0.0001)
+        av_packet_unref(&packet)
+        context.destroy()
+    }
+
+    func testSeekPastThePartialIndexLandsNearTheTarget() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+        context.setupSync()
+        XCTAssertNil(context.error)
+
+        var packet = AVPacket()
+        for _ in 0..<50 {
+            XCTAssertGreaterThanOrEqual(context.readFrame(&packet), 0)
+            av_packet_unref(&packet)
+        }
+        XCTAssertFalse(context.videoKeyFrameIndex.isComplete)
+        XCTAssertNil(context.videoKeyFrameIndex.coveredKeyFrame(atOrBefore: 8))
+
+        // YUV4MPEG has no index of its own: the last key frame read is near 2 s, but
+        // the seek must not fall back to it.
+        context.seekFile(withFFTimebase: 8)
+        XCTAssertGreaterThanOrEqual(context.readFrame(&packet), 0)
+        XCTAssertEqual(IRFFFrameTime.packetPosition(pts: packet.pts, dts: packet.dts, timebase: context.videoTimebase),
+                       8, accuracy: 0.2)
+        av_packet_unref(&packet)
+        context.destroy()
+    }
+
+    func testOnlyADemuxerOwnIndexIsComplete() {
+        XCTAssertTrue(IRFFFormatContext.demuxerIndexIsComplete(entryCount: 10, keyFrameCount: 3, formatFlags: 0))
+        XCTAssertFalse(IRFFFormatContext.demuxerIndexIsComplete(entryCount: 10, keyFrameCount: 3, formatFlags: AVFMT_GENERIC_INDEX))
+        XCTAssertFalse(IRFFFormatContext.demuxerIndexIsComplete(entryCount: 0, keyFrameCount: 0, formatFlags: 0))
+        XCTAssertFalse(IRFFFormatContext.demuxerIndexIsComplete(entryCount: 4, keyFrameCount: 0, formatFlags: 0))
+    }
+
     func testReadFrameReturnsFailureWhenFormatContextIsMissing() {
         let context = IRFFFormatContext(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"), videoFormat: .mpeg4)
         var packet = AVPacket()
@@ -254,6 +389,56 @@ final class IRFFFormatContextTests: XCTestCase {
         XCTAssertEqual(ffmpeg_interrupt_callback(ctx: refCon), 0)
     }
 
+    // MARK: - Benchmarks
+
+    /// Time to open and probe a local stand-in for a camera stream; compare with
+    /// `testBenchmarkLowLatencyProfileStartup`.
+    func testBenchmarkStandardProfileStartup() throws {
+        try measureStartup(profile: .standard)
+    }
+
+    func testBenchmarkLowLatencyProfileStartup() throws {
+        try measureStartup(profile: .lowLatencyLive)
+    }
+
+    /// Scrubbing across an indexed stand-in: seek, then read the packet it lands on.
+    func testBenchmarkIndexedSeek() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+        context.setupSync()
+        var packet = AVPacket()
+        while context.readFrame(&packet) >= 0 {
+            av_packet_unref(&packet)
+        }
+
+        measure {
+            for step in 0..<50 {
+                context.seekFile(withFFTimebase: Double(step) * 0.19)
+                _ = context.readFrame(&packet)
+                av_packet_unref(&packet)
+            }
+        }
+        context.destroy()
+    }
+
+    private func measureStartup(profile: IRDecoderInputProfile) throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+
+        measure {
+            let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+            context.inputProfile = profile
+            context.setupSync()
+            XCTAssertTrue(context.videoEnable)
+            context.destroy()
+        }
+    }
+
     func testReleaseDoesNotPrintDebugOutput() {
         var context: IRFFFormatContext? = IRFFFormatContext(
             contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
@@ -0,0 +1,165 @@
+//
+//  IRFFFrameHeapTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFFrameHeapTests: XCTestCase {
+
+    func testHeapPopsFramesInKeyOrder() {
+        var heap = IRFFFrameHeap()
+        let positions: [TimeInterval] = [5, 1, 4, 2, 3, 0]
+        for (sequence, position) in positions.enumerated() {
+            let frame = makeFrame(position: position)
+            heap.insert(frame, key: IRFFFrameQueuePolicy.sortedOrderingKey(for: frame, sequence: sequence))
+        }
+
+        var popped: [TimeInterval] = []
+        while let frame = heap.popFirst() {
+            popped.append(frame.position)
+        }
+
+        XCTAssertEqual(popped, [0, 1, 2, 3, 4, 5])
+        XCTAssertTrue(heap.isEmpty)
+    }
+
+    func testOrderingKeysRankFiniteThenNonFiniteThenAppended() {
+        let finite = IRFFFrameQueuePolicy.sortedOrderingKey(for: makeFrame(position: 100), sequence: 3)
+        let nonFinite = IRFFFrameQueuePolicy.sortedOrderingKey(for: makeFrame(position: .nan), sequence: 1)
+        let appended = IRFFFrameQueuePolicy.appendedOrderingKey(sequence: 0)
+
+        XCTAssertLessThan(finite, nonFinite)
+        XCTAssertLessThan(nonFinite, appended)
+        XCTAssertLessThan(
+            IRFFFrameQueuePolicy.sortedOrderingKey(for: makeFrame(position: 1), sequence: 0),
+            IRFFFrameQueuePolicy.sortedOrderingKey(for: makeFrame(position: 1), sequence: 1)
+        )
+    }
+
+    // Golden check: the heap must pop in exactly the order the previous backwards
+    // array walk built with `shouldInsert(_:after:)`, including ties and NaN/inf.
+    func testSortedQueueMatchesLegacyInsertionOrder() {
+        var generator = SplitMix64(seed: 0x1234)
+        let specials: [TimeInterval] = [.nan, .infinity, -.infinity]
+        for _ in 0..<200 {
+            let queue = IRFFFrameQueue.frameQueue()
+            var legacy: [IRFFFrame] = []
+            for _ in 0..<Int(generator.next() % 24) {
+                let roll = generator.next() % 10
+                let position = roll == 0 ? specials[Int(generator.next() % 3)] : TimeInterval(generator.next() % 8)
+                let frame = makeFrame(position: position)
+                queue.putSortFrame(frame)
+                legacyInsert(frame, into: &legacy)
+            }
+            for expected in legacy {
+                XCTAssertTrue(queue.getFrameAsync() === expected)
+            }
+            XCTAssertNil(queue.getFrameAsync())
+        }
+    }
+
+    // MARK: - Benchmarks
+
+    // 60 fps HEVC-style hierarchical B-frame GOPs: each mini-GOP of `depth` frames
+    // arrives anchor first, then its B-frames bisected, and the display side pops a
+    // frame whenever more than `depth` are queued.
+    private static let benchmarkFrameCount = 6_000
+
+    func testBenchmarkHeapReorderDepth4To16() {
+        let orders = [4, 8, 16].map { Self.decodeOrderPositions(depth: $0, frameCount: Self.benchmarkFrameCount) }
+        measure {
+            for (depth, positions) in zip([4, 8, 16], orders) {
+                let queue = IRFFFrameQueue.frameQueue()
+                for position in positions {
+                    queue.putSortFrame(makeFrame(position: position))
+                    if queue.count > depth {
+                        _ = queue.getFrameAsync()
+                    }
+                }
+            }
+        }
+    }
+
+    func testBenchmarkLegacyArrayReorderDepth4To16() {
+        let orders = [4, 8, 16].map { Self.decodeOrderPositions(depth: $0, frameCount: Self.benchmarkFrameCount) }
+        measure {
+            for (depth, positions) in zip([4, 8, 16], orders) {
+                var frames: [IRFFFrame] = []
+                for position in positions {
+                    legacyInsert(makeFrame(position: position), into: &frames)
+                    if frames.count > depth {
+                        frames.removeFirst()
+                    }
+                }
+            }
+        }
+    }
+
+    func testDecodeOrderPositionsCoverEveryFrameOnce() {
+        let positions = Self.decodeOrderPositions(depth: 8, frameCount: 64)
+
+        XCTAssertEqual(positions.count, 64)
+        XCTAssertEqual(Set(positions).count, 64)
+        XCTAssertNotEqual(positions, positions.sorted())
+    }
+
+    private static func decodeOrderPositions(depth: Int, frameCount: Int) -> [TimeInterval] {
+        let frameInterval = 1.0 / 60.0
+        var positions: [TimeInterval] = []
+        var start = 0
+        while start < frameCount {
+            let end = min(start + depth, frameCount) - 1
+            positions.append(TimeInterval(end) * frameInterval)
+            var ranges = [(start, end - 1)]
+            while !ranges.isEmpty {
+                let (low, high) = ranges.removeFirst()
+                guard low <= high else { continue }
+                let mid = (low + high) / 2
+                positions.append(TimeInterval(mid) * frameInterval)
+                ranges.append((low, mid - 1))
+                ranges.append((mid + 1, high))
+            }
+            start = end + 1
+        }
+        return positions
+    }
+
+    private func legacyInsert(_ frame: IRFFFrame, into frames: inout [IRFFFrame]) {
+        for i in stride(from: frames.count - 1, through: 0, by: -1) {
+            if IRFFFrameQueuePolicy.shouldInsert(frame, after: frames[i]) {
+                frames.insert(frame, at: i + 1)
+                return
+            }
+        }
+        frames.insert(frame, at: 0)
+    }
+
+    private func makeFrame(position: TimeInterval) -> IRFFFrame {
+        let frame = IRFFFrame()
+        frame.position = position
+        frame.duration = 1.0 / 60.0
+        frame.size = 1
+        return frame
+    }
+}
+
+private struct SplitMix64 {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E3779B97F4A7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+        z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+        return z ^ (z >> 31)
+    }
+}
@@ -232,6 +232,136 @@ final class IRFFFrameQueueTests: XCTestCase {
         XCTAssertEqual(queue.size, 0)
     }
 
+    func testGetFrameUntilDeadlineReturnsNilWhenNoFrameArrives() {
+        let queue = IRFFFrameQueue.frameQueue()
+        let start = Date()
+
+        XCTAssertNil(queue.getFrame(until: .now() + 0.05))
+        XCTAssertGreaterThanOrEqual(Date().timeIntervalSince(start), 0.04)
+    }
+
+    func testGetFrameUntilDeadlineReturnsFramePutWhileWaiting() {
+        let queue = IRFFFrameQueue.frameQueue()
+        let frame = makeFrame(position: 0, duration: 0.1, size: 1)
+        let received = expectation(description: "waiter receives the frame")
+        let lock = NSLock()
+        var receivedFrame: IRFFFrame?
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            let result = queue.getFrame(until: .now() + 1)
+            lock.lock()
+            receivedFrame = result
+            lock.unlock()
+            received.fulfill()
+        }
+
+        Thread.sleep(forTimeInterval: 0.05)
+        queue.putSortFrame(frame)
+
+        wait(for: [received], timeout: 1)
+        lock.lock()
+        XCTAssertTrue(receivedFrame === frame)
+        lock.unlock()
+    }
+
+    func testDestroyWakesDeadlineWaiterImmediately() {
+        let queue = IRFFFrameQueue.frameQueue()
+        let returned = expectation(description: "waiter returns after destroy")
+
+        DispatchQueue.global().async {
+            XCTAssertNil(queue.getFrame(until: .now() + 10))
+            returned.fulfill()
+        }
+
+        Thread.sleep(forTimeInterval: 0.05)
+        queue.destroy()
+        wait(for: [returned], timeout: 1)
+    }
+
+    // Idle display thread for 200 ms: the notifier parks once, where the old 5 ms
+    // poll loop woke about 40 times.
+    func testIdleWaitDoesNotPollCompareToSleepLoop() {
+        let queue = IRFFFrameQueue.frameQueue()
+        let idleInterval: TimeInterval = 0.2
+
+        XCTAssertNil(queue.getFrame(until: .now() + idleInterval))
+        let pollingWakeups = pollingWakeupCount(for: idleInterval)
+
+        XCTAssertLessThanOrEqual(queue.wakeupCount, 1)
+        XCTAssertGreaterThan(pollingWakeups, queue.wakeupCount)
+    }
+
+    func testBlockedConsumerWakesOnPut() {
+        let queue = IRFFFrameQueue.frameQueue()
+        let frame = makeFrame(position: 0, duration: 0.1, size: 1)
+        let waiting = DispatchSemaphore(value: 0)
+        let received = expectation(description: "blocked consumer receives the frame")
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            waiting.signal()
+            XCTAssertTrue(queue.getFrameSync() === frame)
+            received.fulfill()
+        }
+
+        waiting.wait()
+        queue.putFrame(frame)
+        wait(for: [received], timeout: 1)
+    }
+
+    func testBenchmarkNotifierFrameHandoff() {
+        measure {
+            let queue = IRFFFrameQueue.frameQueue()
+            _ = averageHandoffLatency(iterations: 20) { queue.putFrame($0) } get: { queue.getFrameSync() }
+        }
+    }
+
+    func testBenchmarkPollingFrameHandoff() {
+        measure {
+            let queue = IRFFFrameQueue.frameQueue()
+            _ = averageHandoffLatency(iterations: 20) { queue.putFrame($0) } get: {
+                while true {
+                    if let frame = queue.getFrameAsync() {
+                        return frame
+                    }
+                    Thread.sleep(forTimeInterval: 0.005)
+                }
+            }
+        }
+    }
+
+    /// Producer hands a frame to an already-waiting consumer and records how long the
+    /// consumer took to observe it.
+    private func averageHandoffLatency(iterations: Int,
+                                       put: @escaping (IRFFFrame) -> Void,
+                                       get: @escaping () -> IRFFFrame?) -> TimeInterval {
+        var total: TimeInterval = 0
+        for _ in 0..<iterations {
+            let done = DispatchSemaphore(value: 0)
+            var receivedAt: TimeInterval = 0
+            DispatchQueue.global(qos: .userInitiated).async {
+                _ = get()
+                receivedAt = ProcessInfo.processInfo.systemUptime
+                done.signal()
+            }
+            Thread.sleep(forTimeInterval: 0.002)
+            let sentAt = ProcessInfo.processInfo.systemUptime
+            put(makeFrame(position: 0, duration: 0.01, size: 1))
+            done.wait()
+            total += receivedAt - sentAt
+        }
+        return total / TimeInterval(iterations)
+    }
+
+    private func pollingWakeupCount(for interval: TimeInterval) -> Int {
+        let deadline = ProcessInfo.processInfo.systemUptime + interval
+        var wakeups = 0
+        while ProcessInfo.processInfo.systemUptime < deadline {
+            Thread.sleep(forTimeInterval: 0.005)
+            wakeups += 1
+        }
+        return wakeups
+    }
+
     private func makeFrame(position: TimeInterval, duration: TimeInterval, size: Int) -> IRFFFrame {
         let frame = IRFFFrame()
         frame.position = position
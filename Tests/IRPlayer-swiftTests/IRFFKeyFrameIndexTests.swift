@@ -0,0 +1,88 @@
+//
+//  IRFFKeyFrameIndexTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFKeyFrameIndexTests: XCTestCase {
+
+    func testLooksUpTheNearestKeyFrameAtOrBeforeATime() {
+        let index = IRFFKeyFrameIndex()
+        for position in [0.0, 2.0, 4.0, 6.0] {
+            index.insert(position)
+        }
+
+        XCTAssertEqual(index.keyFrame(atOrBefore: 0), 0)
+        XCTAssertEqual(index.keyFrame(atOrBefore: 3.9), 2)
+        XCTAssertEqual(index.keyFrame(atOrBefore: 4), 4)
+        XCTAssertEqual(index.keyFrame(atOrBefore: 100), 6)
+        XCTAssertNil(index.keyFrame(atOrBefore: -0.5))
+        XCTAssertNil(index.keyFrame(atOrBefore: .nan))
+    }
+
+    func testOutOfOrderAndRepeatedPositionsStaySortedAndUnique() {
+        let index = IRFFKeyFrameIndex()
+        // A seek back re-reads key frames that are already indexed.
+        for position in [4.0, 6.0, 0.0, 2.0, 4.0, 4.000_000_1, 6.0] {
+            index.insert(position)
+        }
+        index.insert(.nan)
+        index.insert(-1)
+
+        XCTAssertEqual(index.count, 4)
+        XCTAssertEqual(index.keyFrame(atOrBefore: 1.9), 0)
+        XCTAssertEqual(index.keyFrame(atOrBefore: 5.9), 4)
+
+        index.removeAll()
+        XCTAssertEqual(index.count, 0)
+        XCTAssertNil(index.keyFrame(atOrBefore: 5))
+    }
+
+    func testCoveredLookupStopsAtTheFurthestIndexedKeyFrame() {
+        let index = IRFFKeyFrameIndex()
+        for position in [0.0, 2.0, 4.0] {
+            index.insert(position)
+        }
+
+        XCTAssertEqual(index.coveredKeyFrame(atOrBefore: 3.9), 2)
+        XCTAssertNil(index.coveredKeyFrame(atOrBefore: 4))
+        XCTAssertNil(index.coveredKeyFrame(atOrBefore: 8))
+        XCTAssertNil(index.coveredKeyFrame(atOrBefore: -1))
+
+        index.markComplete()
+        XCTAssertTrue(index.isComplete)
+        XCTAssertEqual(index.coveredKeyFrame(atOrBefore: 8), 4)
+
+        index.removeAll()
+        XCTAssertFalse(index.isComplete)
+    }
+
+    func testInsertionIndexIsTheFirstPositionNotBelowTheValue() {
+        let positions = [1.0, 2.0, 2.0, 3.0]
+
+        XCTAssertEqual(IRFFKeyFrameIndex.insertionIndex(of: 0, in: positions), 0)
+        XCTAssertEqual(IRFFKeyFrameIndex.insertionIndex(of: 2, in: positions), 1)
+        XCTAssertEqual(IRFFKeyFrameIndex.insertionIndex(of: 2.5, in: positions), 3)
+        XCTAssertEqual(IRFFKeyFrameIndex.insertionIndex(of: 4, in: positions), 4)
+        XCTAssertEqual(IRFFKeyFrameIndex.insertionIndex(of: 1, in: []), 0)
+    }
+
+    func testBenchmarkLookupInAnHourOfTwoSecondGOPs() {
+        let index = IRFFKeyFrameIndex()
+        for gop in 0..<1_800 {
+            index.insert(Double(gop) * 2)
+        }
+
+        measure {
+            var found = 0.0
+            for step in 0..<100_000 {
+                found += index.keyFrame(atOrBefore: Double(step % 3_600)) ?? 0
+            }
+            XCTAssertGreaterThan(found, 0)
+        }
+    }
+}
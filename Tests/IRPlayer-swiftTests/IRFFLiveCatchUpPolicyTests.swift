@@ -0,0 +1,82 @@
+//
+//  IRFFLiveCatchUpPolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFLiveCatchUpPolicyTests: XCTestCase {
+
+    func testSpeedUpStartsPastTheExcessAndRunsUntilTheTarget() {
+        func action(_ latency: TimeInterval, speedingUp: Bool) -> IRFFLiveCatchUpAction {
+            return IRFFLiveCatchUpPolicy.action(latency: latency, targetLatency: 1, speedingUp: speedingUp, canDropPackets: true)
+        }
+
+        XCTAssertEqual(action(0.2, speedingUp: false), .none)
+        XCTAssertEqual(action(1.5, speedingUp: false), .none)
+        XCTAssertEqual(action(1.51, speedingUp: false), .speedUp)
+        XCTAssertEqual(action(1.2, speedingUp: true), .speedUp)
+        XCTAssertEqual(action(1.0, speedingUp: true), .none)
+    }
+
+    func testOnlyStreamsThatMayDropPacketsJumpToTheNextKeyFrame() {
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: 4.01, targetLatency: 1, speedingUp: true, canDropPackets: true),
+                       .dropToKeyFrame)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: 4.0, targetLatency: 1, speedingUp: true, canDropPackets: true),
+                       .speedUp)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: 20, targetLatency: 1, speedingUp: false, canDropPackets: false),
+                       .speedUp)
+    }
+
+    func testDisabledOrUnusableInputsNeverCatchUp() {
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: 20, targetLatency: 0, speedingUp: false, canDropPackets: true), .none)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: 20, targetLatency: .nan, speedingUp: true, canDropPackets: true), .none)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.action(latency: .infinity, targetLatency: 1, speedingUp: true, canDropPackets: true), .none)
+    }
+
+    func testPresentationRateAppliesTheSpeedUpWithinTheRateRange() {
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.presentationRate(rate: 1, speedingUp: false), 1)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.presentationRate(rate: 1, speedingUp: true), 1.1, accuracy: 1e-12)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.presentationRate(rate: 2, speedingUp: true), 2.2, accuracy: 1e-12)
+        XCTAssertEqual(IRFFLiveCatchUpPolicy.presentationRate(rate: 4, speedingUp: true), 4)
+    }
+
+    func testSpeedUpShedsABurstBackToTheTarget() {
+        // A 1.2 s burst on a 25 fps feed that keeps arriving in real time.
+        var latency = 2.2
+        var speedingUp = false
+        var seconds = 0.0
+        while seconds < 60 {
+            speedingUp = IRFFLiveCatchUpPolicy.action(latency: latency, targetLatency: 1,
+                                                      speedingUp: speedingUp, canDropPackets: false) == .speedUp
+            let rate = IRFFLiveCatchUpPolicy.presentationRate(rate: 1, speedingUp: speedingUp)
+            latency -= 0.04 * (rate - 1)
+            seconds += 0.04
+            if !speedingUp { break }
+        }
+
+        XCTAssertFalse(speedingUp)
+        XCTAssertEqual(latency, 1, accuracy: 0.01)
+        XCTAssertEqual(seconds, 12, accuracy: 0.1)
+    }
+
+    func testDecoderDefaultsAndWrappersRemainSourceCompatible() {
+        let decoder = IRFFDecoder(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
+                                  videoFormat: .mpeg4,
+                                  videoOutput: nil,
+                                  audioOutput: nil)
+        XCTAssertEqual(decoder.liveTargetLatency, IRFFLiveCatchUpPolicy.defaultTargetLatency)
+        XCTAssertEqual(decoder.liveLatency, 0)
+        XCTAssertEqual(IRPlayerImp.player().liveTargetLatency, IRFFLiveCatchUpPolicy.defaultTargetLatency)
+
+        XCTAssertEqual(
+            IRFFDecoder.liveCatchUpAction(latency: 5, targetLatency: 1, speedingUp: false, canDropPackets: true),
+            IRFFLiveCatchUpPolicy.action(latency: 5, targetLatency: 1, speedingUp: false, canDropPackets: true)
+        )
+        XCTAssertEqual(IRFFDecoder.livePresentationRate(rate: 1.5, speedingUp: true),
+                       IRFFLiveCatchUpPolicy.presentationRate(rate: 1.5, speedingUp: true))
+    }
+}
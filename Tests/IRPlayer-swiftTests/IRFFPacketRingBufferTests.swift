@@ -0,0 +1,234 @@
+//
+//  IRFFPacketRingBufferTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFPacketRingBufferTests: XCTestCase {
+
+    func testRingCapacityRoundsUpToPowerOfTwo() {
+        XCTAssertEqual(IRFFPacketQueuePolicy.ringCapacity(for: 0), 2)
+        XCTAssertEqual(IRFFPacketQueuePolicy.ringCapacity(for: 3), 4)
+        XCTAssertEqual(IRFFPacketQueuePolicy.ringCapacity(for: 4096), 4096)
+        XCTAssertEqual(IRFFPacketQueuePolicy.ringCapacity(for: 4097), 8192)
+        XCTAssertEqual(IRFFPacketQueuePolicy.ringCapacity(for: Int.max), 1 << 20)
+    }
+
+    func testDurationTicksRoundTripAndRejectInvalidDurations() {
+        XCTAssertEqual(IRFFPacketQueuePolicy.duration(fromTicks: IRFFPacketQueuePolicy.durationTicks(for: 0.25)), 0.25, accuracy: 0.000001)
+        XCTAssertEqual(IRFFPacketQueuePolicy.durationTicks(for: .nan), 0)
+        XCTAssertEqual(IRFFPacketQueuePolicy.durationTicks(for: .infinity), 0)
+        XCTAssertEqual(IRFFPacketQueuePolicy.durationTicks(for: -1), 0)
+        XCTAssertGreaterThan(IRFFPacketQueuePolicy.durationTicks(for: .greatestFiniteMagnitude), 0)
+        XCTAssertEqual(IRFFPacketQueuePolicy.duration(fromTicks: -10), 0)
+    }
+
+    func testRingKeepsFIFOOrderAndAccountingAcrossWrapAround() {
+        let ring = IRFFPacketRingBuffer(capacity: 4)
+
+        for round in 0..<3 {
+            for index in 0..<4 {
+                XCTAssertTrue(ring.put(makePacket(size: Int32(round * 10 + index), duration: 0), size: 10, duration: 0.1))
+            }
+            XCTAssertEqual(ring.count, 4)
+            XCTAssertEqual(ring.size, 40)
+            XCTAssertEqual(ring.duration, 0.4, accuracy: 0.0001)
+            for index in 0..<4 {
+                XCTAssertEqual(ring.tryTake()?.packet.size, Int32(round * 10 + index))
+            }
+            XCTAssertEqual(ring.count, 0)
+            XCTAssertEqual(ring.size, 0)
+            XCTAssertEqual(ring.duration, 0, accuracy: 0.0001)
+        }
+    }
+
+    func testTakeWithTimeoutReturnsNilWhenNoPacketArrives() {
+        let ring = IRFFPacketRingBuffer(capacity: 4)
+        let start = Date()
+
+        XCTAssertNil(ring.take(timeout: 0.05))
+        XCTAssertGreaterThanOrEqual(Date().timeIntervalSince(start), 0.04)
+    }
+
+    func testPacketQueueGetPacketWithTimeoutReturnsNilWhenEmpty() {
+        let queue = IRFFPacketQueue(timebase: 0.001, capacity: 4)
+
+        XCTAssertNil(queue.getPacket(timeout: 0.01))
+        queue.putPacket(makePacket(size: 12, duration: 250), duration: 0)
+        XCTAssertEqual(queue.getPacket(timeout: 0.01)?.size, 12)
+    }
+
+    func testFullRingBlocksProducerUntilConsumerFreesASlot() {
+        let ring = IRFFPacketRingBuffer(capacity: 2)
+        ring.put(makePacket(size: 1, duration: 0), size: 1, duration: 0)
+        ring.put(makePacket(size: 2, duration: 0), size: 1, duration: 0)
+        let produced = expectation(description: "producer resumes after a slot is freed")
+
+        DispatchQueue.global().async {
+            ring.put(self.makePacket(size: 3, duration: 0), size: 1, duration: 0)
+            produced.fulfill()
+        }
+
+        Thread.sleep(forTimeInterval: 0.05)
+        XCTAssertEqual(ring.count, 2)
+        XCTAssertEqual(ring.tryTake()?.packet.size, 1)
+
+        wait(for: [produced], timeout: 1)
+        XCTAssertEqual(ring.tryTake()?.packet.size, 2)
+        XCTAssertEqual(ring.tryTake()?.packet.size, 3)
+    }
+
+    func testDestroyReleasesBlockedProducerAndConsumer() {
+        let full = IRFFPacketRingBuffer(capacity: 2)
+        full.put(makePacket(size: 1, duration: 0), size: 1, duration: 0)
+        full.put(makePacket(size: 2, duration: 0), size: 1, duration: 0)
+        let empty = IRFFPacketRingBuffer(capacity: 2)
+        let producerReturned = expectation(description: "blocked producer returns")
+        let consumerReturned = expectation(description: "blocked consumer returns")
+
+        DispatchQueue.global().async {
+            XCTAssertFalse(full.put(self.makePacket(size: 3, duration: 0), size: 1, duration: 0))
+            producerReturned.fulfill()
+        }
+        DispatchQueue.global().async {
+            XCTAssertNil(empty.take())
+            consumerReturned.fulfill()
+        }
+
+        Thread.sleep(forTimeInterval: 0.05)
+        full.destroy()
+        empty.destroy()
+
+        wait(for: [producerReturned, consumerReturned], timeout: 1)
+        XCTAssertEqual(full.count, 0)
+        XCTAssertEqual(full.size, 0)
+    }
+
+    func testFlushFromProducerThreadWhileConsumerWaitsKeepsLaterPackets() {
+        let queue = IRFFPacketQueue(timebase: 0.001, capacity: 8)
+        let received = expectation(description: "consumer receives the post-flush packet")
+        let lock = NSLock()
+        var sizes: [Int32] = []
+
+        DispatchQueue.global().async {
+            let packet = queue.getPacket()
+            lock.lock()
+            sizes.append(packet.size)
+            lock.unlock()
+            received.fulfill()
+        }
+
+        Thread.sleep(forTimeInterval: 0.05)
+        queue.flush()
+        queue.putPacket(makePacket(size: 42, duration: 250), duration: 0)
+
+        wait(for: [received], timeout: 1)
+        lock.lock()
+        XCTAssertEqual(sizes, [42])
+        lock.unlock()
+        queue.destroy()
+    }
+
+    func testSingleProducerSingleConsumerDeliversEveryPacketInOrder() {
+        let ring = IRFFPacketRingBuffer(capacity: 64)
+        let packetCount = 20_000
+        let finished = expectation(description: "consumer drained every packet")
+        var outOfOrder = 0
+
+        DispatchQueue.global(qos: .userInitiated).async {
+            for index in 0..<packetCount {
+                guard let entry = ring.take(timeout: 1) else { break }
+                if entry.packet.size != Int32(index) {
+                    outOfOrder += 1
+                }
+            }
+            finished.fulfill()
+        }
+        for index in 0..<packetCount {
+            ring.put(makePacket(size: Int32(index), duration: 0), size: 1, duration: 0.001)
+        }
+
+        wait(for: [finished], timeout: 10)
+        XCTAssertEqual(outOfOrder, 0)
+        XCTAssertEqual(ring.count, 0)
+        XCTAssertEqual(ring.size, 0)
+        XCTAssertEqual(ring.duration, 0, accuracy: 0.0001)
+    }
+
+    // MARK: - Benchmarks
+
+    private static let benchmarkPacketCount = 50_000
+
+    func testBenchmarkRingPacketQueueHandoff() {
+        measure {
+            let queue = IRFFPacketQueue(timebase: 0.001)
+            runHandoff(put: { queue.putPacket($0, duration: 0.001) },
+                       get: { queue.getPacket() })
+        }
+    }
+
+    func testBenchmarkConditionPacketQueueHandoff() {
+        measure {
+            let queue = ConditionPacketQueue()
+            runHandoff(put: { queue.putPacket($0, duration: 0.001) },
+                       get: { queue.getPacket() })
+        }
+    }
+
+    private func runHandoff(put: @escaping (AVPacket) -> Void, get: @escaping () -> AVPacket) {
+        let done = DispatchSemaphore(value: 0)
+        DispatchQueue.global(qos: .userInitiated).async {
+            for _ in 0..<Self.benchmarkPacketCount {
+                _ = get()
+            }
+            done.signal()
+        }
+        for index in 0..<Self.benchmarkPacketCount {
+            put(makePacket(size: Int32(index & 0xFFFF), duration: 1))
+        }
+        done.wait()
+    }
+
+    private func makePacket(size: Int32, duration: Int64) -> AVPacket {
+        var packet = AVPacket()
+        packet.size = size
+        packet.duration = duration
+        return packet
+    }
+}
+
+/// The array + NSCondition queue IRFFPacketQueue used before the ring buffer, kept
+/// as the benchmark baseline.
+private final class ConditionPacketQueue {
+    private let condition = NSCondition()
+    private var packets: [(packet: AVPacket, duration: TimeInterval)] = []
+    private var size = 0
+    private var duration: TimeInterval = 0
+
+    func putPacket(_ packet: AVPacket, duration: TimeInterval) {
+        condition.lock()
+        packets.append((packet, duration))
+        size += IRFFPacketQueuePolicy.accountedSize(for: packet)
+        self.duration += duration
+        condition.signal()
+        condition.unlock()
+    }
+
+    func getPacket() -> AVPacket {
+        condition.lock()
+        while packets.isEmpty {
+            condition.wait()
+        }
+        let entry = packets.removeFirst()
+        size -= IRFFPacketQueuePolicy.accountedSize(for: entry.packet)
+        duration -= entry.duration
+        condition.unlock()
+        return entry.packet
+    }
+}
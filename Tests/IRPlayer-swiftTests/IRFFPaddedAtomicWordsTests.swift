@@ -0,0 +1,41 @@
+//
+//  IRFFPaddedAtomicWordsTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRPlayerObjc
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFPaddedAtomicWordsTests: XCTestCase {
+    private enum Word: Int, CaseIterable {
+        case first
+        case second
+        case third
+    }
+
+    func testWordsStartAtZeroOnSeparateCacheLines() {
+        let words = IRFFPaddedAtomicWords<Word>()
+
+        XCTAssertEqual(IRFFPaddedAtomicWords<Word>.lineStride * MemoryLayout<Int>.stride, 128)
+        for word in Word.allCases {
+            XCTAssertEqual(IRAtomicLoad(words[word]), 0)
+        }
+        XCTAssertEqual(UnsafeRawPointer(words[.second]) - UnsafeRawPointer(words[.first]), 128)
+        XCTAssertEqual(UnsafeRawPointer(words[.third]) - UnsafeRawPointer(words[.second]), 128)
+    }
+
+    func testWordsAreIndependent() {
+        let words = IRFFPaddedAtomicWords<Word>()
+
+        IRAtomicStore(words[.first], 7)
+        IRAtomicFetchAdd(words[.third], -2)
+
+        XCTAssertEqual(IRAtomicLoad(words[.first]), 7)
+        XCTAssertEqual(IRAtomicLoad(words[.second]), 0)
+        XCTAssertEqual(IRAtomicLoad(words[.third]), -2)
+    }
+}
@@ -0,0 +1,135 @@
+//
+//  IRFFPlaybackRatePolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFPlaybackRatePolicyTests: XCTestCase {
+
+    func testRateIsClampedToSupportedRange() {
+        XCTAssertEqual(IRPlayerRate.normalized(2), 2)
+        XCTAssertEqual(IRPlayerRate.normalized(8), 4)
+        XCTAssertEqual(IRPlayerRate.normalized(0.25), 0.5)
+        XCTAssertEqual(IRPlayerRate.normalized(0), 1)
+        XCTAssertEqual(IRPlayerRate.normalized(.nan), 1)
+        XCTAssertEqual(IRPlayerRate.normalized(nil), 1)
+    }
+
+    func testTimeStretchIsBypassedAtUnityRate() {
+        XCTAssertFalse(IRFFPlaybackRatePolicy.usesTimeStretch(rate: 1))
+        XCTAssertFalse(IRFFPlaybackRatePolicy.usesTimeStretch(rate: 1.0001))
+        XCTAssertTrue(IRFFPlaybackRatePolicy.usesTimeStretch(rate: 0.5))
+        XCTAssertTrue(IRFFPlaybackRatePolicy.usesTimeStretch(rate: 1.25))
+    }
+
+    func testVideoDecimationGrowsWithRate() {
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 0.5), .none)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 1.25), .none)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 1.5), .nonReferenceFrames)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 2), .nonReferenceFrames)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 2.5), .keyFramesOnly)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.videoDecimation(rate: 4), .keyFramesOnly)
+    }
+
+    func testKeyFrameOnlyDecodingResumesAtNextKeyFrame() {
+        var awaitingKeyFrame = false
+        var decoded: [Bool] = []
+        let packets: [(isKeyFrame: Bool, decimation: IRFFVideoDecimation)] = [
+            (true, .keyFramesOnly), (false, .keyFramesOnly), (false, .keyFramesOnly),
+            (false, .none), (false, .none), (true, .none), (false, .none)
+        ]
+        for packet in packets {
+            let decision = IRFFVideoDecoder.packetDecision(isKeyFrame: packet.isKeyFrame,
+                                                           decimation: packet.decimation,
+                                                           awaitingKeyFrame: awaitingKeyFrame)
+            decoded.append(decision.decodes)
+            awaitingKeyFrame = decision.awaitingKeyFrame
+        }
+
+        XCTAssertEqual(decoded, [true, false, false, false, false, true, true])
+        XCTAssertTrue(IRFFPlaybackRatePolicy.packetDecision(isKeyFrame: false, decimation: .nonReferenceFrames, awaitingKeyFrame: false).decodes)
+        // Leaving key-frame-only mode right after a key frame needs no wait.
+        XCTAssertFalse(IRFFPlaybackRatePolicy.packetDecision(isKeyFrame: true, decimation: .keyFramesOnly, awaitingKeyFrame: false).awaitingKeyFrame)
+    }
+
+    func testClockRateComesFromMarkerAndOutputSampleDurations() {
+        let output = 1.0 / 96_000
+        XCTAssertEqual(IRFFPlaybackRatePolicy.clockRate(playbackSecondsPerSample: 2 * output, outputSecondsPerSample: output), 2, accuracy: 1e-12)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.clockRate(playbackSecondsPerSample: 0, outputSecondsPerSample: output), 1)
+        XCTAssertEqual(IRFFPlaybackRatePolicy.clockRate(playbackSecondsPerSample: output, outputSecondsPerSample: .nan), 1)
+        XCTAssertEqual(IRFFDecoder.audioClockRate(playbackSecondsPerSample: 0.5 * output, outputSecondsPerSample: output), 0.5, accuracy: 1e-12)
+    }
+
+    func testVideoTimingScalesWithRate() {
+        XCTAssertEqual(IRFFPlaybackRatePolicy.hostDuration(mediaDuration: 1, rate: 4), 0.25)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 11, clockPosition: 10, clockHostTime: 100, rate: 2), 100.5)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 11, clockPosition: 10, clockHostTime: 100, rate: 0.5), 102)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 11, clockPosition: 10, clockHostTime: 100), 101)
+
+        XCTAssertEqual(IRFFDecoder.audioSyncedVideoSleepDuration(framePosition: 10.1, frameDuration: 0.2, audioTimeClock: 10, fps: 5, rate: 2)!,
+                       0.05, accuracy: 1e-12)
+        XCTAssertEqual(IRFFDecoder.audioSyncedVideoSleepDuration(framePosition: 10.1, frameDuration: 0.2, audioTimeClock: 10, fps: 5, rate: 4)!,
+                       0.025, accuracy: 1e-12)
+    }
+
+    func testStandaloneAnchorMeasuresDriftInHostTimeAtRate() {
+        let anchor = (position: 10.0, hostTime: 100.0)
+        let kept = IRFFDecoder.standalonePresentationAnchor(framePosition: 13, hostTime: 100.8, anchor: anchor, rate: 4)
+        XCTAssertEqual(kept.position, 10)
+        XCTAssertEqual(kept.hostTime, 100)
+
+        let reanchored = IRFFDecoder.standalonePresentationAnchor(framePosition: 13, hostTime: 100.8, anchor: anchor)
+        XCTAssertEqual(reanchored.position, 13)
+        XCTAssertEqual(reanchored.hostTime, 100.8)
+    }
+
+    func testAudioClockAdvancesAtRate() {
+        let clock = IRFFAudioClock.rendered(endPosition: 10, renderedDuration: 0.02, renderHostTime: 100, outputLatency: 0, rate: 2)!
+
+        XCTAssertEqual(clock.rate, 2)
+        XCTAssertEqual(clock.position(atHostTime: 100), 9.96, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 100.01), 9.98, accuracy: 1e-9)
+        XCTAssertEqual(clock.position(atHostTime: 101), 10, accuracy: 1e-9)
+        XCTAssertEqual(IRFFAudioClock.rendered(endPosition: 10, renderedDuration: 0, renderHostTime: 1, outputLatency: 0, rate: .nan)?.rate, 1)
+
+        let shared = IRFFSharedAudioClock()
+        shared.store(clock)
+        XCTAssertEqual(shared.load(), clock)
+    }
+
+    func testRingReportsMarkerDurationOfThePlayingSamples() {
+        let ring = IRFFAudioSampleRing(capacity: 64)
+        let samples = [Float](repeating: 0, count: 8)
+        XCTAssertEqual(ring.playbackSecondsPerSample, 0)
+
+        samples.withUnsafeBufferPointer {
+            ring.write($0.baseAddress!, count: 8, position: 0, secondsPerSample: 0.001)
+            ring.write($0.baseAddress!, count: 8, position: 0.008, secondsPerSample: 0.002)
+        }
+        var output = [Float](repeating: 0, count: 8)
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 4) }
+        XCTAssertEqual(ring.playbackSecondsPerSample, 0.001)
+        XCTAssertEqual(ring.secondsPerSample, 0.002)
+        output.withUnsafeMutableBufferPointer { _ = ring.read(into: $0.baseAddress!, count: 6) }
+        XCTAssertEqual(ring.playbackSecondsPerSample, 0.002)
+
+        ring.flush()
+        XCTAssertEqual(ring.playbackSecondsPerSample, 0)
+    }
+
+    func testDecoderRateIsClampedAndWrappersMatchPolicy() {
+        let decoder = IRFFDecoder(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
+                                  videoFormat: .mpeg4,
+                                  videoOutput: nil,
+                                  audioOutput: nil)
+        decoder.rate = 10
+        XCTAssertEqual(decoder.rate, 4)
+
+        XCTAssertEqual(IRFFDecoder.usesTimeStretch(rate: 2), IRFFPlaybackRatePolicy.usesTimeStretch(rate: 2))
+        XCTAssertEqual(IRFFDecoder.videoDecimation(rate: 3), IRFFPlaybackRatePolicy.videoDecimation(rate: 3))
+    }
+}
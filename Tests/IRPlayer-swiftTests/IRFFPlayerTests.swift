@@ -48,6 +48,108 @@ final class IRFFPlayerTests: XCTestCase {
         withExtendedLifetime(player) {}
     }
 
+    func testInputProfileAndBufferingPoliciesReachFFmpegDecoder() throws {
+        let player = IRPlayerImp.player()
+        player.decoder = IRPlayerDecoder.FFmpegDecoder()
+        player.decoder.ffmpegInputProfile = .lowLatencyLive
+        let patient = IRBufferingPolicy(enterThreshold: 0.5, waitsForPlayableBufferInterval: true,
+                                        timeout: 10, timeoutResumeThreshold: 1)
+        player.decoder.ffmpegLiveBufferingPolicy = patient
+        player.manager = nil
+        player.replaceVideoWithURL(contentURL: NSURL(fileURLWithPath: "/tmp/missing.flv"))
+
+        let ffPlayer = try XCTUnwrap(mirroredFFPlayer(from: player))
+        addTeardownBlock {
+            ffPlayer.stop()
+        }
+        let decoder = try XCTUnwrap(ffPlayer.decoder)
+        XCTAssertEqual(decoder.inputProfile, .lowLatencyLive)
+        XCTAssertEqual(decoder.bufferingPolicy, .standard)
+        XCTAssertEqual(decoder.liveBufferingPolicy, patient)
+        withExtendedLifetime(player) {}
+    }
+
+    func testVideoOnlyReplaceVideoNeverRegistersAudioSession() throws {
+        let player = IRPlayerImp.player()
+        player.decoder = IRPlayerDecoder.FFmpegDecoder()
+        player.decoder.ffmpegVideoOnly = true
+        let manager = AudioSessionSpyManager()
+        player.manager = manager
+        player.replaceVideoWithURL(contentURL: NSURL(fileURLWithPath: "/tmp/missing.flv"))
+
+        let ffPlayer = try XCTUnwrap(mirroredFFPlayer(from: player))
+        addTeardownBlock {
+            ffPlayer.stop()
+        }
+        let decoder = try XCTUnwrap(ffPlayer.decoder)
+        XCTAssertTrue(decoder.videoOnly)
+        XCTAssertNil(decoder.audioOutput)
+        XCTAssertFalse(ffPlayer.audioSessionRegistered)
+        XCTAssertEqual(manager.registerCount, 0)
+        withExtendedLifetime(player) {}
+    }
+
+    func testAudioSessionIsRegisteredOnceWhenMediaMayCarryAudio() throws {
+        let abstractPlayer = IRPlayerImp.player()
+        abstractPlayer.decoder = IRPlayerDecoder.FFmpegDecoder()
+        abstractPlayer.replaceVideoWithURL(contentURL: NSURL(fileURLWithPath: "/tmp/missing.flv"))
+        let manager = AudioSessionSpyManager()
+        abstractPlayer.manager = manager
+        var ffPlayer: IRFFPlayer? = IRFFPlayer.player(with: abstractPlayer)
+        XCTAssertEqual(manager.registerCount, 0)
+
+        ffPlayer?.replaceVideo()
+        ffPlayer?.replaceVideo()
+
+        XCTAssertEqual(ffPlayer?.audioSessionRegistered, true)
+        XCTAssertEqual(manager.registerCount, 1)
+        XCTAssertFalse(ffPlayer?.decoder?.videoOnly ?? true)
+        ffPlayer?.stop()
+        ffPlayer = nil
+        XCTAssertEqual(manager.unregisterCount, 1)
+        withExtendedLifetime(abstractPlayer) {}
+    }
+
+    // MARK: - Benchmarks
+
+    /// Player startup on a video-only stand-in until the decoder is ready to decode,
+    /// including audio probing and session setup; compare with
+    /// `testBenchmarkVideoOnlyPlayerStartup`.
+    func testBenchmarkAudioPlayerStartup() throws {
+        try measureStartup(videoOnly: false)
+    }
+
+    func testBenchmarkVideoOnlyPlayerStartup() throws {
+        try measureStartup(videoOnly: true)
+    }
+
+    private func measureStartup(videoOnly: Bool) throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let abstractPlayer = IRPlayerImp.player()
+        abstractPlayer.decoder = IRPlayerDecoder.FFmpegDecoder()
+        abstractPlayer.decoder.ffmpegVideoOnly = videoOnly
+        abstractPlayer.replaceVideoWithURL(contentURL: url as NSURL)
+        // Only the players measured below should be decoding.
+        mirroredFFPlayer(from: abstractPlayer)?.stop()
+        // A manager of its own, so every player below registers the session afresh.
+        abstractPlayer.manager = IRAudioManager()
+
+        measure {
+            let ffPlayer = IRFFPlayer.player(with: abstractPlayer)
+            ffPlayer.replaceVideo()
+            let deadline = Date().addingTimeInterval(5)
+            while let decoder = ffPlayer.decoder, !decoder.prepareToDecode, decoder.error == nil, Date() < deadline {
+                Thread.sleep(forTimeInterval: 0.001)
+            }
+            XCTAssertEqual(ffPlayer.decoder?.prepareToDecode, true)
+            ffPlayer.stop()
+        }
+        withExtendedLifetime(abstractPlayer) {}
+    }
+
     func testPlayableTimePostsNotificationWhenBufferedTimeChangesWithinDuration() throws {
         let abstractPlayer = IRPlayerImp.player()
         abstractPlayer.manager = nil
@@ -75,28 +177,6 @@ final class IRFFPlayerTests: XCTestCase {
         withExtendedLifetime(abstractPlayer) {}
     }
 
-    func testAudioCopyPlanRejectsInvalidFrameOffsets() {
-        XCTAssertNil(IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: -1, remainingFrames: 32, numberOfChannels: 2))
-        XCTAssertNil(IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 129, remainingFrames: 32, numberOfChannels: 2))
-        XCTAssertNil(IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 0, remainingFrames: 32, numberOfChannels: 0))
-    }
-
-    func testAudioCopyPlanRejectsUnalignedFrameOffsets() {
-        XCTAssertNil(IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 1, remainingFrames: 32, numberOfChannels: 2))
-        XCTAssertNil(IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 4, remainingFrames: 32, numberOfChannels: 2))
-    }
-
-    func testAudioCopyPlanRejectsOverflowingFrameCalculations() {
-        XCTAssertNil(
-            IRFFPlayer.audioCopyPlan(
-                frameSize: Int.max,
-                outputOffset: 0,
-                remainingFrames: .max,
-                numberOfChannels: .max
-            )
-        )
-    }
-
     func testAudioSilenceByteCountRejectsInvalidOrOverflowingInputs() {
         XCTAssertNil(IRFFPlayer.audioSilenceByteCount(numberOfFrames: 0, numberOfChannels: 2))
         XCTAssertNil(IRFFPlayer.audioSilenceByteCount(numberOfFrames: 10, numberOfChannels: 0))
@@ -107,32 +187,6 @@ final class IRFFPlayerTests: XCTestCase {
         XCTAssertEqual(IRFFPlayer.audioSilenceByteCount(numberOfFrames: 10, numberOfChannels: 2), 80)
     }
 
-    func testAudioCopyPlanCalculatesFramesAndBytesWithinBounds() throws {
-        let partial = try XCTUnwrap(
-            IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 0, remainingFrames: 10, numberOfChannels: 2)
-        )
-        XCTAssertEqual(partial.bytesToCopy, 80)
-        XCTAssertEqual(partial.framesToCopy, 10)
-        XCTAssertTrue(partial.hasRemainingFrameBytes)
-
-        let final = try XCTUnwrap(
-            IRFFPlayer.audioCopyPlan(frameSize: 128, outputOffset: 120, remainingFrames: 10, numberOfChannels: 2)
-        )
-        XCTAssertEqual(final.bytesToCopy, 8)
-        XCTAssertEqual(final.framesToCopy, 1)
-        XCTAssertFalse(final.hasRemainingFrameBytes)
-    }
-
-    func testAudioCopyPlanCopiesOnlyWholeFrames() throws {
-        let plan = try XCTUnwrap(
-            IRFFPlayer.audioCopyPlan(frameSize: 10, outputOffset: 0, remainingFrames: 2, numberOfChannels: 2)
-        )
-
-        XCTAssertEqual(plan.bytesToCopy, 8)
-        XCTAssertEqual(plan.framesToCopy, 1)
-        XCTAssertTrue(plan.hasRemainingFrameBytes)
-    }
-
     func testStaticPolicyWrappersRemainSourceCompatible() {
         XCTAssertEqual(
             IRFFPlayer.replaceVideoReadiness(hasAbstractPlayer: true, hasContentURL: true, hasDisplayView: false),
@@ -162,21 +216,6 @@ final class IRFFPlayerTests: XCTestCase {
             IRFFPlayer.audioSilenceByteCount(numberOfFrames: 10, numberOfChannels: 2),
             IRFFPlayerPlaybackPolicy.audioSilenceByteCount(numberOfFrames: 10, numberOfChannels: 2)
         )
-
-        XCTAssertEqual(
-            IRFFPlayer.audioCopyPlan(
-                frameSize: 128,
-                outputOffset: 0,
-                remainingFrames: 10,
-                numberOfChannels: 2
-            ),
-            IRFFPlayerPlaybackPolicy.audioCopyPlan(
-                frameSize: 128,
-                outputOffset: 0,
-                remainingFrames: 10,
-                numberOfChannels: 2
-            )
-        )
     }
 
     func testReplaceVideoReadinessDistinguishesNoOpAndFailurePreconditions() {
@@ -239,6 +278,20 @@ final class IRFFPlayerTests: XCTestCase {
 
 }
 
+private final class AudioSessionSpyManager: IRAudioManager {
+    private(set) var registerCount = 0
+    private(set) var unregisterCount = 0
+
+    override func registerAudioSession() -> Bool {
+        registerCount += 1
+        return true
+    }
+
+    override func unregisterAudioSession() {
+        unregisterCount += 1
+    }
+}
+
 private final class FixedDurationFFDecoder: IRFFDecoder {
     private let fixedDuration: TimeInterval
 
@@ -0,0 +1,352 @@
+//
+//  IRFFPresentationSchedulerPolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFPresentationSchedulerPolicyTests: XCTestCase {
+
+    func testSelectionPresentsLastDueFrameAndDropsEarlierOnes() {
+        let vsyncInterval = 1.0 / 60.0
+
+        XCTAssertEqual(
+            IRFFPresentationSchedulerPolicy.selection(targetHostTimes: [9.95, 9.98, 10.005, 10.02],
+                                                      vsyncHostTime: 10,
+                                                      vsyncInterval: vsyncInterval),
+            .init(index: 2, droppedCount: 2)
+        )
+        XCTAssertEqual(
+            IRFFPresentationSchedulerPolicy.selection(targetHostTimes: [10.009, 10.02],
+                                                      vsyncHostTime: 10,
+                                                      vsyncInterval: vsyncInterval),
+            .init(index: nil, droppedCount: 0)
+        )
+        XCTAssertEqual(
+            IRFFPresentationSchedulerPolicy.selection(targetHostTimes: [],
+                                                      vsyncHostTime: 10,
+                                                      vsyncInterval: vsyncInterval),
+            .init(index: nil, droppedCount: 0)
+        )
+        XCTAssertEqual(
+            IRFFPresentationSchedulerPolicy.selection(targetHostTimes: [9.99, 10],
+                                                      vsyncHostTime: 10,
+                                                      vsyncInterval: .nan),
+            .init(index: 0, droppedCount: 0)
+        )
+    }
+
+    func testRepeatIsOnlyCountedOnceThePresentedFrameOutlivesItsDuration() {
+        XCTAssertFalse(IRFFPresentationSchedulerPolicy.isRepeat(presentedTargetHostTime: nil,
+                                                                presentedDuration: 0.04,
+                                                                vsyncHostTime: 10,
+                                                                vsyncInterval: 0.016))
+        XCTAssertFalse(IRFFPresentationSchedulerPolicy.isRepeat(presentedTargetHostTime: 10,
+                                                                presentedDuration: 0.04,
+                                                                vsyncHostTime: 10.032,
+                                                                vsyncInterval: 0.016))
+        XCTAssertTrue(IRFFPresentationSchedulerPolicy.isRepeat(presentedTargetHostTime: 10,
+                                                               presentedDuration: 0.04,
+                                                               vsyncHostTime: 10.05,
+                                                               vsyncInterval: 0.016))
+        XCTAssertTrue(IRFFPresentationSchedulerPolicy.isRepeat(presentedTargetHostTime: 10,
+                                                               presentedDuration: .nan,
+                                                               vsyncHostTime: 10.01,
+                                                               vsyncInterval: 0.016))
+    }
+
+    func testTargetHostTimeFollowsClockAndRejectsNonFiniteInputs() {
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 5.5,
+                                                                      clockPosition: 5,
+                                                                      clockHostTime: 100)!,
+                       100.5, accuracy: 0.000001)
+        XCTAssertNil(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: .nan,
+                                                                    clockPosition: 5,
+                                                                    clockHostTime: 100))
+        XCTAssertNil(IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 5,
+                                                                    clockPosition: .infinity,
+                                                                    clockHostTime: 100))
+    }
+
+    func testStandaloneAnchorIsKeptUntilPtsJumps() {
+        let first = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2, hostTime: 100, anchor: nil)
+        XCTAssertEqual(first.position, 2)
+        XCTAssertEqual(first.hostTime, 100)
+
+        let kept = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2.5, hostTime: 100.3, anchor: first)
+        XCTAssertEqual(kept.position, 2)
+        XCTAssertEqual(kept.hostTime, 100)
+
+        let rebased = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 30, hostTime: 100.4, anchor: first)
+        XCTAssertEqual(rebased.position, 30)
+        XCTAssertEqual(rebased.hostTime, 100.4)
+    }
+
+    func testStandaloneAnchorGivesWayToLateFramesByTheCorrectionGain() {
+        let anchor = (position: 2.0, hostTime: 100.0)
+
+        // 0.2 s late: the anchor moves a tenth of that, the early frame keeps it.
+        let corrected = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2.5, hostTime: 100.7,
+                                                                         anchor: anchor, driftCorrectionGain: 0.1)
+        XCTAssertEqual(corrected.position, 2)
+        XCTAssertEqual(corrected.hostTime, 100.02, accuracy: 1e-9)
+        let early = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2.5, hostTime: 100.3,
+                                                                     anchor: anchor, driftCorrectionGain: 0.1)
+        XCTAssertEqual(early.hostTime, 100)
+
+        let uncorrected = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2.5, hostTime: 100.7, anchor: anchor)
+        XCTAssertEqual(uncorrected.hostTime, 100)
+        let clamped = IRFFPresentationSchedulerPolicy.standaloneAnchor(framePosition: 2.5, hostTime: 100.7,
+                                                                       anchor: anchor, driftCorrectionGain: 5)
+        XCTAssertEqual(clamped.hostTime, 100.2, accuracy: 1e-9)
+    }
+
+    func testStandaloneAnchorSettlesPersistentLatenessIntoAFixedDelay() {
+        // Every frame arrives 40 ms after its pts would put it; the lateness decays.
+        var anchor: (position: TimeInterval, hostTime: TimeInterval)?
+        var lateness: [TimeInterval] = []
+        for frame in 0..<60 {
+            let position = Double(frame) * 0.04
+            let hostTime = 100 + position + (frame == 0 ? 0 : 0.04)
+            let next = IRFFDecoder.standalonePresentationAnchor(framePosition: position, hostTime: hostTime, anchor: anchor,
+                                                                driftCorrectionGain: IRFFDecoder.standaloneDriftCorrectionGain)
+            let target = IRFFDecoder.presentationTargetHostTime(framePosition: position,
+                                                                clockPosition: next.position,
+                                                                clockHostTime: next.hostTime)!
+            lateness.append(hostTime - target)
+            anchor = next
+        }
+
+        XCTAssertEqual(lateness[1], 0.036, accuracy: 1e-9)
+        XCTAssertLessThan(lateness[59], 0.001)
+        XCTAssertEqual(zip(lateness.dropFirst(), lateness.dropFirst(2)).filter { $0 < $1 }.count, 0)
+    }
+
+    func testDecoderWrappersRemainSourceCompatible() {
+        XCTAssertEqual(
+            IRFFDecoder.presentationTargetHostTime(framePosition: 3, clockPosition: 2, clockHostTime: 50),
+            IRFFPresentationSchedulerPolicy.targetHostTime(framePosition: 3, clockPosition: 2, clockHostTime: 50)
+        )
+        let anchor = IRFFDecoder.standalonePresentationAnchor(framePosition: 1, hostTime: 7, anchor: nil)
+        XCTAssertEqual(anchor.position, 1)
+        XCTAssertEqual(anchor.hostTime, 7)
+    }
+
+    // MARK: - Ring driven by a simulated clock
+
+    func testRingRejectsFramesWhenFullAndKeepsTargetsSorted() {
+        var ring = IRFFPresentationRing<Int>(capacity: 2)
+
+        XCTAssertTrue(ring.enqueue(0, targetHostTime: 10, duration: 0.04))
+        XCTAssertTrue(ring.enqueue(1, targetHostTime: 9, duration: 0.04))
+        XCTAssertTrue(ring.isFull)
+        XCTAssertFalse(ring.enqueue(2, targetHostTime: 11, duration: 0.04))
+        XCTAssertEqual(IRFFPresentationRing<Int>(capacity: 0).capacity, 1)
+
+        XCTAssertEqual(ring.frame(forVsyncAt: 10, interval: 1.0 / 60.0), 1)
+        XCTAssertEqual(ring.droppedCount, 1)
+        XCTAssertEqual(ring.count, 0)
+    }
+
+    func testFilmCadenceOnSixtyHertzPresentsEveryFrameOnce() {
+        var ring = IRFFPresentationRing<Int>()
+
+        let presented = simulate(ring: &ring, fps: 24, refreshRate: 60, vsyncCount: 60)
+
+        XCTAssertEqual(presented, Array(0..<24))
+        XCTAssertEqual(ring.presentedCount, 24)
+        XCTAssertEqual(ring.droppedCount, 0)
+        XCTAssertEqual(ring.repeatedCount, 0)
+    }
+
+    func testSixtyFramesOnThirtyHertzDropsEveryOtherFrame() {
+        var ring = IRFFPresentationRing<Int>()
+
+        let presented = simulate(ring: &ring, fps: 60, refreshRate: 30, vsyncCount: 30)
+
+        XCTAssertEqual(presented, stride(from: 0, to: 60, by: 2).map { $0 })
+        XCTAssertEqual(ring.droppedCount, 29)
+        XCTAssertEqual(ring.repeatedCount, 0)
+    }
+
+    func testStarvedProducerCountsRepeatsThenDropsLateFrames() {
+        var ring = IRFFPresentationRing<Int>()
+
+        let presented = simulate(ring: &ring, fps: 30, refreshRate: 60, vsyncCount: 60, producerStalls: 10..<30)
+
+        XCTAssertGreaterThan(ring.repeatedCount, 0)
+        XCTAssertGreaterThan(ring.droppedCount, 0)
+        XCTAssertEqual(presented, presented.sorted())
+        XCTAssertEqual(ring.presentedCount + ring.droppedCount, presented.last.map { $0 + 1 })
+    }
+
+    func testSkippedVsyncsOnlyCountAsRepeatsPastTheFrameOnScreen() {
+        // Frame on screen from 1.0 for 0.1; the link slept from 1.0 until 1.2 at 20 ms.
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.skippedRepeatCount(presentedTargetHostTime: 1.0,
+                                                                          presentedDuration: 0.1,
+                                                                          previousVsyncHostTime: 1.0,
+                                                                          vsyncHostTime: 1.2,
+                                                                          vsyncInterval: 0.02), 4)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.skippedRepeatCount(presentedTargetHostTime: 1.0,
+                                                                          presentedDuration: 0.1,
+                                                                          previousVsyncHostTime: 1.0,
+                                                                          vsyncHostTime: 1.1,
+                                                                          vsyncInterval: 0.02), 0)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.skippedRepeatCount(presentedTargetHostTime: nil,
+                                                                          presentedDuration: 0.1,
+                                                                          previousVsyncHostTime: 1.0,
+                                                                          vsyncHostTime: 2.0,
+                                                                          vsyncInterval: 0.02), 0)
+        XCTAssertEqual(IRFFPresentationSchedulerPolicy.skippedRepeatCount(presentedTargetHostTime: 1.0,
+                                                                          presentedDuration: 0.1,
+                                                                          previousVsyncHostTime: 1.0,
+                                                                          vsyncHostTime: 2.0,
+                                                                          vsyncInterval: 0), 0)
+    }
+
+    func testPausingTheLinkWhileIdleKeepsTheSameStatistics() {
+        var continuous = IRFFPresentationRing<Int>()
+        var paused = IRFFPresentationRing<Int>()
+
+        let presented = simulate(ring: &continuous, fps: 25, refreshRate: 60, vsyncCount: 120, producerStalls: 5..<50)
+        let presentedWhilePausing = simulate(ring: &paused, fps: 25, refreshRate: 60, vsyncCount: 120,
+                                             producerStalls: 5..<50, pausesWhenIdle: true)
+
+        XCTAssertEqual(presentedWhilePausing, presented)
+        XCTAssertGreaterThan(continuous.repeatedCount, 0)
+        XCTAssertEqual(paused.repeatedCount, continuous.repeatedCount)
+        XCTAssertEqual(paused.droppedCount, continuous.droppedCount)
+    }
+
+    func testSuspendFreezesPresentationAndResumeShiftsQueuedTargets() {
+        var ring = IRFFPresentationRing<Int>()
+        ring.enqueue(0, targetHostTime: 1.0, duration: 0.1)
+        ring.enqueue(1, targetHostTime: 1.1, duration: 0.1)
+
+        XCTAssertTrue(ring.needsVsync)
+        ring.suspend(at: 0.5)
+        XCTAssertTrue(ring.isSuspended)
+        XCTAssertFalse(ring.needsVsync)
+        XCTAssertNil(ring.frame(forVsyncAt: 2.0, interval: 0.016))
+        XCTAssertEqual(ring.count, 2)
+
+        ring.resume(at: 3.0)
+        XCTAssertFalse(ring.isSuspended)
+        XCTAssertNil(ring.frame(forVsyncAt: 3.0, interval: 0.016))
+        XCTAssertEqual(ring.frame(forVsyncAt: 3.5, interval: 0.016), 0)
+        XCTAssertEqual(ring.frame(forVsyncAt: 3.6, interval: 0.016), 1)
+        XCTAssertEqual(ring.droppedCount, 0)
+        XCTAssertEqual(ring.repeatedCount, 0)
+    }
+
+    func testRemoveAllClearsQueueButKeepsCounters() {
+        var ring = IRFFPresentationRing<Int>()
+        ring.enqueue(0, targetHostTime: 1.0, duration: 0.1)
+        ring.enqueue(1, targetHostTime: 1.1, duration: 0.1)
+        XCTAssertEqual(ring.frame(forVsyncAt: 1.2, interval: 0.016), 1)
+
+        ring.removeAll()
+
+        XCTAssertEqual(ring.count, 0)
+        XCTAssertEqual(ring.droppedCount, 1)
+        XCTAssertNil(ring.frame(forVsyncAt: 5, interval: 0.016))
+        XCTAssertEqual(ring.repeatedCount, 0)
+    }
+
+    func testResetCountersStartsStatisticsOver() {
+        var ring = IRFFPresentationRing<Int>()
+        _ = simulate(ring: &ring, fps: 60, refreshRate: 30, vsyncCount: 4)
+        XCTAssertGreaterThan(ring.droppedCount, 0)
+
+        ring.resetCounters()
+
+        XCTAssertEqual(ring.presentedCount, 0)
+        XCTAssertEqual(ring.droppedCount, 0)
+        XCTAssertEqual(ring.repeatedCount, 0)
+    }
+
+    func testSchedulerReleasesWaitingProducerWhenAVsyncConsumesAFrame() {
+        let scheduler = IRFFPresentationScheduler(capacity: 1)
+        let frame = IRFFAVYUVVideoFrame()
+        XCTAssertTrue(scheduler.enqueue(frame, targetHostTime: 1))
+        XCTAssertFalse(scheduler.waitForSpace(until: .now() + .milliseconds(10)))
+
+        let released = expectation(description: "producer sees free space")
+        DispatchQueue.global().async {
+            XCTAssertTrue(scheduler.waitForSpace(until: .now() + 1))
+            released.fulfill()
+        }
+        Thread.sleep(forTimeInterval: 0.02)
+        XCTAssertTrue(scheduler.frame(forVsyncAt: 2, interval: 0.016) === frame)
+
+        wait(for: [released], timeout: 1)
+        XCTAssertEqual(scheduler.presentedFrameCount, 1)
+        XCTAssertEqual(scheduler.droppedFrameCount, 0)
+    }
+
+    func testSchedulerOnlyDemandsVsyncsWhileActiveWithQueuedFrames() {
+        let scheduler = IRFFPresentationScheduler(capacity: 2)
+        var demandChanges = 0
+        scheduler.setVsyncDemandHandler { demandChanges += 1 }
+
+        XCTAssertTrue(scheduler.enqueue(IRFFAVYUVVideoFrame(), targetHostTime: 1))
+        XCTAssertFalse(scheduler.needsVsync)
+        XCTAssertEqual(demandChanges, 0)
+
+        scheduler.setActive(true)
+        XCTAssertTrue(scheduler.needsVsync)
+        XCTAssertEqual(demandChanges, 1)
+        XCTAssertTrue(scheduler.enqueue(IRFFAVYUVVideoFrame(), targetHostTime: 1))
+        XCTAssertEqual(demandChanges, 1)
+
+        scheduler.suspend(at: 1)
+        XCTAssertFalse(scheduler.needsVsync)
+        scheduler.resume(at: 1)
+        XCTAssertTrue(scheduler.needsVsync)
+        XCTAssertEqual(demandChanges, 3)
+
+        XCTAssertNotNil(scheduler.frame(forVsyncAt: 2, interval: 0.016))
+        XCTAssertFalse(scheduler.needsVsync)
+        XCTAssertEqual(demandChanges, 4)
+    }
+
+    /// Drives a ring from a simulated clock: before each vsync the producer tops the
+    /// ring up with frames stamped at their pts (plus a small phase so no target lands
+    /// exactly on a selection boundary), unless it is stalled for that vsync.
+    private func simulate(ring: inout IRFFPresentationRing<Int>,
+                          fps: Double,
+                          refreshRate: Double,
+                          vsyncCount: Int,
+                          producerStalls: Range<Int> = 0..<0,
+                          pausesWhenIdle: Bool = false) -> [Int] {
+        let startHostTime: TimeInterval = 100
+        let phase: TimeInterval = 0.001
+        let frameInterval = 1.0 / fps
+        let vsyncInterval = 1.0 / refreshRate
+        var nextFrame = 0
+        var presented: [Int] = []
+        for vsync in 0..<vsyncCount {
+            if !producerStalls.contains(vsync) {
+                while !ring.isFull {
+                    ring.enqueue(nextFrame,
+                                 targetHostTime: startHostTime + Double(nextFrame) * frameInterval + phase,
+                                 duration: frameInterval)
+                    nextFrame += 1
+                }
+            }
+            // A paused link is woken by the enqueue, so it skips exactly the vsyncs
+            // that find nothing queued.
+            if pausesWhenIdle, !ring.needsVsync {
+                continue
+            }
+            let vsyncHostTime = startHostTime + Double(vsync) * vsyncInterval
+            if let frame = ring.frame(forVsyncAt: vsyncHostTime, interval: vsyncInterval) {
+                presented.append(frame)
+            }
+        }
+        return presented
+    }
+}
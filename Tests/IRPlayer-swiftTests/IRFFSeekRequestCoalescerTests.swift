@@ -0,0 +1,69 @@
+//
+//  IRFFSeekRequestCoalescerTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFSeekRequestCoalescerTests: XCTestCase {
+
+    func testOnlyTheLatestOfRapidSeeksIsHonoured() {
+        let coalescer = IRFFSeekRequestCoalescer()
+        var results: [String] = []
+
+        coalescer.submit(time: 1) { results.append("1:\($0)") }
+        coalescer.submit(time: 2) { results.append("2:\($0)") }
+        coalescer.submit(time: 3) { results.append("3:\($0)") }
+
+        XCTAssertTrue(coalescer.isPending)
+        let request = coalescer.pendingRequest()
+        XCTAssertEqual(request?.time, 3)
+        XCTAssertTrue(coalescer.complete(request!))
+        XCTAssertFalse(coalescer.isPending)
+        XCTAssertNil(coalescer.pendingRequest())
+        XCTAssertEqual(results, ["1:false", "2:false", "3:true"])
+    }
+
+    func testASeekArrivingWhileOneIsAppliedStaysPending() {
+        let coalescer = IRFFSeekRequestCoalescer()
+        var results: [String] = []
+        coalescer.submit(time: 1) { results.append("1:\($0)") }
+        let applying = coalescer.pendingRequest()!
+
+        coalescer.submit(time: 1) { results.append("again:\($0)") }
+
+        XCTAssertFalse(coalescer.complete(applying))
+        XCTAssertTrue(coalescer.isPending)
+        XCTAssertNotEqual(coalescer.pendingRequest(), applying)
+        XCTAssertEqual(results, ["1:false"])
+    }
+
+    func testCancelFailsThePendingSeek() {
+        let coalescer = IRFFSeekRequestCoalescer()
+        var results: [Bool] = []
+        coalescer.submit(time: 1) { results.append($0) }
+
+        coalescer.cancel()
+        coalescer.cancel()
+
+        XCTAssertFalse(coalescer.isPending)
+        XCTAssertEqual(results, [false])
+    }
+
+    func testDecoderRefusesSeeksBeforeOpening() {
+        let decoder = IRFFDecoder(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
+                                  videoFormat: .mpeg4,
+                                  videoOutput: nil,
+                                  audioOutput: nil)
+        var result: Bool?
+
+        // Nothing is open, so the seek is refused outright.
+        decoder.seek(to: 1) { result = $0 }
+
+        XCTAssertEqual(result, false)
+        XCTAssertFalse(decoder.seeking)
+    }
+}
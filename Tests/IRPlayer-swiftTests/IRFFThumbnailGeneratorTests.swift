@@ -0,0 +1,218 @@
+//
+//  IRFFThumbnailGeneratorTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFThumbnailGeneratorTests: XCTestCase {
+
+    // MARK: - Policy
+
+    func testTimeBucketsGroupNearbyRequests() {
+        XCTAssertEqual(IRFFThumbnailPolicy.timeBucket(for: 0, bucketDuration: 1), 0)
+        XCTAssertEqual(IRFFThumbnailPolicy.timeBucket(for: 4.99, bucketDuration: 1), 4)
+        XCTAssertEqual(IRFFThumbnailPolicy.timeBucket(for: 5, bucketDuration: 2.5), 2)
+        XCTAssertNil(IRFFThumbnailPolicy.timeBucket(for: -1, bucketDuration: 1))
+        XCTAssertNil(IRFFThumbnailPolicy.timeBucket(for: .nan, bucketDuration: 1))
+        XCTAssertNil(IRFFThumbnailPolicy.timeBucket(for: 1, bucketDuration: 0))
+    }
+
+    func testBatchTimesSitInTheMiddleOfEvenSlots() {
+        XCTAssertEqual(IRFFThumbnailPolicy.batchTimes(count: 4, duration: 10), [1.25, 3.75, 6.25, 8.75])
+        XCTAssertEqual(IRFFThumbnailPolicy.batchTimes(count: 0, duration: 10), [])
+        XCTAssertEqual(IRFFThumbnailPolicy.batchTimes(count: 3, duration: 0), [])
+        XCTAssertEqual(IRFFThumbnailPolicy.batchTimes(count: 3, duration: TimeInterval(MAXFLOAT)), [])
+    }
+
+    func testFittedSizeKeepsAspectAndNeverUpscales() {
+        XCTAssertTrue(IRFFThumbnailPolicy.fittedSize(sourceWidth: 1920, sourceHeight: 1080, maxWidth: 160, maxHeight: 160)! == (160, 90))
+        XCTAssertTrue(IRFFThumbnailPolicy.fittedSize(sourceWidth: 1080, sourceHeight: 1920, maxWidth: 160, maxHeight: 160)! == (90, 160))
+        XCTAssertTrue(IRFFThumbnailPolicy.fittedSize(sourceWidth: 100, sourceHeight: 50, maxWidth: 400, maxHeight: 400)! == (100, 50))
+        XCTAssertTrue(IRFFThumbnailPolicy.fittedSize(sourceWidth: 4000, sourceHeight: 1, maxWidth: 10, maxHeight: 10)! == (10, 1))
+        XCTAssertNil(IRFFThumbnailPolicy.fittedSize(sourceWidth: 0, sourceHeight: 50, maxWidth: 10, maxHeight: 10))
+        XCTAssertNil(IRFFThumbnailPolicy.fittedSize(sourceWidth: 100, sourceHeight: 50, maxWidth: 10, maxHeight: 0))
+    }
+
+    func testBytesPerRowIsAlignedRGB24() {
+        XCTAssertEqual(IRFFThumbnailPolicy.bytesPerRow(width: 160), 480)
+        XCTAssertEqual(IRFFThumbnailPolicy.bytesPerRow(width: 90), 288)
+        XCTAssertEqual(IRFFThumbnailPolicy.bytesPerRow(width: 1), 32)
+        XCTAssertNil(IRFFThumbnailPolicy.bytesPerRow(width: 0))
+        XCTAssertNil(IRFFThumbnailPolicy.bytesPerRow(width: Int.max))
+    }
+
+    // MARK: - Cache
+
+    func testCacheEvictsTheLeastRecentlyUsedThumbnail() {
+        let cache = IRFFThumbnailCache(capacity: 2)
+        let first = Self.key(bucket: 1)
+        let second = Self.key(bucket: 2)
+        let third = Self.key(bucket: 3)
+        cache.insert(Self.thumbnail(at: 1), for: first)
+        cache.insert(Self.thumbnail(at: 2), for: second)
+
+        XCTAssertEqual(cache.thumbnail(for: first)?.requestedTime, 1)
+        cache.insert(Self.thumbnail(at: 3), for: third)
+
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertNotNil(cache.thumbnail(for: first))
+        XCTAssertNil(cache.thumbnail(for: second))
+        XCTAssertNotNil(cache.thumbnail(for: third))
+
+        cache.removeAll()
+        XCTAssertEqual(cache.count, 0)
+        XCTAssertNil(cache.thumbnail(for: first))
+    }
+
+    func testCacheEvictsByPixelBytesAsWellAsCount() {
+        let cache = IRFFThumbnailCache(capacity: 8, byteCapacity: 100)
+        cache.insert(Self.thumbnail(at: 1, byteCount: 40), for: Self.key(bucket: 1))
+        cache.insert(Self.thumbnail(at: 2, byteCount: 40), for: Self.key(bucket: 2))
+        XCTAssertEqual(cache.byteCount, 80)
+
+        cache.insert(Self.thumbnail(at: 3, byteCount: 40), for: Self.key(bucket: 3))
+        XCTAssertEqual(cache.count, 2)
+        XCTAssertEqual(cache.byteCount, 80)
+        XCTAssertNil(cache.thumbnail(for: Self.key(bucket: 1)))
+
+        // Replacing an entry charges only the difference.
+        cache.insert(Self.thumbnail(at: 3, byteCount: 60), for: Self.key(bucket: 3))
+        XCTAssertEqual(cache.count, 1)
+        XCTAssertEqual(cache.byteCount, 60)
+        XCTAssertNotNil(cache.thumbnail(for: Self.key(bucket: 3)))
+
+        // Larger than the whole budget: not kept, and nothing is evicted for it.
+        cache.insert(Self.thumbnail(at: 4, byteCount: 101), for: Self.key(bucket: 4))
+        XCTAssertEqual(cache.count, 1)
+        XCTAssertEqual(cache.byteCount, 60)
+        XCTAssertNil(cache.thumbnail(for: Self.key(bucket: 4)))
+
+        XCTAssertTrue(IRFFThumbnailPolicy.cacheIsOverLimit(count: 3, byteCount: 0, capacity: 2, byteCapacity: 100))
+        XCTAssertTrue(IRFFThumbnailPolicy.cacheIsOverLimit(count: 1, byteCount: 101, capacity: 2, byteCapacity: 100))
+        XCTAssertFalse(IRFFThumbnailPolicy.cacheIsOverLimit(count: 2, byteCount: 100, capacity: 2, byteCapacity: 100))
+        XCTAssertFalse(IRFFThumbnailPolicy.cacheIsOverLimit(count: 0, byteCount: 0, capacity: 2, byteCapacity: 0))
+    }
+
+    func testCacheKeysSeparateURLsAndSizes() {
+        let cache = IRFFThumbnailCache(capacity: 8)
+        cache.insert(Self.thumbnail(at: 1), for: Self.key(bucket: 1))
+        cache.insert(Self.thumbnail(at: 7), for: Self.key(bucket: 1))
+
+        XCTAssertEqual(cache.count, 1)
+        XCTAssertEqual(cache.thumbnail(for: Self.key(bucket: 1))?.requestedTime, 7)
+        XCTAssertNil(cache.thumbnail(for: Self.key(bucket: 1, url: URL(fileURLWithPath: "/tmp/other.mp4"))))
+        XCTAssertNil(cache.thumbnail(for: Self.key(bucket: 1, maxWidth: 320)))
+    }
+
+    // MARK: - Generator
+
+    func testThumbnailShowsTheKeyFrameAtOrBeforeTheRequestedTime() throws {
+        let generator = try makeGenerator()
+
+        let thumbnail = try XCTUnwrap(generator.thumbnailSync(at: 5.03, maxWidth: 160, maxHeight: 160))
+
+        XCTAssertEqual(thumbnail.position, 5, accuracy: 0.0001)
+        XCTAssertEqual(thumbnail.width, 160)
+        XCTAssertEqual(thumbnail.height, 120)
+        XCTAssertEqual(thumbnail.bytesPerRow, 480)
+        XCTAssertEqual(thumbnail.pixels.count, 480 * 120)
+        // Frame 125 is a flat full-range grey of luma 125.
+        XCTAssertEqual(Int(thumbnail.pixels[0]), 125, accuracy: 2)
+        XCTAssertEqual(Int(thumbnail.pixels[60 * 480 + 80 * 3 + 1]), 125, accuracy: 2)
+    }
+
+    func testRequestsInTheSameBucketAreServedFromTheCache() throws {
+        let generator = try makeGenerator()
+
+        let first = generator.thumbnailSync(at: 3.1, maxWidth: 64, maxHeight: 64)
+        let second = generator.thumbnailSync(at: 3.9, maxWidth: 64, maxHeight: 64)
+        _ = generator.thumbnailSync(at: 3.9, maxWidth: 32, maxHeight: 32)
+
+        XCTAssertEqual(first?.requestedTime, 3.1)
+        XCTAssertEqual(second?.requestedTime, 3.1)
+        XCTAssertEqual(generator.decodedKeyFrameCount, 2)
+    }
+
+    func testBatchSpreadsThumbnailsAcrossTheDuration() throws {
+        let generator = try makeGenerator()
+
+        let thumbnails = generator.thumbnailsSync(count: 5, maxWidth: 80, maxHeight: 80)
+
+        XCTAssertEqual(thumbnails.map(\.requestedTime), [1, 3, 5, 7, 9])
+        for thumbnail in thumbnails {
+            // Every stand-in frame is a key frame, so each lands on the frame at or
+            // just before its time rather than on a key frame indexed earlier.
+            XCTAssertLessThanOrEqual(thumbnail.position, thumbnail.requestedTime + 0.0001)
+            XCTAssertGreaterThan(thumbnail.position, thumbnail.requestedTime - 1.0 / 25)
+        }
+    }
+
+    func testAsyncBatchCallsBackOnTheRequestedQueue() throws {
+        let generator = try makeGenerator()
+        let callbackQueue = DispatchQueue(label: "IRFFThumbnailGeneratorTests")
+        let key = DispatchSpecificKey<Bool>()
+        callbackQueue.setSpecific(key: key, value: true)
+        let done = expectation(description: "thumbnails")
+
+        generator.thumbnails(count: 2, maxWidth: 40, maxHeight: 40, callbackQueue: callbackQueue) { thumbnails in
+            XCTAssertEqual(DispatchQueue.getSpecific(key: key), true)
+            XCTAssertEqual(thumbnails.count, 2)
+            done.fulfill()
+        }
+
+        wait(for: [done], timeout: 10)
+    }
+
+    func testMissingFileYieldsNoThumbnails() {
+        let generator = IRFFThumbnailGenerator(contentURL: URL(fileURLWithPath: "/tmp/missing.mp4"),
+                                               videoFormat: .unknown,
+                                               bucketDuration: 1,
+                                               cache: IRFFThumbnailCache(capacity: 4))
+
+        XCTAssertNil(generator.thumbnailSync(at: 1, maxWidth: 64, maxHeight: 64))
+        XCTAssertEqual(generator.thumbnailsSync(count: 4, maxWidth: 64, maxHeight: 64).count, 0)
+    }
+
+    /// Twenty uncached scrub thumbnails, decoding and scaling each key frame.
+    func testBenchmarkBatchOfTwentyThumbnails() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+
+        measure {
+            let generator = IRFFThumbnailGenerator(contentURL: url,
+                                                   videoFormat: .unknown,
+                                                   bucketDuration: 0.1,
+                                                   cache: IRFFThumbnailCache(capacity: 64))
+            XCTAssertEqual(generator.thumbnailsSync(count: 20, maxWidth: 160, maxHeight: 90).count, 20)
+        }
+    }
+
+    // MARK: - Helpers
+
+    private func makeGenerator() throws -> IRFFThumbnailGenerator {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        return IRFFThumbnailGenerator(contentURL: url,
+                                      videoFormat: .unknown,
+                                      bucketDuration: 1,
+                                      cache: IRFFThumbnailCache(capacity: 16))
+    }
+
+    private static func key(bucket: Int64,
+                            url: URL = URL(fileURLWithPath: "/tmp/clip.mp4"),
+                            maxWidth: Int = 160) -> IRFFThumbnailKey {
+        return IRFFThumbnailKey(url: url, bucket: bucket, maxWidth: maxWidth, maxHeight: 90)
+    }
+
+    private static func thumbnail(at time: TimeInterval, byteCount: Int = 32) -> IRFFThumbnail {
+        return IRFFThumbnail(requestedTime: time, position: time, width: 1, height: 1, bytesPerRow: byteCount, pixels: Data(count: byteCount))
+    }
+}
@@ -128,6 +128,11 @@ final class IRFFVideoDecoderTests: XCTestCase {
         XCTAssertTrue(IRFFVideoDecoder.packetDecodeResultIsFailure(-1))
     }
 
+    func testSkipFrameDiscardOnlyDropsNonReferenceFramesWhileLagging() {
+        XCTAssertEqual(IRFFVideoDecoder.skipFrameDiscard(skippingNonReferenceFrames: true), AVDISCARD_NONREF)
+        XCTAssertEqual(IRFFVideoDecoder.skipFrameDiscard(skippingNonReferenceFrames: false), AVDISCARD_DEFAULT)
+    }
+
     func testShouldFinishDecodeRequiresEndOfFileAndEmptyPacketQueue() {
         XCTAssertFalse(IRFFVideoDecoder.shouldFinishDecode(endOfFile: false, packetEmpty: true))
         XCTAssertFalse(IRFFVideoDecoder.shouldFinishDecode(endOfFile: true, packetEmpty: false))
@@ -182,6 +187,39 @@ final class IRFFVideoDecoderTests: XCTestCase {
         )
     }
 
+    func testFrameThreadedSoftwareDecodeQueuesEveryFrameThroughEndOfFile() throws {
+        let url = try makeVideoStandIn()
+        addTeardownBlock {
+            try? FileManager.default.removeItem(at: url)
+        }
+        let context = IRFFFormatContext(contentURL: url, videoFormat: .unknown)
+        context.videoThreading = IRDecoderThreading(threadCount: 4, threadType: .frame)
+        context.setupSync()
+        let codecContext = try XCTUnwrap(context.videoCodecContext)
+        let decoder = IRFFVideoDecoder(codecContext: codecContext,
+                                       timebase: context.videoTimebase,
+                                       fps: context.videoFPS,
+                                       delegate: nil)
+        decoder.videoToolBoxEnable = false
+        decoder.maxDecodeDuration = 60
+
+        var packet = AVPacket()
+        while context.readFrame(&packet) >= 0 {
+            decoder.putPacket(packet)
+        }
+        decoder.endOfFile = true
+        decoder.decodeFrameThread()
+
+        var positions: [TimeInterval] = []
+        while let frame = decoder.getFrameAsync() {
+            positions.append(frame.position)
+        }
+        XCTAssertEqual(positions.count, 250)
+        XCTAssertEqual(positions.last ?? -1, 9.96, accuracy: 0.0001)
+        decoder.destroy()
+        context.destroy()
+    }
+
     func testReleaseDoesNotPrintDebugOutput() {
         var codecContext = AVCodecContext()
 
@@ -0,0 +1,164 @@
+//
+//  IRFFVideoToolBoxBitstreamPolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import Foundation
+import IRFFMpeg
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFVideoToolBoxBitstreamPolicyTests: XCTestCase {
+
+    // avcC for a High profile, level 3.1 stream: one SPS, one PPS, 4-byte NAL lengths.
+    private let avcC: [UInt8] = [
+        0x01, 0x64, 0x00, 0x1F, 0xFF, 0xE1, 0x00, 0x08,
+        0x67, 0x64, 0x00, 0x1F, 0xAC, 0xD9, 0x40, 0x50,
+        0x01, 0x00, 0x04, 0x68, 0xEB, 0xE3, 0xCB
+    ]
+
+    // hvcC for a Main profile, level 3.1 stream with a single VPS array, 4-byte NAL lengths.
+    private let hvcC: [UInt8] = [
+        0x01, 0x01, 0x60, 0x00, 0x00, 0x00, 0x90, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x5D, 0xF0, 0x00, 0xFC,
+        0xFD, 0xF8, 0xF8, 0x00, 0x00, 0x0F, 0x01,
+        0xA0, 0x00, 0x01, 0x00, 0x04, 0x40, 0x01, 0x0C, 0x01
+    ]
+
+    private func withNALLengthSize(_ record: [UInt8], offset: Int, lengthSize: Int) -> [UInt8] {
+        var record = record
+        record[offset] = (record[offset] & ~0x03) | UInt8(lengthSize - 1)
+        return record
+    }
+
+    func testCodecMapsH264AndHEVCOnly() {
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.codec(for: AV_CODEC_ID_H264), .h264)
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.codec(for: AV_CODEC_ID_HEVC), .hevc)
+        XCTAssertNil(IRFFVideoToolBoxPolicy.codec(for: AV_CODEC_ID_VP9))
+        XCTAssertTrue(IRFFVideoToolBox.supportsCodec(AV_CODEC_ID_HEVC))
+        XCTAssertFalse(IRFFVideoToolBox.supportsCodec(AV_CODEC_ID_AAC))
+    }
+
+    func testSetupValidationUsesPerCodecMinimumRecordSize() {
+        let extradata = UnsafeMutablePointer<UInt8>(bitPattern: 1)
+        XCTAssertEqual(
+            IRFFVideoToolBoxPolicy.setupValidationError(codecID: AV_CODEC_ID_HEVC, extradata: extradata, extradataSize: 22, firstExtradataByte: 1),
+            .extradataSize
+        )
+        XCTAssertNil(
+            IRFFVideoToolBoxPolicy.setupValidationError(codecID: AV_CODEC_ID_HEVC, extradata: extradata, extradataSize: 23, firstExtradataByte: 1)
+        )
+    }
+
+    func testAVCConfigurationRecordKeepsFourByteLengths() throws {
+        let record = try XCTUnwrap(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .h264, extradata: avcC))
+
+        XCTAssertEqual(record.bytes, avcC)
+        XCTAssertEqual(record.sourceNALLengthSize, 4)
+        XCTAssertFalse(record.needsNALLengthConversion)
+    }
+
+    func testAVCConfigurationRecordWidensThreeByteLengths() throws {
+        let threeByte = withNALLengthSize(avcC, offset: 4, lengthSize: 3)
+        XCTAssertEqual(threeByte[4], 0xFE)
+
+        let record = try XCTUnwrap(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .h264, extradata: threeByte))
+
+        XCTAssertEqual(record.bytes, avcC)
+        XCTAssertEqual(record.sourceNALLengthSize, 3)
+        XCTAssertTrue(record.needsNALLengthConversion)
+    }
+
+    func testHEVCConfigurationRecordWidensThreeByteLengths() throws {
+        let threeByte = withNALLengthSize(hvcC, offset: 21, lengthSize: 3)
+
+        let record = try XCTUnwrap(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .hevc, extradata: threeByte))
+
+        XCTAssertEqual(record.bytes, hvcC)
+        XCTAssertEqual(record.bytes[21] & 0x03, 3)
+        XCTAssertEqual(record.bytes[21] & ~0x03, hvcC[21] & ~0x03)
+        XCTAssertTrue(record.needsNALLengthConversion)
+    }
+
+    func testConfigurationRecordKeepsTwoByteLengthsForVideoToolbox() throws {
+        let twoByte = withNALLengthSize(hvcC, offset: 21, lengthSize: 2)
+
+        let record = try XCTUnwrap(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .hevc, extradata: twoByte))
+
+        XCTAssertEqual(record.bytes, twoByte)
+        XCTAssertEqual(record.sourceNALLengthSize, 2)
+        XCTAssertFalse(record.needsNALLengthConversion)
+    }
+
+    func testConfigurationRecordRejectsAnnexBAndTruncatedExtradata() {
+        let annexB: [UInt8] = [0x00, 0x00, 0x00, 0x01, 0x67, 0x64, 0x00, 0x1F, 0x00, 0x00, 0x01, 0x68, 0xEB]
+        XCTAssertTrue(IRFFVideoToolBoxBitstreamPolicy.isAnnexB(annexB))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .h264, extradata: annexB))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .hevc, extradata: Array(hvcC.prefix(22))))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .h264, extradata: Array(avcC.prefix(6))))
+        var wrongVersion = avcC
+        wrongVersion[0] = 2
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.configurationRecord(codec: .h264, extradata: wrongVersion))
+    }
+
+    func testConvertThreeByteH264PacketToFourByteLengths() {
+        // IDR slice followed by an SEI, both with 3-byte length prefixes.
+        let packet: [UInt8] = [0x00, 0x00, 0x03, 0x65, 0x88, 0x84, 0x00, 0x00, 0x02, 0x06, 0x05]
+
+        let converted = IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes(packet, sourceNALLengthSize: 3)
+
+        XCTAssertEqual(converted, [0x00, 0x00, 0x00, 0x03, 0x65, 0x88, 0x84, 0x00, 0x00, 0x00, 0x02, 0x06, 0x05])
+    }
+
+    func testConvertThreeByteHEVCPacketToFourByteLengths() {
+        // IDR_W_RADL slice header bytes with a 3-byte length prefix.
+        let packet: [UInt8] = [0x00, 0x00, 0x04, 0x26, 0x01, 0xAF, 0x06]
+
+        let converted = IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes(packet, sourceNALLengthSize: 3)
+
+        XCTAssertEqual(converted, [0x00, 0x00, 0x00, 0x04, 0x26, 0x01, 0xAF, 0x06])
+    }
+
+    func testConvertHandlesEmptyNALUnitsAndOtherPrefixSizes() {
+        XCTAssertEqual(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x00, 0x00], sourceNALLengthSize: 3), [0x00, 0x00, 0x00, 0x00])
+        XCTAssertEqual(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x01, 0x09], sourceNALLengthSize: 2), [0x00, 0x00, 0x00, 0x01, 0x09])
+        XCTAssertEqual(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x01, 0x09], sourceNALLengthSize: 1), [0x00, 0x00, 0x00, 0x01, 0x09])
+        XCTAssertEqual(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x00, 0x00, 0x01, 0x09], sourceNALLengthSize: 4), [0x00, 0x00, 0x00, 0x01, 0x09])
+        XCTAssertEqual(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([], sourceNALLengthSize: 3), [])
+    }
+
+    func testConvertRejectsTruncatedPacketsAndInvalidPrefixSizes() {
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x00], sourceNALLengthSize: 3))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x00, 0x05, 0x01, 0x02], sourceNALLengthSize: 3))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x00, 0x00, 0x01, 0x65, 0x00], sourceNALLengthSize: 3))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x01, 0x09], sourceNALLengthSize: 0))
+        XCTAssertNil(IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes([0x01, 0x09], sourceNALLengthSize: 5))
+    }
+
+    func testConvertIntoDestinationRequiresEnoughSpace() {
+        let packet: [UInt8] = [0x00, 0x00, 0x01, 0x65]
+        var destination = [UInt8](repeating: 0, count: 4)
+
+        let written = packet.withUnsafeBytes { source in
+            destination.withUnsafeMutableBytes { target in
+                IRFFVideoToolBoxBitstreamPolicy.convertNALLengthPrefixes(source, sourceNALLengthSize: 3, into: target)
+            }
+        }
+
+        XCTAssertNil(written)
+        XCTAssertEqual(packet.withUnsafeBytes { IRFFVideoToolBoxBitstreamPolicy.convertedPacketSize($0, sourceNALLengthSize: 3) }, 5)
+    }
+
+    func testFormatDescriptionExtensionsUseHVCCAtomForHEVC() throws {
+        let extensions: NSDictionary = try hvcC.withUnsafeBufferPointer { buffer in
+            let pointer = try XCTUnwrap(buffer.baseAddress)
+            return IRFFVideoToolBox.makeFormatDescriptionExtensions(extradata: pointer, extradataSize: Int32(buffer.count), codec: .hevc) as NSDictionary
+        }
+
+        let atoms = try XCTUnwrap(extensions["SampleDescriptionExtensionAtoms"] as? NSDictionary)
+        XCTAssertEqual((atoms["hvcC"] as? Data).map(Array.init), hvcC)
+        XCTAssertNil(atoms["avcC"])
+    }
+}
@@ -0,0 +1,146 @@
+//
+//  IRFFVideoToolBoxReorderBufferTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import CoreMedia
+import Foundation
+import IRFFMpeg
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRFFVideoToolBoxReorderBufferTests: XCTestCase {
+
+    private func emitted(decodeOrder: [TimeInterval], depth: Int) -> [TimeInterval] {
+        var buffer = IRFFVideoToolBoxReorderBuffer<TimeInterval>(depth: depth)
+        var output: [TimeInterval] = []
+        for pts in decodeOrder {
+            buffer.insert(pts, pts: pts)
+            while let ready = buffer.popReady() {
+                output.append(ready)
+            }
+        }
+        return output + buffer.drain()
+    }
+
+    func testIBBPDecodeOrderLeavesInPresentationOrder() {
+        // I0 P3 B1 B2 P6 B4 B5: one GOP with two B-frames between references.
+        let decodeOrder: [TimeInterval] = [0, 3, 1, 2, 6, 4, 5]
+
+        XCTAssertEqual(emitted(decodeOrder: decodeOrder, depth: 2), [0, 1, 2, 3, 4, 5, 6])
+    }
+
+    func testPyramidDecodeOrderNeedsMatchingDepth() {
+        // Hierarchical B: I0 P4 B2 b1 b3.
+        let decodeOrder: [TimeInterval] = [0, 4, 2, 1, 3]
+
+        XCTAssertEqual(emitted(decodeOrder: decodeOrder, depth: 2), [0, 1, 2, 3, 4])
+        XCTAssertNotEqual(emitted(decodeOrder: decodeOrder, depth: 1), [0, 1, 2, 3, 4])
+    }
+
+    func testZeroDepthPassesPicturesThroughImmediately() {
+        var buffer = IRFFVideoToolBoxReorderBuffer<Int>(depth: 0)
+
+        buffer.insert(1, pts: 0.5)
+        XCTAssertEqual(buffer.popReady(), 1)
+        XCTAssertNil(buffer.popReady())
+        XCTAssertEqual(IRFFVideoToolBoxReorderBuffer<Int>(depth: -3).depth, 0)
+    }
+
+    func testHoldsPicturesUntilDepthIsExceeded() {
+        var buffer = IRFFVideoToolBoxReorderBuffer<Int>(depth: 2)
+
+        buffer.insert(2, pts: 0.2)
+        buffer.insert(1, pts: 0.1)
+        XCTAssertNil(buffer.popReady())
+        buffer.insert(3, pts: 0.3)
+
+        XCTAssertEqual(buffer.popReady(), 1)
+        XCTAssertNil(buffer.popReady())
+        XCTAssertEqual(buffer.count, 2)
+    }
+
+    func testEqualTimestampsKeepArrivalOrderAndNonFiniteSortLast() {
+        var buffer = IRFFVideoToolBoxReorderBuffer<String>(depth: 8)
+
+        buffer.insert("nan", pts: .nan)
+        buffer.insert("first", pts: 1)
+        buffer.insert("second", pts: 1)
+        buffer.insert("early", pts: 0)
+
+        XCTAssertEqual(buffer.drain(), ["early", "first", "second", "nan"])
+        XCTAssertTrue(buffer.isEmpty)
+    }
+
+    func testRemoveAllDiscardsBufferedPictures() {
+        var buffer = IRFFVideoToolBoxReorderBuffer<Int>(depth: 1)
+        buffer.insert(1, pts: 1)
+        buffer.insert(2, pts: 2)
+
+        buffer.removeAll()
+
+        XCTAssertTrue(buffer.drain().isEmpty)
+    }
+
+    func testReorderDepthFollowsCodecDelayWithinBounds() {
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.reorderDepth(hasBFrames: 0), 0)
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.reorderDepth(hasBFrames: 2), 2)
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.reorderDepth(hasBFrames: -1), 0)
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.reorderDepth(hasBFrames: 64), 16)
+    }
+
+    func testSampleTimingRoundTripsPresentationTime() {
+        let timing = IRFFVideoToolBoxPolicy.sampleTiming(position: 12.345678, duration: 1.0 / 30.0)
+
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.seconds(from: timing.presentationTimeStamp) ?? 0, 12.345678, accuracy: 0.000001)
+        XCTAssertEqual(IRFFVideoToolBoxPolicy.seconds(from: timing.duration) ?? 0, 1.0 / 30.0, accuracy: 0.000001)
+        XCTAssertFalse(timing.decodeTimeStamp.isValid)
+
+        let invalid = IRFFVideoToolBoxPolicy.sampleTiming(position: .nan, duration: -1)
+        XCTAssertNil(IRFFVideoToolBoxPolicy.seconds(from: invalid.presentationTimeStamp))
+        XCTAssertNil(IRFFVideoToolBoxPolicy.seconds(from: invalid.duration))
+    }
+
+    func testOutputWithoutTimestampKeepsTheSubmittedTiming() {
+        let reported = IRFFVideoToolBoxPolicy.outputTiming(presentationTimeStamp: CMTime(seconds: 2, preferredTimescale: 1000),
+                                                           presentationDuration: CMTime(seconds: 0.04, preferredTimescale: 1000),
+                                                           submittedPosition: 7,
+                                                           submittedDuration: 0.1)
+        XCTAssertEqual(reported.position, 2, accuracy: 0.000001)
+        XCTAssertEqual(reported.duration, 0.04, accuracy: 0.000001)
+
+        let missing = IRFFVideoToolBoxPolicy.outputTiming(presentationTimeStamp: .invalid,
+                                                          presentationDuration: .indefinite,
+                                                          submittedPosition: 7,
+                                                          submittedDuration: 0.1)
+        XCTAssertEqual(missing.position, 7, accuracy: 0.000001)
+        XCTAssertEqual(missing.duration, 0.1, accuracy: 0.000001)
+
+        let unknown = IRFFVideoToolBoxPolicy.outputTiming(presentationTimeStamp: .invalid,
+                                                          presentationDuration: .invalid,
+                                                          submittedPosition: .nan,
+                                                          submittedDuration: -1)
+        XCTAssertEqual(unknown.position, 0)
+        XCTAssertEqual(unknown.duration, 0)
+    }
+
+    func testAsynchronousCallbackForUnknownFrameIsIgnored() {
+        var codecContext = AVCodecContext()
+        withUnsafeMutablePointer(to: &codecContext) { context in
+            let videoToolBox = IRFFVideoToolBox.videoToolBox(with: context)
+            let refCon = UnsafeMutableRawPointer(Unmanaged.passUnretained(videoToolBox).toOpaque())
+
+            IRFFVideoToolBox.handleOutputCallback(refCon: refCon,
+                                                  status: noErr,
+                                                  imageBuffer: nil,
+                                                  frameRefCon: UnsafeMutableRawPointer(bitPattern: 42),
+                                                  presentationTimeStamp: CMTime(seconds: 1, preferredTimescale: 1000))
+
+            XCTAssertTrue(videoToolBox.dequeueDecodedImages().isEmpty)
+            XCTAssertEqual(videoToolBox.decodeStatus, noErr)
+            XCTAssertNil(videoToolBox.decodeOutput)
+        }
+    }
+}
@@ -0,0 +1,124 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLFish2PanoPackedPixelMapTests: XCTestCase {
+
+    func testPackMarksOutsideSamplesWithTheSentinel() {
+        let outside = IRGLFish2PanoPixelMapPacking.outsideTexel
+        for (u, v) in [(Float(-1), Float(-1)), (64, 10), (10, 48), (.nan, 10), (10, -0.001)] {
+            let packed = IRGLFish2PanoPixelMapPacking.pack(u: u, v: v, textureWidth: 64, textureHeight: 48)
+            XCTAssertEqual(packed.u, outside, "\(u), \(v)")
+            XCTAssertEqual(packed.v, outside, "\(u), \(v)")
+            XCTAssertNil(IRGLFish2PanoPixelMapPacking.unpack(u: packed.u, v: packed.v, textureWidth: 64, textureHeight: 48))
+        }
+    }
+
+    func testInsideSamplesNeverReachTheSentinel() {
+        let last = Float(1920).nextDown
+        let packed = IRGLFish2PanoPixelMapPacking.pack(u: last, v: 0, textureWidth: 1920, textureHeight: 1080)
+
+        XCTAssertEqual(packed.u, IRGLFish2PanoPixelMapPacking.maxInsideTexel)
+        XCTAssertEqual(packed.v, 0)
+    }
+
+    func testQuantizationErrorStaysWithinBound() throws {
+        for extent in [64, 1920, 3840, 8192] {
+            let bound = IRGLFish2PanoPixelMapPacking.maxQuantizationError(extent: extent)
+            let halfStep = bound / 2
+            // Float arithmetic in the round trip adds a few ulps on top of the step.
+            let slack = Float(extent) * 4 * Float.ulpOfOne
+            let lastFullStep = Float(extent) * (1 - 1 / Float(UInt16.max))
+
+            for index in 0..<10_007 {
+                let coordinate = Float(extent) * Float(index) / 10_007
+                let packed = IRGLFish2PanoPixelMapPacking.pack(u: coordinate, v: 0, textureWidth: extent, textureHeight: 1)
+                let unpacked = try XCTUnwrap(IRGLFish2PanoPixelMapPacking.unpack(u: packed.u, v: packed.v,
+                                                                                  textureWidth: extent, textureHeight: 1))
+                let error = abs(unpacked.u - coordinate)
+                XCTAssertLessThanOrEqual(error, bound + slack, "\(extent) \(coordinate)")
+                if coordinate < lastFullStep {
+                    XCTAssertLessThanOrEqual(error, halfStep + slack, "\(extent) \(coordinate)")
+                }
+            }
+        }
+    }
+
+    func testErrorBoundStaysSubPixelOnLargeFisheyes() {
+        XCTAssertLessThan(IRGLFish2PanoPixelMapPacking.maxQuantizationError(extent: 1920), 0.03)
+        XCTAssertLessThan(IRGLFish2PanoPixelMapPacking.maxQuantizationError(extent: 8192), 0.13)
+    }
+
+    func testPackedGeneratorOutputMatchesTheFloatMapWithinBound() throws {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920,
+                                             outputWidth: 91, outputHeight: 17, antialias: 2)
+        let maps = Fish2PanoPixelMaps(geometry)
+        IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers)
+        let texels = packedFish2PanoTexels(maps)
+        let bound = IRGLFish2PanoPixelMapPacking.maxQuantizationError(extent: 1920) + 1920 * 4 * Float.ulpOfOne
+
+        let count = geometry.outputWidth * geometry.outputHeight
+        var insideCount = 0
+        for slice in 0..<geometry.mapCount {
+            for texel in 0..<count {
+                let u = maps.pointers[slice][texel * 2]
+                let v = maps.pointers[slice][texel * 2 + 1]
+                let offset = (slice * count + texel) * 2
+                let unpacked = IRGLFish2PanoPixelMapPacking.unpack(u: texels[offset], v: texels[offset + 1],
+                                                                   textureWidth: 1920, textureHeight: 1920)
+                guard u >= 0 else {
+                    XCTAssertNil(unpacked)
+                    continue
+                }
+                let inside = try XCTUnwrap(unpacked)
+                XCTAssertEqual(inside.u, u, accuracy: bound)
+                XCTAssertEqual(inside.v, v, accuracy: bound)
+                insideCount += 1
+            }
+        }
+        XCTAssertGreaterThan(insideCount, 0)
+    }
+
+    func testLayoutPacksAllSlicesIntoOneBuffer() throws {
+        let geometry = makeFish2PanoGeometry(antialias: 2)
+        let layout = try XCTUnwrap(IRGLFish2PanoPixelMapPacking.layout(for: geometry))
+
+        XCTAssertEqual(layout.bytesPerRow, 20 * 4)
+        XCTAssertEqual(layout.bytesPerImage, 20 * 6 * 4)
+        XCTAssertEqual(layout.byteCount, 4 * 20 * 6 * 4)
+        // Half of the rg32Float planes it replaces.
+        XCTAssertEqual(layout.byteCount * 2, geometry.mapCount * geometry.mapCapacity * MemoryLayout<Float>.size)
+
+        var invalid = geometry
+        invalid.antialias = 0
+        XCTAssertNil(IRGLFish2PanoPixelMapPacking.layout(for: invalid))
+        invalid = geometry
+        invalid.outputWidth = Int.max / 2
+        XCTAssertNil(IRGLFish2PanoPixelMapPacking.layout(for: invalid))
+    }
+
+    func testBuiltMapExposesSlicesInOrder() throws {
+        let geometry = makeFish2PanoGeometry(outputWidth: 13, outputHeight: 5, antialias: 3)
+        let pixelMap = try XCTUnwrap(IRGLFish2PanoPackedPixelMap(building: geometry))
+        let maps = Fish2PanoPixelMaps(geometry)
+        IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers)
+        let expected = packedFish2PanoTexels(maps)
+
+        XCTAssertEqual(pixelMap.sliceCount, 9)
+        let texelsPerSlice = pixelMap.bytesPerImage / 2
+        for slice in 0..<pixelMap.sliceCount {
+            let actual = Array(UnsafeBufferPointer(start: pixelMap.slice(slice), count: texelsPerSlice))
+            XCTAssertEqual(actual, Array(expected[(slice * texelsPerSlice)..<((slice + 1) * texelsPerSlice)]))
+        }
+    }
+
+    func testBenchmarkPackPixelMap() {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920,
+                                             outputWidth: 2731, outputHeight: 503, antialias: 2)
+        let maps = Fish2PanoPixelMaps(geometry)
+        IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers)
+
+        measure {
+            XCTAssertFalse(packedFish2PanoTexels(maps).isEmpty)
+        }
+    }
+}
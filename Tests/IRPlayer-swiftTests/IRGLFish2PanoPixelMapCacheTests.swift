@@ -0,0 +1,170 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLFish2PanoPixelMapCacheTests: XCTestCase {
+    private var directory: URL!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("IRGLFish2PanoPixelMapCacheTests-\(UUID().uuidString)", isDirectory: true)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    func testFileNameIsStableAcrossLaunches() {
+        // FNV-1a of the header, not Hasher, so the name survives a relaunch.
+        XCTAssertEqual(IRGLFish2PanoPixelMapCachePolicy.fileName(for: makeFish2PanoGeometry()),
+                       "fish2pano-008e0166075a85ec.uvmap")
+    }
+
+    func testFileNameChangesWithEveryGeometryInput() {
+        let base = makeFish2PanoGeometry()
+        let changes: [(inout IRGLFish2PanoPixelMapGeometry) -> Void] = [
+            { $0.antialias = 2 },
+            { $0.textureWidth += 1 },
+            { $0.fishCenterY += 1 },
+            { $0.fishRadiusH -= 1 },
+            { $0.fishAperture = 190 },
+            { $0.lat2 = 59 },
+            { $0.long1 = 1 },
+            { $0.transformX = 5 },
+            { $0.transformZ = 0 }
+        ]
+        let variants: [IRGLFish2PanoPixelMapGeometry] = changes.map { change in
+            var geometry = base
+            change(&geometry)
+            return geometry
+        }
+
+        let names = Set(([base] + variants).map(IRGLFish2PanoPixelMapCachePolicy.fileName(for:)))
+        XCTAssertEqual(names.count, variants.count + 1)
+    }
+
+    func testHeaderAndFileSizes() {
+        let geometry = makeFish2PanoGeometry(antialias: 2)
+
+        XCTAssertEqual(IRGLFish2PanoPixelMapCachePolicy.header(for: geometry).count,
+                       IRGLFish2PanoPixelMapCachePolicy.headerByteCount)
+        XCTAssertEqual(IRGLFish2PanoPixelMapCachePolicy.fileByteCount(for: geometry), 128 + 4 * 20 * 6 * 4)
+
+        var invalid = geometry
+        invalid.outputWidth = 0
+        XCTAssertNil(IRGLFish2PanoPixelMapCachePolicy.fileByteCount(for: invalid))
+        invalid.outputWidth = Int.max / 2
+        XCTAssertNil(IRGLFish2PanoPixelMapCachePolicy.fileByteCount(for: invalid))
+    }
+
+    func testEvictionDropsLeastRecentlyUsedFiles() {
+        let files: [(name: String, lastUsed: Date)] = [
+            ("b", Date(timeIntervalSince1970: 20)),
+            ("a", Date(timeIntervalSince1970: 10)),
+            ("c", Date(timeIntervalSince1970: 30))
+        ]
+
+        XCTAssertEqual(IRGLFish2PanoPixelMapCachePolicy.evictionCandidates(files, maxFileCount: 1), ["a", "b"])
+        XCTAssertEqual(IRGLFish2PanoPixelMapCachePolicy.evictionCandidates(files, maxFileCount: 3), [])
+    }
+
+    func testStoredMapLoadsBitForBit() throws {
+        let cache = IRGLFish2PanoPixelMapCache(directory: directory)
+        let geometry = makeFish2PanoGeometry(outputWidth: 37, outputHeight: 11, antialias: 2)
+        let built = try XCTUnwrap(IRGLFish2PanoPackedPixelMap(building: geometry))
+
+        XCTAssertNil(cache.load(geometry))
+        XCTAssertTrue(cache.store(built))
+        let mapped = try XCTUnwrap(cache.load(geometry))
+
+        XCTAssertEqual(mapped.geometry, geometry)
+        XCTAssertEqual(mapped.byteCount, built.byteCount)
+        XCTAssertEqual(texels(of: mapped), texels(of: built))
+    }
+
+    func testLoadRejectsTruncatedOrForeignFiles() throws {
+        let cache = IRGLFish2PanoPixelMapCache(directory: directory)
+        let geometry = makeFish2PanoGeometry()
+        let other = makeFish2PanoGeometry(textureWidth: 66)
+        XCTAssertTrue(cache.store(try XCTUnwrap(IRGLFish2PanoPackedPixelMap(building: geometry))))
+
+        // Same size, other geometry in the header.
+        try FileManager.default.copyItem(at: cache.fileURL(for: geometry), to: cache.fileURL(for: other))
+        XCTAssertNil(cache.load(other))
+
+        let handle = try FileHandle(forWritingTo: cache.fileURL(for: geometry))
+        try handle.truncate(atOffset: 200)
+        try handle.close()
+        XCTAssertNil(cache.load(geometry))
+    }
+
+    func testStoreKeepsFileCountBounded() throws {
+        let cache = IRGLFish2PanoPixelMapCache(directory: directory, maxFileCount: 2)
+
+        for width in 20..<24 {
+            let geometry = makeFish2PanoGeometry(outputWidth: width)
+            XCTAssertTrue(cache.store(try XCTUnwrap(IRGLFish2PanoPackedPixelMap(building: geometry))))
+        }
+
+        let files = (try? FileManager.default.contentsOfDirectory(atPath: directory.path)) ?? []
+        XCTAssertEqual(files.count, 2)
+    }
+
+    func testShaderParamsReuseTheCachedMap() throws {
+        let cache = IRGLFish2PanoPixelMapCache(directory: directory)
+
+        let first = IRGLFish2PanoShaderParams()
+        first.pixelMapCache = cache
+        first.updateTextureWidth(40, height: 30)
+        let built = try waitForFish2PanoPixelMap(from: first)
+        XCTAssertTrue(FileManager.default.fileExists(atPath: cache.fileURL(for: built.geometry).path))
+
+        let second = IRGLFish2PanoShaderParams()
+        second.pixelMapCache = cache
+        second.updateTextureWidth(40, height: 30)
+        let mapped = try waitForFish2PanoPixelMap(from: second)
+
+        XCTAssertEqual(mapped.geometry, built.geometry)
+        XCTAssertEqual(texels(of: mapped), texels(of: built))
+    }
+
+    func testOnlyThePanoProgramOptsIntoTheSharedCache() {
+        XCTAssertNil(IRGLFish2PanoShaderParams().pixelMapCache)
+
+        let program = IRGLProgramFactory.createIRGLProgram2DFisheye2Pano(pixelFormat: .RGB_IRPixelFormat,
+                                                                        viewportRange: .zero,
+                                                                        parameter: nil)
+        XCTAssertTrue(program.metalFish2PanoParams?.pixelMapCache === IRGLFish2PanoPixelMapCache.shared)
+    }
+
+    // A 1920x1920 fisheye at antialias 2: rebuilding against mapping the same map.
+    func testBenchmarkBuildPixelMap() {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920,
+                                             outputWidth: 2731, outputHeight: 503, antialias: 2)
+
+        measure {
+            XCTAssertNotNil(IRGLFish2PanoPackedPixelMap(building: geometry))
+        }
+    }
+
+    func testBenchmarkLoadCachedPixelMap() throws {
+        let cache = IRGLFish2PanoPixelMapCache(directory: directory)
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920,
+                                             outputWidth: 2731, outputHeight: 503, antialias: 2)
+        XCTAssertTrue(cache.store(try XCTUnwrap(IRGLFish2PanoPackedPixelMap(building: geometry))))
+
+        measure {
+            // Touch every page, as the texture upload would.
+            var sum = 0
+            if let mapped = cache.load(geometry) {
+                for offset in stride(from: 0, to: mapped.byteCount / 2, by: 2048) {
+                    sum += Int(mapped.texels[offset])
+                }
+            }
+            XCTAssertNotEqual(sum, 0)
+        }
+    }
+
+    private func texels(of pixelMap: IRGLFish2PanoPackedPixelMap) -> [UInt16] {
+        return Array(UnsafeBufferPointer(start: pixelMap.texels, count: pixelMap.byteCount / 2))
+    }
+}
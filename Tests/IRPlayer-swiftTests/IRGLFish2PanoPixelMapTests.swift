@@ -0,0 +1,135 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLFish2PanoPixelMapTests: XCTestCase {
+
+    func testFillMatchesScalarReferenceBitForBit() {
+        var geometries = [
+            makeFish2PanoGeometry(),
+            makeFish2PanoGeometry(antialias: 2),
+            // Widths that leave a partial lane at the end of each row.
+            makeFish2PanoGeometry(outputWidth: 37, outputHeight: 11, antialias: 3),
+            makeFish2PanoGeometry(outputWidth: 5, outputHeight: 3),
+            makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1080, outputWidth: 91, outputHeight: 17, antialias: 2)
+        ]
+        var rotated = makeFish2PanoGeometry(outputWidth: 45, outputHeight: 13, antialias: 2)
+        rotated.transformX = 30
+        rotated.transformY = -15
+        rotated.transformZ = 75
+        geometries.append(rotated)
+        var unrotated = makeFish2PanoGeometry(outputWidth: 33, outputHeight: 9)
+        unrotated.transformZ = 0
+        geometries.append(unrotated)
+        var offCentre = makeFish2PanoGeometry(outputWidth: 29, outputHeight: 10, antialias: 2)
+        offCentre.fishCenterX = 20
+        offCentre.fishCenterY = 30
+        offCentre.fishRadiusH = 26
+        offCentre.fishAperture = 200
+        offCentre.lat1 = -30
+        offCentre.lat2 = 50
+        offCentre.long1 = 90
+        offCentre.long2 = 270
+        geometries.append(offCentre)
+
+        for geometry in geometries {
+            let reference = Fish2PanoPixelMaps(geometry)
+            let vectorised = Fish2PanoPixelMaps(geometry)
+            IRGLFish2PanoPixelMap.fillScalar(geometry, into: reference.pointers)
+            IRGLFish2PanoPixelMap.fill(geometry, into: vectorised.pointers)
+
+            XCTAssertEqual(vectorised.bitPatterns, reference.bitPatterns, "\(geometry)")
+        }
+    }
+
+    func testConcurrentAndSerialFillAgree() {
+        let geometry = makeFish2PanoGeometry(outputWidth: 61, outputHeight: 23, antialias: 2)
+        let concurrent = Fish2PanoPixelMaps(geometry)
+        let serial = Fish2PanoPixelMaps(geometry)
+
+        IRGLFish2PanoPixelMap.fill(geometry, into: concurrent.pointers, concurrent: true)
+        IRGLFish2PanoPixelMap.fill(geometry, into: serial.pointers, concurrent: false)
+
+        XCTAssertEqual(concurrent.bitPatterns, serial.bitPatterns)
+    }
+
+    func testFillProducesGoldenSamples() {
+        // Expected values were worked out in double precision for the geometry
+        // IRGLFish2PanoShaderParams builds (lat 0...60, long 0...360, z -90).
+        let geometry = makeFish2PanoGeometry(antialias: 2)
+        let maps = Fish2PanoPixelMaps(geometry)
+        IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers)
+
+        let samples: [(x: Int, y: Int, i: Int, j: Int, u: Float, v: Float)] = [
+            (0, 0, 0, 0, -1, -1),
+            (5, 2, 1, 0, 10.929315, 20.662731),
+            (13, 5, 1, 1, 42.202374, 18.801631),
+            (19, 3, 0, 1, 36.911822, 39.117033),
+            (7, 4, 0, 0, 20.236995, 15.453677),
+            (2, 0, 0, 1, 14.907353, 47.526010)
+        ]
+        for sample in samples {
+            let uv = maps.uv(x: sample.x, y: sample.y, map: geometry.antialias * sample.i + sample.j)
+            XCTAssertEqual(uv.u, sample.u, accuracy: 0.001, "\(sample)")
+            XCTAssertEqual(uv.v, sample.v, accuracy: 0.001, "\(sample)")
+        }
+    }
+
+    func testFillIgnoresInvalidGeometryOrMismatchedMaps() {
+        let geometry = makeFish2PanoGeometry(antialias: 2)
+        let maps = Fish2PanoPixelMaps(geometry)
+        let untouched = maps.bitPatterns
+
+        IRGLFish2PanoPixelMap.fill(geometry, into: Array(maps.pointers.prefix(3)))
+        var invalid = geometry
+        invalid.outputHeight = 0
+        IRGLFish2PanoPixelMap.fill(invalid, into: maps.pointers)
+
+        XCTAssertEqual(maps.bitPatterns, untouched)
+    }
+
+    func testShaderParamsPublishTheReferenceMap() throws {
+        let params = IRGLFish2PanoShaderParams()
+        params.updateTextureWidth(40, height: 30)
+
+        let pixelMap = try waitForFish2PanoPixelMap(from: params)
+
+        let geometry = params.pixelMapGeometry
+        XCTAssertEqual(pixelMap.geometry, geometry)
+        XCTAssertEqual(geometry.textureWidth, 40)
+        XCTAssertEqual(geometry.transformZ, -90)
+        let reference = Fish2PanoPixelMaps(geometry)
+        IRGLFish2PanoPixelMap.fillScalar(geometry, into: reference.pointers)
+
+        XCTAssertEqual(Array(UnsafeBufferPointer(start: pixelMap.texels, count: pixelMap.byteCount / 2)),
+                       packedFish2PanoTexels(reference))
+    }
+
+    // A 1920x1920 fisheye, the size the pano map is rebuilt for on every stream
+    // resolution change.
+    func testBenchmarkScalarPixelMap() {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920, outputWidth: 2731, outputHeight: 503)
+        let maps = Fish2PanoPixelMaps(geometry)
+
+        measure {
+            IRGLFish2PanoPixelMap.fillScalar(geometry, into: maps.pointers)
+        }
+    }
+
+    func testBenchmarkVectorisedPixelMap() {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920, outputWidth: 2731, outputHeight: 503)
+        let maps = Fish2PanoPixelMaps(geometry)
+
+        measure {
+            IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers)
+        }
+    }
+
+    func testBenchmarkVectorisedPixelMapSingleThread() {
+        let geometry = makeFish2PanoGeometry(textureWidth: 1920, textureHeight: 1920, outputWidth: 2731, outputHeight: 503)
+        let maps = Fish2PanoPixelMaps(geometry)
+
+        measure {
+            IRGLFish2PanoPixelMap.fill(geometry, into: maps.pointers, concurrent: false)
+        }
+    }
+}
@@ -187,23 +187,19 @@ final class IRGLProgram2DFisheye2PanoTests: XCTestCase {
         XCTAssertNil(params.consumePixUVIfReady())
 
         params.updateTextureWidth(32, height: 24)
-        let pixUV = try waitForPixUV(from: params)
+        let pixelMap = try waitForFish2PanoPixelMap(from: params)
 
-        XCTAssertEqual(pixUV.count, 1)
-        params.releaseConsumedPixUV(pixUV)
+        XCTAssertEqual(pixelMap.sliceCount, 1)
         XCTAssertNil(params.consumePixUVIfReady())
     }
 
-    func testPanoShaderParamsReleaseConsumedPixUVIsIdempotent() throws {
+    func testPanoShaderParamsConsumedPixUVIsHandedOverOnce() throws {
         let params = IRGLFish2PanoShaderParams()
-
         params.updateTextureWidth(32, height: 24)
-        let pixUV = try waitForPixUV(from: params)
-
-        params.releaseConsumedPixUV(pixUV)
-        params.releaseConsumedPixUV(pixUV)
+        _ = try waitForFish2PanoPixelMap(from: params)
 
         XCTAssertNil(params.consumePixUVIfReady())
+        XCTAssertNil(params.consumePixUVIfReady())
     }
 
     func testPanoShaderParamsHugeTextureUpdateDoesNotBuildOutputMap() {
@@ -317,23 +313,6 @@ final class IRGLProgram2DFisheye2PanoTests: XCTestCase {
         XCTAssertEqual(value.y, y, accuracy: 0.0001, file: file, line: line)
         XCTAssertEqual(value.z, z, accuracy: 0.0001, file: file, line: line)
     }
-
-    private func waitForPixUV(
-        from params: IRGLFish2PanoShaderParams,
-        timeout: TimeInterval = 1,
-        file: StaticString = #filePath,
-        line: UInt = #line
-    ) throws -> [UnsafeMutablePointer<GLfloat>] {
-        let deadline = Date().addingTimeInterval(timeout)
-        while Date() < deadline {
-            if let pixUV = params.consumePixUVIfReady() {
-                return pixUV
-            }
-            RunLoop.current.run(mode: .default, before: Date().addingTimeInterval(0.01))
-        }
-        XCTFail("Expected fish2pano pixel map to become ready", file: file, line: line)
-        throw XCTSkip("Pixel map did not become ready before timeout")
-    }
 }
 
 private final class Fish2PanoRecordingTransformController: IRGLTransformController {
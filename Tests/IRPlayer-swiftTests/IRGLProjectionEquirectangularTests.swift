@@ -11,34 +11,10 @@ import XCTest
 final class IRGLProjectionEquirectangularTests: XCTestCase {
 
     func testStaticPolicyWrappersRemainSourceCompatible() {
-        let wrapperPlan = IRGLProjectionEquirectangular.bufferPlan(slices: 4, indicesPerVertex: 1)
-        let policyPlan = IRGLProjectionEquirectangularPolicy.bufferPlan(slices: 4, indicesPerVertex: 1)
-        XCTAssertEqual(wrapperPlan?.iMax, policyPlan?.iMax)
-        XCTAssertEqual(wrapperPlan?.vertexCount, policyPlan?.vertexCount)
-        XCTAssertEqual(wrapperPlan?.vertexCapacity, policyPlan?.vertexCapacity)
-        XCTAssertEqual(wrapperPlan?.vectorCapacity, policyPlan?.vectorCapacity)
-        XCTAssertEqual(wrapperPlan?.totalIndices, policyPlan?.totalIndices)
-
-        var values = [3, 7, 2]
-        let count = values.count
-        values.withUnsafeMutableBufferPointer { buffer in
-            XCTAssertEqual(
-                IRGLProjectionEquirectangular.maxItem(in: buffer.baseAddress, size: count),
-                IRGLProjectionEquirectangularPolicy.maxItem(in: buffer.baseAddress, size: count)
-            )
-        }
         XCTAssertEqual(
             IRGLProjectionEquirectangular.elementCount(baseCount: 4, components: 3),
             IRGLProjectionEquirectangularPolicy.elementCount(baseCount: 4, components: 3)
         )
-        XCTAssertEqual(
-            IRGLProjectionEquirectangular.byteCount(elementCount: 4, stride: MemoryLayout<Float>.stride),
-            IRGLProjectionEquirectangularPolicy.byteCount(elementCount: 4, stride: MemoryLayout<Float>.stride)
-        )
-        XCTAssertEqual(
-            IRGLProjectionEquirectangular.indexValue(Int(Int16.max)),
-            IRGLProjectionEquirectangularPolicy.indexValue(Int(Int16.max))
-        )
         XCTAssertEqual(
             IRGLProjectionEquirectangular.isValidGeometry(tw: 1440, th: 1080, cr: 520, cx: 720, cy: 540),
             IRGLProjectionEquirectangularPolicy.isValidGeometry(tw: 1440, th: 1080, cr: 520, cx: 720, cy: 540)
@@ -55,46 +31,6 @@ final class IRGLProjectionEquirectangularTests: XCTestCase {
         XCTAssertEqual(IRGLProjectionEquirectangular.elementCount(baseCount: 4, components: 3), 12)
     }
 
-    func testByteCountRejectsInvalidOrOverflowingInputs() {
-        XCTAssertNil(IRGLProjectionEquirectangular.byteCount(elementCount: 0, stride: MemoryLayout<Float>.stride))
-        XCTAssertNil(IRGLProjectionEquirectangular.byteCount(elementCount: 1, stride: 0))
-        XCTAssertNil(IRGLProjectionEquirectangular.byteCount(elementCount: Int.max, stride: 2))
-    }
-
-    func testByteCountCalculatesStrideStorage() {
-        XCTAssertEqual(
-            IRGLProjectionEquirectangular.byteCount(elementCount: 4, stride: MemoryLayout<Float>.stride),
-            16
-        )
-    }
-
-    func testMaxItemRejectsMissingOrEmptyInputs() {
-        XCTAssertNil(IRGLProjectionEquirectangular.maxItem(in: nil, size: 1))
-
-        var values = [1, 2, 3]
-        values.withUnsafeMutableBufferPointer { buffer in
-            XCTAssertNil(IRGLProjectionEquirectangular.maxItem(in: buffer.baseAddress, size: 0))
-        }
-    }
-
-    func testMaxItemReturnsLargestValue() {
-        var values = [3, 7, 2]
-        let count = values.count
-        values.withUnsafeMutableBufferPointer { buffer in
-            XCTAssertEqual(IRGLProjectionEquirectangular.maxItem(in: buffer.baseAddress, size: count), 7)
-        }
-    }
-
-    func testIndexValueRejectsValuesOutsideInt16Range() {
-        XCTAssertNil(IRGLProjectionEquirectangular.indexValue(Int(Int16.min) - 1))
-        XCTAssertNil(IRGLProjectionEquirectangular.indexValue(Int(Int16.max) + 1))
-    }
-
-    func testIndexValueConvertsInt16RepresentableValues() {
-        XCTAssertEqual(IRGLProjectionEquirectangular.indexValue(0), 0)
-        XCTAssertEqual(IRGLProjectionEquirectangular.indexValue(Int(Int16.max)), Int16.max)
-    }
-
     func testInvalidProjectionParametersFallBackWithoutDebugOutput() {
         let output = captureStandardOutput {
             _ = IRGLProjectionEquirectangular(textureWidth: 1440,
@@ -147,8 +83,8 @@ final class IRGLProjectionEquirectangularTests: XCTestCase {
 
     func testBufferPlanRejectsOverflowWithoutDebugOutput() {
         let output = captureStandardOutput {
-            XCTAssertNil(IRGLProjectionEquirectangular.bufferPlan(slices: Int.max, indicesPerVertex: 1))
-            XCTAssertNil(IRGLProjectionEquirectangular.bufferPlan(slices: 3_037_000_499, indicesPerVertex: 1))
+            XCTAssertNil(IRGLProjectionEquirectangularPolicy.bufferPlan(slices: Int.max, indicesPerVertex: 1))
+            XCTAssertNil(IRGLProjectionEquirectangularPolicy.bufferPlan(slices: 3_037_000_499, indicesPerVertex: 1))
         }
 
         XCTAssertEqual(output, "")
@@ -173,7 +109,7 @@ final class IRGLProjectionEquirectangularTests: XCTestCase {
         XCTAssertEqual(firstMesh.indices.count, updatedMesh.indices.count)
         XCTAssertFalse(updatedMesh.positions.isEmpty)
         XCTAssertFalse(updatedMesh.texcoords.isEmpty)
-        XCTAssertFalse(updatedMesh.indices.isEmpty)
+        XCTAssertGreaterThan(updatedMesh.indices.count, 0)
     }
 
     func testProjectionNoOpUpdateAndDrawKeepMeshAvailable() throws {
@@ -189,6 +125,24 @@ final class IRGLProjectionEquirectangularTests: XCTestCase {
         let mesh = try XCTUnwrap(projection.exportMesh())
         XCTAssertFalse(mesh.positions.isEmpty)
         XCTAssertFalse(mesh.texcoords.isEmpty)
-        XCTAssertFalse(mesh.indices.isEmpty)
+        XCTAssertGreaterThan(mesh.indices.count, 0)
+    }
+
+    func testExportMeshKeepsThirtyTwoBitIndicesForFineTessellations() throws {
+        let coarse = IRGLProjectionEquirectangular(textureWidth: 1440, height: 1080, centerX: 720, centerY: 540, radius: 520)
+        guard case .uint16 = try XCTUnwrap(coarse.exportMesh()).indices else {
+            return XCTFail("a 180-slice sphere fits 16-bit indices")
+        }
+
+        // 257 x 257 vertices are past what 16 bits can address.
+        let fine = IRGLProjectionEquirectangular(textureWidth: 1440, height: 1080, centerX: 720, centerY: 540, radius: 520,
+                                                 slices: 256)
+        let mesh = try XCTUnwrap(fine.exportMesh())
+        guard case .uint32(let indices) = mesh.indices else {
+            return XCTFail("a 256-slice sphere needs 32-bit indices")
+        }
+        XCTAssertEqual(mesh.positions.count, 257 * 257)
+        XCTAssertEqual(indices.count, 256 * 256 * 6)
+        XCTAssertEqual(Int(try XCTUnwrap(indices.max())), mesh.positions.count - 1)
     }
 }
@@ -90,7 +90,7 @@ final class IRGLRenderAdapterTests: XCTestCase {
         for adapter in adapters {
             XCTAssertFalse(adapter.renderFish2Pano(frame: frame,
                                                    params: params,
-                                                   texUVTextures: [],
+                                                   texUVTexture: nil,
                                                    to: drawable,
                                                    drawableSize: CGSize(width: 2, height: 2),
                                                    viewport: CGRect(x: 0, y: 0, width: 2, height: 2),
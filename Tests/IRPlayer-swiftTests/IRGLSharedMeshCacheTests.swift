@@ -0,0 +1,98 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLSharedMeshCacheTests: XCTestCase {
+
+    private final class Mesh {}
+
+    private final class BuildCounter {
+        private let lock = NSLock()
+        private var value = 0
+
+        var count: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return value
+        }
+
+        func build() -> Mesh {
+            lock.lock()
+            value += 1
+            lock.unlock()
+            Thread.sleep(forTimeInterval: 0.01)
+            return Mesh()
+        }
+    }
+
+    func testConcurrentRequestsBuildOnce() {
+        let cache = IRGLSharedMeshCache<Int, Mesh>()
+        let counter = BuildCounter()
+        let lock = NSLock()
+        var meshes: [Mesh] = []
+
+        DispatchQueue.concurrentPerform(iterations: 16) { _ in
+            let mesh = cache.value(for: 1) { counter.build() }
+            lock.lock()
+            mesh.map { meshes.append($0) }
+            lock.unlock()
+        }
+
+        XCTAssertEqual(counter.count, 1)
+        XCTAssertEqual(meshes.count, 16)
+        XCTAssertTrue(meshes.allSatisfy { $0 === meshes[0] })
+    }
+
+    func testBackgroundBuildIsStartedOnceAndNotifiesEveryRequester() throws {
+        let cache = IRGLSharedMeshCache<Int, Mesh>()
+        let counter = BuildCounter()
+        let built = expectation(description: "built")
+        built.expectedFulfillmentCount = 2
+
+        XCTAssertNil(cache.valueIfReady(for: 1, build: { counter.build() }) { XCTAssertNotNil($0); built.fulfill() })
+        XCTAssertNil(cache.valueIfReady(for: 1, build: { counter.build() }) { XCTAssertNotNil($0); built.fulfill() })
+        wait(for: [built], timeout: 2)
+
+        let mesh = try XCTUnwrap(cache.valueIfReady(for: 1, build: { counter.build() }) { _ in })
+        XCTAssertTrue(cache.value(for: 1) { counter.build() } === mesh)
+        XCTAssertEqual(counter.count, 1)
+    }
+
+    func testReleasedValuesAreDroppedAndHeldOnesKept() {
+        let cache = IRGLSharedMeshCache<Int, Mesh>()
+        let counter = BuildCounter()
+        var first = cache.value(for: 1) { counter.build() }
+        let second = cache.value(for: 2) { counter.build() }
+
+        cache.purgeUnused()
+        XCTAssertEqual(Set(cache.keys), [1, 2])
+        XCTAssertNotNil(first)
+
+        first = nil
+        cache.purgeUnused()
+        XCTAssertEqual(cache.keys, [2])
+        XCTAssertNotNil(second)
+
+        _ = cache.value(for: 1) { counter.build() }
+        XCTAssertEqual(counter.count, 3)
+    }
+
+    func testBackgroundValueSurvivesPurgeUntilItIsPickedUp() {
+        let cache = IRGLSharedMeshCache<Int, Mesh>()
+        let built = expectation(description: "built")
+
+        XCTAssertNil(cache.valueIfReady(for: 1, build: { Mesh() }) { _ in built.fulfill() })
+        wait(for: [built], timeout: 2)
+        cache.purgeUnused()
+
+        XCTAssertEqual(cache.keys, [1])
+        XCTAssertNotNil(cache.valueIfReady(for: 1, build: { Mesh() }) { _ in })
+    }
+
+    func testFailedBuildIsRetried() {
+        let cache = IRGLSharedMeshCache<Int, Mesh>()
+
+        XCTAssertNil(cache.value(for: 1) { nil })
+        XCTAssertTrue(cache.keys.isEmpty)
+        XCTAssertNotNil(cache.value(for: 1) { Mesh() })
+    }
+}
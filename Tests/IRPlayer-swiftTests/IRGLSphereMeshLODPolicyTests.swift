@@ -0,0 +1,103 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLSphereMeshLODPolicyTests: XCTestCase {
+
+    func testLevelsAreAscendingAndStayBuildable() throws {
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.sliceLevels, IRGLSphereMeshLODPolicy.sliceLevels.sorted())
+        for slices in IRGLSphereMeshLODPolicy.sliceLevels {
+            XCTAssertNotNil(IRGLSphereMeshKey(slices: slices, textureWidth: 200, textureHeight: 100,
+                                              centerX: 100, centerY: 50, radius: 50))
+        }
+    }
+
+    func testPixelsPerRadianGrowsWithViewportAndZoom() throws {
+        let base = try XCTUnwrap(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 1080, fovDegrees: 60))
+        // 540 / tan(30°), densest at the edge: divided by cos²(30°).
+        XCTAssertEqual(base, 540 / tan(Float.pi / 6) / 0.75, accuracy: 0.01)
+
+        let taller = try XCTUnwrap(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 2160, fovDegrees: 60))
+        let zoomed = try XCTUnwrap(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 1080, fovDegrees: 20))
+        XCTAssertEqual(taller, base * 2, accuracy: 0.01)
+        XCTAssertGreaterThan(zoomed, base * 2)
+    }
+
+    func testPixelsPerRadianRejectsInvalidInput() {
+        XCTAssertNil(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 0, fovDegrees: 60))
+        XCTAssertNil(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: .nan, fovDegrees: 60))
+        XCTAssertNil(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 1080, fovDegrees: 0))
+        XCTAssertNil(IRGLSphereMeshLODPolicy.pixelsPerRadian(viewportHeight: 1080, fovDegrees: 180))
+    }
+
+    func testChordErrorQuartersWhenSlicesDouble() {
+        let coarse = IRGLSphereMeshLODPolicy.chordErrorPixels(slices: 64, pixelsPerRadian: 1000)
+        let fine = IRGLSphereMeshLODPolicy.chordErrorPixels(slices: 128, pixelsPerRadian: 1000)
+
+        XCTAssertEqual(coarse / fine, 4, accuracy: 0.01)
+        XCTAssertGreaterThan(IRGLSphereMeshLODPolicy.chordErrorPixels(slices: 64, pixelsPerRadian: 1000, cameraOffset: 120),
+                             coarse)
+    }
+
+    func testSmallGridPanelsUseCoarseMeshes() {
+        // A 2x2 grid on a 1080p screen: every panel is 540 px tall.
+        let panel = IRGLSphereMeshLODPolicy.slices(viewportHeight: 540, fovDegrees: 60, cameraOffset: 120)
+        let thumbnail = IRGLSphereMeshLODPolicy.slices(viewportHeight: 200, fovDegrees: 60, cameraOffset: 120)
+
+        XCTAssertEqual(panel, 64)
+        XCTAssertEqual(thumbnail, 32)
+        XCTAssertLessThan(4 * IRGLSphereMeshLODPolicy.triangleCount(slices: panel),
+                          IRGLSphereMeshLODPolicy.triangleCount(slices: SPHERE_SLICES))
+    }
+
+    func testZoomingInRaisesTheLevel() {
+        var previous = 0
+        for fov: Float in [90, 60, 30, 15, 8, 4] {
+            let slices = IRGLSphereMeshLODPolicy.slices(viewportHeight: 1170, fovDegrees: fov, cameraOffset: 120)
+            XCTAssertGreaterThanOrEqual(slices, previous, "\(fov)")
+            previous = slices
+        }
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.slices(viewportHeight: 2048, fovDegrees: 4, cameraOffset: 120), 256)
+    }
+
+    func testInvalidViewportFallsBackToTheCoarsestLevel() {
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.slices(viewportHeight: 0, fovDegrees: 60), 32)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.slices(viewportHeight: 1080, fovDegrees: .nan), 32)
+    }
+
+    func testClosestLevelPrefersFinerThenCoarser() {
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.closestLevel(to: 64, available: [32, 64, 128]), 64)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.closestLevel(to: 64, available: [32, 128, 256]), 128)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.closestLevel(to: 256, available: [32, 64]), 64)
+        XCTAssertNil(IRGLSphereMeshLODPolicy.closestLevel(to: 64, available: []))
+    }
+
+    func testLevelCoversTheRequestedSlices() {
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.level(for: 1), 32)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.level(for: 64), 64)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.level(for: SPHERE_SLICES), 256)
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.level(for: 1_000), 256)
+    }
+
+    func testViewsHoldTheWantedLevelAndAtMostOneOther() {
+        // Still building: the closest level stands in, nothing else is kept.
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.retainedLevels(for: 256, available: [32, 64, 128]), [128])
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.retainedLevels(for: 64, available: []), [])
+        // Built: one adjacent level survives, distant ones do not.
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.retainedLevels(for: 128, available: [32, 128, 256]), [128, 256])
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.retainedLevels(for: 128, available: [64, 128, 256]), [64, 128])
+        XCTAssertEqual(IRGLSphereMeshLODPolicy.retainedLevels(for: 32, available: [32, 128, 256]), [32])
+    }
+
+    func testControllerFollowsItsViewportAndZoom() {
+        let controller = IRGLTransformController3DFisheye(viewportWidth: 1920, viewportHeight: 1080, tileType: .backward)
+        controller.scaleRange = IRGLScaleRange(minScaleX: 1, minScaleY: 1, maxScaleX: 8, maxScaleY: 8,
+                                               defaultScaleX: 1, defaultScaleY: 1)
+        let initial = controller.sphereMeshSlices()
+        XCTAssertEqual(initial, IRGLSphereMeshLODPolicy.slices(viewportHeight: 1080,
+                                                               fovDegrees: controller.fov,
+                                                               cameraOffset: controller.rc))
+
+        controller.update(fx: 0, fy: 0, sx: 8, sy: 8)
+        XCTAssertGreaterThan(controller.sphereMeshSlices(), initial)
+    }
+}
@@ -0,0 +1,104 @@
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRGLSphereMeshTests: XCTestCase {
+
+    func testKeyAppliesTheCentredFallback() throws {
+        let offCentre = try XCTUnwrap(IRGLSphereMeshKey(slices: 180, textureWidth: 200, textureHeight: 100,
+                                                        centerX: 180, centerY: 50, radius: 40))
+        let centred = try XCTUnwrap(IRGLSphereMeshKey(slices: 180, textureWidth: 200, textureHeight: 100,
+                                                      centerX: 100, centerY: 50, radius: 50))
+
+        XCTAssertEqual(offCentre, centred)
+        XCTAssertEqual(offCentre.radius, 50)
+        XCTAssertNotEqual(offCentre, IRGLSphereMeshKey(slices: 64, textureWidth: 200, textureHeight: 100,
+                                                       centerX: 100, centerY: 50, radius: 50))
+    }
+
+    func testKeyRejectsInvalidGeometry() {
+        XCTAssertNil(IRGLSphereMeshKey(slices: 180, textureWidth: 0, textureHeight: 100, centerX: 50, centerY: 50, radius: 20))
+        XCTAssertNil(IRGLSphereMeshKey(slices: 180, textureWidth: .nan, textureHeight: 100, centerX: 50, centerY: 50, radius: 20))
+        XCTAssertNil(IRGLSphereMeshKey(slices: 0, textureWidth: 200, textureHeight: 100, centerX: 100, centerY: 50, radius: 40))
+    }
+
+    func testMeshFollowsTheSphereFormula() throws {
+        let key = try XCTUnwrap(IRGLSphereMeshKey(slices: 180, textureWidth: 1440, textureHeight: 1080,
+                                                  centerX: 720, centerY: 540, radius: 520))
+        let mesh = try XCTUnwrap(IRGLSphereMesh(key: key))
+        let iMax = 181
+        let step = Float.pi / 180
+
+        XCTAssertEqual(mesh.positions.count, iMax * iMax)
+        XCTAssertEqual(mesh.texcoords.count, iMax * iMax)
+        XCTAssertEqual(mesh.indices.count, 194_400)
+        XCTAssertEqual(mesh.indices.bytesPerIndex, MemoryLayout<UInt16>.stride)
+
+        for (i, j) in [(0, 0), (45, 90), (90, 45), (180, 180), (17, 133)] {
+            let sini = sin(step * Float(i))
+            let cosi = cos(step * Float(i))
+            let position = mesh.positions[i * iMax + j]
+            XCTAssertEqual(position.x, SPHERE_RADIUS * sini * sin(step * Float(j)), accuracy: 0.001)
+            XCTAssertEqual(position.y, SPHERE_RADIUS * sini * cos(step * Float(j)), accuracy: 0.001)
+            XCTAssertEqual(position.z, SPHERE_RADIUS * cosi, accuracy: 0.001)
+
+            let texcoord = mesh.texcoords[i * iMax + (iMax - j - 1)]
+            XCTAssertEqual(texcoord.x, (720 - 520 * sini * cos(step * Float(j))) / 1440, accuracy: 0.0001)
+            XCTAssertEqual(texcoord.y, (520 * cosi - 540) / 1080, accuracy: 0.0001)
+        }
+    }
+
+    func testIndicesSwitchToUInt32OnceVerticesOutgrowUInt16() throws {
+        XCTAssertFalse(IRGLSphereMesh.usesUInt32Indices(vertexCount: 65_536))
+        XCTAssertTrue(IRGLSphereMesh.usesUInt32Indices(vertexCount: 65_537))
+
+        let small = try XCTUnwrap(IRGLSphereMeshKey(slices: 255, textureWidth: 200, textureHeight: 100,
+                                                    centerX: 100, centerY: 50, radius: 50))
+        let large = try XCTUnwrap(IRGLSphereMeshKey(slices: 256, textureWidth: 200, textureHeight: 100,
+                                                    centerX: 100, centerY: 50, radius: 50))
+        let smallMesh = try XCTUnwrap(IRGLSphereMesh(key: small))
+        let largeMesh = try XCTUnwrap(IRGLSphereMesh(key: large))
+
+        XCTAssertEqual(smallMesh.indices.bytesPerIndex, 2)
+        XCTAssertEqual(largeMesh.indices.bytesPerIndex, 4)
+        guard case .uint32(let indices) = largeMesh.indices else { return XCTFail("expected 32-bit indices") }
+        XCTAssertEqual(indices.max(), 257 * 257 - 1)
+        XCTAssertEqual(indices.count, 256 * 256 * 6)
+    }
+
+    func testEveryIndexAddressesAVertex() throws {
+        let key = try XCTUnwrap(IRGLSphereMeshKey(slices: 32, textureWidth: 200, textureHeight: 100,
+                                                  centerX: 100, centerY: 50, radius: 50))
+        let mesh = try XCTUnwrap(IRGLSphereMesh(key: key))
+
+        for index in 0..<mesh.indices.count {
+            XCTAssertLessThan(mesh.indices[index], mesh.positions.count)
+        }
+        XCTAssertEqual(mesh.indices.withUnsafeBytes { $0.count }, mesh.indices.count * 2)
+    }
+
+    func testProjectionsWithTheSameGeometryShareOneMesh() throws {
+        let first = IRGLProjectionEquirectangular(textureWidth: 1440, height: 1080, centerX: 720, centerY: 540, radius: 520)
+        let second = IRGLProjectionEquirectangular(textureWidth: 1440, height: 1080, centerX: 720, centerY: 540, radius: 520)
+        let key = try XCTUnwrap(first.meshKey)
+
+        XCTAssertEqual(second.meshKey, key)
+
+        // Built on first export, then held by the projection.
+        let exported = try XCTUnwrap(first.exportMesh())
+        XCTAssertTrue(IRGLSphereMesh.cache.keys.contains(key))
+        let mesh = try XCTUnwrap(IRGLSphereMesh.shared(for: key))
+        XCTAssertTrue(IRGLSphereMesh.shared(for: key) === mesh)
+        XCTAssertEqual(exported.positions, mesh.positions)
+        XCTAssertEqual(exported.texcoords, mesh.texcoords)
+        XCTAssertEqual(exported.indices.count, mesh.indices.count)
+    }
+
+    func testBenchmarkBuildSphereMesh() throws {
+        let key = try XCTUnwrap(IRGLSphereMeshKey(slices: 180, textureWidth: 1440, textureHeight: 1080,
+                                                  centerX: 720, centerY: 540, radius: 520))
+
+        measure {
+            XCTAssertNotNil(IRGLSphereMesh(key: key))
+        }
+    }
+}
@@ -135,11 +135,11 @@ final class IRGLViewSnapshotTests: XCTestCase {
         XCTAssertNil(IRGLView.texUVTextureLayout(width: Int.max, height: 2))
     }
 
-    func testTexUVTextureLayoutCalculatesRGFloatRows() {
+    func testTexUVTextureLayoutCalculatesRG16UnormRows() {
         let layout = IRGLView.texUVTextureLayout(width: 3, height: 2)
 
-        XCTAssertEqual(layout?.bytesPerRow, 24)
-        XCTAssertEqual(layout?.totalByteCount, 48)
+        XCTAssertEqual(layout?.bytesPerRow, 12)
+        XCTAssertEqual(layout?.totalByteCount, 24)
     }
 
     func testTexUVTextureLayoutWrapperMatchesPolicy() {
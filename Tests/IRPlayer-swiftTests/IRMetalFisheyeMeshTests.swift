@@ -38,22 +38,6 @@ final class IRMetalFisheyeMeshTests: XCTestCase {
         XCTAssertNil(IRMetalFisheyeMeshPolicy.bufferByteLength(elementCount: 0, stride: MemoryLayout<UInt16>.stride))
     }
 
-    func testIndexValueRejectsValuesOutsideUInt16Range() {
-        XCTAssertNil(IRMetalFisheyeMesh.indexValue(-1))
-        XCTAssertNil(IRMetalFisheyeMesh.indexValue(Int(UInt16.max) + 1))
-    }
-
-    func testIndexValueConvertsUInt16RepresentableValues() {
-        XCTAssertEqual(IRMetalFisheyeMesh.indexValue(0), 0)
-        XCTAssertEqual(IRMetalFisheyeMesh.indexValue(Int(UInt16.max)), UInt16.max)
-    }
-
-    func testIndexValueWrapperMatchesPolicy() {
-        XCTAssertEqual(IRMetalFisheyeMesh.indexValue(0), IRMetalFisheyeMeshPolicy.indexValue(0))
-        XCTAssertEqual(IRMetalFisheyeMesh.indexValue(Int(UInt16.max)), IRMetalFisheyeMeshPolicy.indexValue(Int(UInt16.max)))
-        XCTAssertNil(IRMetalFisheyeMeshPolicy.indexValue(-1))
-    }
-
     func testResolveParamsRejectsInvalidTextureDimensions() {
         let params = IRMetalFisheyeMesh.resolveParams(textureWidth: 0, textureHeight: 100, centerX: 20, centerY: 20, radius: 10)
 
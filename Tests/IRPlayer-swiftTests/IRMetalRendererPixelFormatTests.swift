@@ -177,21 +177,21 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                           panoheight: 2,
                                                           antialias: 1,
                                                           offsetX: 0)
-        XCTAssertTrue(IRMetalRenderer.fish2PanoInputsAreValid(params: validParams, texUVTextureCount: 1))
+        XCTAssertTrue(IRMetalRenderer.fish2PanoInputsAreValid(params: validParams, texUVSliceCount: 1))
 
         var invalidParams = validParams
         invalidParams.antialias = 0
-        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVTextureCount: 0))
+        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVSliceCount: 0))
 
         invalidParams = validParams
         invalidParams.fishwidth = 0
-        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVTextureCount: 1))
+        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVSliceCount: 1))
 
         invalidParams = validParams
         invalidParams.offsetX = .nan
-        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVTextureCount: 1))
+        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: invalidParams, texUVSliceCount: 1))
 
-        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: validParams, texUVTextureCount: 0))
+        XCTAssertFalse(IRMetalRenderer.fish2PanoInputsAreValid(params: validParams, texUVSliceCount: 0))
     }
 
     func testFish2PanoInputValidationWrapperMatchesPolicy() {
@@ -202,8 +202,8 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                      antialias: 3,
                                                      offsetX: 0)
         XCTAssertEqual(
-            IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVTextureCount: 9),
-            IRMetalRendererFish2PanoPolicy.inputsAreValid(params: params, texUVTextureCount: 9)
+            IRMetalRenderer.fish2PanoInputsAreValid(params: params, texUVSliceCount: 9),
+            IRMetalRendererFish2PanoPolicy.inputsAreValid(params: params, texUVSliceCount: 9)
         )
     }
 
@@ -412,6 +412,62 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
         }
     }
 
+    func testMakeTextureRecyclesPlaneTextureAfterFrameCompletes() throws {
+        let renderer = try makeRenderer()
+        var bytes = [UInt8](repeating: 0x7f, count: 4)
+
+        guard let commandBuffer = renderer.makeFrameCommandBuffer() else {
+            throw XCTSkip("Metal command buffer unavailable")
+        }
+        let first = bytes.withUnsafeMutableBytes { buffer in
+            renderer.makeTexture(width: 2, height: 2, pixelFormat: .r8Unorm, bytes: buffer.baseAddress!)
+        }
+        renderer.commitFrame(commandBuffer)
+        commandBuffer.waitUntilCompleted()
+        let deadline = Date().addingTimeInterval(1)
+        while renderer.texturePool.inFlightCount > 0, Date() < deadline {
+            Thread.sleep(forTimeInterval: 0.001)
+        }
+
+        let second = bytes.withUnsafeMutableBytes { buffer in
+            renderer.makeTexture(width: 2, height: 2, pixelFormat: .r8Unorm, bytes: buffer.baseAddress!)
+        }
+        XCTAssertNotNil(first)
+        XCTAssertTrue(first === second)
+    }
+
+    func testPlaneBytesPerRowKeepsPaddedStrideAndRejectsShortRows() {
+        XCTAssertEqual(IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 6, height: 4, stride: nil), 6)
+        XCTAssertEqual(IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 6, height: 4, stride: 64), 64)
+        XCTAssertNil(IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 6, height: 4, stride: 4))
+        XCTAssertNil(IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 0, height: 4, stride: 64))
+        XCTAssertNil(IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 6, height: 4, stride: .max))
+        XCTAssertEqual(IRMetalRenderer.planeBytesPerRow(width: 6, height: 4, stride: 64),
+                       IRMetalRendererPixelFormatPolicy.planeBytesPerRow(width: 6, height: 4, stride: 64))
+    }
+
+    func testMakeTextureUploadsPaddedRowsUsingStride() throws {
+        let renderer = try makeRenderer()
+        var bytes: [UInt8] = [
+            1, 2, 0xee, 0xee,
+            3, 4, 0xee, 0xee
+        ]
+
+        let texture = bytes.withUnsafeMutableBytes { buffer in
+            renderer.makeTexture(width: 2, height: 2, pixelFormat: .r8Unorm, bytes: buffer.baseAddress!, bytesPerRow: 4)
+        }
+        let unwrapped = try XCTUnwrap(texture)
+        var readBack = [UInt8](repeating: 0, count: 4)
+        readBack.withUnsafeMutableBytes { buffer in
+            unwrapped.getBytes(buffer.baseAddress!, bytesPerRow: 2, from: MTLRegionMake2D(0, 0, 2, 2), mipmapLevel: 0)
+        }
+
+        XCTAssertEqual(readBack, [1, 2, 3, 4])
+        bytes.withUnsafeMutableBytes { buffer in
+            XCTAssertNil(renderer.makeTexture(width: 2, height: 2, pixelFormat: .r8Unorm, bytes: buffer.baseAddress!, bytesPerRow: 1))
+        }
+    }
+
     func testMakeNV12TexturesCreatesPlaneTexturesForBiPlanarBuffer() throws {
         let renderer = try makeRenderer()
         let pixelBuffer = try makePixelBuffer(format: kCVPixelFormatType_420YpCbCr8BiPlanarFullRange)
@@ -562,14 +618,17 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                 XCTAssertFalse(renderer.renderNV12Mesh(cvFrame: nv12Frame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
                 XCTAssertFalse(renderer.renderBGRAMesh(cvFrame: bgraFrame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
                 XCTAssertFalse(renderer.renderI420Mesh(yuvFrame: yuvFrame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
             }
         }
@@ -589,6 +648,7 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                     frame: frame,
                                                     encoder: encoder,
                                                     indexCount: 0,
+                                                    indexType: .uint16,
                                                     indexBuffer: renderer.vertexBuffer!))
         }
     }
@@ -621,41 +681,44 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                        frame: nv12Frame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
                 XCTAssertFalse(nv12Renderer.renderMesh(renderer: renderer,
                                                        frame: bgraFrame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
                 XCTAssertFalse(nv12Renderer.renderFish2Pano(renderer: renderer,
                                                             frame: nv12Frame,
                                                             encoder: encoder,
                                                             params: params,
-                                                            texUVTextures: []))
+                                                            texUVTexture: nil))
                 XCTAssertFalse(nv12Renderer.renderFish2Pano(renderer: renderer,
                                                             frame: bgraFrame,
                                                             encoder: encoder,
                                                             params: params,
-                                                            texUVTextures: []))
+                                                            texUVTexture: nil))
 
                 XCTAssertFalse(i420Renderer.render2D(renderer: renderer, frame: frame, encoder: encoder))
                 XCTAssertFalse(i420Renderer.renderMesh(renderer: renderer,
                                                        frame: frame,
                                                        encoder: encoder,
                                                        indexCount: 3,
+                                                       indexType: .uint16,
                                                        indexBuffer: indexBuffer))
                 XCTAssertFalse(i420Renderer.renderFish2Pano(renderer: renderer,
                                                             frame: frame,
                                                             encoder: encoder,
                                                             params: params,
-                                                            texUVTextures: []))
+                                                            texUVTexture: nil))
 
                 XCTAssertFalse(rgbRenderer.render2D(renderer: renderer, frame: rgbFrame, encoder: encoder))
                 XCTAssertFalse(rgbRenderer.renderFish2Pano(renderer: renderer,
                                                            frame: rgbFrame,
                                                            encoder: encoder,
                                                            params: params,
-                                                           texUVTextures: []))
+                                                           texUVTexture: nil))
             }
         }
     }
@@ -673,6 +736,7 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                     frame: frame,
                                                     encoder: encoder,
                                                     indexCount: 0,
+                                                    indexType: .uint16,
                                                     indexBuffer: renderer.vertexBuffer!))
         }
     }
@@ -690,24 +754,26 @@ final class IRMetalRendererPixelFormatTests: XCTestCase {
                                                    frame: rgbFrame,
                                                    encoder: encoder,
                                                    indexCount: 0,
+                                                   indexType: .uint16,
                                                    indexBuffer: renderer.vertexBuffer!))
             XCTAssertFalse(nv12Renderer.renderFish2Pano(renderer: renderer,
                                                         frame: rgbFrame,
                                                         encoder: encoder,
                                                         params: params,
-                                                        texUVTextures: []))
+                                                        texUVTexture: nil))
 
             XCTAssertFalse(i420Renderer.render2D(renderer: renderer, frame: rgbFrame, encoder: encoder))
             XCTAssertFalse(i420Renderer.renderMesh(renderer: renderer,
                                                    frame: rgbFrame,
                                                    encoder: encoder,
                                                    indexCount: 0,
+                                                   indexType: .uint16,
                                                    indexBuffer: renderer.vertexBuffer!))
             XCTAssertFalse(i420Renderer.renderFish2Pano(renderer: renderer,
                                                         frame: rgbFrame,
                                                         encoder: encoder,
                                                         params: params,
-                                                        texUVTextures: []))
+                                                        texUVTexture: nil))
         }
     }
 }
@@ -0,0 +1,176 @@
+//
+//  IRMetalTexturePoolPolicyTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRMetalTexturePoolPolicyTests: XCTestCase {
+
+    private final class FakeTexture {}
+
+    private typealias Policy = IRMetalTexturePoolPolicy<FakeTexture>
+
+    private let lumaKey = IRMetalTextureKey(width: 1920, height: 1080, pixelFormat: 10)
+    private let chromaKey = IRMetalTextureKey(width: 960, height: 540, pixelFormat: 10)
+
+    func testKeyRejectsEmptySizesAndSeparatesPixelFormats() {
+        XCTAssertNil(Policy.key(width: 0, height: 4, pixelFormat: 10))
+        XCTAssertNil(Policy.key(width: 4, height: -1, pixelFormat: 10))
+        XCTAssertNotEqual(Policy.key(width: 4, height: 4, pixelFormat: 10),
+                          Policy.key(width: 4, height: 4, pixelFormat: 80))
+        XCTAssertEqual(Policy.key(width: 4, height: 4, pixelFormat: 10),
+                       IRMetalTextureKey(width: 4, height: 4, pixelFormat: 10))
+    }
+
+    func testTextureIsRecycledOnlyAfterItsFrameCompletes() {
+        var policy = Policy()
+        let texture = FakeTexture()
+
+        policy.beginFrame()
+        XCTAssertNil(policy.checkout(lumaKey))
+        policy.track(texture, key: lumaKey)
+        let frameID = policy.commitFrame()
+
+        policy.beginFrame()
+        XCTAssertNil(policy.checkout(lumaKey))
+        XCTAssertEqual(policy.inFlightCount, 1)
+
+        policy.completeFrame(frameID)
+        XCTAssertEqual(policy.inFlightCount, 0)
+        XCTAssertTrue(policy.checkout(lumaKey) === texture)
+        XCTAssertEqual(policy.pendingCount, 1)
+    }
+
+    func testCheckoutMatchesExactKeyOnly() {
+        var policy = Policy()
+        policy.track(FakeTexture(), key: chromaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+
+        XCTAssertNil(policy.checkout(lumaKey))
+        XCTAssertNil(policy.checkout(IRMetalTextureKey(width: 960, height: 540, pixelFormat: 80)))
+        XCTAssertNotNil(policy.checkout(chromaKey))
+        XCTAssertNil(policy.checkout(chromaKey))
+    }
+
+    func testSameKeyTexturesWithinOneFrameAreDistinct() {
+        var policy = Policy()
+        let chromaB = FakeTexture()
+        let chromaR = FakeTexture()
+        policy.track(chromaB, key: chromaKey)
+        policy.track(chromaR, key: chromaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+
+        policy.beginFrame()
+        let first = policy.checkout(chromaKey)
+        let second = policy.checkout(chromaKey)
+        XCTAssertNotNil(first)
+        XCTAssertNotNil(second)
+        XCTAssertFalse(first === second)
+        XCTAssertNil(policy.checkout(chromaKey))
+    }
+
+    func testAbandonedFrameReturnsPendingTexturesOnNextBegin() {
+        var policy = Policy()
+        let texture = FakeTexture()
+        policy.beginFrame()
+        policy.track(texture, key: lumaKey)
+
+        policy.beginFrame()
+        XCTAssertEqual(policy.pendingCount, 0)
+        XCTAssertTrue(policy.checkout(lumaKey) === texture)
+    }
+
+    func testFramesCompleteOutOfOrderIndependently() {
+        var policy = Policy()
+        let first = FakeTexture()
+        let second = FakeTexture()
+        policy.track(first, key: lumaKey)
+        let firstID = policy.commitFrame()
+        policy.beginFrame()
+        policy.track(second, key: lumaKey)
+        let secondID = policy.commitFrame()
+        XCTAssertEqual(policy.framesInFlight, 2)
+
+        policy.completeFrame(secondID)
+        XCTAssertEqual(policy.framesInFlight, 1)
+        XCTAssertTrue(policy.checkout(lumaKey) === second)
+
+        policy.completeFrame(firstID)
+        policy.completeFrame(firstID)
+        XCTAssertEqual(policy.framesInFlight, 0)
+        XCTAssertEqual(policy.availableCount(for: lumaKey), 1)
+    }
+
+    func testIdleTexturesAreEvictedAfterMaxIdleFrames() {
+        var policy = Policy(configuration: .init(maxFramesInFlight: 3, maxIdleFrames: 2, maxAvailablePerKey: 8))
+        policy.track(FakeTexture(), key: chromaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+        XCTAssertEqual(policy.availableCount, 1)
+
+        for _ in 0..<2 {
+            policy.beginFrame()
+            _ = policy.commitFrame()
+        }
+        XCTAssertEqual(policy.availableCount, 1)
+
+        policy.beginFrame()
+        _ = policy.commitFrame()
+        XCTAssertEqual(policy.availableCount, 0)
+    }
+
+    func testReusedTexturesStayResidentAcrossManyFrames() {
+        var policy = Policy(configuration: .init(maxFramesInFlight: 3, maxIdleFrames: 2, maxAvailablePerKey: 8))
+        let texture = FakeTexture()
+        policy.track(texture, key: lumaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+
+        for _ in 0..<10 {
+            policy.beginFrame()
+            XCTAssertTrue(policy.checkout(lumaKey) === texture)
+            let frame = policy.commitFrame()
+            policy.completeFrame(frame)
+        }
+        XCTAssertEqual(policy.availableCount, 1)
+    }
+
+    func testAvailableTexturesAreCappedPerKey() {
+        var policy = Policy(configuration: .init(maxFramesInFlight: 3, maxIdleFrames: 60, maxAvailablePerKey: 2))
+        for _ in 0..<5 {
+            policy.track(FakeTexture(), key: chromaKey)
+        }
+        policy.track(FakeTexture(), key: lumaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+
+        XCTAssertEqual(policy.availableCount(for: chromaKey), 2)
+        XCTAssertEqual(policy.availableCount(for: lumaKey), 1)
+    }
+
+    func testConfigurationIsClampedAndRemoveAvailableKeepsInFlight() {
+        var policy = Policy(configuration: .init(maxFramesInFlight: 0, maxIdleFrames: -4, maxAvailablePerKey: -1))
+        XCTAssertEqual(policy.configuration.maxFramesInFlight, 1)
+        XCTAssertEqual(policy.configuration.maxIdleFrames, 0)
+        XCTAssertEqual(policy.configuration.maxAvailablePerKey, 0)
+
+        policy = Policy()
+        policy.track(FakeTexture(), key: lumaKey)
+        let frame = policy.commitFrame()
+        policy.completeFrame(frame)
+        policy.track(FakeTexture(), key: chromaKey)
+        let frameID = policy.commitFrame()
+
+        policy.removeAvailable()
+        XCTAssertEqual(policy.availableCount, 0)
+        XCTAssertEqual(policy.inFlightCount, 1)
+        policy.completeFrame(frameID)
+        XCTAssertEqual(policy.availableCount(for: chromaKey), 1)
+    }
+}
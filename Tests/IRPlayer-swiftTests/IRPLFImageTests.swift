@@ -52,6 +52,30 @@ final class IRPLFImageTests: XCTestCase {
         XCTAssertNil(image)
     }
 
+    func testCGImageWithBGRADataUsesLittleEndianSkipFirstLayout() {
+        let pixels: [UInt8] = [
+            255, 0, 0, 255, 0, 255, 0, 255,
+            0, 0, 255, 255, 255, 255, 255, 255
+        ]
+
+        let image = pixels.withUnsafeBufferPointer { buffer in
+            IRPLFImageCGImageWithBGRAData(buffer.baseAddress!, linesize: 8, width: 2, height: 2)
+        }
+
+        XCTAssertEqual(image?.width, 2)
+        XCTAssertEqual(image?.bitsPerPixel, 32)
+        XCTAssertEqual(image?.bytesPerRow, 8)
+        XCTAssertEqual(image?.alphaInfo, .noneSkipFirst)
+        XCTAssertEqual(image?.bitmapInfo.contains(.byteOrder32Little), true)
+    }
+
+    func testBGRADataByteCountRequiresFourBytesPerPixel() {
+        XCTAssertNil(IRPLFImageBGRADataByteCount(linesize: 15, width: 4, height: 2))
+        XCTAssertEqual(IRPLFImageBGRADataByteCount(linesize: 16, width: 4, height: 2), 32)
+        XCTAssertEqual(IRPLFImageBGRADataByteCount(linesize: 64, width: 4, height: 2), 128)
+        XCTAssertNil(IRPLFImagePolicy.dataByteCount(linesize: 16, width: Int.max, height: 2, bytesPerPixel: 4))
+    }
+
     func testRGBDataByteCountRejectsInvalidOrOverflowingInputs() {
         XCTAssertNil(IRPLFImageRGBDataByteCount(linesize: 0, width: 4, height: 4))
         XCTAssertNil(IRPLFImageRGBDataByteCount(linesize: 12, width: 0, height: 4))
@@ -7,6 +7,7 @@
 
 import Foundation
 import Darwin
+import XCTest
 @testable import IRPlayer_swift
 
 final class FormatContextInterruptDelegate: IRFFFormatContextDelegate {
@@ -43,6 +44,26 @@ func mirroredFFPlayer(from player: IRPlayerImp) -> IRFFPlayer? {
     return childValue as? IRFFPlayer
 }
 
+let videoStandInWidth = 320
+let videoStandInHeight = 240
+
+/// Ten seconds of 25 fps YUV4MPEG video, which FFmpeg demuxes and decodes without
+/// any optional codec. Frame `n` has luma `n` (mod 256) and neutral chroma.
+func makeVideoStandIn() throws -> URL {
+    let url = FileManager.default.temporaryDirectory
+        .appendingPathComponent("IRVideoStandIn-\(UUID().uuidString).y4m")
+    var data = Data("YUV4MPEG2 W\(videoStandInWidth) H\(videoStandInHeight) F25:1 Ip A1:1 C420jpeg\n".utf8)
+    let frameHeader = Data("FRAME\n".utf8)
+    let lumaSize = videoStandInWidth * videoStandInHeight
+    for frame in 0..<250 {
+        data.append(frameHeader)
+        data.append(Data(repeating: UInt8(truncatingIfNeeded: frame), count: lumaSize))
+        data.append(Data(repeating: 128, count: lumaSize / 2))
+    }
+    try data.write(to: url)
+    return url
+}
+
 func captureStandardOutput(_ body: () -> Void) -> String {
     let pipe = Pipe()
     let originalStdout = dup(STDOUT_FILENO)
@@ -59,3 +80,86 @@ func captureStandardOutput(_ body: () -> Void) -> String {
     let data = pipe.fileHandleForReading.readDataToEndOfFile()
     return String(data: data, encoding: .utf8) ?? ""
 }
+
+/// The geometry IRGLFish2PanoShaderParams builds for a centred fisheye, shrunk to a
+/// size the tests can compare float by float.
+func makeFish2PanoGeometry(textureWidth: Int = 64,
+                           textureHeight: Int = 48,
+                           outputWidth: Int = 20,
+                           outputHeight: Int = 6,
+                           antialias: Int = 1) -> IRGLFish2PanoPixelMapGeometry {
+    return IRGLFish2PanoPixelMapGeometry(outputWidth: outputWidth,
+                                         outputHeight: outputHeight,
+                                         antialias: antialias,
+                                         textureWidth: textureWidth,
+                                         textureHeight: textureHeight,
+                                         fishCenterX: textureWidth / 2,
+                                         fishCenterY: textureHeight / 2,
+                                         fishRadiusH: textureWidth / 2,
+                                         fishAperture: 180,
+                                         lat1: 0,
+                                         lat2: 60,
+                                         long1: 0,
+                                         long2: 360,
+                                         transformX: 0,
+                                         transformY: 0,
+                                         transformZ: -90)
+}
+
+/// Owns one set of UV maps for a geometry, pre-filled with a sentinel so untouched
+/// floats show up in comparisons.
+final class Fish2PanoPixelMaps {
+    let geometry: IRGLFish2PanoPixelMapGeometry
+    let pointers: [UnsafeMutablePointer<Float>]
+
+    init(_ geometry: IRGLFish2PanoPixelMapGeometry) {
+        self.geometry = geometry
+        pointers = (0..<geometry.mapCount).map { _ in
+            let map = UnsafeMutablePointer<Float>.allocate(capacity: geometry.mapCapacity)
+            map.initialize(repeating: 12345, count: geometry.mapCapacity)
+            return map
+        }
+    }
+
+    var bitPatterns: [[UInt32]] {
+        return pointers.map { map in
+            UnsafeBufferPointer(start: map, count: geometry.mapCapacity).map(\.bitPattern)
+        }
+    }
+
+    func uv(x: Int, y: Int, map: Int) -> (u: Float, v: Float) {
+        let offset = (geometry.outputWidth * y + x) * 2
+        return (pointers[map][offset], pointers[map][offset + 1])
+    }
+
+    deinit {
+        pointers.forEach { $0.deallocate() }
+    }
+}
+
+func waitForFish2PanoPixelMap(
+    from params: IRGLFish2PanoShaderParams,
+    timeout: TimeInterval = 2,
+    file: StaticString = #filePath,
+    line: UInt = #line
+) throws -> IRGLFish2PanoPackedPixelMap {
+    let deadline = Date().addingTimeInterval(timeout)
+    while Date() < deadline {
+        if let pixelMap = params.consumePixUVIfReady() {
+            return pixelMap
+        }
+        RunLoop.current.run(mode: .default, before: Date().addingTimeInterval(0.01))
+    }
+    XCTFail("Expected fish2pano pixel map to become ready", file: file, line: line)
+    throw XCTSkip("Pixel map did not become ready before timeout")
+}
+
+/// Packs `maps` the way IRGLFish2PanoShaderParams publishes them.
+func packedFish2PanoTexels(_ maps: Fish2PanoPixelMaps) -> [UInt16] {
+    guard let layout = IRGLFish2PanoPixelMapPacking.layout(for: maps.geometry) else { return [] }
+    var texels = [UInt16](repeating: 0, count: layout.byteCount / MemoryLayout<UInt16>.stride)
+    texels.withUnsafeMutableBufferPointer {
+        IRGLFish2PanoPixelMapPacking.pack(maps.pointers, geometry: maps.geometry, into: $0.baseAddress!)
+    }
+    return texels
+}
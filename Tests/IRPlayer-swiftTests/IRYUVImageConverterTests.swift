@@ -0,0 +1,199 @@
+//
+//  IRYUVImageConverterTests.swift
+//  IRPlayer-swiftTests
+//
+//  Created by irons on 2026/10/17.
+//
+
+import IRFFMpeg
+import XCTest
+@testable import IRPlayer_swift
+
+final class IRYUVImageConverterTests: XCTestCase {
+
+    func testRowBandsStayOnChromaRowsAndCoverTheImage() {
+        XCTAssertEqual(IRYUVToolsPolicy.rowBands(height: 0, maxBands: 4, rowAlignment: 2), [])
+        XCTAssertEqual(IRYUVToolsPolicy.rowBands(height: 100, maxBands: 8, rowAlignment: 2), [0..<100])
+        XCTAssertEqual(IRYUVToolsPolicy.rowBands(height: 1080, maxBands: 1, rowAlignment: 2), [0..<1080])
+
+        let bands = IRYUVToolsPolicy.rowBands(height: 1081, maxBands: 4, rowAlignment: 2)
+        XCTAssertEqual(bands.count, 4)
+        XCTAssertEqual(bands.first?.lowerBound, 0)
+        XCTAssertEqual(bands.last?.upperBound, 1081)
+        for (band, next) in zip(bands, bands.dropFirst()) {
+            XCTAssertEqual(band.upperBound, next.lowerBound)
+            XCTAssertEqual(band.upperBound % 2, 0)
+        }
+    }
+
+    func testConvertsYUV420ToOpaqueBGRA() {
+        let frame = Self.yuv420Frame(width: 16, height: 16) { _, _ in 235 }
+        let converter = IRYUVImageConverter()
+
+        let pixel = frame.convert(with: converter, outputFormat: .bgra) { pixels, _ in
+            Array(UnsafeBufferPointer(start: pixels, count: 4))
+        }
+
+        // Video-range white.
+        XCTAssertEqual(pixel ?? [], [255, 255, 255, 255])
+    }
+
+    func testReusesContextsAndBufferPerGeometryAndFormat() {
+        let converter = IRYUVImageConverter(capacity: 2)
+        let small = Self.yuv420Frame(width: 16, height: 16) { _, _ in 128 }
+        let large = Self.yuv420Frame(width: 32, height: 16) { _, _ in 128 }
+
+        for _ in 0..<5 {
+            XCTAssertNotNil(small.convert(with: converter, outputFormat: .bgra) { _, linesize in linesize })
+        }
+        XCTAssertEqual(converter.createdEntryCount, 1)
+
+        XCTAssertNotNil(small.convert(with: converter, outputFormat: .rgb24) { _, linesize in linesize })
+        XCTAssertNotNil(large.convert(with: converter, outputFormat: .bgra) { _, linesize in linesize })
+        XCTAssertEqual(converter.createdEntryCount, 3)
+        XCTAssertEqual(converter.cachedEntryCount, 2)
+
+        // The first geometry was the least recently used and had to be rebuilt.
+        XCTAssertNotNil(small.convert(with: converter, outputFormat: .bgra) { _, linesize in linesize })
+        XCTAssertEqual(converter.createdEntryCount, 4)
+    }
+
+    func testOutputRowsAreAlignedForSIMD() {
+        let frame = Self.yuv420Frame(width: 18, height: 4) { _, _ in 128 }
+
+        let linesize = frame.convert(with: IRYUVImageConverter(), outputFormat: .bgra) { _, linesize in linesize }
+
+        XCTAssertEqual((linesize ?? 1) % 64, 0)
+        XCTAssertGreaterThanOrEqual(linesize ?? 0, 18 * 4)
+    }
+
+    func testRowParallelConversionMatchesSerialConversion() {
+        let frame = Self.yuv420Frame(width: 320, height: 480) { x, y in UInt8(truncatingIfNeeded: x * 3 + y * 7) }
+        let serial = frame.convert(with: IRYUVImageConverter(), outputFormat: .bgra) { pixels, linesize in
+            Data(bytes: pixels, count: linesize * 480)
+        }
+        let parallel = frame.convert(with: IRYUVImageConverter(rowParallel: true), outputFormat: .bgra) { pixels, linesize in
+            Data(bytes: pixels, count: linesize * 480)
+        }
+
+        XCTAssertNotNil(serial)
+        XCTAssertEqual(serial, parallel)
+    }
+
+    func testConvertToImageBuildsBGRAImagesByDefault() throws {
+        let frame = Self.yuv420Frame(width: 16, height: 8) { _, _ in 128 }
+
+        let image = try XCTUnwrap(frame.withPlanes { srcData, srcLinesize in
+            IRYUVConvertToImage(srcData: srcData, srcLinesize: srcLinesize, width: 16, height: 8,
+                                pixelFormat: AV_PIX_FMT_YUV420P, converter: IRYUVImageConverter())
+        })
+
+        XCTAssertEqual(image.cgImage?.bitsPerPixel, 32)
+        XCTAssertEqual(image.cgImage?.alphaInfo, .noneSkipFirst)
+    }
+
+    func testConcurrentCallersShareOneConverter() {
+        let converter = IRYUVImageConverter(rowParallel: true)
+        let frame = Self.yuv420Frame(width: 64, height: 256) { x, _ in UInt8(x) }
+        let expected = frame.convert(with: converter, outputFormat: .bgra) { pixels, linesize in
+            Data(bytes: pixels, count: linesize * 256)
+        }
+        let mismatches = ManagedCounter()
+
+        DispatchQueue.concurrentPerform(iterations: 16) { _ in
+            let result = frame.convert(with: converter, outputFormat: .bgra) { pixels, linesize in
+                Data(bytes: pixels, count: linesize * 256)
+            }
+            if result != expected {
+                mismatches.increment()
+            }
+        }
+
+        XCTAssertEqual(mismatches.value, 0)
+        XCTAssertEqual(converter.createdEntryCount, 1)
+    }
+
+    // MARK: - Benchmarks
+
+    /// A 1080p frame converted with a fresh context and buffer, as before the cache.
+    func testBenchmarkUncachedConversion() {
+        let frame = Self.yuv420Frame(width: 1920, height: 1080) { x, y in UInt8(truncatingIfNeeded: x + y) }
+        measure {
+            for _ in 0..<10 {
+                _ = frame.convert(with: IRYUVImageConverter(), outputFormat: .bgra) { _, linesize in linesize }
+            }
+        }
+    }
+
+    func testBenchmarkCachedConversion() {
+        let frame = Self.yuv420Frame(width: 1920, height: 1080) { x, y in UInt8(truncatingIfNeeded: x + y) }
+        let converter = IRYUVImageConverter()
+        measure {
+            for _ in 0..<10 {
+                _ = frame.convert(with: converter, outputFormat: .bgra) { _, linesize in linesize }
+            }
+        }
+    }
+
+    func testBenchmarkRowParallelConversion() {
+        let frame = Self.yuv420Frame(width: 1920, height: 1080) { x, y in UInt8(truncatingIfNeeded: x + y) }
+        let converter = IRYUVImageConverter(rowParallel: true)
+        measure {
+            for _ in 0..<10 {
+                _ = frame.convert(with: converter, outputFormat: .bgra) { _, linesize in linesize }
+            }
+        }
+    }
+
+    // MARK: - Helpers
+
+    private final class ManagedCounter {
+        private let lock = NSLock()
+        private(set) var value = 0
+
+        func increment() {
+            lock.lock()
+            value += 1
+            lock.unlock()
+        }
+    }
+
+    private struct YUV420Frame {
+        let width: Int
+        let height: Int
+        let luma: [UInt8]
+        let chroma: [UInt8]
+
+        func withPlanes<T>(_ body: ([UnsafePointer<UInt8>?], [Int32]) -> T) -> T {
+            return luma.withUnsafeBufferPointer { lumaBuffer in
+                chroma.withUnsafeBufferPointer { chromaBuffer in
+                    body([lumaBuffer.baseAddress, chromaBuffer.baseAddress, chromaBuffer.baseAddress],
+                         [Int32(width), Int32(width / 2), Int32(width / 2)])
+                }
+            }
+        }
+
+        func convert<T>(with converter: IRYUVImageConverter,
+                        outputFormat: IRYUVImageOutputFormat,
+                        body: (UnsafePointer<UInt8>, Int) -> T?) -> T? {
+            return withPlanes { srcData, srcLinesize in
+                converter.convert(srcData: srcData, srcLinesize: srcLinesize, width: width, height: height,
+                                  pixelFormat: AV_PIX_FMT_YUV420P, outputFormat: outputFormat, body: body)
+            }
+        }
+    }
+
+    /// Both chroma planes share one neutral buffer.
+    private static func yuv420Frame(width: Int, height: Int, luma: (Int, Int) -> UInt8) -> YUV420Frame {
+        var lumaPlane = [UInt8](repeating: 0, count: width * height)
+        for y in 0..<height {
+            for x in 0..<width {
+                lumaPlane[y * width + x] = luma(x, y)
+            }
+        }
+        return YUV420Frame(width: width,
+                           height: height,
+                           luma: lumaPlane,
+                           chroma: [UInt8](repeating: 128, count: width / 2 * height / 2))
+    }
+}